@@ -131,6 +131,39 @@
  */
 #define CFE_PSP_SOFT_TIMEBASE_NAME "cFS-Master"
 
+/******************************************************************************
+ TYPE DEFINITIONS
+ ******************************************************************************/
+
+/**
+ * @brief Timing statistics of the software timebase
+ *
+ * Lateness is the delay between the scheduled deadline of a timebase tick
+ * and the time the timebase thread actually woke up to service it.
+ *
+ * @sa CFE_PSP_SoftTimebase_GetStats()
+ */
+typedef struct
+{
+    uint64 TickCount;        /**< Number of timebase periods elapsed */
+    uint64 MissedTicks;      /**< Periods that elapsed without a wakeup of their own (serviced late) */
+    uint64 NumWakeups;       /**< Number of wakeups of the timebase thread (lateness samples) */
+    uint32 MinLatenessNsec;  /**< Minimum lateness of a wakeup, in nanoseconds */
+    uint32 MeanLatenessNsec; /**< Mean lateness of a wakeup, in nanoseconds */
+    uint32 MaxLatenessNsec;  /**< Maximum lateness of a wakeup, in nanoseconds */
+    uint32 P99LatenessNsec;  /**< 99th percentile lateness of a wakeup, in nanoseconds (1 usec resolution) */
+} CFE_PSP_SoftTimebase_Stats_t;
+
+/**
+ * @brief Callback for a timebase derived from the software timebase
+ *
+ * @param TickCount Number of ticks of the derived timebase since startup
+ * @param Arg       Opaque argument supplied when the derived timebase was added
+ *
+ * @sa CFE_PSP_SoftTimebase_AddDerived()
+ */
+typedef void (*CFE_PSP_SoftTimebase_Callback_t)(uint32 TickCount, void *Arg);
+
 /******************************************************************************
  FUNCTION PROTOTYPES
  ******************************************************************************/
@@ -172,6 +205,25 @@ extern void CFE_PSP_Main(void);
  */
 extern void CFE_PSP_GetTime(OS_time_t *LocalTime);
 
+/*--------------------------------------------------------------------------------------*/
+/**
+ * @brief Read a coarse, low-overhead version of the platform clock
+ *
+ * Outputs the value of CFE_PSP_GetTime() as of the most recent update by the
+ * software timebase.  The resolution is therefore the update period of the
+ * software timebase (typically 10ms, see CFE_PSP_SoftTimebase_SetCoarsePeriod()),
+ * but this only reads a value from memory
+ * and is much cheaper than CFE_PSP_GetTime().  It is intended for uses such as
+ * timestamping log entries, where a fine resolution is not needed.
+ *
+ * If the software timebase is not running, this is the same as CFE_PSP_GetTime().
+ *
+ * @sa CFE_PSP_GetTime()
+ *
+ * @param[out] LocalTime Value of PSP tick counter as OS_time_t
+ */
+extern void CFE_PSP_GetTimeCoarse(OS_time_t *LocalTime);
+
 /*--------------------------------------------------------------------------------------*/
 /**
  * @brief Entry point back to the BSP to restart the processor.
@@ -296,6 +348,70 @@ extern uint32 CFE_PSP_GetTimerLow32Rollover(void);
  */
 extern void CFE_PSP_Get_Timebase(uint32 *Tbu, uint32 *Tbl);
 
+/*--------------------------------------------------------------------------------------*/
+/**
+ * @brief Get the timing statistics of the software timebase
+ *
+ * Reports how late the software timebase (#CFE_PSP_SOFT_TIMEBASE_NAME) has been
+ * in servicing its ticks, accumulated since startup or the last call to
+ * CFE_PSP_SoftTimebase_ResetStats().
+ *
+ * @note This is only available on platforms where the software timebase is
+ * driven by the PSP itself, such as pc-linux with CFE_PSP_SOFT_TIMEBASE_TIMERFD.
+ *
+ * @param[out] Stats Buffer to hold the statistics
+ *
+ * @retval CFE_PSP_SUCCESS on success
+ * @retval CFE_PSP_INVALID_POINTER if Stats is NULL
+ * @retval CFE_PSP_ERROR_NOT_IMPLEMENTED if not implemented on this platform
+ */
+extern int32 CFE_PSP_SoftTimebase_GetStats(CFE_PSP_SoftTimebase_Stats_t *Stats);
+
+/*--------------------------------------------------------------------------------------*/
+/**
+ * @brief Reset the timing statistics of the software timebase
+ *
+ * @sa CFE_PSP_SoftTimebase_GetStats()
+ */
+extern void CFE_PSP_SoftTimebase_ResetStats(void);
+
+/*--------------------------------------------------------------------------------------*/
+/**
+ * @brief Add a timebase derived from the software timebase
+ *
+ * Registers a callback that is invoked once every Divider ticks of the
+ * software timebase (#CFE_PSP_SOFT_TIMEBASE_NAME).  All derived timebases
+ * tick on master ticks that are a multiple of their divider, so they are
+ * phase-aligned with each other and with the master.
+ *
+ * The callback runs directly in the context of the software timebase thread,
+ * so no additional threads are created.  It must therefore be short and must
+ * not block, for example by giving a semaphore to wake an application task.
+ *
+ * @param[in] Name     Name of the derived timebase (for diagnostics)
+ * @param[in] Divider  Number of master ticks per tick of the derived timebase
+ * @param[in] Callback Function to invoke on every tick of the derived timebase
+ * @param[in] Arg      Opaque argument passed to the callback
+ *
+ * @retval CFE_PSP_SUCCESS on success
+ * @retval CFE_PSP_INVALID_POINTER if Name or Callback is NULL
+ * @retval CFE_PSP_ERROR if the timebase could not be added
+ */
+extern int32 CFE_PSP_SoftTimebase_AddDerived(const char *Name, uint32 Divider, CFE_PSP_SoftTimebase_Callback_t Callback,
+                                             void *Arg);
+
+/*--------------------------------------------------------------------------------------*/
+/**
+ * @brief Set how often the software timebase updates CFE_PSP_GetTimeCoarse()
+ *
+ * The period is rounded down to a whole number of software timebase periods,
+ * with a minimum of one, and takes effect from the next tick.  The initial
+ * period is CFE_PSP_SOFT_TIMEBASE_COARSE_PERIOD from cfe_psp_config.h.
+ *
+ * @param[in] PeriodUsec Update period in microseconds
+ */
+extern void CFE_PSP_SoftTimebase_SetCoarsePeriod(uint32 PeriodUsec);
+
 /*--------------------------------------------------------------------------------------*/
 /**
  * @brief CFE_PSP_Get_Dec
@@ -1,7 +1,14 @@
 /************************************************************************
  * Includes
  ************************************************************************/
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+
 #include "cfe_psp.h"
+#include "cfe_psp_sysmonalarm.h"
+#include "cfe_psp_sysmonrecord.h"
+#include "cfe_psp_sysmonutil.h"
 
 #include "iodriver_impl.h"
 #include "iodriver_analog_io.h"
@@ -15,6 +22,12 @@
  ********************************************************************/
 #define FREERTOS_SYSMON_AGGREGATE_SUBSYS   0
 #define FREERTOS_SYSMON_CPULOAD_SUBSYS     1
+#define FREERTOS_SYSMON_CPUAVG_1S_SUBSYS   2
+#define FREERTOS_SYSMON_CPUAVG_10S_SUBSYS  3
+#define FREERTOS_SYSMON_CPUAVG_60S_SUBSYS  4
+#define FREERTOS_SYSMON_TASKLOAD_SUBSYS    5
+#define FREERTOS_SYSMON_TASKSTACK_SUBSYS   6
+#define FREERTOS_SYSMON_MEMORY_SUBSYS      7
 #define FREERTOS_SYSMON_AGGR_CPULOAD_SUBCH 0
 #define FREERTOS_SYSMON_SAMPLE_DELAY       1000
 #define FREERTOS_SYSMON_MAX_CPUS           1
@@ -23,10 +36,74 @@
 #define FREERTOS_SYSMON_MAX_SCALE          100
 #define FREERTOS_SYSMON_TASK_NAME          "freertos_sysmon"
 
+/*
+ * Exponentially weighted averages of the CPU load over 1, 10 and 60 seconds
+ *
+ * These are the "cpu-load-1s", "cpu-load-10s" and "cpu-load-60s" subchannels
+ * of the aggregate and the "per-cpu-1s", "per-cpu-10s" and "per-cpu-60s"
+ * subsystems.  As the sample period is fixed the decay per sample is a constant,
+ * exp(-period/window) as a fraction of CFE_PSP_SYSMON_DECAY_ONE.
+ */
+#define FREERTOS_SYSMON_NUM_AVG_WINDOWS 3
+
+#if FREERTOS_SYSMON_SAMPLE_DELAY != 1000
+#error "freertos_sysmon_avg_decay is computed for a sample period of 1000 ms"
+#endif
+
+/*
+ * Subchannels of the "memory" subsystem, all in bytes except for the alarms,
+ * which are the FREERTOS_SYSMON_ALARM bits currently raised.  The stack value
+ * is the lowest of all tasks, see the "per-task-stack" subsystem for each task.
+ */
+#define FREERTOS_SYSMON_HEAP_FREE_SUBCH      0
+#define FREERTOS_SYSMON_HEAP_MIN_FREE_SUBCH  1
+#define FREERTOS_SYSMON_STACK_MIN_FREE_SUBCH 2
+#define FREERTOS_SYSMON_ALARMS_SUBCH         3
+#define FREERTOS_SYSMON_MEMORY_NUM_SUBCH     4
+
+#define FREERTOS_SYSMON_ALARM_HEAP  0x1
+#define FREERTOS_SYSMON_ALARM_STACK 0x2
+
+/*
+ * Sample period of the memory subsystem, which is independent of the CPU load and
+ * can be changed at run time via CFE_PSP_IODriver_SET_CONFIGURATION with
+ * "memory_period_ms=<n>".  The alarm thresholds are set the same way with
+ * "heap_free_min=<bytes>" and "stack_free_min=<bytes>", where zero disables them.
+ * Like the configurable alarms on any channel ("alarm=...", see cfe_psp_sysmonalarm.h),
+ * these notify CFE when they are raised or cleared.
+ */
+#ifndef FREERTOS_SYSMON_DEFAULT_MEMORY_PERIOD_MS
+#define FREERTOS_SYSMON_DEFAULT_MEMORY_PERIOD_MS 1000
+#endif
+#define FREERTOS_SYSMON_MIN_MEMORY_PERIOD_MS 10
+#define FREERTOS_SYSMON_MAX_MEMORY_PERIOD_MS 3600000
+
+/*
+ * Size of the per-task table, which is also the array passed to uxTaskGetSystemState(),
+ * so this must be at least the number of tasks in the system.
+ */
+#ifndef FREERTOS_SYSMON_MAX_TASKS
+#define FREERTOS_SYSMON_MAX_TASKS 32
+#endif
+
 #ifndef UNUSED_ARGUMENT
 #define UNUSED_ARGUMENT(x) (void)(x)
 #endif
 
+#ifdef DEBUG_BUILD
+#define FREERTOS_SYSMON_DEBUG(...) OS_printf(__VA_ARGS__)
+#else
+#define FREERTOS_SYSMON_DEBUG(...)
+#endif
+
+/*
+ * The heap statistics only exist with heap_4 and heap_5, not with heap_3 (as used by
+ * the POSIX port) which wraps malloc().  These weak references are NULL without them,
+ * and then the heap subchannels read as an error.
+ */
+#pragma weak xPortGetFreeHeapSize
+#pragma weak xPortGetMinimumEverFreeHeapSize
+
 
 /********************************************************************
  * Local Type Definitions
@@ -36,9 +113,64 @@ typedef struct freertos_sysmon_cpuload_core
     TickType_t last_run_time;
     TickType_t idle_last_uptime;
     CFE_PSP_IODriver_AdcCode_t avg_load;
+    bool                       has_avg;
+    uint32_t                   avg[FREERTOS_SYSMON_NUM_AVG_WINDOWS];
 
 } freertos_sysmon_cpuload_core_t;
 
+/*
+ * Each task keeps its slot, and so its subchannel, for as long as it exists.
+ * Slots are matched by the task number, which FreeRTOS never reuses.
+ */
+typedef struct freertos_sysmon_task_entry
+{
+    UBaseType_t                task_number; /* zero if this slot is free */
+    bool                       seen;
+    uint32_t                   last_run_time;
+    CFE_PSP_IODriver_AdcCode_t avg_load;
+    CFE_PSP_IODriver_AdcCode_t stack_free; /* bytes of stack which have never been used */
+    char                       name[configMAX_TASK_NAME_LEN];
+} freertos_sysmon_task_entry_t;
+
+typedef struct freertos_sysmon_tasks_state
+{
+    uint32_t last_total_run_time;
+    uint16_t num_slots; /* highest slot in use + 1 */
+    bool     tasks_dropped;
+
+    TaskStatus_t                 status[FREERTOS_SYSMON_MAX_TASKS]; /* filled in by uxTaskGetSystemState() */
+    freertos_sysmon_task_entry_t entries[FREERTOS_SYSMON_MAX_TASKS];
+} freertos_sysmon_tasks_state_t;
+
+typedef struct freertos_sysmon_memory_state
+{
+    TickType_t last_sample_time;
+
+    CFE_PSP_IODriver_AdcCode_t value[FREERTOS_SYSMON_MEMORY_NUM_SUBCH];
+} freertos_sysmon_memory_state_t;
+
+/*
+ * The values of one complete sample, as seen by readers
+ *
+ * The sampler task fills in one of two snapshots while readers use the other,
+ * then switches them over by incrementing snapshot_seq.  Readers check that
+ * snapshot_seq is unchanged after reading, and only need to retry if they were
+ * preempted for a whole sample period.  The sampler never waits for readers.
+ */
+typedef struct freertos_sysmon_snapshot
+{
+    /* the current load of each CPU, followed by the same for each of the averages */
+    CFE_PSP_IODriver_AdcCode_t cpu_load[1 + FREERTOS_SYSMON_NUM_AVG_WINDOWS][FREERTOS_SYSMON_MAX_CPUS];
+
+    uint16_t                   num_task_slots;
+    CFE_PSP_IODriver_AdcCode_t task_load[FREERTOS_SYSMON_MAX_TASKS];
+    CFE_PSP_IODriver_AdcCode_t task_stack[FREERTOS_SYSMON_MAX_TASKS];
+    /* empty if the slot is free */
+    char task_name[FREERTOS_SYSMON_MAX_TASKS][configMAX_TASK_NAME_LEN];
+
+    CFE_PSP_IODriver_AdcCode_t memory[FREERTOS_SYSMON_MEMORY_NUM_SUBCH];
+} freertos_sysmon_snapshot_t;
+
 /* This driver was made with use in a FreeRTOS single core. In case of
  * using SMP, it would be required changes to support the multi core
  * monitoring.
@@ -51,12 +183,31 @@ typedef struct freertos_sysmon_cpuload_state
 
     /* Driver only supported for single core. */
     freertos_sysmon_cpuload_core_t core;
+    freertos_sysmon_tasks_state_t  tasks;
+    freertos_sysmon_memory_state_t memory;
+    CFE_PSP_SysmonRecorder_t       recorder; /* records each sample, if the platform reserves memory for it */
+
+    /* kept across stop/start of the sampler, as readers use these without locking */
+    volatile uint32_t          snapshot_seq; /* number of samples published, the latest is in snapshot[seq & 1] */
+    freertos_sysmon_snapshot_t snapshot[2];
 
 } freertos_sysmon_cpuload_state_t;
 
+/*
+ * Configuration, which is kept across stop/start of the sampler
+ */
+typedef struct freertos_sysmon_config
+{
+    volatile uint32_t memory_period_ms;
+    volatile uint32_t heap_free_min;
+    volatile uint32_t stack_free_min;
+} freertos_sysmon_config_t;
+
 typedef struct freertos_sysmon_state
 {
     uint32_t                        local_module_id;
+    freertos_sysmon_config_t        config;
+    CFE_PSP_SysmonAlarmSet_t        alarms;
     freertos_sysmon_cpuload_state_t cpu_load;
 
 } freertos_sysmon_state_t;
@@ -69,24 +220,39 @@ static int32_t freertos_sysmon_Start(freertos_sysmon_cpuload_state_t* state);
 static int32_t freertos_sysmon_Stop(freertos_sysmon_cpuload_state_t* state);
 
 int32_t freertos_sysmon_aggregate_dispatch(uint32_t CommandCode, uint16_t Subchannel, CFE_PSP_IODriver_Arg_t Arg);
-int32_t freertos_sysmon_calc_aggregate_cpu(freertos_sysmon_cpuload_state_t *state, CFE_PSP_IODriver_AdcCode_t *Val);
+int32_t freertos_sysmon_calc_aggregate_cpu(freertos_sysmon_cpuload_state_t *state, uint16_t Subchannel,
+                                           CFE_PSP_IODriver_AnalogRdWr_t *RdWr);
 
 /* Function that starts up freertos_sysmon driver. */
 int32_t freertos_sysmon_DevCmd(uint32_t CommandCode, uint16_t SubsystemId, uint16_t SubchannelId,
                                CFE_PSP_IODriver_Arg_t Arg);
+int32_t freertos_sysmon_DevMutex(uint32_t CommandCode, uint16_t SubsystemId, uint16_t SubchannelId,
+                                 CFE_PSP_IODriver_Arg_t Arg);
 
 /********************************************************************
  * Global Data
  ********************************************************************/
 /* freertos_sysmon device command that is called by iodriver to start up freertos_sysmon */
-CFE_PSP_IODriver_API_t freertos_sysmon_DevApi = {.DeviceCommand = freertos_sysmon_DevCmd};
+CFE_PSP_IODriver_API_t freertos_sysmon_DevApi = {
+    .DeviceCommand     = freertos_sysmon_DevCmd,
+    .DeviceMutex       = freertos_sysmon_DevMutex,
+    .ReentrantBaseOps  = CFE_PSP_SYSMON_REENTRANT_BASE_OPS,
+    .ReentrantClassOps = CFE_PSP_SYSMON_REENTRANT_CLASS_OPS};
 
 CFE_PSP_MODULE_DECLARE_IODEVICEDRIVER(freertos_sysmon);
 
 freertos_sysmon_state_t freertos_sysmon_global;
 
-static const char *freertos_sysmon_subsystem_names[]  = {"aggregate", "per-cpu", NULL};
-static const char *freertos_sysmon_subchannel_names[] = {"cpu-load", NULL};
+static const char *freertos_sysmon_subsystem_names[]  = {"aggregate", "per-cpu",        "per-cpu-1s",
+                                                         "per-cpu-10s", "per-cpu-60s", "per-task",
+                                                         "per-task-stack", "memory", NULL};
+static const char *freertos_sysmon_subchannel_names[] = {"cpu-load", "cpu-load-1s", "cpu-load-10s", "cpu-load-60s",
+                                                         NULL};
+static const char *freertos_sysmon_memory_subchannel_names[] = {"heap-free", "heap-min-free", "stack-min-free",
+                                                                "alarms", NULL};
+
+/* exp(-1/1), exp(-1/10) and exp(-1/60), the fraction of each average remaining after one sample */
+static const uint32_t freertos_sysmon_avg_decay[FREERTOS_SYSMON_NUM_AVG_WINDOWS] = {24109, 59299, 64453};
 
 /***********************************************************************
  * Global Functions
@@ -95,7 +261,77 @@ void freertos_sysmon_Init(uint32_t local_module_id)
 {
     memset(&freertos_sysmon_global, 0, sizeof(freertos_sysmon_global));
 
-    freertos_sysmon_global.local_module_id = local_module_id;
+    freertos_sysmon_global.local_module_id         = local_module_id;
+    freertos_sysmon_global.config.memory_period_ms = FREERTOS_SYSMON_DEFAULT_MEMORY_PERIOD_MS;
+
+    CFE_PSP_SysmonAlarm_Init(&freertos_sysmon_global.alarms, "freertos_sysmon", freertos_sysmon_subsystem_names);
+}
+
+/*
+ * Sets one of the memory alarm thresholds from its configuration value
+ */
+static int32_t freertos_sysmon_set_threshold(volatile uint32_t *threshold, const char *value_str)
+{
+    char *        end_p;
+    unsigned long value;
+
+    value = strtoul(value_str, &end_p, 10);
+    if (end_p == value_str || *end_p != 0 || value > 0x7FFFFFFF)
+    {
+        OS_printf("CFE_PSP(freertos_sysmon): Invalid threshold \'%s\'\n", value_str);
+        return CFE_PSP_ERROR;
+    }
+
+    *threshold = value;
+    return CFE_PSP_SUCCESS;
+}
+
+int32_t freertos_sysmon_set_config(const char *config_str)
+{
+    freertos_sysmon_config_t *config;
+    const char *              value_str;
+    char *                    end_p;
+    unsigned long             value;
+
+    if (config_str == NULL)
+    {
+        return CFE_PSP_INVALID_POINTER;
+    }
+
+    config = &freertos_sysmon_global.config;
+
+    if ((value_str = CFE_PSP_SysmonConfig_GetValue(config_str, "alarm")) != NULL)
+    {
+        return CFE_PSP_SysmonAlarm_Configure(&freertos_sysmon_global.alarms, value_str);
+    }
+    else if ((value_str = CFE_PSP_SysmonConfig_GetValue(config_str, "memory_period_ms")) != NULL)
+    {
+        value = strtoul(value_str, &end_p, 10);
+        if (end_p == value_str || *end_p != 0 || value < FREERTOS_SYSMON_MIN_MEMORY_PERIOD_MS ||
+            value > FREERTOS_SYSMON_MAX_MEMORY_PERIOD_MS)
+        {
+            OS_printf("CFE_PSP(freertos_sysmon): Invalid memory sample period \'%s\', must be %u-%u ms\n", value_str,
+                      (unsigned int)FREERTOS_SYSMON_MIN_MEMORY_PERIOD_MS,
+                      (unsigned int)FREERTOS_SYSMON_MAX_MEMORY_PERIOD_MS);
+            return CFE_PSP_ERROR;
+        }
+
+        config->memory_period_ms = value;
+    }
+    else if ((value_str = CFE_PSP_SysmonConfig_GetValue(config_str, "heap_free_min")) != NULL)
+    {
+        return freertos_sysmon_set_threshold(&config->heap_free_min, value_str);
+    }
+    else if ((value_str = CFE_PSP_SysmonConfig_GetValue(config_str, "stack_free_min")) != NULL)
+    {
+        return freertos_sysmon_set_threshold(&config->stack_free_min, value_str);
+    }
+    else
+    {
+        return CFE_PSP_ERROR_NOT_IMPLEMENTED;
+    }
+
+    return CFE_PSP_SUCCESS;
 }
 
 void freertos_sysmon_update_state(freertos_sysmon_cpuload_state_t *state)
@@ -131,10 +367,9 @@ void freertos_sysmon_update_state(freertos_sysmon_cpuload_state_t *state)
         idle_percent_since_last_report = ((uint32_t)( ((uint64_t)idle_uptime_elapsed * 100) / total_elapsed ));
         current_load = FREERTOS_SYSMON_MAX_SCALE - idle_percent_since_last_report;
 
-        OS_printf("IDLE Percent: %u, Ticks Elapsed: %u, Idle Ticks: %u\n",
-                  (unsigned int)idle_percent_since_last_report,
-                  (unsigned int)total_elapsed,
-                  (unsigned int)idle_uptime_elapsed);
+        FREERTOS_SYSMON_DEBUG("CFE_PSP(freertos_sysmon): IDLE Percent: %u, Ticks Elapsed: %u, Idle Ticks: %u\n",
+                              (unsigned int)idle_percent_since_last_report, (unsigned int)total_elapsed,
+                              (unsigned int)idle_uptime_elapsed);
 
         /*
         ** Mimic ADC so that "analogio" API can be used with out modification. API assumes 24 bits.
@@ -143,6 +378,9 @@ void freertos_sysmon_update_state(freertos_sysmon_cpuload_state_t *state)
         */
         core->avg_load = (0x1000 * current_load) / FREERTOS_SYSMON_MAX_SCALE;
         core->avg_load |= (core->avg_load << 12);
+
+        CFE_PSP_SysmonAvg_Update(core->avg, &core->has_avg, core->avg_load, freertos_sysmon_avg_decay,
+                                 FREERTOS_SYSMON_NUM_AVG_WINDOWS);
     }
     else
     {
@@ -153,16 +391,419 @@ void freertos_sysmon_update_state(freertos_sysmon_cpuload_state_t *state)
     core->last_run_time    = current_uptime;
 }
 
+static freertos_sysmon_task_entry_t *freertos_sysmon_find_task(freertos_sysmon_tasks_state_t *tasks,
+                                                               const TaskStatus_t *           status)
+{
+    freertos_sysmon_task_entry_t *free_entry;
+    uint16_t                      i;
+
+    free_entry = NULL;
+    for (i = 0; i < FREERTOS_SYSMON_MAX_TASKS; ++i)
+    {
+        if (tasks->entries[i].task_number == status->xTaskNumber)
+        {
+            return &tasks->entries[i];
+        }
+        if (free_entry == NULL && tasks->entries[i].task_number == 0)
+        {
+            free_entry = &tasks->entries[i];
+        }
+    }
+
+    /* a new task, whose load is zero until the next sample */
+    if (free_entry != NULL)
+    {
+        free_entry->task_number   = status->xTaskNumber;
+        free_entry->last_run_time = status->ulRunTimeCounter;
+        free_entry->avg_load      = 0;
+        strncpy(free_entry->name, status->pcTaskName, sizeof(free_entry->name) - 1);
+        free_entry->name[sizeof(free_entry->name) - 1] = 0;
+    }
+
+    return free_entry;
+}
+
+/*
+ * Samples the run time and stack use of all tasks with one call to uxTaskGetSystemState()
+ */
+void freertos_sysmon_update_tasks(freertos_sysmon_tasks_state_t *tasks, bool update_load)
+{
+    freertos_sysmon_task_entry_t *entry;
+    uint32_t                      total_run_time;
+    uint32_t                      elapsed;
+    uint64_t                      load;
+    UBaseType_t                   num_tasks;
+    UBaseType_t                   i;
+
+    /* this returns zero if the array is too small for all tasks */
+    num_tasks = uxTaskGetSystemState(tasks->status, FREERTOS_SYSMON_MAX_TASKS, &total_run_time);
+    if (num_tasks == 0)
+    {
+        if (!tasks->tasks_dropped)
+        {
+            OS_printf("CFE_PSP(freertos_sysmon): More than %u tasks, increase FREERTOS_SYSMON_MAX_TASKS\n",
+                      (unsigned int)FREERTOS_SYSMON_MAX_TASKS);
+            tasks->tasks_dropped = true;
+        }
+        return;
+    }
+
+    elapsed = update_load ? (total_run_time - tasks->last_total_run_time) : 0;
+    for (i = 0; i < FREERTOS_SYSMON_MAX_TASKS; ++i)
+    {
+        tasks->entries[i].seen = false;
+    }
+
+    for (i = 0; i < num_tasks; ++i)
+    {
+        entry = freertos_sysmon_find_task(tasks, &tasks->status[i]);
+        if (entry == NULL)
+        {
+            continue;
+        }
+
+        /* as for the CPU load, 12 bits duplicated to fill the 24 bit analog value */
+        if (elapsed != 0)
+        {
+            load = ((uint64_t)0x1000 * (uint32_t)(tasks->status[i].ulRunTimeCounter - entry->last_run_time)) / elapsed;
+            if (load > 0xFFF)
+            {
+                load = 0xFFF;
+            }
+            entry->avg_load = load | (load << 12);
+        }
+
+        if (update_load)
+        {
+            entry->last_run_time = tasks->status[i].ulRunTimeCounter;
+        }
+        entry->stack_free    = tasks->status[i].usStackHighWaterMark * sizeof(StackType_t);
+        entry->seen          = true;
+    }
+
+    /* tasks which were not reported have been deleted */
+    tasks->num_slots = 0;
+    for (i = 0; i < FREERTOS_SYSMON_MAX_TASKS; ++i)
+    {
+        entry = &tasks->entries[i];
+        if (!entry->seen)
+        {
+            entry->task_number = 0;
+            entry->name[0]     = 0;
+        }
+        else
+        {
+            tasks->num_slots = i + 1;
+        }
+    }
+
+    if (update_load)
+    {
+        tasks->last_total_run_time = total_run_time;
+    }
+}
+
+/*
+ * Clamps a size in bytes to the range of an analog value
+ */
+static CFE_PSP_IODriver_AdcCode_t freertos_sysmon_clamp_size(size_t size)
+{
+    return (size > 0x7FFFFFFF) ? 0x7FFFFFFF : (CFE_PSP_IODriver_AdcCode_t)size;
+}
+
+/*
+ * Samples the heap and finds the task with the least stack left, from the per-task
+ * values just updated, then checks both against the alarm thresholds.  Each alarm is
+ * reported once when raised and again when cleared.
+ */
+void freertos_sysmon_update_memory(freertos_sysmon_cpuload_state_t *state)
+{
+    freertos_sysmon_memory_state_t *    memory;
+    const freertos_sysmon_task_entry_t *min_entry;
+    uint32_t                            threshold;
+    uint32_t                            alarms;
+    uint16_t                            i;
+
+    memory = &state->memory;
+
+    if (xPortGetFreeHeapSize != NULL && xPortGetMinimumEverFreeHeapSize != NULL)
+    {
+        memory->value[FREERTOS_SYSMON_HEAP_FREE_SUBCH] = freertos_sysmon_clamp_size(xPortGetFreeHeapSize());
+        memory->value[FREERTOS_SYSMON_HEAP_MIN_FREE_SUBCH] =
+            freertos_sysmon_clamp_size(xPortGetMinimumEverFreeHeapSize());
+    }
+
+    min_entry = NULL;
+    for (i = 0; i < state->tasks.num_slots; ++i)
+    {
+        if (state->tasks.entries[i].task_number != 0 &&
+            (min_entry == NULL || state->tasks.entries[i].stack_free < min_entry->stack_free))
+        {
+            min_entry = &state->tasks.entries[i];
+        }
+    }
+    if (min_entry != NULL)
+    {
+        memory->value[FREERTOS_SYSMON_STACK_MIN_FREE_SUBCH] = min_entry->stack_free;
+    }
+
+    alarms = 0;
+
+    threshold = freertos_sysmon_global.config.heap_free_min;
+    if (threshold != 0 && xPortGetFreeHeapSize != NULL &&
+        memory->value[FREERTOS_SYSMON_HEAP_FREE_SUBCH] < (CFE_PSP_IODriver_AdcCode_t)threshold)
+    {
+        alarms |= FREERTOS_SYSMON_ALARM_HEAP;
+    }
+
+    threshold = freertos_sysmon_global.config.stack_free_min;
+    if (threshold != 0 && min_entry != NULL && min_entry->stack_free < (CFE_PSP_IODriver_AdcCode_t)threshold)
+    {
+        alarms |= FREERTOS_SYSMON_ALARM_STACK;
+    }
+
+    if ((alarms ^ memory->value[FREERTOS_SYSMON_ALARMS_SUBCH]) & FREERTOS_SYSMON_ALARM_HEAP)
+    {
+        OS_printf("CFE_PSP(freertos_sysmon): Free heap %s: %ld bytes\n",
+                  (alarms & FREERTOS_SYSMON_ALARM_HEAP) ? "LOW" : "recovered",
+                  (long)memory->value[FREERTOS_SYSMON_HEAP_FREE_SUBCH]);
+    }
+    if ((alarms ^ memory->value[FREERTOS_SYSMON_ALARMS_SUBCH]) & FREERTOS_SYSMON_ALARM_STACK)
+    {
+        OS_printf("CFE_PSP(freertos_sysmon): Free stack %s: %ld bytes in task %s\n",
+                  (alarms & FREERTOS_SYSMON_ALARM_STACK) ? "LOW" : "recovered",
+                  (long)memory->value[FREERTOS_SYSMON_STACK_MIN_FREE_SUBCH],
+                  (min_entry != NULL) ? min_entry->name : "");
+    }
+
+    if (alarms != (uint32_t)memory->value[FREERTOS_SYSMON_ALARMS_SUBCH])
+    {
+        CFE_PSP_SysmonAlarm_Notify(&freertos_sysmon_global.alarms);
+    }
+
+    memory->value[FREERTOS_SYSMON_ALARMS_SUBCH] = alarms;
+}
+
+/*
+ * Records every channel of a published snapshot, skipping free task slots
+ */
+static void freertos_sysmon_record(freertos_sysmon_cpuload_state_t *state, const freertos_sysmon_snapshot_t *snap)
+{
+    uint16_t i;
+    int      w;
+
+    if (state->recorder.Header == NULL)
+    {
+        return;
+    }
+
+    CFE_PSP_SysmonRecord_BeginSample(&state->recorder);
+    for (w = 0; w <= FREERTOS_SYSMON_NUM_AVG_WINDOWS; ++w)
+    {
+        /* single core, so the aggregate is the same as the one CPU */
+        CFE_PSP_SysmonRecord_Add(&state->recorder, FREERTOS_SYSMON_AGGREGATE_SUBSYS, w, snap->cpu_load[w][0]);
+        CFE_PSP_SysmonRecord_Add(&state->recorder, FREERTOS_SYSMON_CPULOAD_SUBSYS + w, 0, snap->cpu_load[w][0]);
+    }
+    for (i = 0; i < snap->num_task_slots; ++i)
+    {
+        if (snap->task_name[i][0] != 0)
+        {
+            CFE_PSP_SysmonRecord_Add(&state->recorder, FREERTOS_SYSMON_TASKLOAD_SUBSYS, i, snap->task_load[i]);
+            CFE_PSP_SysmonRecord_Add(&state->recorder, FREERTOS_SYSMON_TASKSTACK_SUBSYS, i, snap->task_stack[i]);
+        }
+    }
+    for (i = 0; i < FREERTOS_SYSMON_MEMORY_NUM_SUBCH; ++i)
+    {
+        CFE_PSP_SysmonRecord_Add(&state->recorder, FREERTOS_SYSMON_MEMORY_SUBSYS, i, snap->memory[i]);
+    }
+    CFE_PSP_SysmonRecord_EndSample(&state->recorder);
+}
+
+/*
+ * Reads a channel of the snapshot just published, for the alarms
+ */
+static bool freertos_sysmon_alarm_value(void *arg, uint16_t subsystem, uint16_t subchannel, uint32_t *value)
+{
+    const freertos_sysmon_snapshot_t *snap = arg;
+
+    switch (subsystem)
+    {
+        case FREERTOS_SYSMON_AGGREGATE_SUBSYS:
+            if (subchannel > FREERTOS_SYSMON_NUM_AVG_WINDOWS)
+            {
+                return false;
+            }
+            *value = snap->cpu_load[subchannel][0];
+            break;
+        case FREERTOS_SYSMON_CPULOAD_SUBSYS:
+        case FREERTOS_SYSMON_CPUAVG_1S_SUBSYS:
+        case FREERTOS_SYSMON_CPUAVG_10S_SUBSYS:
+        case FREERTOS_SYSMON_CPUAVG_60S_SUBSYS:
+            if (subchannel >= FREERTOS_SYSMON_MAX_CPUS)
+            {
+                return false;
+            }
+            *value = snap->cpu_load[subsystem - FREERTOS_SYSMON_CPULOAD_SUBSYS][subchannel];
+            break;
+        case FREERTOS_SYSMON_TASKLOAD_SUBSYS:
+        case FREERTOS_SYSMON_TASKSTACK_SUBSYS:
+            if (subchannel >= snap->num_task_slots || snap->task_name[subchannel][0] == 0)
+            {
+                return false;
+            }
+            if (subsystem == FREERTOS_SYSMON_TASKSTACK_SUBSYS)
+            {
+                *value = snap->task_stack[subchannel];
+            }
+            else
+            {
+                *value = snap->task_load[subchannel];
+            }
+            break;
+        case FREERTOS_SYSMON_MEMORY_SUBSYS:
+            if (subchannel >= FREERTOS_SYSMON_MEMORY_NUM_SUBCH ||
+                (xPortGetFreeHeapSize == NULL && subchannel <= FREERTOS_SYSMON_HEAP_MIN_FREE_SUBCH))
+            {
+                return false;
+            }
+            *value = snap->memory[subchannel];
+            break;
+        default:
+            return false;
+    }
+
+    return true;
+}
+
+/*
+ * Publishes the values of the sample just taken to readers, from the sampler task only
+ */
+static void freertos_sysmon_publish(freertos_sysmon_cpuload_state_t *state)
+{
+    freertos_sysmon_snapshot_t *  snap;
+    freertos_sysmon_task_entry_t *entry;
+    uint32_t                      seq;
+    uint16_t                      i;
+    int                           w;
+
+    seq  = state->snapshot_seq;
+    snap = &state->snapshot[(seq + 1) & 1];
+
+    /* make sure readers of this snapshot from two samples ago see the sequence change first */
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+
+    snap->cpu_load[0][0] = state->core.avg_load;
+    for (w = 0; w < FREERTOS_SYSMON_NUM_AVG_WINDOWS; ++w)
+    {
+        snap->cpu_load[1 + w][0] = CFE_PSP_SysmonAvg_ToLoad(state->core.avg[w]);
+    }
+
+    snap->num_task_slots = state->tasks.num_slots;
+    for (i = 0; i < FREERTOS_SYSMON_MAX_TASKS; ++i)
+    {
+        entry                = &state->tasks.entries[i];
+        snap->task_load[i]  = entry->avg_load;
+        snap->task_stack[i] = entry->stack_free;
+        if (entry->task_number != 0)
+        {
+            memcpy(snap->task_name[i], entry->name, sizeof(snap->task_name[i]));
+        }
+        else
+        {
+            snap->task_load[i]    = 0;
+            snap->task_stack[i]   = 0;
+            snap->task_name[i][0] = 0;
+        }
+    }
+
+    memcpy(snap->memory, state->memory.value, sizeof(snap->memory));
+
+    __atomic_store_n(&state->snapshot_seq, seq + 1, __ATOMIC_RELEASE);
+
+    freertos_sysmon_record(state, snap);
+    CFE_PSP_SysmonAlarm_Check(&freertos_sysmon_global.alarms, freertos_sysmon_alarm_value, snap);
+}
+
+/*
+ * Gets the latest snapshot for reading, values from it are only valid if
+ * freertos_sysmon_read_end() then returns true
+ */
+static const freertos_sysmon_snapshot_t *freertos_sysmon_read_begin(freertos_sysmon_cpuload_state_t *state,
+                                                                    uint32_t *                       seq)
+{
+    *seq = __atomic_load_n(&state->snapshot_seq, __ATOMIC_ACQUIRE);
+    return &state->snapshot[*seq & 1];
+}
+
+static bool freertos_sysmon_read_end(freertos_sysmon_cpuload_state_t *state, uint32_t seq)
+{
+    __atomic_thread_fence(__ATOMIC_ACQUIRE);
+    return __atomic_load_n(&state->snapshot_seq, __ATOMIC_RELAXED) == seq;
+}
+
 void freertos_sysmon_Task(void *pvParameters)
 {
     UNUSED_ARGUMENT(pvParameters);
 
     freertos_sysmon_cpuload_state_t* state = &freertos_sysmon_global.cpu_load;
 
+    TickType_t last_cpu_time;
+    TickType_t now;
+    TickType_t cpu_wait;
+    TickType_t memory_wait;
+    TickType_t memory_period;
+    bool       cpu_due;
+
+    /* the memory is sampled straight away, the CPU load needs a full period */
+    now                            = xTaskGetTickCount();
+    last_cpu_time                  = now;
+    state->memory.last_sample_time = now - pdMS_TO_TICKS(FREERTOS_SYSMON_MAX_MEMORY_PERIOD_MS);
+
     while (state->should_run)
     {
-        OS_TaskDelay(FREERTOS_SYSMON_SAMPLE_DELAY);
-        freertos_sysmon_update_state(state);
+        /*
+         * The memory period is read each time round, so that a change applies from the
+         * last memory sample rather than after the old period has expired
+         */
+        now           = xTaskGetTickCount();
+        memory_period = pdMS_TO_TICKS(freertos_sysmon_global.config.memory_period_ms);
+        if (memory_period == 0)
+        {
+            /* a period below one tick would sample on every pass without ever delaying */
+            memory_period = 1;
+        }
+        cpu_wait      = pdMS_TO_TICKS(FREERTOS_SYSMON_SAMPLE_DELAY) - (TickType_t)(now - last_cpu_time);
+        memory_wait   = memory_period - (TickType_t)(now - state->memory.last_sample_time);
+
+        /* these are negative (large) once the period has expired */
+        cpu_due = (cpu_wait == 0 || cpu_wait > pdMS_TO_TICKS(FREERTOS_SYSMON_SAMPLE_DELAY));
+        if (memory_wait > memory_period)
+        {
+            memory_wait = 0;
+        }
+
+        if (!cpu_due && memory_wait != 0)
+        {
+            vTaskDelay((cpu_wait < memory_wait) ? cpu_wait : memory_wait);
+            continue;
+        }
+
+        if (cpu_due)
+        {
+            last_cpu_time = now;
+            freertos_sysmon_update_state(state);
+        }
+
+        /* the per-task stack use is needed by both */
+        freertos_sysmon_update_tasks(&state->tasks, cpu_due);
+
+        if (memory_wait == 0)
+        {
+            state->memory.last_sample_time = now;
+            freertos_sysmon_update_memory(state);
+        }
+
+        freertos_sysmon_publish(state);
     }
 
     vTaskDelete(NULL);
@@ -180,9 +821,14 @@ int32_t freertos_sysmon_Start(freertos_sysmon_cpuload_state_t* state)
     }
     else
     {
-        memset(state, 0, sizeof(*state));
+        /* the snapshots are kept, as readers may be using them */
+        memset(state, 0, offsetof(freertos_sysmon_cpuload_state_t, snapshot_seq));
         StatusCode = CFE_PSP_ERROR;
 
+        /* recording is optional, and carries on from the samples already in reserved memory */
+        CFE_PSP_SysmonRecord_AttachReserved(&state->recorder, "freertos_sysmon", freertos_sysmon_subsystem_names);
+        CFE_PSP_SysmonAlarm_Reset(&freertos_sysmon_global.alarms);
+
         state->should_run = true;
 
         xReturned = xTaskCreate(
@@ -227,15 +873,36 @@ int32_t freertos_sysmon_Stop(freertos_sysmon_cpuload_state_t* state)
     return CFE_PSP_SUCCESS;
 }
 
-int32_t freertos_sysmon_calc_aggregate_cpu(freertos_sysmon_cpuload_state_t *state, CFE_PSP_IODriver_AdcCode_t *Val)
+/*
+ * Reads the aggregate load, where Subchannel 0 is the current load and the
+ * subchannels after it are the averages
+ */
+int32_t freertos_sysmon_calc_aggregate_cpu(freertos_sysmon_cpuload_state_t *state, uint16_t Subchannel,
+                                           CFE_PSP_IODriver_AnalogRdWr_t *RdWr)
 {
+    const freertos_sysmon_snapshot_t *snap;
+    uint32_t                          seq;
+    uint32_t                          ch;
+
+    if ((Subchannel + RdWr->NumChannels) > (1 + FREERTOS_SYSMON_NUM_AVG_WINDOWS))
+    {
+        return CFE_PSP_ERROR_NOT_IMPLEMENTED;
+    }
+
     /*
     ** Usually this would return the avreage of load for each CPU, but
     ** in FreeRTOS, this port is currently only supported for a single core.
     */
-    *Val = state->core.avg_load;
+    do
+    {
+        snap = freertos_sysmon_read_begin(state, &seq);
+        for (ch = 0; ch < RdWr->NumChannels; ++ch)
+        {
+            RdWr->Samples[ch] = snap->cpu_load[Subchannel + ch][0];
+        }
+    } while (!freertos_sysmon_read_end(state, seq));
 
-    OS_printf("CFE_PSP(freertos_sysmon): Aggregate CPU load=%08X\n", (unsigned int)*Val);
+    FREERTOS_SYSMON_DEBUG("CFE_PSP(freertos_sysmon): Aggregate CPU load=%08X\n", (unsigned int)RdWr->Samples[0]);
 
     return CFE_PSP_SUCCESS;
 }
@@ -274,10 +941,18 @@ int32_t freertos_sysmon_aggregate_dispatch(uint32_t CommandCode, uint16_t Subcha
             StatusCode = state->is_running;
             break;
         }
-        case CFE_PSP_IODriver_SET_CONFIGURATION:
-        case CFE_PSP_IODriver_GET_CONFIGURATION:
+        case CFE_PSP_IODriver_SET_CONFIGURATION: /**< const string argument (device-dependent content) */
+        {
+            StatusCode = freertos_sysmon_set_config(Arg.ConstStr);
+            break;
+        }
+        case CFE_PSP_IODriver_GET_CONFIGURATION: /**< CFE_PSP_SysmonAlarmStatus_t argument */
         {
-            /* Not implemented for now */
+            if (Arg.Vptr != NULL)
+            {
+                CFE_PSP_SysmonAlarm_GetStatus(&freertos_sysmon_global.alarms, Arg.Vptr);
+                StatusCode = CFE_PSP_SUCCESS;
+            }
             break;
         }
         case CFE_PSP_IODriver_LOOKUP_SUBSYSTEM: /**< const char * argument, looks up name and returns positive
@@ -328,11 +1003,7 @@ int32_t freertos_sysmon_aggregate_dispatch(uint32_t CommandCode, uint16_t Subcha
         {
             CFE_PSP_IODriver_AnalogRdWr_t *RdWr = Arg.Vptr;
 
-            if (RdWr->NumChannels == 1 && Subchannel == FREERTOS_SYSMON_AGGR_CPULOAD_SUBCH)
-            {
-                StatusCode = freertos_sysmon_calc_aggregate_cpu(state, RdWr->Samples);
-            }
-
+            StatusCode = freertos_sysmon_calc_aggregate_cpu(state, Subchannel, RdWr);
             break;
         }
         default:
@@ -342,7 +1013,12 @@ int32_t freertos_sysmon_aggregate_dispatch(uint32_t CommandCode, uint16_t Subcha
     return StatusCode;
 }
 
-int32_t freertos_sysmon_cpu_load_dispatch(uint32_t CommandCode, uint16_t Subchannel, CFE_PSP_IODriver_Arg_t Arg)
+/*
+ * The per-cpu subsystems share this, where window 0 is the current load and
+ * the others are the averages
+ */
+int32_t freertos_sysmon_cpu_load_dispatch(uint32_t CommandCode, uint16_t Subchannel, CFE_PSP_IODriver_Arg_t Arg,
+                                          uint32_t window)
 {
     int32_t                          StatusCode;
     freertos_sysmon_cpuload_state_t* state;
@@ -361,15 +1037,21 @@ int32_t freertos_sysmon_cpu_load_dispatch(uint32_t CommandCode, uint16_t Subchan
         }
         case CFE_PSP_IODriver_ANALOG_IO_READ_CHANNELS:
         {
-            CFE_PSP_IODriver_AnalogRdWr_t *RdWr = Arg.Vptr;
-            uint32_t                       ch;
+            CFE_PSP_IODriver_AnalogRdWr_t *   RdWr = Arg.Vptr;
+            const freertos_sysmon_snapshot_t *snap;
+            uint32_t                          seq;
+            uint32_t                          ch;
 
             if (Subchannel < FREERTOS_SYSMON_MAX_CPUS && (Subchannel + RdWr->NumChannels) <= FREERTOS_SYSMON_MAX_CPUS)
             {
-                for (ch = Subchannel; ch < (Subchannel + RdWr->NumChannels); ++ch)
+                do
                 {
-                    RdWr->Samples[ch] = state->core.avg_load;
-                }
+                    snap = freertos_sysmon_read_begin(state, &seq);
+                    for (ch = 0; ch < RdWr->NumChannels; ++ch)
+                    {
+                        RdWr->Samples[ch] = snap->cpu_load[window][Subchannel + ch];
+                    }
+                } while (!freertos_sysmon_read_end(state, seq));
 
                 StatusCode = CFE_PSP_SUCCESS;
             }
@@ -385,6 +1067,166 @@ int32_t freertos_sysmon_cpu_load_dispatch(uint32_t CommandCode, uint16_t Subchan
     return StatusCode;
 }
 
+int32_t freertos_sysmon_memory_dispatch(uint32_t CommandCode, uint16_t Subchannel, CFE_PSP_IODriver_Arg_t Arg)
+{
+    int32_t                           StatusCode;
+    freertos_sysmon_cpuload_state_t * state;
+    const freertos_sysmon_snapshot_t *snap;
+    uint32_t                          seq;
+
+    /* There is just one global cpuload object */
+    state      = &freertos_sysmon_global.cpu_load;
+    StatusCode = CFE_PSP_ERROR_NOT_IMPLEMENTED;
+
+    switch (CommandCode)
+    {
+        case CFE_PSP_IODriver_NOOP:
+        case CFE_PSP_IODriver_ANALOG_IO_NOOP:
+        {
+            StatusCode = CFE_PSP_SUCCESS;
+            break;
+        }
+        case CFE_PSP_IODriver_LOOKUP_SUBCHANNEL: /**< const char * argument, looks up name and returns positive
+                                                    value for channel number, negative value for error */
+        {
+            uint16_t i;
+
+            for (i = 0; freertos_sysmon_memory_subchannel_names[i] != NULL; ++i)
+            {
+                if (strcmp(Arg.ConstStr, freertos_sysmon_memory_subchannel_names[i]) == 0)
+                {
+                    StatusCode = i;
+                    break;
+                }
+            }
+
+            break;
+        }
+        case CFE_PSP_IODriver_ANALOG_IO_READ_CHANNELS:
+        {
+            CFE_PSP_IODriver_AnalogRdWr_t *RdWr = Arg.Vptr;
+            uint32_t                       ch;
+
+            if ((Subchannel + RdWr->NumChannels) <= FREERTOS_SYSMON_MEMORY_NUM_SUBCH)
+            {
+                do
+                {
+                    snap = freertos_sysmon_read_begin(state, &seq);
+                    for (ch = 0; ch < RdWr->NumChannels; ++ch)
+                    {
+                        RdWr->Samples[ch] = snap->memory[Subchannel + ch];
+                    }
+                } while (!freertos_sysmon_read_end(state, seq));
+
+                StatusCode = CFE_PSP_SUCCESS;
+
+                /* without the heap statistics, there are no heap values to read */
+                if (xPortGetFreeHeapSize == NULL && Subchannel <= FREERTOS_SYSMON_HEAP_MIN_FREE_SUBCH)
+                {
+                    StatusCode = CFE_PSP_ERROR;
+                }
+            }
+            break;
+        }
+        default:
+            break;
+    }
+
+    return StatusCode;
+}
+
+/*
+ * The per-task subsystems share this, and the same slots, reporting either the CPU share
+ * or the stack never used by each task
+ */
+int32_t freertos_sysmon_task_dispatch(uint32_t CommandCode, uint16_t Subchannel, CFE_PSP_IODriver_Arg_t Arg,
+                                      bool stack)
+{
+    int32_t                           StatusCode;
+    freertos_sysmon_cpuload_state_t * state;
+    const freertos_sysmon_snapshot_t *snap;
+    uint32_t                          seq;
+
+    /* There is just one global cpuload object */
+    state      = &freertos_sysmon_global.cpu_load;
+    StatusCode = CFE_PSP_ERROR_NOT_IMPLEMENTED;
+
+    switch (CommandCode)
+    {
+        case CFE_PSP_IODriver_NOOP:
+        case CFE_PSP_IODriver_ANALOG_IO_NOOP:
+        {
+            StatusCode = CFE_PSP_SUCCESS;
+            break;
+        }
+        case CFE_PSP_IODriver_LOOKUP_SUBCHANNEL: /**< const char * argument, looks up task name and returns positive
+                                                    value for channel number, negative value for error */
+        {
+            uint16_t i;
+
+            /* The subchannel remains valid for as long as the task exists */
+            do
+            {
+                snap       = freertos_sysmon_read_begin(state, &seq);
+                StatusCode = CFE_PSP_ERROR;
+                for (i = 0; i < snap->num_task_slots; ++i)
+                {
+                    if (snap->task_name[i][0] != 0 &&
+                        strncmp(Arg.ConstStr, snap->task_name[i], configMAX_TASK_NAME_LEN - 1) == 0)
+                    {
+                        StatusCode = i;
+                        break;
+                    }
+                }
+            } while (!freertos_sysmon_read_end(state, seq));
+            break;
+        }
+        case CFE_PSP_IODriver_ANALOG_IO_READ_CHANNELS:
+        {
+            CFE_PSP_IODriver_AnalogRdWr_t *RdWr = Arg.Vptr;
+            uint32_t                       ch;
+
+            /* Slots without a task read as zero */
+            if ((Subchannel + RdWr->NumChannels) <= FREERTOS_SYSMON_MAX_TASKS)
+            {
+                do
+                {
+                    snap = freertos_sysmon_read_begin(state, &seq);
+                    for (ch = 0; ch < RdWr->NumChannels; ++ch)
+                    {
+                        if (stack)
+                        {
+                            RdWr->Samples[ch] = snap->task_stack[Subchannel + ch];
+                        }
+                        else
+                        {
+                            RdWr->Samples[ch] = snap->task_load[Subchannel + ch];
+                        }
+                    }
+                } while (!freertos_sysmon_read_end(state, seq));
+
+                StatusCode = CFE_PSP_SUCCESS;
+            }
+            break;
+        }
+        default:
+            break;
+    }
+
+    return StatusCode;
+}
+
+/*
+ * vTaskDelete() in a stop must see the handle of the task the matching start created, and
+ * the heap and stack thresholds are written by configuration, so these share one mutex.
+ * Reads do not take it, as freertos_sysmon_Start() leaves the snapshots in place.
+ */
+int32_t freertos_sysmon_DevMutex(uint32_t CommandCode, uint16_t SubsystemId, uint16_t SubchannelId,
+                                 CFE_PSP_IODriver_Arg_t Arg)
+{
+    return 0;
+}
+
 /* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
 /*    freertos_sysmon_DevCmd()                               */
 /* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
@@ -415,7 +1257,22 @@ int32_t freertos_sysmon_DevCmd(uint32_t CommandCode, uint16_t SubsystemId, uint1
             StatusCode = freertos_sysmon_aggregate_dispatch(CommandCode, SubchannelId, Arg);
             break;
         case FREERTOS_SYSMON_CPULOAD_SUBSYS:
-            StatusCode = freertos_sysmon_cpu_load_dispatch(CommandCode, SubchannelId, Arg);
+            StatusCode = freertos_sysmon_cpu_load_dispatch(CommandCode, SubchannelId, Arg, 0);
+            break;
+        case FREERTOS_SYSMON_CPUAVG_1S_SUBSYS:
+        case FREERTOS_SYSMON_CPUAVG_10S_SUBSYS:
+        case FREERTOS_SYSMON_CPUAVG_60S_SUBSYS:
+            StatusCode = freertos_sysmon_cpu_load_dispatch(CommandCode, SubchannelId, Arg,
+                                                           1 + SubsystemId - FREERTOS_SYSMON_CPUAVG_1S_SUBSYS);
+            break;
+        case FREERTOS_SYSMON_TASKLOAD_SUBSYS:
+            StatusCode = freertos_sysmon_task_dispatch(CommandCode, SubchannelId, Arg, false);
+            break;
+        case FREERTOS_SYSMON_TASKSTACK_SUBSYS:
+            StatusCode = freertos_sysmon_task_dispatch(CommandCode, SubchannelId, Arg, true);
+            break;
+        case FREERTOS_SYSMON_MEMORY_SUBSYS:
+            StatusCode = freertos_sysmon_memory_dispatch(CommandCode, SubchannelId, Arg);
             break;
         default:
             /* not implemented */
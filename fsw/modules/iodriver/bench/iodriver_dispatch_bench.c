@@ -0,0 +1,369 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,719-1, and identified as “core Flight System: Bootes”
+ *
+ * Copyright (c) 2020 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ************************************************************************/
+
+/**
+ * \file
+ *
+ * Host benchmark for the iodriver command dispatch
+ *
+ * Measures the throughput of CFE_PSP_IODriver_Command() style dispatch to one
+ * device from several threads at once, with and without the device mutex.
+ * The dispatch here follows iodriver.c: the driver API is looked up by module
+ * ID, then unless the opcode is marked in the reentrant opcode masks of the
+ * driver, DeviceMutex() selects one of the hashed mutexes to hold around
+ * DeviceCommand().  OSAL mutexes are replaced by the pthread mutexes they are
+ * built on in the POSIX OSAL.
+ *
+ * The device command reads a block of channels from a snapshot under a
+ * sequence count, as the sysmon modules do for CFE_PSP_IODriver_ANALOG_IO_READ_CHANNELS,
+ * while another thread publishes a new snapshot every millisecond.  The
+ * number of threads is doubled from 1 up to the given number, and each is
+ * run once with the opcode locked and once with it declared reentrant.
+ *
+ * This is standalone and not part of the CFE build.  To build and run:
+ *
+ *    cc -O2 -pthread -o iodriver_dispatch_bench iodriver_dispatch_bench.c
+ *    ./iodriver_dispatch_bench [-t threads] [-i iterations] [-n channels]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <unistd.h>
+#include <time.h>
+#include <pthread.h>
+
+#define DISPATCH_BENCH_DEFAULT_THREADS    8
+#define DISPATCH_BENCH_DEFAULT_ITERATIONS 1000000
+#define DISPATCH_BENCH_DEFAULT_CHANNELS   4
+#define DISPATCH_BENCH_MAX_CHANNELS       64
+
+/* as in iodriver.c and iodriver_base.h */
+#define DISPATCH_BENCH_LOCK_TABLE_SIZE 7
+#define DISPATCH_BENCH_CLASS_BASE      0x00010000
+#define DISPATCH_BENCH_EXTENDED_BASE   0x7FFF0000
+#define DISPATCH_BENCH_OPCODE_BIT(x)   (1U << ((x)&0x1F))
+
+/* CFE_PSP_IODriver_ANALOG_IO_READ_CHANNELS */
+#define DISPATCH_BENCH_READ_CHANNELS (DISPATCH_BENCH_CLASS_BASE + 1)
+
+#define DISPATCH_BENCH_MODULE_ID 0x70FF0003
+
+typedef int32_t (*dispatch_bench_func_t)(uint32_t CommandCode, uint16_t SubsystemId, uint16_t SubchannelId,
+                                         void *Arg);
+
+typedef struct
+{
+    dispatch_bench_func_t DeviceCommand;
+    dispatch_bench_func_t DeviceMutex;
+    uint32_t              ReentrantBaseOps;
+    uint32_t              ReentrantClassOps;
+} dispatch_bench_api_t;
+
+typedef struct
+{
+    uint32_t seq;
+    int32_t  values[2][DISPATCH_BENCH_MAX_CHANNELS];
+} dispatch_bench_device_t;
+
+typedef struct
+{
+    pthread_t    thread;
+    unsigned int iterations;
+    unsigned int errors;
+    int32_t      sum;
+} dispatch_bench_worker_t;
+
+static pthread_mutex_t         dispatch_bench_mutex_table[DISPATCH_BENCH_LOCK_TABLE_SIZE];
+static dispatch_bench_device_t dispatch_bench_device;
+static dispatch_bench_api_t    dispatch_bench_api;
+static unsigned int            dispatch_bench_channels;
+static volatile bool           dispatch_bench_stop;
+
+static uint64_t dispatch_bench_nsec(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ((uint64_t)ts.tv_sec * 1000000000) + ts.tv_nsec;
+}
+
+/* A sysmon style read of channels from the latest snapshot */
+static int32_t dispatch_bench_device_command(uint32_t CommandCode, uint16_t SubsystemId, uint16_t SubchannelId,
+                                             void *Arg)
+{
+    int32_t *    samples = Arg;
+    uint32_t     seq;
+    unsigned int ch;
+
+    if (CommandCode != DISPATCH_BENCH_READ_CHANNELS ||
+        (SubchannelId + dispatch_bench_channels) > DISPATCH_BENCH_MAX_CHANNELS)
+    {
+        return -1;
+    }
+
+    do
+    {
+        seq = __atomic_load_n(&dispatch_bench_device.seq, __ATOMIC_ACQUIRE);
+        for (ch = 0; ch < dispatch_bench_channels; ++ch)
+        {
+            samples[ch] = __atomic_load_n(&dispatch_bench_device.values[seq & 1][SubchannelId + ch], __ATOMIC_RELAXED);
+        }
+        __atomic_thread_fence(__ATOMIC_ACQUIRE);
+    } while (__atomic_load_n(&dispatch_bench_device.seq, __ATOMIC_RELAXED) != seq);
+
+    return 0;
+}
+
+static int32_t dispatch_bench_device_mutex(uint32_t CommandCode, uint16_t SubsystemId, uint16_t SubchannelId,
+                                           void *Arg)
+{
+    return 0;
+}
+
+static void *dispatch_bench_publish(void *arg)
+{
+    struct timespec delay = {0, 1000000};
+    uint32_t        seq;
+    unsigned int    ch;
+
+    while (!dispatch_bench_stop)
+    {
+        seq = dispatch_bench_device.seq;
+        __atomic_thread_fence(__ATOMIC_RELEASE);
+        for (ch = 0; ch < DISPATCH_BENCH_MAX_CHANNELS; ++ch)
+        {
+            __atomic_store_n(&dispatch_bench_device.values[(seq + 1) & 1][ch], (int32_t)(seq + ch), __ATOMIC_RELAXED);
+        }
+        __atomic_store_n(&dispatch_bench_device.seq, seq + 1, __ATOMIC_RELEASE);
+        nanosleep(&delay, NULL);
+    }
+
+    return NULL;
+}
+
+/* As CFE_PSP_IODriver_GetAPI(), a lookup of the module API by ID */
+static dispatch_bench_api_t *dispatch_bench_get_api(uint32_t PspModuleId)
+{
+    static dispatch_bench_api_t *const module_list[] = {NULL, NULL, NULL, &dispatch_bench_api};
+    uint32_t                           index         = PspModuleId & 0xFFFF;
+
+    if ((PspModuleId & 0xFFFF0000) != (DISPATCH_BENCH_MODULE_ID & 0xFFFF0000) ||
+        index >= (sizeof(module_list) / sizeof(module_list[0])) || module_list[index] == NULL)
+    {
+        return NULL;
+    }
+
+    return module_list[index];
+}
+
+/* As CFE_PSP_IODriver_IsReentrant() */
+static bool dispatch_bench_is_reentrant(const dispatch_bench_api_t *api, uint32_t CommandCode)
+{
+    uint32_t mask;
+
+    if ((CommandCode & 0xFFFF) >= 32 || CommandCode >= DISPATCH_BENCH_EXTENDED_BASE)
+    {
+        return false;
+    }
+
+    mask = (CommandCode < DISPATCH_BENCH_CLASS_BASE) ? api->ReentrantBaseOps : api->ReentrantClassOps;
+
+    return (mask & DISPATCH_BENCH_OPCODE_BIT(CommandCode)) != 0;
+}
+
+/* As CFE_PSP_IODriver_Command() */
+static int32_t dispatch_bench_command(uint32_t PspModuleId, uint16_t SubsystemId, uint16_t SubchannelId,
+                                      uint32_t CommandCode, void *Arg)
+{
+    dispatch_bench_api_t *api;
+    pthread_mutex_t *     mutex;
+    int32_t               hash;
+    int32_t               result;
+
+    api = dispatch_bench_get_api(PspModuleId);
+    if (api == NULL || api->DeviceCommand == NULL)
+    {
+        return -1;
+    }
+
+    mutex = NULL;
+    if (api->DeviceMutex != NULL && !dispatch_bench_is_reentrant(api, CommandCode))
+    {
+        hash = api->DeviceMutex(CommandCode, SubsystemId, SubchannelId, Arg);
+        if (hash >= 0)
+        {
+            mutex = &dispatch_bench_mutex_table[((uint32_t)hash ^ PspModuleId) % DISPATCH_BENCH_LOCK_TABLE_SIZE];
+        }
+    }
+
+    if (mutex != NULL)
+    {
+        pthread_mutex_lock(mutex);
+    }
+    result = api->DeviceCommand(CommandCode, SubsystemId, SubchannelId, Arg);
+    if (mutex != NULL)
+    {
+        pthread_mutex_unlock(mutex);
+    }
+
+    return result;
+}
+
+static void *dispatch_bench_worker(void *arg)
+{
+    dispatch_bench_worker_t *worker = arg;
+    int32_t                  samples[DISPATCH_BENCH_MAX_CHANNELS];
+    unsigned int             i;
+
+    for (i = 0; i < worker->iterations; ++i)
+    {
+        if (dispatch_bench_command(DISPATCH_BENCH_MODULE_ID, 0, 0, DISPATCH_BENCH_READ_CHANNELS, samples) != 0)
+        {
+            ++worker->errors;
+        }
+        worker->sum += samples[0];
+    }
+
+    return NULL;
+}
+
+/* Runs the given number of threads at once, and returns the elapsed time in nanoseconds */
+static uint64_t dispatch_bench_run(dispatch_bench_worker_t *workers, unsigned int num_threads, unsigned int iterations)
+{
+    uint64_t     start;
+    unsigned int t;
+
+    start = dispatch_bench_nsec();
+    for (t = 0; t < num_threads; ++t)
+    {
+        workers[t].iterations = iterations;
+        workers[t].errors     = 0;
+        if (pthread_create(&workers[t].thread, NULL, dispatch_bench_worker, &workers[t]) != 0)
+        {
+            perror("pthread_create()");
+            exit(EXIT_FAILURE);
+        }
+    }
+    for (t = 0; t < num_threads; ++t)
+    {
+        pthread_join(workers[t].thread, NULL);
+        if (workers[t].errors != 0)
+        {
+            printf("FAIL: %u command errors\n", workers[t].errors);
+            exit(EXIT_FAILURE);
+        }
+    }
+
+    return dispatch_bench_nsec() - start;
+}
+
+int main(int argc, char *argv[])
+{
+    dispatch_bench_worker_t *workers;
+    pthread_t                publisher;
+    unsigned int             max_threads;
+    unsigned int             iterations;
+    unsigned int             num_threads;
+    unsigned int             i;
+    uint64_t                 locked;
+    uint64_t                 elided;
+    double                   total;
+    int                      opt;
+
+    max_threads             = DISPATCH_BENCH_DEFAULT_THREADS;
+    iterations              = DISPATCH_BENCH_DEFAULT_ITERATIONS;
+    dispatch_bench_channels = DISPATCH_BENCH_DEFAULT_CHANNELS;
+
+    while ((opt = getopt(argc, argv, "t:i:n:")) != -1)
+    {
+        switch (opt)
+        {
+            case 't':
+                max_threads = strtoul(optarg, NULL, 0);
+                break;
+            case 'i':
+                iterations = strtoul(optarg, NULL, 0);
+                break;
+            case 'n':
+                dispatch_bench_channels = strtoul(optarg, NULL, 0);
+                break;
+            default:
+                fprintf(stderr, "usage: %s [-t threads] [-i iterations] [-n channels]\n", argv[0]);
+                return EXIT_FAILURE;
+        }
+    }
+
+    if (max_threads == 0 || dispatch_bench_channels > DISPATCH_BENCH_MAX_CHANNELS)
+    {
+        fprintf(stderr, "need at least 1 thread and at most %d channels\n", DISPATCH_BENCH_MAX_CHANNELS);
+        return EXIT_FAILURE;
+    }
+
+    workers = calloc(max_threads, sizeof(*workers));
+    if (workers == NULL)
+    {
+        perror("calloc()");
+        return EXIT_FAILURE;
+    }
+
+    for (i = 0; i < DISPATCH_BENCH_LOCK_TABLE_SIZE; ++i)
+    {
+        pthread_mutex_init(&dispatch_bench_mutex_table[i], NULL);
+    }
+
+    dispatch_bench_api.DeviceCommand = dispatch_bench_device_command;
+    dispatch_bench_api.DeviceMutex   = dispatch_bench_device_mutex;
+
+    if (pthread_create(&publisher, NULL, dispatch_bench_publish, NULL) != 0)
+    {
+        perror("pthread_create()");
+        return EXIT_FAILURE;
+    }
+
+    printf("%u iterations per thread, %u channels per read\n", iterations, dispatch_bench_channels);
+    printf("threads    locked Mcmd/s  ns/cmd    reentrant Mcmd/s  ns/cmd\n");
+    /* doubling the threads each time, up to the maximum */
+    num_threads = 1;
+    while (true)
+    {
+        dispatch_bench_api.ReentrantClassOps = 0;
+        locked                               = dispatch_bench_run(workers, num_threads, iterations);
+
+        dispatch_bench_api.ReentrantClassOps = DISPATCH_BENCH_OPCODE_BIT(DISPATCH_BENCH_READ_CHANNELS);
+        elided                               = dispatch_bench_run(workers, num_threads, iterations);
+
+        /* ns/cmd is the time each thread takes per command */
+        total = (double)num_threads * iterations;
+        printf("%7u    %13.2f  %6.1f    %16.2f  %6.1f\n", num_threads, (total * 1000.0) / locked,
+               (double)locked / iterations, (total * 1000.0) / elided, (double)elided / iterations);
+
+        if (num_threads == max_threads)
+        {
+            break;
+        }
+        num_threads = (num_threads * 2 < max_threads) ? (num_threads * 2) : max_threads;
+    }
+
+    dispatch_bench_stop = true;
+    pthread_join(publisher, NULL);
+    free(workers);
+
+    return EXIT_SUCCESS;
+}
@@ -43,10 +43,34 @@
 typedef int32 (*CFE_PSP_IODriver_ApiFunc_t)(uint32 CommandCode, uint16 Instance, uint16 SubChannel,
                                             CFE_PSP_IODriver_Arg_t arg);
 
+/**
+ * Bit for an opcode in the ReentrantBaseOps or ReentrantClassOps mask of a driver
+ *
+ * Only the first 32 opcodes of the common set and of each device class can be
+ * marked.  The class of the opcode selects the mask, so for instance
+ * CFE_PSP_IODRIVER_OPCODE_BIT(CFE_PSP_IODriver_ANALOG_IO_READ_CHANNELS) goes in
+ * ReentrantClassOps.
+ */
+#define CFE_PSP_IODRIVER_OPCODE_BIT(x) (1U << ((x)&0x1F))
+
+/**
+ * Entry points of a device driver
+ *
+ * If DeviceMutex is set, it is called with the same arguments as DeviceCommand
+ * and returns a hash selecting the mutex to hold around the command, or a
+ * negative value for none.
+ *
+ * Opcodes marked in ReentrantBaseOps (common opcodes) or ReentrantClassOps
+ * (device class opcodes) may be run concurrently with any other command of the
+ * driver, so these are dispatched without calling DeviceMutex or taking a lock.
+ * Extended opcodes are never treated as reentrant.
+ */
 typedef const struct
 {
     CFE_PSP_IODriver_ApiFunc_t DeviceCommand;
     CFE_PSP_IODriver_ApiFunc_t DeviceMutex;
+    uint32                     ReentrantBaseOps;
+    uint32                     ReentrantClassOps;
 } CFE_PSP_IODriver_API_t;
 
 osal_id_t CFE_PSP_IODriver_GetMutex(uint32 PspModuleId, int32 DeviceHash);
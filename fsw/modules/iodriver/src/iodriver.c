@@ -13,6 +13,7 @@
  */
 
 #include "cfe_psp_module.h"
+#include "cfe_psp_trace.h"
 #include "iodriver_base.h"
 #include "iodriver_impl.h"
 
@@ -91,6 +92,30 @@ int32 CFE_PSP_IODriver_HashMutex(int32 StartHash, int32 Datum)
     return ((StartHash + Datum) & 0x7FFFFFFF);
 }
 
+/**
+ * Checks if the driver declared that an opcode can run without the device mutex
+ */
+static bool CFE_PSP_IODriver_IsReentrant(CFE_PSP_IODriver_API_t *API, uint32 CommandCode)
+{
+    uint32 Mask;
+
+    if ((CommandCode & 0xFFFF) >= 32 || CommandCode >= CFE_PSP_IODriver_EXTENDED_BASE)
+    {
+        return false;
+    }
+
+    if (CommandCode < CFE_PSP_IODriver_ANALOG_IO_CLASS_BASE)
+    {
+        Mask = API->ReentrantBaseOps;
+    }
+    else
+    {
+        Mask = API->ReentrantClassOps;
+    }
+
+    return (Mask & CFE_PSP_IODRIVER_OPCODE_BIT(CommandCode)) != 0;
+}
+
 int32 CFE_PSP_IODriver_Command(const CFE_PSP_IODriver_Location_t *Location, uint32 CommandCode,
                                CFE_PSP_IODriver_Arg_t Arg)
 {
@@ -101,7 +126,7 @@ int32 CFE_PSP_IODriver_Command(const CFE_PSP_IODriver_Location_t *Location, uint
     API = CFE_PSP_IODriver_GetAPI(Location->PspModuleId);
     if (API->DeviceCommand != NULL)
     {
-        if (API->DeviceMutex != NULL)
+        if (API->DeviceMutex != NULL && !CFE_PSP_IODriver_IsReentrant(API, CommandCode))
         {
             MutexId =
                 CFE_PSP_IODriver_GetMutex(Location->PspModuleId, API->DeviceMutex(CommandCode, Location->SubsystemId,
@@ -115,7 +140,9 @@ int32 CFE_PSP_IODriver_Command(const CFE_PSP_IODriver_Location_t *Location, uint
         {
             OS_MutSemTake(MutexId);
         }
+        CFE_PSP_TRACE_BEGIN(CFE_PSP_TRACE_EVENT_IODRIVER_COMMAND, CommandCode);
         Result = API->DeviceCommand(CommandCode, Location->SubsystemId, Location->SubchannelId, Arg);
+        CFE_PSP_TRACE_END(CFE_PSP_TRACE_EVENT_IODRIVER_COMMAND, Result);
         if (OS_ObjectIdDefined(MutexId))
         {
             OS_MutSemGive(MutexId);
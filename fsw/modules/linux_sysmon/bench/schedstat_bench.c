@@ -0,0 +1,246 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,719-1, and identified as “core Flight System: Bootes”
+ *
+ * Copyright (c) 2020 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ************************************************************************/
+
+/**
+ * \file
+ *
+ * Host benchmark for the linux_sysmon /proc/schedstat parser
+ *
+ * Generates a synthetic /proc/schedstat in the kernel's version 15 format
+ * (each CPU line followed by its scheduling domain lines), checks that the
+ * parser used by the PSP module recovers every CPU number and run time, and
+ * then measures the time to parse it.
+ *
+ * If a file is given, such as /proc/schedstat on the host or the
+ * schedstat_fixture.txt alongside this file, that is parsed and its CPU
+ * lines printed instead.  The "-w" option writes the synthetic data to a
+ * file, which is how schedstat_fixture.txt was made ("-n 4 -w ...").
+ *
+ * This is standalone and not part of the CFE build.  To build and run:
+ *
+ *    cc -O2 -o schedstat_bench schedstat_bench.c
+ *    ./schedstat_bench [-n cpus] [-d domains] [-i iterations] [-w output_file] [input_file]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <time.h>
+#include <inttypes.h>
+
+#include "../linux_sysmon_schedstat.h"
+
+#define SCHEDSTAT_BENCH_DEFAULT_CPUS       192
+#define SCHEDSTAT_BENCH_DEFAULT_DOMAINS    3
+#define SCHEDSTAT_BENCH_DEFAULT_ITERATIONS 20000
+
+/* number of values on each domain line after the CPU mask, in version 15 */
+#define SCHEDSTAT_BENCH_DOMAIN_VALUES 45
+
+static volatile uint64_t schedstat_bench_sink;
+
+static uint64_t schedstat_bench_nsec(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ((uint64_t)ts.tv_sec * 1000000000) + ts.tv_nsec;
+}
+
+/* The run time given to each CPU, large enough to exercise the full 64 bit range of a long uptime */
+static uint64_t schedstat_bench_run_time(unsigned int cpu)
+{
+    return 123456789012345ULL + ((uint64_t)cpu * 1000003ULL);
+}
+
+static size_t schedstat_bench_generate(char *buf, size_t bufsize, unsigned int num_cpus, unsigned int num_domains)
+{
+    size_t       len;
+    unsigned int cpu;
+    unsigned int dom;
+    unsigned int i;
+
+    len = snprintf(buf, bufsize, "version 15\ntimestamp 4297295042\n");
+    for (cpu = 0; cpu < num_cpus && len < bufsize; ++cpu)
+    {
+        len += snprintf(&buf[len], bufsize - len, "cpu%u 0 0 %u %u %u %u %" PRIu64 " %" PRIu64 " %u\n", cpu,
+                        1000000 + cpu, 400000 + cpu, 500000 + cpu, 200000 + cpu, schedstat_bench_run_time(cpu),
+                        (uint64_t)9876543210ULL + cpu, 300000 + cpu);
+        for (dom = 0; dom < num_domains && len < bufsize; ++dom)
+        {
+            len += snprintf(&buf[len], bufsize - len, "domain%u %08x,%08x", dom, ~0U << dom, 0xffU >> dom);
+            for (i = 0; i < SCHEDSTAT_BENCH_DOMAIN_VALUES && len < bufsize; ++i)
+            {
+                len += snprintf(&buf[len], bufsize - len, " %u", (i % 5 == 0) ? (cpu * 31 + i) : 0);
+            }
+            if (len < bufsize)
+            {
+                buf[len++] = '\n';
+            }
+        }
+    }
+
+    if (len >= bufsize)
+    {
+        fprintf(stderr, "generated data does not fit\n");
+        exit(EXIT_FAILURE);
+    }
+
+    buf[len] = 0;
+    return len;
+}
+
+static int schedstat_bench_print_file(const char *filename)
+{
+    static char  buf[1 << 22];
+    FILE *       fp;
+    size_t       len;
+    const char * pos;
+    unsigned int cpu_num;
+    uint64_t     run_time;
+
+    fp = fopen(filename, "r");
+    if (fp == NULL)
+    {
+        perror(filename);
+        return EXIT_FAILURE;
+    }
+
+    len = fread(buf, 1, sizeof(buf) - 1, fp);
+    fclose(fp);
+    buf[len] = 0;
+
+    pos = buf;
+    while ((pos = linux_sysmon_schedstat_next_cpu(pos, buf + len, &cpu_num, &run_time)) != NULL)
+    {
+        printf("cpu%u run_time=%" PRIu64 " ns\n", cpu_num, run_time);
+    }
+
+    return EXIT_SUCCESS;
+}
+
+int main(int argc, char *argv[])
+{
+    char *       buf;
+    size_t       bufsize;
+    size_t       len;
+    const char * pos;
+    const char * out_file;
+    unsigned int num_cpus;
+    unsigned int num_domains;
+    unsigned int iterations;
+    unsigned int count;
+    unsigned int cpu_num;
+    unsigned int i;
+    uint64_t     run_time;
+    uint64_t     start;
+    uint64_t     elapsed;
+    FILE *       fp;
+    int          opt;
+
+    num_cpus    = SCHEDSTAT_BENCH_DEFAULT_CPUS;
+    num_domains = SCHEDSTAT_BENCH_DEFAULT_DOMAINS;
+    iterations  = SCHEDSTAT_BENCH_DEFAULT_ITERATIONS;
+    out_file    = NULL;
+
+    while ((opt = getopt(argc, argv, "n:d:i:w:")) != -1)
+    {
+        switch (opt)
+        {
+            case 'n':
+                num_cpus = strtoul(optarg, NULL, 0);
+                break;
+            case 'd':
+                num_domains = strtoul(optarg, NULL, 0);
+                break;
+            case 'i':
+                iterations = strtoul(optarg, NULL, 0);
+                break;
+            case 'w':
+                out_file = optarg;
+                break;
+            default:
+                fprintf(stderr, "usage: %s [-n cpus] [-d domains] [-i iterations] [-w output_file] [input_file]\n",
+                        argv[0]);
+                return EXIT_FAILURE;
+        }
+    }
+
+    if (optind < argc)
+    {
+        return schedstat_bench_print_file(argv[optind]);
+    }
+
+    bufsize = 256 + (size_t)num_cpus * (128 + num_domains * 256);
+    buf     = malloc(bufsize);
+    if (buf == NULL)
+    {
+        perror("malloc()");
+        return EXIT_FAILURE;
+    }
+
+    len = schedstat_bench_generate(buf, bufsize, num_cpus, num_domains);
+
+    if (out_file != NULL)
+    {
+        fp = fopen(out_file, "w");
+        if (fp == NULL || fwrite(buf, 1, len, fp) != len)
+        {
+            perror(out_file);
+            return EXIT_FAILURE;
+        }
+        fclose(fp);
+    }
+
+    /* check that every CPU is found, in order, with the right run time */
+    count = 0;
+    pos   = buf;
+    while ((pos = linux_sysmon_schedstat_next_cpu(pos, buf + len, &cpu_num, &run_time)) != NULL)
+    {
+        if (cpu_num != count || run_time != schedstat_bench_run_time(count))
+        {
+            printf("FAIL: line %u parsed as cpu%u run_time=%" PRIu64 "\n", count, cpu_num, run_time);
+            return EXIT_FAILURE;
+        }
+        ++count;
+    }
+    if (count != num_cpus)
+    {
+        printf("FAIL: found %u of %u CPUs\n", count, num_cpus);
+        return EXIT_FAILURE;
+    }
+
+    printf("%u CPUs, %u domains each, %lu bytes: parsed OK\n", num_cpus, num_domains, (unsigned long)len);
+
+    start = schedstat_bench_nsec();
+    for (i = 0; i < iterations; ++i)
+    {
+        pos = buf;
+        while ((pos = linux_sysmon_schedstat_next_cpu(pos, buf + len, &cpu_num, &run_time)) != NULL)
+        {
+            schedstat_bench_sink += run_time;
+        }
+    }
+    elapsed = schedstat_bench_nsec() - start;
+
+    printf("parse: %.1f us per sample, %.1f ns per CPU, %.0f MB/s\n", (double)elapsed / iterations / 1000.0,
+           (double)elapsed / iterations / num_cpus, ((double)len * iterations * 1000.0) / elapsed);
+
+    free(buf);
+    return EXIT_SUCCESS;
+}
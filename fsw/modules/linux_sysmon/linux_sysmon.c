@@ -18,30 +18,165 @@
  ************************************************************************/
 
 #include <fcntl.h>
-#include <ctype.h>
 #include <unistd.h>
 #include <errno.h>
 #include <string.h>
 #include <pthread.h>
+#include <stddef.h>
 #include <stdint.h>
+#include <stdlib.h>
 #include <poll.h>
+#include <time.h>
+#include <dirent.h>
+#include <limits.h>
+#include <sys/eventfd.h>
+#include <sys/stat.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <sys/mman.h>
+#include <linux/perf_event.h>
 
 #include "cfe_psp.h"
 #include "cfe_psp_module.h"
+#include "cfe_psp_idleevent.h"
+#include "cfe_psp_sysmonalarm.h"
+#include "cfe_psp_sysmonrecord.h"
+#include "cfe_psp_sysmonutil.h"
 #include "osapi-clock.h"
 
 #include "iodriver_impl.h"
 #include "iodriver_analog_io.h"
 
+#include "linux_sysmon_schedstat.h"
+
 /********************************************************************
  * Local Defines
  ********************************************************************/
 
 #define LINUX_SYSMON_AGGREGATE_SUBSYS   0
 #define LINUX_SYSMON_CPULOAD_SUBSYS     1
+#define LINUX_SYSMON_TASKLOAD_SUBSYS    2
+#define LINUX_SYSMON_MEMORY_SUBSYS      3
+#define LINUX_SYSMON_CPUAVG_1S_SUBSYS   4
+#define LINUX_SYSMON_CPUAVG_10S_SUBSYS  5
+#define LINUX_SYSMON_CPUAVG_60S_SUBSYS  6
+#define LINUX_SYSMON_PERF_SUBSYS        7
+#define LINUX_SYSMON_PRESSURE_SUBSYS    8
+#define LINUX_SYSMON_CGROUP_SUBSYS      9
 #define LINUX_SYSMON_AGGR_CPULOAD_SUBCH 0
-#define LINUX_SYSMON_MAX_CPUS           128
-#define LINUX_SYSMON_SAMPLE_DELAY       30
+
+/*
+ * Exponentially weighted averages of the CPU load
+ *
+ * These are the "cpu-load-1s", "cpu-load-10s" and "cpu-load-60s" subchannels
+ * of the aggregate, and the "per-cpu-1s", "per-cpu-10s" and "per-cpu-60s"
+ * subsystems for each CPU, where the name is the time constant.  They are
+ * updated once per sample, so a window shorter than the sample period just
+ * follows the current load.
+ *
+ * The decay factors depend on the time between samples, see linux_sysmon_calc_decay().
+ */
+#define LINUX_SYSMON_NUM_AVG_WINDOWS 3
+
+/*
+ * The per-core state of the sampler and the snapshots read by other threads
+ * are aligned to cache lines, so readers do not contend with the sampler.
+ */
+#ifndef LINUX_SYSMON_CACHE_LINE_SIZE
+#define LINUX_SYSMON_CACHE_LINE_SIZE 64
+#endif
+
+/*
+ * Maximum number of threads of the process that are monitored by the
+ * "per-task" subsystem.  Each thread keeps the same subchannel for as long
+ * as it exists, and additional threads beyond this are not monitored.
+ */
+#define LINUX_SYSMON_MAX_TASKS 64
+
+/* The kernel limit on thread names (comm), including the terminator */
+#define LINUX_SYSMON_TASK_NAME_LEN 16
+
+/*
+ * Subchannels of the "memory" subsystem
+ *
+ * Memory sizes are in KiB, and page fault rates are in faults per second
+ * over the last sample period.
+ */
+#define LINUX_SYSMON_MEM_RSS_SUBCH       0
+#define LINUX_SYSMON_MEM_ANON_SUBCH      1
+#define LINUX_SYSMON_MEM_SHARED_SUBCH    2
+#define LINUX_SYSMON_MEM_MINFLT_SUBCH    3
+#define LINUX_SYSMON_MEM_MAJFLT_SUBCH    4
+#define LINUX_SYSMON_MEM_NUM_SUBCH       5
+
+/*
+ * Subchannels of the "perf" subsystem, from perf_event counters of the process
+ *
+ * The task clock is the CPU time used in hundredths of a percent of one CPU,
+ * so 10000 is one CPU fully busy and the 24 bit range covers over a thousand
+ * CPUs.  Cycles and instructions are in millions per second, and the others
+ * are in events per second, all limited to 0xFFFFFF.  Cycles and instructions are only available
+ * if the kernel allows access to the hardware counters.
+ */
+#define LINUX_SYSMON_PERF_TASK_CLOCK_SUBCH   0
+#define LINUX_SYSMON_PERF_CTX_SWITCH_SUBCH   1
+#define LINUX_SYSMON_PERF_MIGRATION_SUBCH    2
+#define LINUX_SYSMON_PERF_PAGE_FAULT_SUBCH   3
+#define LINUX_SYSMON_PERF_CYCLES_SUBCH       4
+#define LINUX_SYSMON_PERF_INSTRUCTIONS_SUBCH 5
+#define LINUX_SYSMON_PERF_NUM_SUBCH          6
+
+/*
+ * Subchannels of the "pressure" subsystem, from Pressure Stall Information
+ *
+ * Each is the percentage of the last sample period in which some (or all)
+ * tasks were stalled waiting for the resource, in hundredths of a percent.
+ * The pressure of the cgroup is used if there is one, so inside a container
+ * this is the stall caused by the container's own limits.
+ */
+#define LINUX_SYSMON_PSI_CPU_SOME_SUBCH    0
+#define LINUX_SYSMON_PSI_CPU_FULL_SUBCH    1
+#define LINUX_SYSMON_PSI_MEMORY_SOME_SUBCH 2
+#define LINUX_SYSMON_PSI_MEMORY_FULL_SUBCH 3
+#define LINUX_SYSMON_PSI_IO_SOME_SUBCH     4
+#define LINUX_SYSMON_PSI_IO_FULL_SUBCH     5
+#define LINUX_SYSMON_PSI_NUM_SUBCH         6
+#define LINUX_SYSMON_PSI_NUM_RESOURCES     3
+
+/*
+ * Subchannels of the "cgroup" subsystem, from the cgroup v2 controllers
+ *
+ * CPU usage and throttled time are in hundredths of a percent of one CPU, as
+ * for the task clock, so 10000 is one CPU.  The throttled periods are the percentage of CFS quota periods in
+ * which the cgroup was throttled, in hundredths of a percent, and the memory
+ * is in KiB.  The throttling values are only available if the cgroup has a
+ * CPU quota controller.
+ */
+#define LINUX_SYSMON_CGROUP_CPU_USAGE_SUBCH      0
+#define LINUX_SYSMON_CGROUP_THROTTLED_TIME_SUBCH 1
+#define LINUX_SYSMON_CGROUP_THROTTLED_PER_SUBCH  2
+#define LINUX_SYSMON_CGROUP_MEMORY_SUBCH         3
+#define LINUX_SYSMON_CGROUP_NUM_SUBCH            4
+
+/*
+ * Sample period of the CPU load, which can be changed at run time
+ * via CFE_PSP_IODriver_SET_CONFIGURATION with "sample_period_ms=<n>"
+ */
+#define LINUX_SYSMON_DEFAULT_SAMPLE_PERIOD_MS 30000
+#define LINUX_SYSMON_MIN_SAMPLE_PERIOD_MS     10
+#define LINUX_SYSMON_MAX_SAMPLE_PERIOD_MS     3600000
+
+/*
+ * Every sample can be recorded into a file, set via CFE_PSP_IODriver_SET_CONFIGURATION
+ * with "record_file=<path>" and "record_entries=<n>" while the sampler is stopped.
+ * Each entry is one channel value, and the number of entries must be a power of two.
+ */
+#define LINUX_SYSMON_DEFAULT_RECORD_ENTRIES 65536
+#define LINUX_SYSMON_MIN_RECORD_ENTRIES     64
+#define LINUX_SYSMON_MAX_RECORD_ENTRIES     (1UL << 26)
+
+/* How long linux_sysmon_Start() waits for the first sample */
+#define LINUX_SYSMON_START_TIMEOUT_MS 5000
 
 #ifdef DEBUG_BUILD
 #define LINUX_SYSMON_DEBUG(...) OS_printf(__VA_ARGS__)
@@ -56,26 +191,192 @@
 typedef struct linux_sysmon_cpuload_core
 {
     CFE_PSP_IODriver_AdcCode_t avg_load;
-    unsigned long              last_run_time;
-} linux_sysmon_cpuload_core_t;
+    uint32_t                   last_sample; /* sample in which the CPU was last seen online */
+    uint64_t                   last_run_time;
+    bool                       has_avg;
+    uint32_t                   avg[LINUX_SYSMON_NUM_AVG_WINDOWS];
+} __attribute__((aligned(LINUX_SYSMON_CACHE_LINE_SIZE))) linux_sysmon_cpuload_core_t;
+
+typedef struct linux_sysmon_task_entry
+{
+    pid_t                      tid; /* zero if this slot is free */
+    int                        stat_fd;
+    bool                       name_pending;
+    uint64_t                   last_run_time;
+    CFE_PSP_IODriver_AdcCode_t avg_load;
+    char                       name[LINUX_SYSMON_TASK_NAME_LEN];
+} linux_sysmon_task_entry_t;
+
+typedef struct linux_sysmon_tasks_state
+{
+    DIR *    task_dir;    /* kept-open /proc/self/task directory */
+    nlink_t  last_nlink;  /* link count of task_dir at the last scan, which tracks the number of threads */
+    bool     need_rescan; /* set when a monitored thread has exited */
+    uint16_t num_slots;   /* highest slot in use + 1 */
+    uint32_t num_dropped; /* threads which did not fit in the table */
+
+    linux_sysmon_task_entry_t entries[LINUX_SYSMON_MAX_TASKS];
+} linux_sysmon_tasks_state_t;
+
+typedef struct linux_sysmon_memory_state
+{
+    int      statm_fd; /* kept-open /proc/self/statm */
+    int      stat_fd;  /* kept-open /proc/self/stat */
+    uint32_t page_kb;
+    uint64_t last_minflt;
+    uint64_t last_majflt;
+
+    CFE_PSP_IODriver_AdcCode_t values[LINUX_SYSMON_MEM_NUM_SUBCH];
+} linux_sysmon_memory_state_t;
+
+/*
+ * The perf_event counters are opened once at module init, on the main thread
+ * before CFE starts, so they are inherited by every thread created after that.
+ * They are only enabled while the sampler is running.
+ */
+typedef struct linux_sysmon_perf_state
+{
+    int      group_fd;                           /* group leader, -1 if no counters could be opened */
+    int      fd[LINUX_SYSMON_PERF_NUM_SUBCH];    /* -1 for counters which are not available */
+    uint32_t num_counters;                       /* number of counters in the group */
+    uint8_t  subch[LINUX_SYSMON_PERF_NUM_SUBCH]; /* subchannel of each counter, in group read order */
+    uint64_t last_enabled;
+    uint64_t last_running;
+    uint64_t last_count[LINUX_SYSMON_PERF_NUM_SUBCH];
+
+    CFE_PSP_IODriver_AdcCode_t values[LINUX_SYSMON_PERF_NUM_SUBCH];
+} linux_sysmon_perf_state_t;
+
+/*
+ * The cgroup and pressure files are found and opened when the sampler
+ * starts, and are read with pread() into a buffer on the stack.  Any which
+ * do not exist, or do not have the expected fields, are marked as not valid.
+ */
+typedef struct linux_sysmon_cgroup_state
+{
+    int psi_fd[LINUX_SYSMON_PSI_NUM_RESOURCES]; /* kept-open cpu, memory and io pressure */
+    int cpu_stat_fd;                            /* kept-open cpu.stat of the cgroup */
+    int memory_current_fd;                      /* kept-open memory.current of the cgroup */
+
+    uint64_t last_stall_us[LINUX_SYSMON_PSI_NUM_SUBCH];
+    uint64_t last_usage_us;
+    uint64_t last_throttled_us;
+    uint64_t last_nr_periods;
+    uint64_t last_nr_throttled;
+
+    uint32_t                   psi_valid;    /* bit for each "pressure" subchannel which was read */
+    uint32_t                   cgroup_valid; /* bit for each "cgroup" subchannel which was read */
+    CFE_PSP_IODriver_AdcCode_t psi_values[LINUX_SYSMON_PSI_NUM_SUBCH];
+    CFE_PSP_IODriver_AdcCode_t cgroup_values[LINUX_SYSMON_CGROUP_NUM_SUBCH];
+} linux_sysmon_cgroup_state_t;
+
+/*
+ * The sample recorder, when a record file is configured
+ *
+ * The file is mapped into memory when the sampler starts, and pre-faulted so
+ * that recording a sample is only stores into memory which is already there.
+ */
+typedef struct linux_sysmon_record_state
+{
+    CFE_PSP_SysmonRecorder_t recorder;
+    void *                   map; /* NULL if not recording */
+    size_t                   map_size;
+} linux_sysmon_record_state_t;
+
+/*
+ * The values of one complete sample, as seen by readers
+ *
+ * The sampler fills in one of two snapshots while readers use the other, and
+ * then switches them over by incrementing snapshot_seq.  A reader picks the
+ * snapshot from the sequence number, and checks afterwards that the sequence
+ * number did not move on by a whole sample while it was reading.  Readers never
+ * block the sampler, and only need to retry if preempted for a whole sample period.
+ */
+typedef struct linux_sysmon_snapshot
+{
+    uint32_t                   num_cpus;   /* highest online CPU number + 1, the range of per-cpu subchannels */
+    uint32_t                   num_online; /* number of CPUs in the aggregate */
+    CFE_PSP_IODriver_AdcCode_t aggregate_load[1 + LINUX_SYSMON_NUM_AVG_WINDOWS]; /* current, then the averages */
+    uint16_t                   num_task_slots;
+
+    /*
+     * The current load of each CPU, followed by the same for each of the averages,
+     * so the load of CPU c for window w is at [(w * max_cpus) + c].  Offline CPUs read as zero.
+     */
+    CFE_PSP_IODriver_AdcCode_t *cpu_load;
+    CFE_PSP_IODriver_AdcCode_t  task_load[LINUX_SYSMON_MAX_TASKS];
+    char                       task_name[LINUX_SYSMON_MAX_TASKS][LINUX_SYSMON_TASK_NAME_LEN]; /* empty if slot is free */
+    CFE_PSP_IODriver_AdcCode_t memory[LINUX_SYSMON_MEM_NUM_SUBCH];
+    CFE_PSP_IODriver_AdcCode_t perf[LINUX_SYSMON_PERF_NUM_SUBCH];
+    uint32_t                   psi_valid;
+    uint32_t                   cgroup_valid;
+    CFE_PSP_IODriver_AdcCode_t psi[LINUX_SYSMON_PSI_NUM_SUBCH];
+    CFE_PSP_IODriver_AdcCode_t cgroup[LINUX_SYSMON_CGROUP_NUM_SUBCH];
+} __attribute__((aligned(LINUX_SYSMON_CACHE_LINE_SIZE))) linux_sysmon_snapshot_t;
 
 typedef struct linux_sysmon_cpuload_state
 {
     volatile bool is_running;
     volatile bool should_run;
 
-    uint8_t   num_cpus;
+    uint32_t  num_cpus;
+    uint32_t  num_online;
+    bool      cpus_dropped;
+    bool      has_aggregate_avg;
+
+    CFE_PSP_IODriver_AdcCode_t aggregate_load;
+    uint32_t                   aggregate_avg[LINUX_SYSMON_NUM_AVG_WINDOWS];
+
     pthread_t task_id;
+
+    /* the sampler reports the status of its first sample to linux_sysmon_Start() through these */
+    pthread_mutex_t ready_lock;
+    pthread_cond_t  ready_cond;
+    bool            ready;
+    int32_t         ready_status;
+
     int       dev_fd;
+    char *    schedstat_buf; /* holds all of /proc/schedstat, grown as needed */
+    size_t    schedstat_bufsize;
+    int       wake_fd; /* eventfd to wake the sampler when the configuration changes, or to stop */
     uint32_t  num_samples;
     uint64_t  last_sample_time;
 
-    linux_sysmon_cpuload_core_t per_core[LINUX_SYSMON_MAX_CPUS];
+    linux_sysmon_tasks_state_t  tasks;
+    linux_sysmon_memory_state_t memory;
+    linux_sysmon_cgroup_state_t cgroup;
+    linux_sysmon_record_state_t record;
+
+    /*
+     * Everything from here on is kept across stop/start of the sampler, as readers
+     * use the snapshots without locking.  The per-core arrays are sized at init.
+     */
+    uint32_t                     max_cpus; /* size of the per-core arrays */
+    linux_sysmon_cpuload_core_t *per_core; /* max_cpus entries */
+
+    /* number of samples published, the latest is in snapshot[seq & 1] */
+    volatile uint32_t snapshot_seq __attribute__((aligned(LINUX_SYSMON_CACHE_LINE_SIZE)));
+
+    linux_sysmon_snapshot_t snapshot[2];
 } linux_sysmon_cpuload_state_t;
 
+/*
+ * Configuration, which is kept across stop/start of the sampler
+ */
+typedef struct linux_sysmon_config
+{
+    volatile uint64_t sample_period_ns;
+    uint32_t          record_entries;
+    char              record_file[PATH_MAX]; /* empty if not recording */
+} linux_sysmon_config_t;
+
 typedef struct linux_sysmon_state
 {
     uint32_t                     local_module_id;
+    linux_sysmon_config_t        config;
+    CFE_PSP_SysmonAlarmSet_t     alarms;
+    uint32_t                     alarm_event_id; /* idle task event source, which notifies CFE of alarms */
+    linux_sysmon_perf_state_t    perf;
     linux_sysmon_cpuload_state_t cpu_load;
 } linux_sysmon_state_t;
 
@@ -87,24 +388,67 @@ static void *  linux_sysmon_Task(void *arg);
 static int32_t linux_sysmon_Start(linux_sysmon_cpuload_state_t *state);
 static int32_t linux_sysmon_Stop(linux_sysmon_cpuload_state_t *state);
 static void    linux_sysmon_Init(uint32_t local_module_id);
+static void    linux_sysmon_open_perf(linux_sysmon_perf_state_t *perf);
+static int     linux_sysmon_alloc_cpus(linux_sysmon_cpuload_state_t *state);
+static void    linux_sysmon_alarm_notify(void *arg);
 
 /* Function that starts up linux_sysmon driver. */
 static int32_t linux_sysmon_DevCmd(uint32_t CommandCode, uint16_t SubsystemId, uint16_t SubchannelId,
                                    CFE_PSP_IODriver_Arg_t Arg);
+static int32_t linux_sysmon_DevMutex(uint32_t CommandCode, uint16_t SubsystemId, uint16_t SubchannelId,
+                                     CFE_PSP_IODriver_Arg_t Arg);
 
 /********************************************************************
  * Global Data
  ********************************************************************/
 
 /* linux_sysmon device command that is called by iodriver to start up linux_sysmon */
-CFE_PSP_IODriver_API_t linux_sysmon_DevApi = {.DeviceCommand = linux_sysmon_DevCmd};
+CFE_PSP_IODriver_API_t linux_sysmon_DevApi = {
+    .DeviceCommand     = linux_sysmon_DevCmd,
+    .DeviceMutex       = linux_sysmon_DevMutex,
+    .ReentrantBaseOps  = CFE_PSP_SYSMON_REENTRANT_BASE_OPS,
+    .ReentrantClassOps = CFE_PSP_SYSMON_REENTRANT_CLASS_OPS};
 
 CFE_PSP_MODULE_DECLARE_IODEVICEDRIVER(linux_sysmon);
 
 static linux_sysmon_state_t linux_sysmon_global;
 
-static const char *linux_sysmon_subsystem_names[]  = {"aggregate", "per-cpu", NULL};
-static const char *linux_sysmon_subchannel_names[] = {"cpu-load", NULL};
+static const char *linux_sysmon_subsystem_names[]  = {"aggregate",  "per-cpu",     "per-task",    "memory",
+                                                      "per-cpu-1s", "per-cpu-10s", "per-cpu-60s", "perf",
+                                                      "pressure",   "cgroup",      NULL};
+static const char *linux_sysmon_subchannel_names[] = {"cpu-load", "cpu-load-1s", "cpu-load-10s", "cpu-load-60s", NULL};
+
+/* Time constants of the averages, in the same order as the names */
+static const uint32_t linux_sysmon_avg_window_ms[LINUX_SYSMON_NUM_AVG_WINDOWS] = {1000, 10000, 60000};
+
+static const char *linux_sysmon_memory_subchannel_names[] = {"rss", "anon", "shared", "minor-faults", "major-faults",
+                                                             NULL};
+static const char *linux_sysmon_perf_subchannel_names[]   = {"task-clock", "context-switches", "cpu-migrations",
+                                                           "page-faults", "cycles",           "instructions",
+                                                           NULL};
+
+static const char *linux_sysmon_psi_subchannel_names[]    = {"cpu-some", "cpu-full", "memory-some", "memory-full",
+                                                          "io-some",  "io-full",  NULL};
+static const char *linux_sysmon_cgroup_subchannel_names[] = {"cpu-usage", "throttled-time", "throttled-periods",
+                                                             "memory-current", NULL};
+
+/* The pressure files, in the order of the "pressure" subchannels */
+static const char *linux_sysmon_psi_resources[LINUX_SYSMON_PSI_NUM_RESOURCES] = {"cpu", "memory", "io"};
+
+/* The counter for each "perf" subchannel, and the scale from a count per nanosecond to its units */
+static const struct
+{
+    uint32_t type;
+    uint64_t config;
+    uint32_t scale;
+} linux_sysmon_perf_counters[LINUX_SYSMON_PERF_NUM_SUBCH] = {
+    {PERF_TYPE_SOFTWARE, PERF_COUNT_SW_TASK_CLOCK, 10000},
+    {PERF_TYPE_SOFTWARE, PERF_COUNT_SW_CONTEXT_SWITCHES, 1000000000},
+    {PERF_TYPE_SOFTWARE, PERF_COUNT_SW_CPU_MIGRATIONS, 1000000000},
+    {PERF_TYPE_SOFTWARE, PERF_COUNT_SW_PAGE_FAULTS, 1000000000},
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES, 1000},
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS, 1000},
+};
 
 /***********************************************************************
  * Global Functions
@@ -114,250 +458,1897 @@ void linux_sysmon_Init(uint32_t local_module_id)
 {
     memset(&linux_sysmon_global, 0, sizeof(linux_sysmon_global));
 
-    linux_sysmon_global.local_module_id = local_module_id;
+    linux_sysmon_global.local_module_id         = local_module_id;
+    linux_sysmon_global.config.sample_period_ns = LINUX_SYSMON_DEFAULT_SAMPLE_PERIOD_MS * 1000000ULL;
+    linux_sysmon_global.config.record_entries   = LINUX_SYSMON_DEFAULT_RECORD_ENTRIES;
+
+    linux_sysmon_open_perf(&linux_sysmon_global.perf);
+
+    if (linux_sysmon_alloc_cpus(&linux_sysmon_global.cpu_load) < 0)
+    {
+        perror("posix_memalign()");
+    }
+
+    /*
+     * Alarms wake the idle task to notify CFE, as exceptions do, rather than calling
+     * into CFE from the sampler.  If that is not possible CFE is notified directly.
+     */
+    CFE_PSP_SysmonAlarm_Init(&linux_sysmon_global.alarms, "linux_sysmon", linux_sysmon_subsystem_names);
+    if (CFE_PSP_IdleEvent_Register("linux_sysmon", NULL, NULL, &linux_sysmon_global.alarm_event_id) ==
+        CFE_PSP_SUCCESS)
+    {
+        CFE_PSP_SysmonAlarm_SetNotify(&linux_sysmon_global.alarms, linux_sysmon_alarm_notify, NULL);
+    }
+}
+
+/*
+ * Raises the idle task event of the module, from the sampler
+ */
+static void linux_sysmon_alarm_notify(void *arg)
+{
+    CFE_PSP_IdleEvent_Raise(linux_sysmon_global.alarm_event_id);
+}
+
+static uint64_t linux_sysmon_get_time_ns(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ((uint64_t)ts.tv_sec * 1000000000) + ts.tv_nsec;
+}
+
+/*
+ * Wakes the sampler from waiting for the next sample, to apply a new configuration or to stop
+ */
+static void linux_sysmon_wake(linux_sysmon_cpuload_state_t *state)
+{
+    uint64_t wake;
+
+    wake = 1;
+    if (write(state->wake_fd, &wake, sizeof(wake)) < 0)
+    {
+        perror("write(wake_fd)");
+    }
 }
 
-void linux_sysmon_read_cpuuse_line(const char *line_data, unsigned int *cpu_num, unsigned long *run_time)
+/*
+ * Sets the record file or its number of entries, which are used from the
+ * next start of the sampler.  An empty file name turns recording off.
+ */
+static int32_t linux_sysmon_set_record_config(linux_sysmon_cpuload_state_t *state, const char *file_str,
+                                              const char *entries_str)
 {
+    char *        end_p;
     unsigned long value;
-    const char *  val_end;
-    int           val_count;
 
-    /* each "cpu" line contains the cpu number followed by 9 values */
-    for (val_count = 0; val_count < 10 && *line_data != 0; ++val_count)
+    if (state->is_running)
+    {
+        OS_printf("CFE_PSP(linux_sysmon): The recorder can only be configured while stopped\n");
+        return CFE_PSP_ERROR;
+    }
+
+    if (file_str != NULL)
     {
-        while (isspace((unsigned char)*line_data))
+        if (strlen(file_str) >= sizeof(linux_sysmon_global.config.record_file))
         {
-            ++line_data;
+            OS_printf("CFE_PSP(linux_sysmon): Record file name too long\n");
+            return CFE_PSP_ERROR;
         }
-        value = strtoul(line_data, (char **)&val_end, 10);
-        if (val_end == line_data)
+
+        strcpy(linux_sysmon_global.config.record_file, file_str);
+    }
+    else
+    {
+        value = strtoul(entries_str, &end_p, 10);
+        if (end_p == entries_str || *end_p != 0 || value < LINUX_SYSMON_MIN_RECORD_ENTRIES ||
+            value > LINUX_SYSMON_MAX_RECORD_ENTRIES || (value & (value - 1)) != 0)
         {
-            /* not a number, something went wrong */
-            break;
+            OS_printf("CFE_PSP(linux_sysmon): Invalid record entries \'%s\', must be a power of two from %lu-%lu\n",
+                      entries_str, (unsigned long)LINUX_SYSMON_MIN_RECORD_ENTRIES,
+                      (unsigned long)LINUX_SYSMON_MAX_RECORD_ENTRIES);
+            return CFE_PSP_ERROR;
         }
 
-        line_data = val_end;
+        linux_sysmon_global.config.record_entries = value;
+    }
 
-        switch (val_count)
-        {
-            case 0: /* this is the cpu number */
-                *cpu_num = value;
-                break;
+    return CFE_PSP_SUCCESS;
+}
 
-            case 7: /* this is the number of nanoseconds spent executing instructions on this CPU */
-                *run_time = value;
-                break;
+int32_t linux_sysmon_set_config(linux_sysmon_cpuload_state_t *state, const char *config_str)
+{
+    const char *  value_str;
+    const char *  entries_str;
+    char *        end_p;
+    unsigned long value;
 
-            default: /* don't care about this one */
-                break;
-        }
+    if (config_str == NULL)
+    {
+        return CFE_PSP_INVALID_POINTER;
+    }
+
+    value_str   = CFE_PSP_SysmonConfig_GetValue(config_str, "record_file");
+    entries_str = CFE_PSP_SysmonConfig_GetValue(config_str, "record_entries");
+    if (value_str != NULL || entries_str != NULL)
+    {
+        return linux_sysmon_set_record_config(state, value_str, entries_str);
+    }
+
+    value_str = CFE_PSP_SysmonConfig_GetValue(config_str, "alarm");
+    if (value_str != NULL)
+    {
+        return CFE_PSP_SysmonAlarm_Configure(&linux_sysmon_global.alarms, value_str);
+    }
+
+    value_str = CFE_PSP_SysmonConfig_GetValue(config_str, "sample_period_ms");
+    if (value_str == NULL)
+    {
+        return CFE_PSP_ERROR_NOT_IMPLEMENTED;
+    }
+
+    value = strtoul(value_str, &end_p, 10);
+    if (end_p == value_str || *end_p != 0 || value < LINUX_SYSMON_MIN_SAMPLE_PERIOD_MS ||
+        value > LINUX_SYSMON_MAX_SAMPLE_PERIOD_MS)
+    {
+        OS_printf("CFE_PSP(linux_sysmon): Invalid sample period \'%s\', must be %u-%u ms\n", value_str,
+                  (unsigned int)LINUX_SYSMON_MIN_SAMPLE_PERIOD_MS, (unsigned int)LINUX_SYSMON_MAX_SAMPLE_PERIOD_MS);
+        return CFE_PSP_ERROR;
+    }
+
+    linux_sysmon_global.config.sample_period_ns = value * 1000000ULL;
+
+    /* If the sampler is waiting out a longer period, wake it to apply the new one now */
+    if (state->is_running)
+    {
+        linux_sysmon_wake(state);
     }
+
+    return CFE_PSP_SUCCESS;
 }
 
-void linux_sysmon_update_schedstat(linux_sysmon_cpuload_state_t *state, int elapsed_ms)
+/*
+ * Converts a run time within an elapsed time to the 24 bit load value
+ */
+static CFE_PSP_IODriver_AdcCode_t linux_sysmon_calc_load(uint64_t run_time_ns, uint64_t elapsed_ns)
 {
-    unsigned int  cpu_time_ms;
-    unsigned int  cpu_num;
-    unsigned int  highest_cpu_num;
-    unsigned long run_time;
-    char          line_data[256];
-    size_t        line_size;
-    ssize_t       line_rdsz;
-    char *        eol_p;
+    CFE_PSP_IODriver_AdcCode_t load;
 
-    linux_sysmon_cpuload_core_t *core_p;
+    if (elapsed_ns == 0)
+    {
+        load = 0;
+    }
+    else if (run_time_ns >= elapsed_ns)
+    {
+        load = 0xFFFFFF; /* max */
+    }
+    else
+    {
+        load = (0x1000 * run_time_ns) / elapsed_ns;
+        load |= (load << 12); /* Expand from 12->24 bit */
+    }
 
-    line_size       = 0;
-    highest_cpu_num = 0;
+    return load;
+}
 
-    /* Reset to beginning of file to re-read it */
-    lseek(state->dev_fd, 0, SEEK_SET);
+/*
+ * Reads all of /proc/schedstat into the buffer, and returns the length
+ *
+ * The kernel fills the buffer as far as the data goes, so this is normally
+ * a single pread().  The buffer starts at one page and is only grown if the
+ * data fills it, e.g. on the first sample on a host with many CPUs, so the
+ * steady state does not allocate.
+ */
+static ssize_t linux_sysmon_read_schedstat(linux_sysmon_cpuload_state_t *state)
+{
+    ssize_t len;
+    char *  new_buf;
 
     while (true)
     {
-        line_rdsz = read(state->dev_fd, &line_data[line_size], sizeof(line_data) - line_size);
-        if (line_rdsz <= 0)
+        len = pread(state->dev_fd, state->schedstat_buf, state->schedstat_bufsize - 1, 0);
+        if (len < 0)
         {
-            /* error (not expected) or EOF, stop reading */
-            break;
+            perror("pread(/proc/schedstat)");
+            return len;
         }
 
-        /* check for newline char */
-        eol_p = memchr(&line_data[line_size], '\n', line_rdsz);
-        line_size += line_rdsz;
-
-        while (eol_p != NULL)
+        if ((size_t)len < (state->schedstat_bufsize - 1))
         {
-            *eol_p = 0;
-            ++eol_p;
+            break;
+        }
 
-            if (strncmp("cpu", line_data, 3) == 0)
-            {
-                cpu_num  = -1;
-                run_time = 0;
-                linux_sysmon_read_cpuuse_line(&line_data[3], &cpu_num, &run_time);
+        /* the file may have been truncated, retry with a bigger buffer */
+        new_buf = realloc(state->schedstat_buf, state->schedstat_bufsize * 2);
+        if (new_buf == NULL)
+        {
+            /* just use what was read, the higher CPUs will be missing */
+            OS_printf("CFE_PSP(linux_sysmon): /proc/schedstat truncated to %lu bytes\n", (unsigned long)len);
+            break;
+        }
 
-                if (cpu_num < LINUX_SYSMON_MAX_CPUS)
-                {
-                    core_p = &state->per_core[cpu_num];
-                    if (cpu_num > highest_cpu_num)
-                    {
-                        highest_cpu_num = cpu_num;
-                    }
-                }
-                else
-                {
-                    core_p = NULL;
-                }
+        state->schedstat_buf = new_buf;
+        state->schedstat_bufsize *= 2;
+    }
 
-                if (core_p != NULL)
-                {
-                    cpu_time_ms =
-                        OS_TimeGetTotalMilliseconds(OS_TimeFromTotalNanoseconds(run_time - core_p->last_run_time));
-                    core_p->last_run_time = run_time;
-                    if (cpu_time_ms >= elapsed_ms)
-                    {
-                        core_p->avg_load = 0xFFFFFF; /* max */
-                    }
-                    else if (elapsed_ms == 0)
-                    {
-                        core_p->avg_load = 0;
-                    }
-                    else
-                    {
-                        core_p->avg_load = (0x1000 * cpu_time_ms) / elapsed_ms;
-                        core_p->avg_load |= (core_p->avg_load << 12); /* Expand from 12->24 bit */
-                    }
-                    LINUX_SYSMON_DEBUG("CFE_PSP(linux_sysmon): CPU%u time_ms=%u ms, load=%06x\n", cpu_num, cpu_time_ms,
-                                       (unsigned int)core_p->avg_load);
-                }
-            }
+    state->schedstat_buf[len] = 0;
+    return len;
+}
 
-            line_rdsz = eol_p - &line_data[0];
-            if (line_rdsz < line_size)
-            {
-                memmove(line_data, eol_p, line_size - line_rdsz);
-                line_size -= line_rdsz;
-            }
-            else
-            {
-                line_size = 0;
-            }
+/*
+ * Finds the size needed for the per-core state
+ *
+ * This is the number of CPUs configured rather than those online, so there
+ * is room for CPUs brought online later, and allows for gaps in the numbering
+ * of the CPUs that are online now.
+ */
+static uint32_t linux_sysmon_count_cpus(linux_sysmon_cpuload_state_t *state)
+{
+    long         count;
+    ssize_t      len;
+    const char * pos;
+    unsigned int cpu_num;
+    uint64_t     run_time;
+
+    count = sysconf(_SC_NPROCESSORS_CONF);
+    if (count < 1)
+    {
+        count = 1;
+    }
 
-            eol_p = memchr(line_data, '\n', line_size);
-        }
+    if (state->dev_fd < 0 || state->schedstat_buf == NULL)
+    {
+        return count;
+    }
 
-        if (line_size >= sizeof(line_data))
+    len = linux_sysmon_read_schedstat(state);
+    if (len > 0)
+    {
+        pos = state->schedstat_buf;
+        while ((pos = linux_sysmon_schedstat_next_cpu(pos, state->schedstat_buf + len, &cpu_num, &run_time)) != NULL)
         {
-            /* not supposed to happen, drop data */
-            OS_printf("CFE_PSP(linux_sysmon): malformed data from /proc/schedstat\n");
-            break;
+            if (cpu_num >= count)
+            {
+                count = cpu_num + 1;
+            }
         }
     }
 
-    state->num_cpus = 1 + highest_cpu_num;
+    return count;
 }
 
-void *linux_sysmon_Task(void *arg)
+/*
+ * Allocates the per-core state, once at init
+ *
+ * Readers index the snapshots by max_cpus without locking, so the arrays are
+ * never resized or freed afterwards, even while the sampler is stopped.
+ */
+static int linux_sysmon_alloc_cpus(linux_sysmon_cpuload_state_t *state)
 {
-    linux_sysmon_cpuload_state_t *state = arg;
-
-    OS_time_t     last_sample;
-    OS_time_t     curr_sample;
-    OS_time_t     next_sample;
-    int           msec_diff;
-    struct pollfd pfd;
+    size_t load_size;
+    void * ptr;
+    int    i;
+
+    /* only to count the CPUs, the sampler opens it again when started */
+    state->dev_fd            = open("/proc/schedstat", O_RDONLY | O_CLOEXEC);
+    state->schedstat_bufsize = sysconf(_SC_PAGESIZE);
+    state->schedstat_buf     = malloc(state->schedstat_bufsize);
+    state->max_cpus          = linux_sysmon_count_cpus(state);
+    if (state->dev_fd >= 0)
+    {
+        close(state->dev_fd);
+    }
+    free(state->schedstat_buf);
+    state->dev_fd        = -1;
+    state->schedstat_buf = NULL;
 
-    CFE_PSP_GetTime(&next_sample);
-    curr_sample = next_sample;
-    memset(&pfd, 0, sizeof(pfd));
+    load_size = state->max_cpus * (1 + LINUX_SYSMON_NUM_AVG_WINDOWS) * sizeof(CFE_PSP_IODriver_AdcCode_t);
 
-    linux_sysmon_update_schedstat(state, 0);
+    if (posix_memalign(&ptr, LINUX_SYSMON_CACHE_LINE_SIZE, state->max_cpus * sizeof(*state->per_core)) != 0)
+    {
+        state->max_cpus = 0;
+        return -1;
+    }
+    memset(ptr, 0, state->max_cpus * sizeof(*state->per_core));
+    state->per_core = ptr;
 
-    while (state->should_run)
+    for (i = 0; i < 2; ++i)
     {
-        next_sample = OS_TimeAdd(next_sample, OS_TimeFromTotalSeconds(LINUX_SYSMON_SAMPLE_DELAY));
-        msec_diff   = OS_TimeGetTotalMilliseconds(OS_TimeSubtract(next_sample, curr_sample));
-        if (msec_diff > 0)
+        if (posix_memalign(&ptr, LINUX_SYSMON_CACHE_LINE_SIZE, load_size) != 0)
         {
-            poll(&pfd, 0, msec_diff);
+            free(state->per_core);
+            free(state->snapshot[0].cpu_load);
+            state->per_core             = NULL;
+            state->snapshot[0].cpu_load = NULL;
+            state->max_cpus             = 0;
+            return -1;
         }
-
-        last_sample = curr_sample;
-        CFE_PSP_GetTime(&curr_sample);
-        msec_diff = OS_TimeGetTotalMilliseconds(OS_TimeSubtract(curr_sample, last_sample));
-        linux_sysmon_update_schedstat(state, msec_diff);
+        memset(ptr, 0, load_size);
+        state->snapshot[i].cpu_load = ptr;
     }
 
-    return NULL;
+    return 0;
 }
 
-/* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
- * linux_sysmon_Start()
- * ------------------------------------------------------
- *  Starts the cpu load watcher function
+/*
+ * Closes /proc/schedstat, the per-core state is kept for the next start
  *
- * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
-int32_t linux_sysmon_Start(linux_sysmon_cpuload_state_t *state)
+ * This is only called when the sampler is not running.
+ */
+static void linux_sysmon_close_schedstat(linux_sysmon_cpuload_state_t *state)
 {
-    int32_t StatusCode;
-    int32_t DelayCount;
+    int i;
 
-    DelayCount = 0;
-    if (state->is_running)
+    /* Readers which are not yet done with a snapshot will retry, and see no CPUs */
+    for (i = 0; i < 2; ++i)
     {
-        /* already running, nothing to do */
-        StatusCode = CFE_PSP_SUCCESS;
+        state->snapshot[i].num_cpus   = 0;
+        state->snapshot[i].num_online = 0;
     }
-    else
+    __atomic_fetch_add(&state->snapshot_seq, 2, __ATOMIC_RELEASE);
+
+    if (state->dev_fd >= 0)
     {
-        /* start clean */
-        memset(state, 0, sizeof(*state));
-        StatusCode = CFE_PSP_ERROR;
+        close(state->dev_fd);
+    }
+    free(state->schedstat_buf);
+    state->schedstat_buf = NULL;
+}
+
+/*
+ * Computes exp(-elapsed/window) as a fraction of CFE_PSP_SYSMON_DECAY_ONE,
+ * which is how much of an average remains after one sample
+ *
+ * This is done without floating point, as the whole number part from
+ * a table and the fraction from a series, which converges quickly
+ * as the fraction is below 1.
+ */
+static uint32_t linux_sysmon_calc_decay(uint64_t elapsed_ns, uint64_t window_ns)
+{
+    static const uint32_t exp_neg_int[] = {65536, 24109, 8869, 3263, 1200, 442, 162, 60, 22, 8, 3, 1};
+
+    uint64_t x;
+    uint64_t n;
+    int64_t  f;
+    int64_t  term;
+    int64_t  sum;
+    int      k;
+
+    n = sizeof(exp_neg_int) / sizeof(exp_neg_int[0]);
+    if (elapsed_ns >= (window_ns * n))
+    {
+        /* nothing remains */
+        return 0;
+    }
 
-        state->dev_fd = open("/proc/schedstat", O_RDONLY);
-        if (state->dev_fd < 0)
+    /* x is elapsed/window in 16.16 fixed point */
+    x = (elapsed_ns << CFE_PSP_SYSMON_DECAY_SHIFT) / window_ns;
+    n = x >> CFE_PSP_SYSMON_DECAY_SHIFT;
+
+    /* exp(-f) = 1 - f + f^2/2! - f^3/3! ..., in 32.32 fixed point */
+    f    = x & (CFE_PSP_SYSMON_DECAY_ONE - 1);
+    term = (int64_t)1 << 32;
+    sum  = term;
+    for (k = 1; k <= 8; ++k)
+    {
+        term = (term * f) / ((int64_t)k << CFE_PSP_SYSMON_DECAY_SHIFT);
+        if (k & 1)
         {
-            perror("open(/proc/schedstat)");
+            sum -= term;
         }
         else
         {
+            sum += term;
+        }
+    }
+
+    return ((sum >> CFE_PSP_SYSMON_DECAY_SHIFT) * exp_neg_int[n]) >> CFE_PSP_SYSMON_DECAY_SHIFT;
+}
+
+void linux_sysmon_update_schedstat(linux_sysmon_cpuload_state_t *state, uint64_t elapsed_ns)
+{
+    uint64_t     cpu_time_ns;
+    uint64_t     run_time;
+    unsigned int cpu_num;
+    unsigned int highest_cpu_num;
+    uint32_t     num_online;
+    uint64_t     sum;
+    uint32_t     decay[LINUX_SYSMON_NUM_AVG_WINDOWS];
+    ssize_t      len;
+    const char * pos;
+    int          w;
+
+    linux_sysmon_cpuload_core_t *core_p;
+
+    len = linux_sysmon_read_schedstat(state);
+    if (len < 0)
+    {
+        return;
+    }
+
+    for (w = 0; w < LINUX_SYSMON_NUM_AVG_WINDOWS; ++w)
+    {
+        decay[w] = linux_sysmon_calc_decay(elapsed_ns, linux_sysmon_avg_window_ms[w] * 1000000ULL);
+    }
+
+    /* CPUs which are offline do not appear in /proc/schedstat at all */
+    ++state->num_samples;
+    highest_cpu_num = 0;
+    num_online      = 0;
+    sum             = 0;
+    pos             = state->schedstat_buf;
+    while ((pos = linux_sysmon_schedstat_next_cpu(pos, state->schedstat_buf + len, &cpu_num, &run_time)) != NULL)
+    {
+        if (cpu_num >= state->max_cpus)
+        {
+            if (!state->cpus_dropped)
+            {
+                OS_printf("CFE_PSP(linux_sysmon): CPU%u was added after init, and is not monitored\n", cpu_num);
+                state->cpus_dropped = true;
+            }
+            continue;
+        }
+
+        core_p = &state->per_core[cpu_num];
+        if (cpu_num > highest_cpu_num)
+        {
+            highest_cpu_num = cpu_num;
+        }
+
+        /*
+         * This is computed in nanoseconds, as at short sample periods
+         * a millisecond count would only give a handful of load steps.
+         *
+         * A CPU which was offline in the previous sample has no valid
+         * starting point, so it reads as idle until the next sample, and
+         * its averages start over.
+         */
+        if (core_p->last_sample + 1 == state->num_samples && elapsed_ns != 0)
+        {
+            cpu_time_ns      = run_time - core_p->last_run_time;
+            core_p->avg_load = linux_sysmon_calc_load(cpu_time_ns, elapsed_ns);
+            CFE_PSP_SysmonAvg_Update(core_p->avg, &core_p->has_avg, core_p->avg_load, decay,
+                                     LINUX_SYSMON_NUM_AVG_WINDOWS);
+        }
+        else
+        {
+            cpu_time_ns      = 0;
+            core_p->avg_load = 0;
+            core_p->has_avg  = false;
+        }
+        core_p->last_run_time = run_time;
+        core_p->last_sample   = state->num_samples;
+        sum += core_p->avg_load;
+        ++num_online;
+
+        LINUX_SYSMON_DEBUG("CFE_PSP(linux_sysmon): CPU%u time_ns=%llu ns, load=%06x\n", cpu_num,
+                           (unsigned long long)cpu_time_ns, (unsigned int)core_p->avg_load);
+    }
+
+    /* the aggregate is the average of the CPUs which are online */
+    state->num_online = num_online;
+    if (num_online == 0)
+    {
+        state->num_cpus       = 0;
+        state->aggregate_load = 0;
+    }
+    else
+    {
+        state->num_cpus       = 1 + highest_cpu_num;
+        state->aggregate_load = sum / num_online;
+        if (elapsed_ns != 0)
+        {
+            CFE_PSP_SysmonAvg_Update(state->aggregate_avg, &state->has_aggregate_avg, state->aggregate_load, decay,
+                                     LINUX_SYSMON_NUM_AVG_WINDOWS);
+        }
+    }
+}
+
+/*
+ * Reads the name of a thread, which the PSP sets to the OSAL task name
+ * (see CFE_PSP_OS_EventHandler).
+ */
+static void linux_sysmon_read_task_name(linux_sysmon_tasks_state_t *tasks, linux_sysmon_task_entry_t *entry)
+{
+    char    path[32];
+    int     fd;
+    ssize_t len;
+
+    snprintf(path, sizeof(path), "%d/comm", (int)entry->tid);
+    fd = openat(dirfd(tasks->task_dir), path, O_RDONLY | O_CLOEXEC);
+    if (fd >= 0)
+    {
+        len = pread(fd, entry->name, sizeof(entry->name) - 1, 0);
+        if (len > 0 && entry->name[len - 1] == '\n')
+        {
+            --len;
+        }
+        entry->name[len > 0 ? len : 0] = 0;
+        close(fd);
+    }
+}
+
+/*
+ * Reads the total run time of a thread from its kept-open schedstat file
+ *
+ * Returns false if the thread no longer exists.
+ */
+static bool linux_sysmon_read_task_run_time(linux_sysmon_task_entry_t *entry, uint64_t *run_time)
+{
+    char    buf[64];
+    ssize_t len;
+
+    len = pread(entry->stat_fd, buf, sizeof(buf) - 1, 0);
+    if (len <= 0)
+    {
+        return false;
+    }
+
+    /* the first field is the time spent running, in nanoseconds */
+    buf[len]  = 0;
+    *run_time = strtoull(buf, NULL, 10);
+
+    return true;
+}
+
+static void linux_sysmon_release_task(linux_sysmon_tasks_state_t *tasks, linux_sysmon_task_entry_t *entry)
+{
+    close(entry->stat_fd);
+    memset(entry, 0, sizeof(*entry));
+}
+
+/*
+ * Scans the task directory for threads which are not yet monitored
+ *
+ * This is only done when the set of threads has changed, so the cost of
+ * a regular sample is just one pread() per thread.
+ */
+static void linux_sysmon_scan_tasks(linux_sysmon_tasks_state_t *tasks)
+{
+    struct dirent *            de;
+    linux_sysmon_task_entry_t *entry;
+    linux_sysmon_task_entry_t *free_entry;
+    char                       path[32];
+    pid_t                      tid;
+    uint16_t                   i;
+
+    tasks->num_dropped = 0;
+
+    rewinddir(tasks->task_dir);
+    while ((de = readdir(tasks->task_dir)) != NULL)
+    {
+        tid = strtol(de->d_name, NULL, 10);
+        if (tid <= 0)
+        {
+            continue; /* "." and ".." */
+        }
+
+        free_entry = NULL;
+        for (i = 0; i < LINUX_SYSMON_MAX_TASKS; ++i)
+        {
+            entry = &tasks->entries[i];
+            if (entry->tid == tid)
+            {
+                break;
+            }
+            if (entry->tid == 0 && free_entry == NULL)
+            {
+                free_entry = entry;
+            }
+        }
+
+        if (i < LINUX_SYSMON_MAX_TASKS)
+        {
+            continue; /* already monitored */
+        }
+
+        if (free_entry == NULL)
+        {
+            ++tasks->num_dropped;
+            continue;
+        }
+
+        snprintf(path, sizeof(path), "%d/schedstat", (int)tid);
+        free_entry->stat_fd = openat(dirfd(tasks->task_dir), path, O_RDONLY | O_CLOEXEC);
+        if (free_entry->stat_fd < 0)
+        {
+            continue; /* exited in the meantime */
+        }
+
+        free_entry->tid = tid;
+        linux_sysmon_read_task_name(tasks, free_entry);
+        linux_sysmon_read_task_run_time(free_entry, &free_entry->last_run_time);
+
+        /*
+         * A new thread may not have been named yet, as this happens
+         * from within the thread as it starts, so read it again next time
+         */
+        free_entry->name_pending = true;
+
+        if ((free_entry - tasks->entries) >= tasks->num_slots)
+        {
+            tasks->num_slots = 1 + (free_entry - tasks->entries);
+        }
+    }
+
+    if (tasks->num_dropped != 0)
+    {
+        LINUX_SYSMON_DEBUG("CFE_PSP(linux_sysmon): %u threads not monitored\n", (unsigned int)tasks->num_dropped);
+    }
+}
+
+static void linux_sysmon_close_tasks(linux_sysmon_tasks_state_t *tasks)
+{
+    uint16_t i;
+
+    for (i = 0; i < LINUX_SYSMON_MAX_TASKS; ++i)
+    {
+        if (tasks->entries[i].tid != 0)
+        {
+            linux_sysmon_release_task(tasks, &tasks->entries[i]);
+        }
+    }
+
+    if (tasks->task_dir != NULL)
+    {
+        closedir(tasks->task_dir);
+        tasks->task_dir = NULL;
+    }
+}
+
+void linux_sysmon_update_tasks(linux_sysmon_tasks_state_t *tasks, uint64_t elapsed_ns)
+{
+    linux_sysmon_task_entry_t *entry;
+    struct stat                dir_stat;
+    uint64_t                   run_time;
+    uint16_t                   i;
+
+    if (tasks->task_dir == NULL)
+    {
+        return;
+    }
+
+    /* The link count of the task directory is 2 + the number of threads */
+    if (fstat(dirfd(tasks->task_dir), &dir_stat) == 0 && dir_stat.st_nlink != tasks->last_nlink)
+    {
+        tasks->last_nlink  = dir_stat.st_nlink;
+        tasks->need_rescan = true;
+    }
+
+    for (i = 0; i < tasks->num_slots; ++i)
+    {
+        entry = &tasks->entries[i];
+        if (entry->tid == 0)
+        {
+            continue;
+        }
+
+        if (!linux_sysmon_read_task_run_time(entry, &run_time))
+        {
+            /* thread has exited, free the slot and look for new ones */
+            linux_sysmon_release_task(tasks, entry);
+            tasks->need_rescan = true;
+            continue;
+        }
+
+        if (entry->name_pending)
+        {
+            linux_sysmon_read_task_name(tasks, entry);
+            entry->name_pending = false;
+        }
+
+        entry->avg_load      = linux_sysmon_calc_load(run_time - entry->last_run_time, elapsed_ns);
+        entry->last_run_time = run_time;
+    }
+
+    while (tasks->num_slots > 0 && tasks->entries[tasks->num_slots - 1].tid == 0)
+    {
+        --tasks->num_slots;
+    }
+
+    if (tasks->need_rescan)
+    {
+        tasks->need_rescan = false;
+        linux_sysmon_scan_tasks(tasks);
+    }
+}
+
+static int linux_sysmon_open_memory(linux_sysmon_memory_state_t *memory)
+{
+    memory->page_kb  = sysconf(_SC_PAGESIZE) / 1024;
+    memory->statm_fd = open("/proc/self/statm", O_RDONLY | O_CLOEXEC);
+    memory->stat_fd  = open("/proc/self/stat", O_RDONLY | O_CLOEXEC);
+    if (memory->statm_fd < 0 || memory->stat_fd < 0)
+    {
+        perror("open(/proc/self/statm, /proc/self/stat)");
+        return -1;
+    }
+
+    return 0;
+}
+
+static void linux_sysmon_close_memory(linux_sysmon_memory_state_t *memory)
+{
+    if (memory->statm_fd >= 0)
+    {
+        close(memory->statm_fd);
+    }
+    if (memory->stat_fd >= 0)
+    {
+        close(memory->stat_fd);
+    }
+    memory->statm_fd = -1;
+    memory->stat_fd  = -1;
+}
+
+/*
+ * Computes (value * mul) / div, for counts over sample periods of up to an hour
+ *
+ * If the product would overflow, the value and divisor are halved together
+ * until it does not, which only drops bits far below the 24 bit result.
+ */
+static uint64_t linux_sysmon_muldiv(uint64_t value, uint64_t mul, uint64_t div)
+{
+    while (mul != 0 && value > (UINT64_MAX / mul))
+    {
+        value >>= 1;
+        div >>= 1;
+    }
+
+    if (div == 0)
+    {
+        return UINT64_MAX;
+    }
+
+    return (value * mul) / div;
+}
+
+/*
+ * Computes the rate of a count over the sample period, as count * scale per
+ * nanosecond, limited to the 24 bit range of the channels
+ */
+static CFE_PSP_IODriver_AdcCode_t linux_sysmon_calc_rate(uint64_t count, uint64_t scale, uint64_t elapsed_ns)
+{
+    uint64_t rate;
+
+    if (elapsed_ns == 0)
+    {
+        return 0;
+    }
+
+    rate = linux_sysmon_muldiv(count, scale, elapsed_ns);
+    if (rate > 0xFFFFFF)
+    {
+        rate = 0xFFFFFF;
+    }
+
+    return rate;
+}
+
+void linux_sysmon_update_memory(linux_sysmon_memory_state_t *memory, uint64_t elapsed_ns)
+{
+    char               buf[512];
+    char *             p;
+    ssize_t            len;
+    unsigned long long resident;
+    unsigned long long shared;
+    unsigned long long minflt;
+    unsigned long long majflt;
+    int                field;
+
+    if (memory->statm_fd < 0 || memory->stat_fd < 0)
+    {
+        return;
+    }
+
+    /* statm is "size resident shared text lib data dt", all in pages */
+    len = pread(memory->statm_fd, buf, sizeof(buf) - 1, 0);
+    if (len > 0)
+    {
+        buf[len] = 0;
+        p        = buf;
+        strtoull(p, &p, 10);
+        resident = strtoull(p, &p, 10);
+        shared   = strtoull(p, &p, 10);
+        if (shared > resident)
+        {
+            shared = resident;
+        }
+
+        memory->values[LINUX_SYSMON_MEM_RSS_SUBCH]    = resident * memory->page_kb;
+        memory->values[LINUX_SYSMON_MEM_ANON_SUBCH]   = (resident - shared) * memory->page_kb;
+        memory->values[LINUX_SYSMON_MEM_SHARED_SUBCH] = shared * memory->page_kb;
+    }
+
+    /*
+     * In stat, the fault counts are fields 10 (minflt) and 12 (majflt).  The
+     * command name in field 2 may contain spaces, so count from the ')' that ends it.
+     */
+    len = pread(memory->stat_fd, buf, sizeof(buf) - 1, 0);
+    if (len > 0)
+    {
+        buf[len] = 0;
+        p        = strrchr(buf, ')');
+        if (p != NULL)
+        {
+            minflt = 0;
+            majflt = 0;
+            ++p;
+            for (field = 3; field <= 12 && *p != 0; ++field)
+            {
+                while (*p == ' ')
+                {
+                    ++p;
+                }
+                if (field == 10)
+                {
+                    minflt = strtoull(p, NULL, 10);
+                }
+                else if (field == 12)
+                {
+                    majflt = strtoull(p, NULL, 10);
+                }
+                while (*p != ' ' && *p != 0)
+                {
+                    ++p;
+                }
+            }
+
+            if (elapsed_ns != 0)
+            {
+                memory->values[LINUX_SYSMON_MEM_MINFLT_SUBCH] =
+                    linux_sysmon_calc_rate(minflt - memory->last_minflt, 1000000000, elapsed_ns);
+                memory->values[LINUX_SYSMON_MEM_MAJFLT_SUBCH] =
+                    linux_sysmon_calc_rate(majflt - memory->last_majflt, 1000000000, elapsed_ns);
+            }
+            memory->last_minflt = minflt;
+            memory->last_majflt = majflt;
+        }
+    }
+}
+
+/*
+ * Opens the perf_event counters as one group, leaving out any which the kernel does not allow
+ *
+ * The software counters are available to any process unless perf_event_paranoid
+ * is 3 or more, but the hardware counters also need a PMU which is accessible
+ * from user space, which is often not the case in virtual machines.
+ */
+static void linux_sysmon_open_perf(linux_sysmon_perf_state_t *perf)
+{
+    struct perf_event_attr attr;
+    int                    i;
+    int                    fd;
+
+    perf->group_fd     = -1;
+    perf->num_counters = 0;
+    for (i = 0; i < LINUX_SYSMON_PERF_NUM_SUBCH; ++i)
+    {
+        memset(&attr, 0, sizeof(attr));
+        attr.size        = sizeof(attr);
+        attr.type        = linux_sysmon_perf_counters[i].type;
+        attr.config      = linux_sysmon_perf_counters[i].config;
+        attr.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+        attr.disabled    = (perf->group_fd < 0);
+        attr.inherit     = 1;
+
+        /* software events such as context switches occur in the kernel, but the PMU may be user space only */
+        if (attr.type == PERF_TYPE_HARDWARE)
+        {
+            attr.exclude_kernel = 1;
+            attr.exclude_hv     = 1;
+        }
+
+        fd = syscall(SYS_perf_event_open, &attr, 0, -1, perf->group_fd, PERF_FLAG_FD_CLOEXEC);
+
+        perf->fd[i] = fd;
+        if (fd >= 0)
+        {
+            if (perf->group_fd < 0)
+            {
+                perf->group_fd = fd;
+            }
+            perf->subch[perf->num_counters] = i;
+            ++perf->num_counters;
+        }
+    }
+
+    if (perf->group_fd < 0)
+    {
+        perror("perf_event_open()");
+    }
+}
+
+/*
+ * Counts only while the sampler runs, so a stopped monitor adds no overhead to context switches
+ */
+static void linux_sysmon_enable_perf(linux_sysmon_perf_state_t *perf, bool enable)
+{
+    if (perf->group_fd >= 0 &&
+        ioctl(perf->group_fd, enable ? PERF_EVENT_IOC_ENABLE : PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP) < 0)
+    {
+        perror("ioctl(PERF_EVENT_IOC_ENABLE)");
+    }
+}
+
+void linux_sysmon_update_perf(linux_sysmon_perf_state_t *perf, uint64_t elapsed_ns)
+{
+    uint64_t buf[3 + LINUX_SYSMON_PERF_NUM_SUBCH];
+    uint64_t enabled;
+    uint64_t running;
+    uint64_t count;
+    uint32_t i;
+    uint8_t  subch;
+
+    if (perf->group_fd < 0)
+    {
+        return;
+    }
+
+    /* one read gets all the counters, as { nr, time_enabled, time_running, value[nr] } */
+    if (read(perf->group_fd, buf, sizeof(buf)) < (ssize_t)((3 + perf->num_counters) * sizeof(buf[0])))
+    {
+        return;
+    }
+
+    enabled = buf[1] - perf->last_enabled;
+    running = buf[2] - perf->last_running;
+    for (i = 0; i < perf->num_counters; ++i)
+    {
+        subch = perf->subch[i];
+        count = buf[3 + i] - perf->last_count[subch];
+
+        /* if the PMU was shared with other users, scale up to the time the group was enabled */
+        if (running != 0 && running < enabled)
+        {
+            count = linux_sysmon_muldiv(count, enabled, running);
+        }
+
+        perf->values[subch] = linux_sysmon_calc_rate(count, linux_sysmon_perf_counters[subch].scale, elapsed_ns);
+
+        perf->last_count[subch] = buf[3 + i];
+    }
+    perf->last_enabled = buf[1];
+    perf->last_running = buf[2];
+}
+
+/*
+ * Finds the directory of the cgroup v2 hierarchy which this process is in
+ *
+ * This is the cgroup2 mount point from /proc/self/mountinfo followed by the
+ * path from the "0::" line of /proc/self/cgroup.  Inside a container with its
+ * own cgroup namespace, the path is just "/".
+ */
+static int linux_sysmon_find_cgroup(char *dir, size_t dir_size)
+{
+    char   line[PATH_MAX + 256];
+    char   mount_point[PATH_MAX];
+    char * p;
+    FILE * fp;
+    size_t len;
+    int    field;
+
+    mount_point[0] = 0;
+    fp             = fopen("/proc/self/mountinfo", "r");
+    if (fp == NULL)
+    {
+        return -1;
+    }
+    while (mount_point[0] == 0 && fgets(line, sizeof(line), fp) != NULL)
+    {
+        /* the mount point is field 5, and the filesystem type follows the " - " separator */
+        if (strstr(line, " - cgroup2 ") == NULL)
+        {
+            continue;
+        }
+        p = line;
+        for (field = 1; field < 5 && p != NULL; ++field)
+        {
+            p = strchr(p, ' ');
+            if (p != NULL)
+            {
+                ++p;
+            }
+        }
+        if (p != NULL)
+        {
+            snprintf(mount_point, sizeof(mount_point), "%.*s", (int)strcspn(p, " "), p);
+        }
+    }
+    fclose(fp);
+
+    if (mount_point[0] == 0)
+    {
+        return -1;
+    }
+
+    fp = fopen("/proc/self/cgroup", "r");
+    if (fp == NULL)
+    {
+        return -1;
+    }
+    p = NULL;
+    while (fgets(line, sizeof(line), fp) != NULL)
+    {
+        if (strncmp(line, "0::", 3) == 0)
+        {
+            p   = &line[3];
+            len = strcspn(p, "\n");
+            while (len > 0 && p[len - 1] == '/')
+            {
+                --len;
+            }
+            p[len] = 0;
+            break;
+        }
+    }
+    fclose(fp);
+
+    if (p == NULL || snprintf(dir, dir_size, "%s%s", mount_point, p) >= (int)dir_size)
+    {
+        return -1;
+    }
+
+    return 0;
+}
+
+static void linux_sysmon_open_cgroup(linux_sysmon_cgroup_state_t *cgroup)
+{
+    char dir[PATH_MAX];
+    char path[PATH_MAX + 32];
+    bool has_cgroup;
+    int  i;
+
+    has_cgroup                = (linux_sysmon_find_cgroup(dir, sizeof(dir)) == 0);
+    cgroup->cpu_stat_fd       = -1;
+    cgroup->memory_current_fd = -1;
+    if (has_cgroup)
+    {
+        snprintf(path, sizeof(path), "%s/cpu.stat", dir);
+        cgroup->cpu_stat_fd = open(path, O_RDONLY | O_CLOEXEC);
+        snprintf(path, sizeof(path), "%s/memory.current", dir);
+        cgroup->memory_current_fd = open(path, O_RDONLY | O_CLOEXEC);
+    }
+
+    /* the pressure of the cgroup if it is available, otherwise that of the whole system */
+    for (i = 0; i < LINUX_SYSMON_PSI_NUM_RESOURCES; ++i)
+    {
+        cgroup->psi_fd[i] = -1;
+        if (has_cgroup)
+        {
+            snprintf(path, sizeof(path), "%s/%s.pressure", dir, linux_sysmon_psi_resources[i]);
+            cgroup->psi_fd[i] = open(path, O_RDONLY | O_CLOEXEC);
+        }
+        if (cgroup->psi_fd[i] < 0)
+        {
+            snprintf(path, sizeof(path), "/proc/pressure/%s", linux_sysmon_psi_resources[i]);
+            cgroup->psi_fd[i] = open(path, O_RDONLY | O_CLOEXEC);
+        }
+    }
+
+    if (cgroup->cpu_stat_fd < 0 && cgroup->psi_fd[0] < 0)
+    {
+        OS_printf("CFE_PSP(linux_sysmon): No cgroup v2 or pressure stall information available\n");
+    }
+}
+
+static void linux_sysmon_close_cgroup(linux_sysmon_cgroup_state_t *cgroup)
+{
+    int i;
+
+    for (i = 0; i < LINUX_SYSMON_PSI_NUM_RESOURCES; ++i)
+    {
+        if (cgroup->psi_fd[i] >= 0)
+        {
+            close(cgroup->psi_fd[i]);
+        }
+        cgroup->psi_fd[i] = -1;
+    }
+    if (cgroup->cpu_stat_fd >= 0)
+    {
+        close(cgroup->cpu_stat_fd);
+    }
+    if (cgroup->memory_current_fd >= 0)
+    {
+        close(cgroup->memory_current_fd);
+    }
+    cgroup->cpu_stat_fd       = -1;
+    cgroup->memory_current_fd = -1;
+}
+
+/*
+ * Reads the whole of a small file which is kept open, returning false if it could not be read
+ */
+static bool linux_sysmon_pread_file(int fd, char *buf, size_t size)
+{
+    ssize_t len;
+
+    if (fd < 0)
+    {
+        return false;
+    }
+
+    len = pread(fd, buf, size - 1, 0);
+    if (len <= 0)
+    {
+        return false;
+    }
+
+    buf[len] = 0;
+    return true;
+}
+
+/*
+ * Finds a value in the text of a cgroup or pressure file
+ *
+ * This finds the line starting with "key", and then the number following
+ * "field" on that line, or directly following the key if field is NULL.
+ * This covers both the "key value" lines of cpu.stat and the
+ * "some avg10=... total=value" lines of the pressure files.
+ */
+static bool linux_sysmon_find_value(const char *buf, const char *key, const char *field, uint64_t *value)
+{
+    const char *line;
+    const char *end;
+    const char *p;
+    size_t      key_len;
+    size_t      field_len;
+
+    key_len = strlen(key);
+    for (line = buf; *line != 0; line = end + 1)
+    {
+        end = strchr(line, '\n');
+        if (end == NULL)
+        {
+            end = line + strlen(line);
+        }
+
+        if (strncmp(line, key, key_len) == 0 && line[key_len] == ' ')
+        {
+            p = &line[key_len];
+            if (field != NULL)
+            {
+                field_len = strlen(field);
+                while (p < end && strncmp(p, field, field_len) != 0)
+                {
+                    ++p;
+                }
+                if (p >= end)
+                {
+                    return false;
+                }
+                p += field_len;
+            }
+
+            *value = strtoull(p, NULL, 10);
+            return true;
+        }
+
+        if (*end == 0)
+        {
+            break;
+        }
+    }
+
+    return false;
+}
+
+void linux_sysmon_update_cgroup(linux_sysmon_cgroup_state_t *cgroup, uint64_t elapsed_ns)
+{
+    static const char *const psi_lines[2] = {"some", "full"};
+
+    char     buf[1024];
+    uint64_t value;
+    uint64_t nr_periods;
+    uint64_t nr_throttled;
+    uint32_t subch;
+    int      i;
+    int      j;
+
+    /*
+     * The stall totals and CPU times are in microseconds, and 1000000 us per second
+     * is 10000 hundredths of a percent, so the rate is us * 10^7 per nanosecond
+     */
+    cgroup->psi_valid = 0;
+    for (i = 0; i < LINUX_SYSMON_PSI_NUM_RESOURCES; ++i)
+    {
+        if (!linux_sysmon_pread_file(cgroup->psi_fd[i], buf, sizeof(buf)))
+        {
+            continue;
+        }
+        for (j = 0; j < 2; ++j)
+        {
+            subch = (i * 2) + j;
+            if (linux_sysmon_find_value(buf, psi_lines[j], "total=", &value))
+            {
+                cgroup->psi_values[subch] =
+                    linux_sysmon_calc_rate(value - cgroup->last_stall_us[subch], 10000000, elapsed_ns);
+                cgroup->last_stall_us[subch] = value;
+                cgroup->psi_valid |= 1 << subch;
+            }
+        }
+    }
+
+    cgroup->cgroup_valid = 0;
+    if (linux_sysmon_pread_file(cgroup->cpu_stat_fd, buf, sizeof(buf)))
+    {
+        if (linux_sysmon_find_value(buf, "usage_usec", NULL, &value))
+        {
+            cgroup->cgroup_values[LINUX_SYSMON_CGROUP_CPU_USAGE_SUBCH] =
+                linux_sysmon_calc_rate(value - cgroup->last_usage_us, 10000000, elapsed_ns);
+            cgroup->last_usage_us = value;
+            cgroup->cgroup_valid |= 1 << LINUX_SYSMON_CGROUP_CPU_USAGE_SUBCH;
+        }
+
+        /* these are only present with the cpu controller enabled */
+        if (linux_sysmon_find_value(buf, "throttled_usec", NULL, &value))
+        {
+            cgroup->cgroup_values[LINUX_SYSMON_CGROUP_THROTTLED_TIME_SUBCH] =
+                linux_sysmon_calc_rate(value - cgroup->last_throttled_us, 10000000, elapsed_ns);
+            cgroup->last_throttled_us = value;
+            cgroup->cgroup_valid |= 1 << LINUX_SYSMON_CGROUP_THROTTLED_TIME_SUBCH;
+        }
+        if (linux_sysmon_find_value(buf, "nr_periods", NULL, &nr_periods) &&
+            linux_sysmon_find_value(buf, "nr_throttled", NULL, &nr_throttled))
+        {
+            if (elapsed_ns == 0 || nr_periods == cgroup->last_nr_periods)
+            {
+                value = 0;
+            }
+            else
+            {
+                value = ((nr_throttled - cgroup->last_nr_throttled) * 10000) / (nr_periods - cgroup->last_nr_periods);
+            }
+            cgroup->cgroup_values[LINUX_SYSMON_CGROUP_THROTTLED_PER_SUBCH] = value;
+            cgroup->last_nr_periods                                        = nr_periods;
+            cgroup->last_nr_throttled                                      = nr_throttled;
+            cgroup->cgroup_valid |= 1 << LINUX_SYSMON_CGROUP_THROTTLED_PER_SUBCH;
+        }
+    }
+
+    if (linux_sysmon_pread_file(cgroup->memory_current_fd, buf, sizeof(buf)))
+    {
+        value = strtoull(buf, NULL, 10) / 1024;
+        if (value > 0xFFFFFF)
+        {
+            value = 0xFFFFFF;
+        }
+        cgroup->cgroup_values[LINUX_SYSMON_CGROUP_MEMORY_SUBCH] = value;
+        cgroup->cgroup_valid |= 1 << LINUX_SYSMON_CGROUP_MEMORY_SUBCH;
+    }
+}
+
+/*
+ * Maps the record file and starts recording into it, if one is configured
+ *
+ * Recording is optional, so on failure the sampler runs without it.  Samples
+ * already in the file are kept if it has the same number of entries.
+ */
+static void linux_sysmon_open_record(linux_sysmon_record_state_t *record)
+{
+    const char *path;
+    void *      map;
+    int         fd;
+
+    path = linux_sysmon_global.config.record_file;
+    if (path[0] == 0)
+    {
+        return;
+    }
+
+    record->map_size = sizeof(CFE_PSP_SysmonRecordHeader_t) +
+                       ((size_t)linux_sysmon_global.config.record_entries * sizeof(CFE_PSP_SysmonRecordEntry_t));
+
+    fd = open(path, O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+    if (fd < 0)
+    {
+        perror(path);
+        return;
+    }
+
+    if (ftruncate(fd, record->map_size) < 0)
+    {
+        perror("ftruncate(record_file)");
+    }
+    else
+    {
+        map = mmap(NULL, record->map_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, 0);
+        if (map == MAP_FAILED)
+        {
+            perror("mmap(record_file)");
+        }
+        else if (CFE_PSP_SysmonRecord_Attach(&record->recorder, map, record->map_size, "linux_sysmon",
+                                             linux_sysmon_subsystem_names) != CFE_PSP_SUCCESS)
+        {
+            munmap(map, record->map_size);
+        }
+        else
+        {
+            record->map = map;
+        }
+    }
+
+    /* the mapping keeps the file open */
+    close(fd);
+}
+
+static void linux_sysmon_close_record(linux_sysmon_record_state_t *record)
+{
+    if (record->map != NULL)
+    {
+        CFE_PSP_SysmonRecord_Detach(&record->recorder);
+        munmap(record->map, record->map_size);
+        record->map = NULL;
+    }
+}
+
+/*
+ * Records every channel of a published snapshot
+ *
+ * Channels which are not available, such as offline CPUs, free task slots
+ * and counters which could not be opened, are skipped.
+ */
+static void linux_sysmon_record(linux_sysmon_cpuload_state_t *state, const linux_sysmon_snapshot_t *snap)
+{
+    CFE_PSP_SysmonRecorder_t *recorder;
+    uint32_t                  cpu;
+    uint16_t                  subsys;
+    uint16_t                  i;
+    int                       w;
+
+    recorder = &state->record.recorder;
+    if (state->record.map == NULL)
+    {
+        return;
+    }
+
+    CFE_PSP_SysmonRecord_BeginSample(recorder);
+
+    for (w = 0; w <= LINUX_SYSMON_NUM_AVG_WINDOWS; ++w)
+    {
+        CFE_PSP_SysmonRecord_Add(recorder, LINUX_SYSMON_AGGREGATE_SUBSYS, w, snap->aggregate_load[w]);
+    }
+
+    for (w = 0; w <= LINUX_SYSMON_NUM_AVG_WINDOWS; ++w)
+    {
+        subsys = (w == 0) ? LINUX_SYSMON_CPULOAD_SUBSYS : (LINUX_SYSMON_CPUAVG_1S_SUBSYS + w - 1);
+        for (cpu = 0; cpu < snap->num_cpus; ++cpu)
+        {
+            if (state->per_core[cpu].last_sample == state->num_samples)
+            {
+                CFE_PSP_SysmonRecord_Add(recorder, subsys, cpu, snap->cpu_load[(w * state->max_cpus) + cpu]);
+            }
+        }
+    }
+
+    for (i = 0; i < snap->num_task_slots; ++i)
+    {
+        if (snap->task_name[i][0] != 0)
+        {
+            CFE_PSP_SysmonRecord_Add(recorder, LINUX_SYSMON_TASKLOAD_SUBSYS, i, snap->task_load[i]);
+        }
+    }
+
+    if (state->memory.statm_fd >= 0)
+    {
+        for (i = 0; i < LINUX_SYSMON_MEM_NUM_SUBCH; ++i)
+        {
+            CFE_PSP_SysmonRecord_Add(recorder, LINUX_SYSMON_MEMORY_SUBSYS, i, snap->memory[i]);
+        }
+    }
+
+    for (i = 0; i < LINUX_SYSMON_PERF_NUM_SUBCH; ++i)
+    {
+        if (linux_sysmon_global.perf.fd[i] >= 0)
+        {
+            CFE_PSP_SysmonRecord_Add(recorder, LINUX_SYSMON_PERF_SUBSYS, i, snap->perf[i]);
+        }
+    }
+
+    for (i = 0; i < LINUX_SYSMON_PSI_NUM_SUBCH; ++i)
+    {
+        if (snap->psi_valid & (1U << i))
+        {
+            CFE_PSP_SysmonRecord_Add(recorder, LINUX_SYSMON_PRESSURE_SUBSYS, i, snap->psi[i]);
+        }
+    }
+
+    for (i = 0; i < LINUX_SYSMON_CGROUP_NUM_SUBCH; ++i)
+    {
+        if (snap->cgroup_valid & (1U << i))
+        {
+            CFE_PSP_SysmonRecord_Add(recorder, LINUX_SYSMON_CGROUP_SUBSYS, i, snap->cgroup[i]);
+        }
+    }
+
+    CFE_PSP_SysmonRecord_EndSample(recorder);
+}
+
+/*
+ * Reads a channel of the snapshot just published, for the alarms
+ *
+ * As for the recorder, channels which are not available have no value.
+ */
+static bool linux_sysmon_alarm_value(void *arg, uint16_t subsystem, uint16_t subchannel, uint32_t *value)
+{
+    linux_sysmon_cpuload_state_t * state = arg;
+    const linux_sysmon_snapshot_t *snap;
+    uint32_t                       w;
+
+    snap = &state->snapshot[state->snapshot_seq & 1];
+
+    switch (subsystem)
+    {
+        case LINUX_SYSMON_AGGREGATE_SUBSYS:
+            if (subchannel > LINUX_SYSMON_NUM_AVG_WINDOWS || snap->num_online == 0)
+            {
+                return false;
+            }
+            *value = snap->aggregate_load[subchannel];
+            break;
+        case LINUX_SYSMON_CPULOAD_SUBSYS:
+        case LINUX_SYSMON_CPUAVG_1S_SUBSYS:
+        case LINUX_SYSMON_CPUAVG_10S_SUBSYS:
+        case LINUX_SYSMON_CPUAVG_60S_SUBSYS:
+            if (subchannel >= snap->num_cpus || state->per_core[subchannel].last_sample != state->num_samples)
+            {
+                return false;
+            }
+            w      = (subsystem == LINUX_SYSMON_CPULOAD_SUBSYS) ? 0 : (1 + subsystem - LINUX_SYSMON_CPUAVG_1S_SUBSYS);
+            *value = snap->cpu_load[(w * state->max_cpus) + subchannel];
+            break;
+        case LINUX_SYSMON_TASKLOAD_SUBSYS:
+            if (subchannel >= snap->num_task_slots || snap->task_name[subchannel][0] == 0)
+            {
+                return false;
+            }
+            *value = snap->task_load[subchannel];
+            break;
+        case LINUX_SYSMON_MEMORY_SUBSYS:
+            if (subchannel >= LINUX_SYSMON_MEM_NUM_SUBCH || state->memory.statm_fd < 0)
+            {
+                return false;
+            }
+            *value = snap->memory[subchannel];
+            break;
+        case LINUX_SYSMON_PERF_SUBSYS:
+            if (subchannel >= LINUX_SYSMON_PERF_NUM_SUBCH || linux_sysmon_global.perf.fd[subchannel] < 0)
+            {
+                return false;
+            }
+            *value = snap->perf[subchannel];
+            break;
+        case LINUX_SYSMON_PRESSURE_SUBSYS:
+            if (subchannel >= LINUX_SYSMON_PSI_NUM_SUBCH || (snap->psi_valid & (1U << subchannel)) == 0)
+            {
+                return false;
+            }
+            *value = snap->psi[subchannel];
+            break;
+        case LINUX_SYSMON_CGROUP_SUBSYS:
+            if (subchannel >= LINUX_SYSMON_CGROUP_NUM_SUBCH || (snap->cgroup_valid & (1U << subchannel)) == 0)
+            {
+                return false;
+            }
+            *value = snap->cgroup[subchannel];
+            break;
+        default:
+            return false;
+    }
+
+    return true;
+}
+
+/*
+ * Publishes the values of the sample just taken to readers
+ *
+ * This is only called from the sampler thread.
+ */
+static void linux_sysmon_publish(linux_sysmon_cpuload_state_t *state)
+{
+    linux_sysmon_snapshot_t *    snap;
+    linux_sysmon_task_entry_t *  entry;
+    linux_sysmon_cpuload_core_t *core_p;
+    CFE_PSP_IODriver_AdcCode_t * cpu_avg;
+    uint32_t                     seq;
+    uint32_t                     cpu;
+    uint16_t                     i;
+    int                          w;
+
+    seq  = state->snapshot_seq;
+    snap = &state->snapshot[(seq + 1) & 1];
+
+    /*
+     * Readers which are still using this snapshot from two samples ago will see
+     * that the sequence number has changed, as long as that is stored first.
+     */
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+
+    for (cpu = 0; cpu < state->num_cpus; ++cpu)
+    {
+        core_p  = &state->per_core[cpu];
+        cpu_avg = &snap->cpu_load[cpu];
+        if (core_p->last_sample == state->num_samples)
+        {
+            cpu_avg[0] = core_p->avg_load;
+        }
+        else
+        {
+            cpu_avg[0] = 0;
+        }
+        for (w = 0; w < LINUX_SYSMON_NUM_AVG_WINDOWS; ++w)
+        {
+            cpu_avg += state->max_cpus;
+            if (core_p->last_sample == state->num_samples && core_p->has_avg)
+            {
+                *cpu_avg = CFE_PSP_SysmonAvg_ToLoad(core_p->avg[w]);
+            }
+            else
+            {
+                *cpu_avg = 0;
+            }
+        }
+    }
+
+    snap->num_cpus          = state->num_cpus;
+    snap->num_online        = state->num_online;
+    snap->aggregate_load[0] = state->aggregate_load;
+    for (w = 0; w < LINUX_SYSMON_NUM_AVG_WINDOWS; ++w)
+    {
+        snap->aggregate_load[1 + w] = CFE_PSP_SysmonAvg_ToLoad(state->aggregate_avg[w]);
+    }
+
+    snap->num_task_slots = state->tasks.num_slots;
+    for (i = 0; i < state->tasks.num_slots; ++i)
+    {
+        entry = &state->tasks.entries[i];
+        if (entry->tid != 0)
+        {
+            snap->task_load[i] = entry->avg_load;
+            memcpy(snap->task_name[i], entry->name, LINUX_SYSMON_TASK_NAME_LEN);
+        }
+        else
+        {
+            snap->task_load[i]    = 0;
+            snap->task_name[i][0] = 0;
+        }
+    }
+    for (; i < LINUX_SYSMON_MAX_TASKS; ++i)
+    {
+        snap->task_load[i] = 0;
+    }
+
+    memcpy(snap->memory, state->memory.values, sizeof(snap->memory));
+    memcpy(snap->perf, linux_sysmon_global.perf.values, sizeof(snap->perf));
+    snap->psi_valid    = state->cgroup.psi_valid;
+    snap->cgroup_valid = state->cgroup.cgroup_valid;
+    memcpy(snap->psi, state->cgroup.psi_values, sizeof(snap->psi));
+    memcpy(snap->cgroup, state->cgroup.cgroup_values, sizeof(snap->cgroup));
+
+    __atomic_store_n(&state->snapshot_seq, seq + 1, __ATOMIC_RELEASE);
+
+    linux_sysmon_record(state, snap);
+    CFE_PSP_SysmonAlarm_Check(&linux_sysmon_global.alarms, linux_sysmon_alarm_value, state);
+}
+
+/*
+ * Gets the latest snapshot for reading
+ *
+ * Values read from the snapshot are only valid if linux_sysmon_read_end()
+ * then returns true, otherwise the read should be repeated.
+ */
+static const linux_sysmon_snapshot_t *linux_sysmon_read_begin(linux_sysmon_cpuload_state_t *state, uint32_t *seq)
+{
+    *seq = __atomic_load_n(&state->snapshot_seq, __ATOMIC_ACQUIRE);
+    return &state->snapshot[*seq & 1];
+}
+
+static bool linux_sysmon_read_end(linux_sysmon_cpuload_state_t *state, uint32_t seq)
+{
+    /* the snapshot is only rewritten once the sequence has advanced by at least one */
+    __atomic_thread_fence(__ATOMIC_ACQUIRE);
+    return __atomic_load_n(&state->snapshot_seq, __ATOMIC_RELAXED) == seq;
+}
+
+void *linux_sysmon_Task(void *arg)
+{
+    linux_sysmon_cpuload_state_t *state = arg;
+
+    uint64_t        last_sample;
+    uint64_t        curr_sample;
+    uint64_t        next_sample;
+    uint64_t        wake;
+    struct timespec timeout;
+    struct pollfd   pfd;
+
+    curr_sample = linux_sysmon_get_time_ns();
+    next_sample = curr_sample;
+    memset(&pfd, 0, sizeof(pfd));
+    pfd.fd     = state->wake_fd;
+    pfd.events = POLLIN;
+
+    linux_sysmon_update_schedstat(state, 0);
+    linux_sysmon_update_tasks(&state->tasks, 0);
+    linux_sysmon_update_memory(&state->memory, 0);
+    linux_sysmon_update_perf(&linux_sysmon_global.perf, 0);
+    linux_sysmon_update_cgroup(&state->cgroup, 0);
+    linux_sysmon_publish(state);
+
+    /* the first sample tells linux_sysmon_Start() whether the CPUs could be read */
+    pthread_mutex_lock(&state->ready_lock);
+    state->ready_status = (state->num_cpus != 0) ? CFE_PSP_SUCCESS : CFE_PSP_ERROR;
+    state->ready        = true;
+    pthread_cond_signal(&state->ready_cond);
+    pthread_mutex_unlock(&state->ready_lock);
+
+    while (state->should_run)
+    {
+        /*
+         * Deadlines are absolute so the period does not drift with the time
+         * taken by each sample.  If a deadline was missed entirely (or the
+         * period was just shortened) this resynchronizes rather than taking
+         * a burst of samples to catch up.
+         */
+        next_sample += linux_sysmon_global.config.sample_period_ns;
+        if (next_sample <= curr_sample)
+        {
+            next_sample = curr_sample + linux_sysmon_global.config.sample_period_ns;
+        }
+
+        last_sample = linux_sysmon_get_time_ns();
+        if (next_sample > last_sample)
+        {
+            timeout.tv_sec  = (next_sample - last_sample) / 1000000000;
+            timeout.tv_nsec = (next_sample - last_sample) % 1000000000;
+            if (ppoll(&pfd, 1, &timeout, NULL) > 0)
+            {
+                /* configuration changed or stopping, recompute the deadline from the last sample */
+                if (read(state->wake_fd, &wake, sizeof(wake)) < 0)
+                {
+                    perror("read(wake_fd)");
+                }
+                next_sample = curr_sample;
+                continue;
+            }
+        }
+
+        last_sample = curr_sample;
+        curr_sample = linux_sysmon_get_time_ns();
+        linux_sysmon_update_schedstat(state, curr_sample - last_sample);
+        linux_sysmon_update_tasks(&state->tasks, curr_sample - last_sample);
+        linux_sysmon_update_memory(&state->memory, curr_sample - last_sample);
+        linux_sysmon_update_perf(&linux_sysmon_global.perf, curr_sample - last_sample);
+        linux_sysmon_update_cgroup(&state->cgroup, curr_sample - last_sample);
+        linux_sysmon_publish(state);
+    }
+
+    return NULL;
+}
+
+/*
+ * Waits for the sampler to take its first sample, and returns its status
+ */
+static int32_t linux_sysmon_wait_ready(linux_sysmon_cpuload_state_t *state)
+{
+    struct timespec deadline;
+    int32_t         StatusCode;
+    int             rc;
+
+    clock_gettime(CLOCK_MONOTONIC, &deadline);
+    deadline.tv_sec += LINUX_SYSMON_START_TIMEOUT_MS / 1000;
+    deadline.tv_nsec += (LINUX_SYSMON_START_TIMEOUT_MS % 1000) * 1000000;
+    if (deadline.tv_nsec >= 1000000000)
+    {
+        deadline.tv_nsec -= 1000000000;
+        ++deadline.tv_sec;
+    }
+
+    rc = 0;
+    pthread_mutex_lock(&state->ready_lock);
+    while (!state->ready && rc == 0)
+    {
+        rc = pthread_cond_timedwait(&state->ready_cond, &state->ready_lock, &deadline);
+    }
+    if (state->ready)
+    {
+        StatusCode = state->ready_status;
+    }
+    else
+    {
+        StatusCode = CFE_PSP_ERROR_TIMEOUT;
+    }
+    pthread_mutex_unlock(&state->ready_lock);
+
+    return StatusCode;
+}
+
+/*
+ * Stops the sampler and waits for it to exit
+ *
+ * The sampler only blocks in ppoll() on wake_fd, so it sees should_run
+ * once woken, and always exits between samples.
+ */
+static void linux_sysmon_join(linux_sysmon_cpuload_state_t *state)
+{
+    state->should_run = false;
+    linux_sysmon_wake(state);
+    pthread_join(state->task_id, NULL);
+}
+
+/*
+ * Releases what linux_sysmon_open_base() acquired, any of the files and buffers may not be open
+ */
+static void linux_sysmon_release_base(linux_sysmon_cpuload_state_t *state)
+{
+    linux_sysmon_close_schedstat(state);
+    if (state->wake_fd >= 0)
+    {
+        close(state->wake_fd);
+    }
+    state->dev_fd  = -1;
+    state->wake_fd = -1;
+    pthread_cond_destroy(&state->ready_cond);
+    pthread_mutex_destroy(&state->ready_lock);
+}
+
+/*
+ * Acquires what the sampler cannot run without
+ *
+ * Each step is checked as it is taken, and on failure everything acquired
+ * before it is released again, so a failed start leaks nothing.
+ */
+static int linux_sysmon_open_base(linux_sysmon_cpuload_state_t *state)
+{
+    pthread_condattr_t attr;
+    int                rc;
+
+    state->dev_fd            = -1;
+    state->wake_fd           = -1;
+    state->schedstat_bufsize = sysconf(_SC_PAGESIZE);
+
+    /* the timeout is on the monotonic clock, so it is not affected by setting the time */
+    pthread_condattr_init(&attr);
+    pthread_condattr_setclock(&attr, CLOCK_MONOTONIC);
+    rc = pthread_cond_init(&state->ready_cond, &attr);
+    pthread_condattr_destroy(&attr);
+    if (rc != 0)
+    {
+        errno = rc;
+        perror("pthread_cond_init()");
+        return -1;
+    }
+
+    rc = pthread_mutex_init(&state->ready_lock, NULL);
+    if (rc != 0)
+    {
+        errno = rc;
+        perror("pthread_mutex_init()");
+        pthread_cond_destroy(&state->ready_cond);
+        return -1;
+    }
+
+    if ((state->dev_fd = open("/proc/schedstat", O_RDONLY | O_CLOEXEC)) < 0)
+    {
+        perror("open(/proc/schedstat)");
+    }
+    else if ((state->wake_fd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK)) < 0)
+    {
+        perror("eventfd()");
+    }
+    else if ((state->schedstat_buf = malloc(state->schedstat_bufsize)) == NULL)
+    {
+        perror("malloc()");
+    }
+    else if (state->per_core == NULL)
+    {
+        OS_printf("CFE_PSP(linux_sysmon): No per-core state, it could not be allocated at init\n");
+    }
+    else
+    {
+        /* the sample count starts over, so nothing from the last run is taken as current */
+        memset(state->per_core, 0, state->max_cpus * sizeof(*state->per_core));
+        return 0;
+    }
+
+    linux_sysmon_release_base(state);
+    return -1;
+}
+
+/*
+ * Releases everything opened by linux_sysmon_Start(), once the sampler is not running
+ */
+static void linux_sysmon_release(linux_sysmon_cpuload_state_t *state)
+{
+    linux_sysmon_close_tasks(&state->tasks);
+    linux_sysmon_close_memory(&state->memory);
+    linux_sysmon_enable_perf(&linux_sysmon_global.perf, false);
+    linux_sysmon_close_cgroup(&state->cgroup);
+    linux_sysmon_close_record(&state->record);
+    linux_sysmon_release_base(state);
+}
+
+/* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ * linux_sysmon_Start()
+ * ------------------------------------------------------
+ *  Starts the cpu load watcher function
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+int32_t linux_sysmon_Start(linux_sysmon_cpuload_state_t *state)
+{
+    int32_t StatusCode;
+
+    if (state->is_running)
+    {
+        /* already running, nothing to do */
+        StatusCode = CFE_PSP_SUCCESS;
+    }
+    else
+    {
+        /* start clean, but keep the per-core arrays and snapshots which readers may be using */
+        memset(state, 0, offsetof(linux_sysmon_cpuload_state_t, max_cpus));
+        StatusCode = CFE_PSP_ERROR;
+
+        if (linux_sysmon_open_base(state) == 0)
+        {
+            /* per-task monitoring is optional, the CPU load works without it */
+            state->tasks.task_dir = opendir("/proc/self/task");
+            if (state->tasks.task_dir == NULL)
+            {
+                perror("opendir(/proc/self/task)");
+            }
+
+            /* likewise for the memory statistics */
+            if (linux_sysmon_open_memory(&state->memory) < 0)
+            {
+                linux_sysmon_close_memory(&state->memory);
+            }
+
+            /* and the perf counters, which were opened at init if they are available */
+            linux_sysmon_enable_perf(&linux_sysmon_global.perf, true);
+
+            /* and the cgroup and pressure stall information */
+            linux_sysmon_open_cgroup(&state->cgroup);
+
+            /* and the recorder */
+            linux_sysmon_open_record(&state->record);
+
+            CFE_PSP_SysmonAlarm_Reset(&linux_sysmon_global.alarms);
+
             state->should_run = true;
-            if (pthread_create(&state->task_id, NULL, linux_sysmon_Task, state) < 0)
+            errno = pthread_create(&state->task_id, NULL, linux_sysmon_Task, state);
+            if (errno != 0)
             {
                 perror("pthread_create()");
 
                 /* Clean up */
                 state->should_run = false;
-                close(state->dev_fd);
+                linux_sysmon_release(state);
             }
             else
             {
-                /* wait for the "num_cpus" to become nonzero, this should be
-                 * initialized in the first sample taken by the worker task */
-                while (state->num_cpus == 0 && DelayCount < 100000000 /*jphfix*/)
-                {
-                    ++DelayCount;
-                    OS_TaskDelay(10);
-                }
-
-                if (state->num_cpus == 0)
+                /* the sampler reports back once the first sample is taken */
+                StatusCode = linux_sysmon_wait_ready(state);
+                if (StatusCode != CFE_PSP_SUCCESS)
                 {
-                    OS_printf("CFE_PSP(Linux_SysMon): Failed to detect number of CPUs\n");
+                    if (StatusCode == CFE_PSP_ERROR_TIMEOUT)
+                    {
+                        OS_printf("CFE_PSP(Linux_SysMon): No first sample within %u ms\n",
+                                  (unsigned int)LINUX_SYSMON_START_TIMEOUT_MS);
+                    }
+                    else
+                    {
+                        OS_printf("CFE_PSP(Linux_SysMon): Failed to detect number of CPUs\n");
+                    }
 
                     /* Clean up */
-                    state->should_run = false;
-                    pthread_cancel(state->task_id);
-                    pthread_join(state->task_id, NULL);
-                    close(state->dev_fd);
+                    linux_sysmon_join(state);
+                    linux_sysmon_release(state);
                 }
                 else
                 {
-                    OS_printf("CFE_PSP(Linux_SysMon): Started CPU utilization monitoring on %u CPU(s)\n",
-                              (unsigned int)state->num_cpus);
+                    OS_printf("CFE_PSP(Linux_SysMon): Started CPU utilization monitoring on %u CPU(s), every %u ms\n",
+                              (unsigned int)state->num_online,
+                              (unsigned int)(linux_sysmon_global.config.sample_period_ns / 1000000));
 
-                    StatusCode        = CFE_PSP_SUCCESS;
                     state->is_running = true;
                 }
             }
@@ -371,37 +2362,49 @@ int32_t linux_sysmon_Stop(linux_sysmon_cpuload_state_t *state)
 {
     if (state->is_running)
     {
-        state->should_run = false;
         state->is_running = false;
-        pthread_cancel(state->task_id);
-        pthread_join(state->task_id, NULL);
-        close(state->dev_fd);
+        linux_sysmon_join(state);
+        linux_sysmon_release(state);
     }
 
     return CFE_PSP_SUCCESS;
 }
 
-int32_t linux_sysmon_calc_aggregate_cpu(linux_sysmon_cpuload_state_t *state, CFE_PSP_IODriver_AdcCode_t *Val)
+/*
+ * Reads the aggregate load, where Subchannel 0 is the current load and the
+ * subchannels after it are the averages
+ */
+int32_t linux_sysmon_calc_aggregate_cpu(linux_sysmon_cpuload_state_t *state, uint16_t Subchannel,
+                                        CFE_PSP_IODriver_AnalogRdWr_t *RdWr)
 {
-    uint8_t  cpu;
-    uint32_t sum;
+    const linux_sysmon_snapshot_t *snap;
+    uint32_t                       seq;
+    uint32_t                       num_online;
+    uint32_t                       ch;
 
-    sum = 0;
-    for (cpu = 0; cpu < state->num_cpus; ++cpu)
+    if ((Subchannel + RdWr->NumChannels) > (1 + LINUX_SYSMON_NUM_AVG_WINDOWS))
     {
-        sum += state->per_core[cpu].avg_load;
+        return CFE_PSP_ERROR_NOT_IMPLEMENTED;
     }
 
-    if (cpu == 0)
+    /* this is computed by the sampler over the CPUs which were online */
+    do
+    {
+        snap       = linux_sysmon_read_begin(state, &seq);
+        num_online = snap->num_online;
+        for (ch = 0; ch < RdWr->NumChannels; ++ch)
+        {
+            RdWr->Samples[ch] = snap->aggregate_load[Subchannel + ch];
+        }
+    } while (!linux_sysmon_read_end(state, seq));
+
+    if (num_online == 0)
     {
-        *Val = 0;
         return CFE_PSP_ERROR;
     }
 
-    /* average of all cpus */
-    sum /= cpu;
-    LINUX_SYSMON_DEBUG("CFE_PSP(linux_sysmon): Aggregate CPU load=%06x\n", (unsigned int)sum);
-    *Val = sum;
+    LINUX_SYSMON_DEBUG("CFE_PSP(linux_sysmon): Aggregate CPU load=%06x over %u CPU(s)\n",
+                       (unsigned int)snap->aggregate_load[0], (unsigned int)num_online);
 
     return CFE_PSP_SUCCESS;
 }
@@ -446,9 +2449,22 @@ int32_t linux_sysmon_aggregate_dispatch(uint32_t CommandCode, uint16_t Subchanne
             break;
         }
         case CFE_PSP_IODriver_SET_CONFIGURATION: /**< const string argument (device-dependent content) */
-        case CFE_PSP_IODriver_GET_CONFIGURATION: /**< void * argument (device-dependent content) */
         {
-            /* not implemented for now */
+            /*
+             * "sample_period_ms=<n>" sets the CPU load sample period, from 10 ms
+             * "record_file=<path>" and "record_entries=<n>" set up the recorder, while stopped
+             * "alarm=<subsystem>/<subchannel>,<low>,<high>[,<hysteresis>]" sets an alarm
+             */
+            StatusCode = linux_sysmon_set_config(state, Arg.ConstStr);
+            break;
+        }
+        case CFE_PSP_IODriver_GET_CONFIGURATION: /**< CFE_PSP_SysmonAlarmStatus_t argument */
+        {
+            if (Arg.Vptr != NULL)
+            {
+                CFE_PSP_SysmonAlarm_GetStatus(&linux_sysmon_global.alarms, Arg.Vptr);
+                StatusCode = CFE_PSP_SUCCESS;
+            }
             break;
         }
         case CFE_PSP_IODriver_LOOKUP_SUBSYSTEM: /**< const char * argument, looks up name and returns positive
@@ -497,10 +2513,7 @@ int32_t linux_sysmon_aggregate_dispatch(uint32_t CommandCode, uint16_t Subchanne
         {
             CFE_PSP_IODriver_AnalogRdWr_t *RdWr = Arg.Vptr;
 
-            if (RdWr->NumChannels == 1 && Subchannel == LINUX_SYSMON_AGGR_CPULOAD_SUBCH)
-            {
-                StatusCode = linux_sysmon_calc_aggregate_cpu(state, RdWr->Samples);
-            }
+            StatusCode = linux_sysmon_calc_aggregate_cpu(state, Subchannel, RdWr);
             break;
         }
         default:
@@ -510,7 +2523,12 @@ int32_t linux_sysmon_aggregate_dispatch(uint32_t CommandCode, uint16_t Subchanne
     return StatusCode;
 }
 
-int32_t linux_sysmon_cpu_load_dispatch(uint32_t CommandCode, uint16_t Subchannel, CFE_PSP_IODriver_Arg_t Arg)
+/*
+ * The per-cpu subsystems share this, where window 0 is the current load and
+ * the others are the averages over each of linux_sysmon_avg_window_ms
+ */
+int32_t linux_sysmon_cpu_load_dispatch(uint32_t CommandCode, uint16_t Subchannel, CFE_PSP_IODriver_Arg_t Arg,
+                                       uint32_t window)
 {
     int32_t                       StatusCode;
     linux_sysmon_cpuload_state_t *state;
@@ -531,19 +2549,354 @@ int32_t linux_sysmon_cpu_load_dispatch(uint32_t CommandCode, uint16_t Subchannel
             break;
         }
         case CFE_PSP_IODriver_ANALOG_IO_READ_CHANNELS:
+        {
+            CFE_PSP_IODriver_AnalogRdWr_t *RdWr = Arg.Vptr;
+            const linux_sysmon_snapshot_t *snap;
+            const CFE_PSP_IODriver_AdcCode_t *cpu_load;
+            uint32_t                       seq;
+            uint32_t                       ch;
+
+            do
+            {
+                snap = linux_sysmon_read_begin(state, &seq);
+                if (Subchannel < snap->num_cpus && (Subchannel + RdWr->NumChannels) <= snap->num_cpus)
+                {
+                    /* max_cpus and the arrays are fixed from init, and num_cpus is zero while stopped */
+                    cpu_load = &snap->cpu_load[(window * state->max_cpus) + Subchannel];
+                    for (ch = 0; ch < RdWr->NumChannels; ++ch)
+                    {
+                        RdWr->Samples[ch] = cpu_load[ch];
+                    }
+                    StatusCode = CFE_PSP_SUCCESS;
+                }
+            } while (!linux_sysmon_read_end(state, seq));
+            break;
+        }
+        default:
+            break;
+    }
+
+    return StatusCode;
+}
+
+int32_t linux_sysmon_task_load_dispatch(uint32_t CommandCode, uint16_t Subchannel, CFE_PSP_IODriver_Arg_t Arg)
+{
+    int32_t                        StatusCode;
+    linux_sysmon_cpuload_state_t * state;
+    const linux_sysmon_snapshot_t *snap;
+    uint32_t                       seq;
+
+    /* There is just one global cpuload object */
+    state      = &linux_sysmon_global.cpu_load;
+    StatusCode = CFE_PSP_ERROR_NOT_IMPLEMENTED;
+    switch (CommandCode)
+    {
+        case CFE_PSP_IODriver_NOOP:
+        case CFE_PSP_IODriver_ANALOG_IO_NOOP:
+        {
+            StatusCode = CFE_PSP_SUCCESS;
+            break;
+        }
+        case CFE_PSP_IODriver_LOOKUP_SUBCHANNEL: /**< const char * argument, looks up task name and returns positive
+                                                    value for channel number, negative value for error */
+        {
+            uint16_t i;
+
+            /*
+             * Thread names are truncated to the kernel limit, so only compare that much.
+             * The subchannel remains valid for as long as the task exists.
+             */
+            do
+            {
+                snap       = linux_sysmon_read_begin(state, &seq);
+                StatusCode = CFE_PSP_ERROR;
+                for (i = 0; i < snap->num_task_slots; ++i)
+                {
+                    if (snap->task_name[i][0] != 0 &&
+                        strncmp(Arg.ConstStr, snap->task_name[i], LINUX_SYSMON_TASK_NAME_LEN - 1) == 0)
+                    {
+                        StatusCode = i;
+                        break;
+                    }
+                }
+            } while (!linux_sysmon_read_end(state, seq));
+            break;
+        }
+        case CFE_PSP_IODriver_ANALOG_IO_READ_CHANNELS:
+        {
+            CFE_PSP_IODriver_AnalogRdWr_t *RdWr = Arg.Vptr;
+            uint32_t                       ch;
+
+            /* Slots without a task read as zero load */
+            if ((Subchannel + RdWr->NumChannels) <= LINUX_SYSMON_MAX_TASKS)
+            {
+                do
+                {
+                    snap = linux_sysmon_read_begin(state, &seq);
+                    for (ch = 0; ch < RdWr->NumChannels; ++ch)
+                    {
+                        RdWr->Samples[ch] = snap->task_load[Subchannel + ch];
+                    }
+                } while (!linux_sysmon_read_end(state, seq));
+                StatusCode = CFE_PSP_SUCCESS;
+            }
+            break;
+        }
+        default:
+            break;
+    }
+
+    return StatusCode;
+}
+
+int32_t linux_sysmon_memory_dispatch(uint32_t CommandCode, uint16_t Subchannel, CFE_PSP_IODriver_Arg_t Arg)
+{
+    int32_t                        StatusCode;
+    linux_sysmon_cpuload_state_t * state;
+    const linux_sysmon_snapshot_t *snap;
+    uint32_t                       seq;
+
+    /* There is just one global cpuload object */
+    state      = &linux_sysmon_global.cpu_load;
+    StatusCode = CFE_PSP_ERROR_NOT_IMPLEMENTED;
+    switch (CommandCode)
+    {
+        case CFE_PSP_IODriver_NOOP:
+        case CFE_PSP_IODriver_ANALOG_IO_NOOP:
+        {
+            StatusCode = CFE_PSP_SUCCESS;
+            break;
+        }
+        case CFE_PSP_IODriver_LOOKUP_SUBCHANNEL: /**< const char * argument, looks up name and returns positive
+                                                    value for channel number, negative value for error */
+        {
+            uint16_t i;
+
+            for (i = 0; linux_sysmon_memory_subchannel_names[i] != NULL; ++i)
+            {
+                if (strcmp(Arg.ConstStr, linux_sysmon_memory_subchannel_names[i]) == 0)
+                {
+                    StatusCode = i;
+                    break;
+                }
+            }
+            break;
+        }
+        case CFE_PSP_IODriver_ANALOG_IO_READ_CHANNELS:
+        {
+            CFE_PSP_IODriver_AnalogRdWr_t *RdWr = Arg.Vptr;
+            uint32_t                       ch;
+
+            if ((Subchannel + RdWr->NumChannels) <= LINUX_SYSMON_MEM_NUM_SUBCH)
+            {
+                do
+                {
+                    snap = linux_sysmon_read_begin(state, &seq);
+                    for (ch = 0; ch < RdWr->NumChannels; ++ch)
+                    {
+                        RdWr->Samples[ch] = snap->memory[Subchannel + ch];
+                    }
+                } while (!linux_sysmon_read_end(state, seq));
+                StatusCode = CFE_PSP_SUCCESS;
+            }
+            break;
+        }
+        default:
+            break;
+    }
+
+    return StatusCode;
+}
+
+int32_t linux_sysmon_perf_dispatch(uint32_t CommandCode, uint16_t Subchannel, CFE_PSP_IODriver_Arg_t Arg)
+{
+    int32_t                        StatusCode;
+    linux_sysmon_cpuload_state_t * state;
+    const linux_sysmon_snapshot_t *snap;
+    uint32_t                       seq;
+
+    /* There is just one global cpuload object */
+    state      = &linux_sysmon_global.cpu_load;
+    StatusCode = CFE_PSP_ERROR_NOT_IMPLEMENTED;
+    switch (CommandCode)
+    {
+        case CFE_PSP_IODriver_NOOP:
+        case CFE_PSP_IODriver_ANALOG_IO_NOOP:
+        {
+            StatusCode = CFE_PSP_SUCCESS;
+            break;
+        }
+        case CFE_PSP_IODriver_LOOKUP_SUBCHANNEL: /**< const char * argument, looks up name and returns positive
+                                                    value for channel number, negative value for error */
+        {
+            uint16_t i;
+
+            for (i = 0; linux_sysmon_perf_subchannel_names[i] != NULL; ++i)
+            {
+                if (strcmp(Arg.ConstStr, linux_sysmon_perf_subchannel_names[i]) == 0)
+                {
+                    StatusCode = i;
+                    break;
+                }
+            }
+            break;
+        }
+        case CFE_PSP_IODriver_ANALOG_IO_READ_CHANNELS:
+        {
+            CFE_PSP_IODriver_AnalogRdWr_t *RdWr = Arg.Vptr;
+            uint32_t                       ch;
+
+            if ((Subchannel + RdWr->NumChannels) <= LINUX_SYSMON_PERF_NUM_SUBCH)
+            {
+                /* the set of counters is fixed at init, and any which the kernel did not allow is an error */
+                StatusCode = CFE_PSP_SUCCESS;
+                for (ch = 0; ch < RdWr->NumChannels; ++ch)
+                {
+                    if (linux_sysmon_global.perf.fd[Subchannel + ch] < 0)
+                    {
+                        StatusCode = CFE_PSP_ERROR;
+                    }
+                }
+
+                do
+                {
+                    snap = linux_sysmon_read_begin(state, &seq);
+                    for (ch = 0; ch < RdWr->NumChannels; ++ch)
+                    {
+                        RdWr->Samples[ch] = snap->perf[Subchannel + ch];
+                    }
+                } while (!linux_sysmon_read_end(state, seq));
+            }
+            break;
+        }
+        default:
+            break;
+    }
+
+    return StatusCode;
+}
+
+int32_t linux_sysmon_pressure_dispatch(uint32_t CommandCode, uint16_t Subchannel, CFE_PSP_IODriver_Arg_t Arg)
+{
+    int32_t                        StatusCode;
+    linux_sysmon_cpuload_state_t * state;
+    const linux_sysmon_snapshot_t *snap;
+    uint32_t                       seq;
+
+    /* There is just one global cpuload object */
+    state      = &linux_sysmon_global.cpu_load;
+    StatusCode = CFE_PSP_ERROR_NOT_IMPLEMENTED;
+    switch (CommandCode)
+    {
+        case CFE_PSP_IODriver_NOOP:
+        case CFE_PSP_IODriver_ANALOG_IO_NOOP:
+        {
+            StatusCode = CFE_PSP_SUCCESS;
+            break;
+        }
+        case CFE_PSP_IODriver_LOOKUP_SUBCHANNEL: /**< const char * argument, looks up name and returns positive
+                                                    value for channel number, negative value for error */
+        {
+            uint16_t i;
+
+            for (i = 0; linux_sysmon_psi_subchannel_names[i] != NULL; ++i)
+            {
+                if (strcmp(Arg.ConstStr, linux_sysmon_psi_subchannel_names[i]) == 0)
+                {
+                    StatusCode = i;
+                    break;
+                }
+            }
+            break;
+        }
+        case CFE_PSP_IODriver_ANALOG_IO_READ_CHANNELS:
         {
             CFE_PSP_IODriver_AnalogRdWr_t *RdWr = Arg.Vptr;
             uint32_t                       ch;
 
-            if (Subchannel < state->num_cpus && (Subchannel + RdWr->NumChannels) <= state->num_cpus)
+            if ((Subchannel + RdWr->NumChannels) <= LINUX_SYSMON_PSI_NUM_SUBCH)
+            {
+                /* values which are not in the kernel, such as "cpu-full" before Linux 5.13, are an error */
+                do
+                {
+                    snap       = linux_sysmon_read_begin(state, &seq);
+                    StatusCode = CFE_PSP_SUCCESS;
+                    for (ch = 0; ch < RdWr->NumChannels; ++ch)
+                    {
+                        RdWr->Samples[ch] = snap->psi[Subchannel + ch];
+                        if ((snap->psi_valid & (1 << (Subchannel + ch))) == 0)
+                        {
+                            StatusCode = CFE_PSP_ERROR;
+                        }
+                    }
+                } while (!linux_sysmon_read_end(state, seq));
+            }
+            break;
+        }
+        default:
+            break;
+    }
+
+    return StatusCode;
+}
+
+int32_t linux_sysmon_cgroup_dispatch(uint32_t CommandCode, uint16_t Subchannel, CFE_PSP_IODriver_Arg_t Arg)
+{
+    int32_t                        StatusCode;
+    linux_sysmon_cpuload_state_t * state;
+    const linux_sysmon_snapshot_t *snap;
+    uint32_t                       seq;
+
+    /* There is just one global cpuload object */
+    state      = &linux_sysmon_global.cpu_load;
+    StatusCode = CFE_PSP_ERROR_NOT_IMPLEMENTED;
+    switch (CommandCode)
+    {
+        case CFE_PSP_IODriver_NOOP:
+        case CFE_PSP_IODriver_ANALOG_IO_NOOP:
+        {
+            StatusCode = CFE_PSP_SUCCESS;
+            break;
+        }
+        case CFE_PSP_IODriver_LOOKUP_SUBCHANNEL: /**< const char * argument, looks up name and returns positive
+                                                    value for channel number, negative value for error */
+        {
+            uint16_t i;
+
+            for (i = 0; linux_sysmon_cgroup_subchannel_names[i] != NULL; ++i)
             {
-                for (ch = Subchannel; ch < (Subchannel + RdWr->NumChannels); ++ch)
+                if (strcmp(Arg.ConstStr, linux_sysmon_cgroup_subchannel_names[i]) == 0)
                 {
-                    RdWr->Samples[ch] = state->per_core[ch].avg_load;
+                    StatusCode = i;
+                    break;
                 }
             }
             break;
         }
+        case CFE_PSP_IODriver_ANALOG_IO_READ_CHANNELS:
+        {
+            CFE_PSP_IODriver_AnalogRdWr_t *RdWr = Arg.Vptr;
+            uint32_t                       ch;
+
+            if ((Subchannel + RdWr->NumChannels) <= LINUX_SYSMON_CGROUP_NUM_SUBCH)
+            {
+                /* values which are not in the cgroup, such as from a controller which is not enabled, are an error */
+                do
+                {
+                    snap       = linux_sysmon_read_begin(state, &seq);
+                    StatusCode = CFE_PSP_SUCCESS;
+                    for (ch = 0; ch < RdWr->NumChannels; ++ch)
+                    {
+                        RdWr->Samples[ch] = snap->cgroup[Subchannel + ch];
+                        if ((snap->cgroup_valid & (1 << (Subchannel + ch))) == 0)
+                        {
+                            StatusCode = CFE_PSP_ERROR;
+                        }
+                    }
+                } while (!linux_sysmon_read_end(state, seq));
+            }
+            break;
+        }
         default:
             break;
     }
@@ -551,6 +2904,17 @@ int32_t linux_sysmon_cpu_load_dispatch(uint32_t CommandCode, uint16_t Subchannel
     return StatusCode;
 }
 
+/*
+ * Start and stop open and close the /proc, perf and cgroup files and join the sampler
+ * thread, so they must not overlap each other or a configuration change.  Reads do not
+ * take the mutex, which is safe as the per-CPU arrays and snapshots outlive the sampler.
+ */
+static int32_t linux_sysmon_DevMutex(uint32_t CommandCode, uint16_t SubsystemId, uint16_t SubchannelId,
+                                     CFE_PSP_IODriver_Arg_t Arg)
+{
+    return 0;
+}
+
 /* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
 /*    linux_sysmon_DevCmd()                                         */
 /* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
@@ -582,7 +2946,28 @@ int32_t linux_sysmon_DevCmd(uint32_t CommandCode, uint16_t SubsystemId, uint16_t
             StatusCode = linux_sysmon_aggregate_dispatch(CommandCode, SubchannelId, Arg);
             break;
         case LINUX_SYSMON_CPULOAD_SUBSYS:
-            StatusCode = linux_sysmon_cpu_load_dispatch(CommandCode, SubchannelId, Arg);
+            StatusCode = linux_sysmon_cpu_load_dispatch(CommandCode, SubchannelId, Arg, 0);
+            break;
+        case LINUX_SYSMON_CPUAVG_1S_SUBSYS:
+        case LINUX_SYSMON_CPUAVG_10S_SUBSYS:
+        case LINUX_SYSMON_CPUAVG_60S_SUBSYS:
+            StatusCode = linux_sysmon_cpu_load_dispatch(CommandCode, SubchannelId, Arg,
+                                                        1 + SubsystemId - LINUX_SYSMON_CPUAVG_1S_SUBSYS);
+            break;
+        case LINUX_SYSMON_TASKLOAD_SUBSYS:
+            StatusCode = linux_sysmon_task_load_dispatch(CommandCode, SubchannelId, Arg);
+            break;
+        case LINUX_SYSMON_MEMORY_SUBSYS:
+            StatusCode = linux_sysmon_memory_dispatch(CommandCode, SubchannelId, Arg);
+            break;
+        case LINUX_SYSMON_PERF_SUBSYS:
+            StatusCode = linux_sysmon_perf_dispatch(CommandCode, SubchannelId, Arg);
+            break;
+        case LINUX_SYSMON_PRESSURE_SUBSYS:
+            StatusCode = linux_sysmon_pressure_dispatch(CommandCode, SubchannelId, Arg);
+            break;
+        case LINUX_SYSMON_CGROUP_SUBSYS:
+            StatusCode = linux_sysmon_cgroup_dispatch(CommandCode, SubchannelId, Arg);
             break;
         default:
             /* not implemented */
@@ -0,0 +1,136 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,719-1, and identified as “core Flight System: Bootes”
+ *
+ * Copyright (c) 2020 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ************************************************************************/
+
+/**
+ * \file
+ *
+ * Internal header for linux_sysmon.c
+ *
+ * Contains the /proc/schedstat parser.  This does not depend on OSAL or
+ * CFE so the same code can be used by the standalone benchmark in the
+ * "bench" subdirectory.
+ */
+
+#ifndef LINUX_SYSMON_SCHEDSTAT_H_
+#define LINUX_SYSMON_SCHEDSTAT_H_
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+
+/*
+ * Each "cpu<N>" line of /proc/schedstat contains 9 values after the CPU
+ * number, of which the 7th is the time in nanoseconds spent running tasks
+ * on that CPU.  The other lines ("version", "timestamp" and the "domain<N>"
+ * lines following each CPU) are skipped.
+ */
+#define LINUX_SYSMON_SCHEDSTAT_RUN_TIME_FIELD 7
+
+static inline const char *linux_sysmon_schedstat_skip_field(const char *pos)
+{
+    while (*pos == ' ')
+    {
+        ++pos;
+    }
+    while ((unsigned char)(*pos - '0') < 10)
+    {
+        ++pos;
+    }
+
+    return pos;
+}
+
+/**
+ * Finds the next "cpu" line in a /proc/schedstat buffer
+ *
+ * The buffer must be NUL terminated at end.  Only the CPU number and the run
+ * time are decoded, everything else is skipped in the same pass.
+ *
+ * \param pos      Position in the buffer to continue from, initially the start of the buffer
+ * \param end      End of the data in the buffer
+ * \param cpu_num  Set to the CPU number of the line found
+ * \param run_time Set to the cumulative run time in nanoseconds of the CPU
+ *
+ * \returns the position to continue from on the next call, or NULL if there are no more CPUs
+ */
+static inline const char *linux_sysmon_schedstat_next_cpu(const char *pos, const char *end, unsigned int *cpu_num,
+                                                          uint64_t *run_time)
+{
+    const char * line;
+    unsigned int field;
+    unsigned int num;
+    uint64_t     value;
+
+    while (pos < end)
+    {
+        line = pos;
+        pos  = memchr(line, '\n', end - line);
+        if (pos == NULL)
+        {
+            pos = end;
+        }
+        else
+        {
+            ++pos;
+        }
+
+        /* the NUL terminator stops these checks on a short final line */
+        if (line[0] != 'c' || line[1] != 'p' || line[2] != 'u' || (unsigned char)(line[3] - '0') >= 10)
+        {
+            continue;
+        }
+
+        line += 3;
+        num = 0;
+        while ((unsigned char)(*line - '0') < 10)
+        {
+            num = (num * 10) + (*line - '0');
+            ++line;
+        }
+
+        for (field = 1; field < LINUX_SYSMON_SCHEDSTAT_RUN_TIME_FIELD; ++field)
+        {
+            line = linux_sysmon_schedstat_skip_field(line);
+        }
+
+        while (*line == ' ')
+        {
+            ++line;
+        }
+        if ((unsigned char)(*line - '0') >= 10)
+        {
+            /* truncated line, not expected */
+            continue;
+        }
+
+        value = 0;
+        while ((unsigned char)(*line - '0') < 10)
+        {
+            value = (value * 10) + (*line - '0');
+            ++line;
+        }
+
+        *cpu_num  = num;
+        *run_time = value;
+        return pos;
+    }
+
+    return NULL;
+}
+
+#endif /* LINUX_SYSMON_SCHEDSTAT_H_ */
@@ -25,81 +25,25 @@
  ************************************************************************/
 
 #include "cfe_psp.h"
+#include "cfe_psp_sysmonalarm.h"
+#include "cfe_psp_sysmonrecord.h"
+#include "cfe_psp_sysmonutil.h"
 
 #include "iodriver_impl.h"
 #include "iodriver_analog_io.h"
 
+#include <stddef.h>
 #include <rtems.h>
 #include <rtems/cpuuse.h>
 #include <rtems/score/threadimpl.h>
 #include <rtems/rtems/tasks.h>
 
-/********************************************************************
- * Local Defines
- ********************************************************************/
-#ifdef OS_MAXIMUM_PROCESSORS
-    #define RTEMS_SYSMON_MAX_CPUS  OS_MAXIMUM_PROCESSORS
-#else
-    #define RTEMS_SYSMON_MAX_CPUS  1
-#endif
-
-#define RTEMS_SYSMON_AGGREGATE_SUBSYS   0
-#define RTEMS_SYSMON_CPULOAD_SUBSYS     1
-#define RTEMS_SYSMON_AGGR_CPULOAD_SUBCH 0
-#define RTEMS_SYSMON_SAMPLE_DELAY       1000
-#define RTEMS_SYSMON_TASK_PRIORITY      100
-#define RTEMS_SYSMON_STACK_SIZE         4096
-#define RTEMS_SYSMON_MAX_SCALE          100000
-
-#ifdef DEBUG_BUILD
-#define RTEMS_SYSMON_DEBUG(...) OS_printf(__VA_ARGS__)
-#else
-#define RTEMS_SYSMON_DEBUG(...)
-#endif
-
-/********************************************************************
- * Local Type Definitions
- ********************************************************************/
-typedef struct rtems_sysmon_cpuload_core
-{
-    CFE_PSP_IODriver_AdcCode_t avg_load;
-    Timestamp_Control last_run_time;
-    Timestamp_Control idle_last_uptime;
-
-} rtems_sysmon_cpuload_core_t;
-
-typedef struct rtems_sysmon_cpuload_state
-{
-    volatile bool is_running;
-    volatile bool should_run;
-
-    rtems_id   task_id;
-    rtems_name task_name;
-
-    uint8_t    num_cpus;
-    rtems_sysmon_cpuload_core_t per_core[RTEMS_SYSMON_MAX_CPUS];
-
-} rtems_sysmon_cpuload_state_t;
-
-typedef struct rtems_sysmon_state
-{
-    uint32_t                     local_module_id;
-    rtems_sysmon_cpuload_state_t cpu_load;
-} rtems_sysmon_state_t;
+#include "rtems_sysmon.h"
 
 /********************************************************************
  * Local Function Prototypes
  ********************************************************************/
-static void    rtems_sysmon_Init(uint32_t local_module_id);
-static int32_t rtems_sysmon_Start(rtems_sysmon_cpuload_state_t *state);
-static int32_t rtems_sysmon_Stop(rtems_sysmon_cpuload_state_t *state);
-
-int32_t rtems_sysmon_aggregate_dispatch(uint32_t CommandCode, uint16_t Subchannel, CFE_PSP_IODriver_Arg_t Arg);
-int32_t rtems_sysmon_calc_aggregate_cpu(rtems_sysmon_cpuload_state_t *state, CFE_PSP_IODriver_AdcCode_t *Val);
-
-/* Function that starts up rtems_sysmon driver. */
-static int32_t rtems_sysmon_DevCmd(uint32_t CommandCode, uint16_t SubsystemId, uint16_t SubchannelId,
-                                   CFE_PSP_IODriver_Arg_t Arg);
+static void rtems_sysmon_Init(uint32_t local_module_id);
 
 /********************************************************************
  * Global Data
@@ -108,14 +52,22 @@ static int32_t rtems_sysmon_DevCmd(uint32_t CommandCode, uint16_t SubsystemId, u
 extern Timestamp_Control CPU_usage_Uptime_at_last_reset;
 
 /* rtems_sysmon device command that is called by iodriver to start up rtems_sysmon */
-CFE_PSP_IODriver_API_t rtems_sysmon_DevApi = {.DeviceCommand = rtems_sysmon_DevCmd};
+CFE_PSP_IODriver_API_t rtems_sysmon_DevApi = {
+    .DeviceCommand     = rtems_sysmon_DevCmd,
+    .DeviceMutex       = rtems_sysmon_DevMutex,
+    .ReentrantBaseOps  = CFE_PSP_SYSMON_REENTRANT_BASE_OPS,
+    .ReentrantClassOps = CFE_PSP_SYSMON_REENTRANT_CLASS_OPS};
 
 CFE_PSP_MODULE_DECLARE_IODEVICEDRIVER(rtems_sysmon);
 
-static rtems_sysmon_state_t rtems_sysmon_global;
+rtems_sysmon_state_t rtems_sysmon_global;
+
+static const char *rtems_sysmon_subsystem_names[]  = {"aggregate",   "per-cpu",  "per-cpu-1s", "per-cpu-10s",
+                                                      "per-cpu-60s", "per-task", NULL};
+static const char *rtems_sysmon_subchannel_names[] = {"cpu-load", "cpu-load-1s", "cpu-load-10s", "cpu-load-60s", NULL};
 
-static const char *rtems_sysmon_subsystem_names[]  = {"aggregate", "per-cpu", NULL};
-static const char *rtems_sysmon_subchannel_names[] = {"cpu-load", NULL};
+/* exp(-1/1), exp(-1/10) and exp(-1/60), the fraction of each average remaining after one sample */
+static const uint32_t rtems_sysmon_avg_decay[RTEMS_SYSMON_NUM_AVG_WINDOWS] = {24109, 59299, 64453};
 
 /***********************************************************************
  * Global Functions
@@ -125,11 +77,51 @@ void rtems_sysmon_Init(uint32_t local_module_id)
     memset(&rtems_sysmon_global, 0, sizeof(rtems_sysmon_global));
 
     rtems_sysmon_global.local_module_id = local_module_id;
+
+    CFE_PSP_SysmonAlarm_Init(&rtems_sysmon_global.alarms, "rtems_sysmon", rtems_sysmon_subsystem_names);
 }
 
-static bool rtems_cpu_usage_vistor(Thread_Control *the_thread, void *arg)
+/*
+ * The only setting is "alarm=...", see cfe_psp_sysmonalarm.h
+ */
+int32_t rtems_sysmon_set_config(const char *config_str)
+{
+    const char *value_str;
+
+    if (config_str == NULL)
+    {
+        return CFE_PSP_INVALID_POINTER;
+    }
+
+    if ((value_str = CFE_PSP_SysmonConfig_GetValue(config_str, "alarm")) != NULL)
+    {
+        return CFE_PSP_SysmonAlarm_Configure(&rtems_sysmon_global.alarms, value_str);
+    }
+
+    return CFE_PSP_ERROR_NOT_IMPLEMENTED;
+}
+
+/*
+ * Gets the CPU time used by a thread since the CPU usage was last reset
+ */
+static Timestamp_Control rtems_sysmon_get_cpu_time(Thread_Control *the_thread)
+{
+    Timestamp_Control cpu_time;
+
+#if __RTEMS_MAJOR__ == 5
+    _Thread_Get_CPU_time_used(the_thread, &cpu_time);
+#else /* RTEMS 6 */
+    cpu_time = _Thread_Get_CPU_time_used_after_last_reset(the_thread);
+#endif
+
+    return cpu_time;
+}
+
+/*
+ * Calculates the load of the next CPU from its IDLE thread
+ */
+static void rtems_sysmon_update_idle(rtems_sysmon_cpuload_state_t *state, Thread_Control *the_thread)
 {
-    rtems_sysmon_cpuload_state_t *state = (rtems_sysmon_cpuload_state_t *)arg;
     rtems_sysmon_cpuload_core_t* core_p = &state->per_core[state->num_cpus];
 
     Timestamp_Control uptime_at_last_calc = core_p->last_run_time;
@@ -139,81 +131,369 @@ static bool rtems_cpu_usage_vistor(Thread_Control *the_thread, void *arg)
     Timestamp_Control idle_uptime_elapsed;
     Timestamp_Control total_elapsed;
 
-    char name[38];
     uint32_t ival; 
     uint32_t fval; 
-    bool status = false;
+
+    idle_task_uptime = rtems_sysmon_get_cpu_time(the_thread);
+
+    _TOD_Get_uptime(&current_uptime);
+    _Timestamp_Subtract(&idle_uptime_at_last_calc, &idle_task_uptime, &idle_uptime_elapsed);
+    _Timestamp_Subtract(&uptime_at_last_calc, &current_uptime, &total_elapsed);
+    _Timestamp_Divide(&idle_uptime_elapsed, &total_elapsed, &ival, &fval);   /* ival - points to the integer portion */
+                                                                             /* fval - points to the thousandths of percentage */
+
+    core_p->last_run_time = current_uptime;
+    core_p->idle_last_uptime = idle_task_uptime;
+
+    if(ival >= 100)
+    {
+        core_p->avg_load = 0xFFFFFF; /* max */
+    }
+    else if(total_elapsed == 0)
+    {
+        core_p->avg_load = 0;
+    }
+    else
+    {
+        while (fval > 999) { fval /= 10; } /* Keep 3 most significant digits. Should not occur. */
+        core_p->avg_load = (RTEMS_SYSMON_MAX_SCALE - ((ival * 1000) + fval)); /* Get percentages as integer */
+
+        /* 
+        ** Mimic ADC so that "analogio" API can be used with out modification. API assumes 24 bits.
+        ** First calculate out of 0x1000 and then duplicate it to expand to 24 bits. Doing this prevents 
+        ** an overflow. avg_load has a "real" resolution of 12 bits.
+        */
+        core_p->avg_load = (0x1000 * core_p->avg_load) / RTEMS_SYSMON_MAX_SCALE; 
+        core_p->avg_load |= (core_p->avg_load << 12);
+    }
+
+    #ifdef DEBUG_BUILD
+    rtems_cpu_usage_report();
+    
+    uint32_t microsec = _Timestamp_Get_nanoseconds( &idle_uptime_elapsed ) / TOD_NANOSECONDS_PER_MICROSECOND;
+    uint32_t sec = _Timestamp_Get_seconds( &idle_uptime_elapsed );
+    RTEMS_SYSMON_DEBUG("\nCFE_PSP(rtems_sysmon): IDLE cpu time elapsed = %7u.%06u, IDLE percentages =%4u.%03u\n",
+                       sec, microsec, ival, fval);
+
+    microsec = _Timestamp_Get_nanoseconds( &total_elapsed ) / TOD_NANOSECONDS_PER_MICROSECOND;
+    sec = _Timestamp_Get_seconds( &total_elapsed );
+    RTEMS_SYSMON_DEBUG("CFE_PSP(rtems_sysmon): Total elapsed CPU time = %7u.%06u, CPU Load =%08X\n",
+                       sec, microsec, core_p->avg_load);
+    #endif
+
+    state->num_cpus++;
+}
+
+/*
+ * Finds the slot of a task from its ID, or a free slot for a new task
+ *
+ * The search starts from the slot given by the ID, where the low bits are the object
+ * index, and goes on through slots used by other tasks.  Slots of deleted tasks are
+ * passed over in the same way (as a task after them may have been found by passing
+ * over them), but are remembered so they can be reused.  The search stops at a slot
+ * which has never been used, as no task can be after that.
+ */
+static rtems_sysmon_task_entry_t *rtems_sysmon_find_task(rtems_sysmon_tasks_state_t *tasks, rtems_id id)
+{
+    rtems_sysmon_task_entry_t *entry;
+    rtems_sysmon_task_entry_t *free_entry;
+    uint32_t                   i;
+
+    free_entry = NULL;
+    for (i = 0; i < RTEMS_SYSMON_MAX_TASKS; ++i)
+    {
+        entry = &tasks->entries[(id + i) & (RTEMS_SYSMON_MAX_TASKS - 1)];
+        if (entry->in_use)
+        {
+            if (entry->id == id)
+            {
+                return entry;
+            }
+        }
+        else
+        {
+            if (free_entry == NULL)
+            {
+                free_entry = entry;
+            }
+            if (entry->id == 0)
+            {
+                break;
+            }
+        }
+    }
+
+    return free_entry;
+}
+
+/*
+ * Calculates the load of one task, which is zero for a task not seen before
+ */
+static void rtems_sysmon_update_task(rtems_sysmon_tasks_state_t *tasks, Thread_Control *the_thread,
+                                     const char *name)
+{
+    rtems_sysmon_task_entry_t *entry;
+    Timestamp_Control          cpu_time;
+    Timestamp_Control          used;
+    uint64_t                   load;
+
+    entry = rtems_sysmon_find_task(tasks, the_thread->Object.id);
+    if (entry == NULL)
+    {
+        if (!tasks->tasks_dropped)
+        {
+            OS_printf("CFE_PSP(rtems_sysmon): More than %u tasks, increase RTEMS_SYSMON_MAX_TASKS\n",
+                      (unsigned int)RTEMS_SYSMON_MAX_TASKS);
+            tasks->tasks_dropped = true;
+        }
+        return;
+    }
+
+    cpu_time = rtems_sysmon_get_cpu_time(the_thread);
+
+    if (!entry->in_use)
+    {
+        entry->id     = the_thread->Object.id;
+        entry->in_use = true;
+        entry->load   = 0;
+        strncpy(entry->name, name, sizeof(entry->name) - 1);
+        entry->name[sizeof(entry->name) - 1] = 0;
+    }
+    else if (_Timestamp_Less_than(&cpu_time, &entry->last_cpu_time) || tasks->elapsed_ns == 0)
+    {
+        /* the CPU usage was reset */
+        entry->load = 0;
+    }
+    else
+    {
+        /* as for the CPU load, 12 bits duplicated to fill the 24 bit analog value */
+        _Timestamp_Subtract(&entry->last_cpu_time, &cpu_time, &used);
+        load = (0x1000 * _Timestamp_Get_as_nanoseconds(&used)) / tasks->elapsed_ns;
+        if (load > 0xFFF)
+        {
+            load = 0xFFF;
+        }
+        entry->load = load | (load << 12);
+    }
+
+    entry->last_cpu_time = cpu_time;
+    entry->seen          = true;
+}
+
+static bool rtems_cpu_usage_vistor(Thread_Control *the_thread, void *arg)
+{
+    rtems_sysmon_cpuload_state_t *state = (rtems_sysmon_cpuload_state_t *)arg;
+    char                          name[38];
 
     _Thread_Get_name(the_thread, name, sizeof(name));
-    if(strncmp("IDLE", name, 4) == 0)
+    if (strncmp("IDLE", name, 4) == 0 && state->num_cpus < RTEMS_SYSMON_MAX_CPUS)
     {
-        #if __RTEMS_MAJOR__ == 5
-        _Thread_Get_CPU_time_used( the_thread, &idle_task_uptime );
-        #else /* RTEMS 6 */
-        idle_task_uptime = _Thread_Get_CPU_time_used_after_last_reset( the_thread );
-        #endif
+        rtems_sysmon_update_idle(state, the_thread);
+    }
 
-        _TOD_Get_uptime(&current_uptime);
-        _Timestamp_Subtract(&idle_uptime_at_last_calc, &idle_task_uptime, &idle_uptime_elapsed);
-        _Timestamp_Subtract(&uptime_at_last_calc, &current_uptime, &total_elapsed);
-        _Timestamp_Divide(&idle_uptime_elapsed, &total_elapsed, &ival, &fval);   /* ival - points to the integer portion */
-                                                                                 /* fval - points to the thousandths of percentage */
+    rtems_sysmon_update_task(&state->tasks, the_thread, name);
 
-        core_p->last_run_time = current_uptime;
-        core_p->idle_last_uptime = idle_task_uptime;
+    /* return false to go on to every task */
+    return false;
+}
 
-        if(ival >= 100)
+/*
+ * Records every channel of a published snapshot, skipping free task slots
+ */
+static void rtems_sysmon_record(rtems_sysmon_cpuload_state_t *state, const rtems_sysmon_snapshot_t *snap)
+{
+    uint16_t i;
+    uint8_t  cpu;
+    int      w;
+
+    if (state->recorder.Header == NULL)
+    {
+        return;
+    }
+
+    CFE_PSP_SysmonRecord_BeginSample(&state->recorder);
+    for (w = 0; w <= RTEMS_SYSMON_NUM_AVG_WINDOWS; ++w)
+    {
+        CFE_PSP_SysmonRecord_Add(&state->recorder, RTEMS_SYSMON_AGGREGATE_SUBSYS, w, snap->aggregate_load[w]);
+    }
+    for (w = 0; w <= RTEMS_SYSMON_NUM_AVG_WINDOWS; ++w)
+    {
+        /* the current load and then the averages are consecutive subsystems */
+        for (cpu = 0; cpu < snap->num_cpus; ++cpu)
         {
-            core_p->avg_load = 0xFFFFFF; /* max */
+            CFE_PSP_SysmonRecord_Add(&state->recorder, RTEMS_SYSMON_CPULOAD_SUBSYS + w, cpu, snap->cpu_load[w][cpu]);
         }
-        else if(total_elapsed == 0)
+    }
+    for (i = 0; i < RTEMS_SYSMON_MAX_TASKS; ++i)
+    {
+        if (snap->task_name[i][0] != 0)
         {
-            core_p->avg_load = 0;
+            CFE_PSP_SysmonRecord_Add(&state->recorder, RTEMS_SYSMON_TASKLOAD_SUBSYS, i, snap->task_load[i]);
         }
-        else
+    }
+    CFE_PSP_SysmonRecord_EndSample(&state->recorder);
+}
+
+/*
+ * Reads a channel of the snapshot just published, for the alarms
+ */
+static bool rtems_sysmon_alarm_value(void *arg, uint16_t subsystem, uint16_t subchannel, uint32_t *value)
+{
+    const rtems_sysmon_snapshot_t *snap = arg;
+
+    switch (subsystem)
+    {
+        case RTEMS_SYSMON_AGGREGATE_SUBSYS:
+            if (subchannel > RTEMS_SYSMON_NUM_AVG_WINDOWS)
+            {
+                return false;
+            }
+            *value = snap->aggregate_load[subchannel];
+            break;
+        case RTEMS_SYSMON_CPULOAD_SUBSYS:
+        case RTEMS_SYSMON_CPUAVG_1S_SUBSYS:
+        case RTEMS_SYSMON_CPUAVG_10S_SUBSYS:
+        case RTEMS_SYSMON_CPUAVG_60S_SUBSYS:
+            if (subchannel >= snap->num_cpus)
+            {
+                return false;
+            }
+            *value = snap->cpu_load[subsystem - RTEMS_SYSMON_CPULOAD_SUBSYS][subchannel];
+            break;
+        case RTEMS_SYSMON_TASKLOAD_SUBSYS:
+            if (subchannel >= RTEMS_SYSMON_MAX_TASKS || snap->task_name[subchannel][0] == 0)
+            {
+                return false;
+            }
+            *value = snap->task_load[subchannel];
+            break;
+        default:
+            return false;
+    }
+
+    return true;
+}
+
+/*
+ * Publishes the values of the sample just taken to readers, from the sampler task only
+ */
+static void rtems_sysmon_publish(rtems_sysmon_cpuload_state_t *state)
+{
+    rtems_sysmon_snapshot_t *  snap;
+    rtems_sysmon_task_entry_t *entry;
+    uint32_t                   seq;
+    uint32_t                   i;
+    uint8_t                    cpu;
+    int                        w;
+
+    seq  = state->snapshot_seq;
+    snap = &state->snapshot[(seq + 1) & 1];
+
+    /* make sure readers of this snapshot from two samples ago see the sequence change first */
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+
+    snap->num_cpus          = state->num_cpus;
+    snap->aggregate_load[0] = state->aggregate_load;
+    for (cpu = 0; cpu < RTEMS_SYSMON_MAX_CPUS; ++cpu)
+    {
+        snap->cpu_load[0][cpu] = state->per_core[cpu].avg_load;
+    }
+    for (w = 0; w < RTEMS_SYSMON_NUM_AVG_WINDOWS; ++w)
+    {
+        snap->aggregate_load[1 + w] = CFE_PSP_SysmonAvg_ToLoad(state->aggregate_avg[w]);
+        for (cpu = 0; cpu < RTEMS_SYSMON_MAX_CPUS; ++cpu)
         {
-            while (fval > 999) { fval /= 10; } /* Keep 3 most significant digits. Should not occur. */
-            core_p->avg_load = (RTEMS_SYSMON_MAX_SCALE - ((ival * 1000) + fval)); /* Get percentages as integer */
-
-            /* 
-            ** Mimic ADC so that "analogio" API can be used with out modification. API assumes 24 bits.
-            ** First calculate out of 0x1000 and then duplicate it to expand to 24 bits. Doing this prevents 
-            ** an overflow. avg_load has a "real" resolution of 12 bits.
-            */
-            core_p->avg_load = (0x1000 * core_p->avg_load) / RTEMS_SYSMON_MAX_SCALE; 
-            core_p->avg_load |= (core_p->avg_load << 12);
+            snap->cpu_load[1 + w][cpu] = CFE_PSP_SysmonAvg_ToLoad(state->per_core[cpu].avg[w]);
         }
+    }
 
-        #ifdef DEBUG_BUILD
-        rtems_cpu_usage_report();
-        
-        uint32_t microsec = _Timestamp_Get_nanoseconds( &idle_uptime_elapsed ) / TOD_NANOSECONDS_PER_MICROSECOND;
-        uint32_t sec = _Timestamp_Get_seconds( &idle_uptime_elapsed );
-        RTEMS_SYSMON_DEBUG("\nCFE_PSP(rtems_sysmon): IDLE cpu time elapsed = %7u.%06u, IDLE percentages =%4u.%03u\n",
-                           sec, microsec, ival, fval);
-
-        microsec = _Timestamp_Get_nanoseconds( &total_elapsed ) / TOD_NANOSECONDS_PER_MICROSECOND;
-        sec = _Timestamp_Get_seconds( &total_elapsed );
-        RTEMS_SYSMON_DEBUG("CFE_PSP(rtems_sysmon): Total elapsed CPU time = %7u.%06u, CPU Load =%08X\n",
-                           sec, microsec, core_p->avg_load);
-        #endif
-
-        state->num_cpus++;
-        if(state->num_cpus >= RTEMS_SYSMON_MAX_CPUS)
+    for (i = 0; i < RTEMS_SYSMON_MAX_TASKS; ++i)
+    {
+        entry = &state->tasks.entries[i];
+        if (entry->in_use)
+        {
+            snap->task_load[i] = entry->load;
+            memcpy(snap->task_name[i], entry->name, sizeof(snap->task_name[i]));
+        }
+        else
         {
-            /* stop checking when all idle tasks has been found */
-            status = true;
+            snap->task_load[i]    = 0;
+            snap->task_name[i][0] = 0;
         }
     }
-    
-    /* return true to exit iterating tasks */
-    return status;
+
+    __atomic_store_n(&state->snapshot_seq, seq + 1, __ATOMIC_RELEASE);
+
+    rtems_sysmon_record(state, snap);
+    CFE_PSP_SysmonAlarm_Check(&rtems_sysmon_global.alarms, rtems_sysmon_alarm_value, snap);
+}
+
+/*
+ * Gets the latest snapshot for reading, values from it are only valid if
+ * rtems_sysmon_read_end() then returns true
+ */
+static const rtems_sysmon_snapshot_t *rtems_sysmon_read_begin(rtems_sysmon_cpuload_state_t *state, uint32_t *seq)
+{
+    *seq = __atomic_load_n(&state->snapshot_seq, __ATOMIC_ACQUIRE);
+    return &state->snapshot[*seq & 1];
+}
+
+static bool rtems_sysmon_read_end(rtems_sysmon_cpuload_state_t *state, uint32_t seq)
+{
+    __atomic_thread_fence(__ATOMIC_ACQUIRE);
+    return __atomic_load_n(&state->snapshot_seq, __ATOMIC_RELAXED) == seq;
 }
 
 void rtems_sysmon_update_stat(rtems_sysmon_cpuload_state_t *state)
 {
+    rtems_sysmon_cpuload_core_t *core_p;
+    rtems_sysmon_task_entry_t *  entry;
+    Timestamp_Control            uptime;
+    Timestamp_Control            elapsed;
+    uint32_t                     sum;
+    uint32_t                     i;
+    uint8_t                      cpu;
+
+    _TOD_Get_uptime(&uptime);
+    _Timestamp_Subtract(&state->tasks.last_uptime, &uptime, &elapsed);
+    state->tasks.elapsed_ns  = _Timestamp_Get_as_nanoseconds(&elapsed);
+    state->tasks.last_uptime = uptime;
+
+    for (i = 0; i < RTEMS_SYSMON_MAX_TASKS; ++i)
+    {
+        state->tasks.entries[i].seen = false;
+    }
+
     state->num_cpus = 0;
     rtems_task_iterate( rtems_cpu_usage_vistor, state);
+
+    /* tasks which were not visited have been deleted */
+    for (i = 0; i < RTEMS_SYSMON_MAX_TASKS; ++i)
+    {
+        entry = &state->tasks.entries[i];
+        if (entry->in_use && !entry->seen)
+        {
+            entry->in_use = false;
+        }
+    }
+
+    /* the aggregate is the average over all CPUs */
+    sum = 0;
+    for (cpu = 0; cpu < RTEMS_SYSMON_MAX_CPUS; ++cpu)
+    {
+        core_p = &state->per_core[cpu];
+        if (cpu < state->num_cpus)
+        {
+            CFE_PSP_SysmonAvg_Update(core_p->avg, &core_p->has_avg, core_p->avg_load, rtems_sysmon_avg_decay,
+                                     RTEMS_SYSMON_NUM_AVG_WINDOWS);
+        }
+        sum += core_p->avg_load;
+    }
+    state->aggregate_load = sum / RTEMS_SYSMON_MAX_CPUS;
+    CFE_PSP_SysmonAvg_Update(state->aggregate_avg, &state->has_aggregate_avg, state->aggregate_load,
+                             rtems_sysmon_avg_decay, RTEMS_SYSMON_NUM_AVG_WINDOWS);
+
+    rtems_sysmon_publish(state);
 }
 
 rtems_task rtems_sysmon_Task(rtems_task_argument arg)
@@ -229,6 +509,7 @@ rtems_task rtems_sysmon_Task(rtems_task_argument arg)
     {
         state->per_core[i].last_run_time = CPU_usage_Uptime_at_last_reset;
     }
+    state->tasks.last_uptime = CPU_usage_Uptime_at_last_reset;
 
     while (state->should_run)
     {
@@ -246,7 +527,7 @@ rtems_task rtems_sysmon_Task(rtems_task_argument arg)
  *  Starts the cpu load watcher function
  *
  * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
-static int32_t rtems_sysmon_Start(rtems_sysmon_cpuload_state_t *state)
+int32_t rtems_sysmon_Start(rtems_sysmon_cpuload_state_t *state)
 {
     int32_t StatusCode;
     rtems_status_code status;
@@ -258,10 +539,14 @@ static int32_t rtems_sysmon_Start(rtems_sysmon_cpuload_state_t *state)
     }
     else
     {
-        /* start clean */
-        memset(state, 0, sizeof(*state));
+        /* start clean, apart from the snapshots which readers may be using */
+        memset(state, 0, offsetof(rtems_sysmon_cpuload_state_t, snapshot_seq));
         StatusCode = CFE_PSP_ERROR;
 
+        /* recording is optional, and carries on from the samples already in reserved memory */
+        CFE_PSP_SysmonRecord_AttachReserved(&state->recorder, "rtems_sysmon", rtems_sysmon_subsystem_names);
+        CFE_PSP_SysmonAlarm_Reset(&rtems_sysmon_global.alarms);
+
         state->should_run = true;
         state->task_name = rtems_build_name( 'R','S','M',' ');
         status = rtems_task_create(state->task_name, RTEMS_SYSMON_TASK_PRIORITY,
@@ -305,22 +590,32 @@ int32_t rtems_sysmon_Stop(rtems_sysmon_cpuload_state_t *state)
     return CFE_PSP_SUCCESS;
 }
 
-int32_t rtems_sysmon_calc_aggregate_cpu(rtems_sysmon_cpuload_state_t *state, CFE_PSP_IODriver_AdcCode_t *Val)
+/*
+ * Reads the aggregate load, where Subchannel 0 is the current load and the
+ * subchannels after it are the averages
+ */
+int32_t rtems_sysmon_calc_aggregate_cpu(rtems_sysmon_cpuload_state_t *state, uint16_t Subchannel,
+                                        CFE_PSP_IODriver_AnalogRdWr_t *RdWr)
 {
+    const rtems_sysmon_snapshot_t *snap;
+    uint32_t                       seq;
+    uint32_t                       ch;
 
-    uint8_t  cpu;
-    uint32_t sum;
-
-    sum = 0;
-    for (cpu = 0; cpu < RTEMS_SYSMON_MAX_CPUS; cpu++ )
+    if ((Subchannel + RdWr->NumChannels) > (1 + RTEMS_SYSMON_NUM_AVG_WINDOWS))
     {
-        sum += state->per_core[cpu].avg_load; 
+        return CFE_PSP_ERROR_NOT_IMPLEMENTED;
     }
 
-    sum /= RTEMS_SYSMON_MAX_CPUS;
-    *Val = sum;
+    do
+    {
+        snap = rtems_sysmon_read_begin(state, &seq);
+        for (ch = 0; ch < RdWr->NumChannels; ++ch)
+        {
+            RdWr->Samples[ch] = snap->aggregate_load[Subchannel + ch];
+        }
+    } while (!rtems_sysmon_read_end(state, seq));
 
-    RTEMS_SYSMON_DEBUG("CFE_PSP(rtems_sysmon): Aggregate CPU load=%08X\n", (unsigned int)sum);
+    RTEMS_SYSMON_DEBUG("CFE_PSP(rtems_sysmon): Aggregate CPU load=%08X\n", (unsigned int)RdWr->Samples[0]);
 
     return CFE_PSP_SUCCESS;
 }
@@ -358,9 +653,17 @@ int32_t rtems_sysmon_aggregate_dispatch(uint32_t CommandCode, uint16_t Subchanne
             break;
         }
         case CFE_PSP_IODriver_SET_CONFIGURATION: /**< const string argument (device-dependent content) */
-        case CFE_PSP_IODriver_GET_CONFIGURATION: /**< void * argument (device-dependent content) */
         {
-            /* not implemented for now */
+            StatusCode = rtems_sysmon_set_config(Arg.ConstStr);
+            break;
+        }
+        case CFE_PSP_IODriver_GET_CONFIGURATION: /**< CFE_PSP_SysmonAlarmStatus_t argument */
+        {
+            if (Arg.Vptr != NULL)
+            {
+                CFE_PSP_SysmonAlarm_GetStatus(&rtems_sysmon_global.alarms, Arg.Vptr);
+                StatusCode = CFE_PSP_SUCCESS;
+            }
             break;
         }
         case CFE_PSP_IODriver_LOOKUP_SUBSYSTEM: /**< const char * argument, looks up name and returns positive
@@ -409,10 +712,7 @@ int32_t rtems_sysmon_aggregate_dispatch(uint32_t CommandCode, uint16_t Subchanne
         {
             CFE_PSP_IODriver_AnalogRdWr_t *RdWr = Arg.Vptr;
 
-            if (RdWr->NumChannels == 1 && Subchannel == RTEMS_SYSMON_AGGR_CPULOAD_SUBCH)
-            {
-                StatusCode = rtems_sysmon_calc_aggregate_cpu(state, RdWr->Samples);
-            }
+            StatusCode = rtems_sysmon_calc_aggregate_cpu(state, Subchannel, RdWr);
             break;
         }
         default:
@@ -422,7 +722,12 @@ int32_t rtems_sysmon_aggregate_dispatch(uint32_t CommandCode, uint16_t Subchanne
     return StatusCode;
 }
 
-int32_t rtems_sysmon_cpu_load_dispatch(uint32_t CommandCode, uint16_t Subchannel, CFE_PSP_IODriver_Arg_t Arg)
+/*
+ * The per-cpu subsystems share this, where window 0 is the current load and
+ * the others are the averages
+ */
+int32_t rtems_sysmon_cpu_load_dispatch(uint32_t CommandCode, uint16_t Subchannel, CFE_PSP_IODriver_Arg_t Arg,
+                                       uint32_t window)
 {
     int32_t                       StatusCode;
     rtems_sysmon_cpuload_state_t *state;
@@ -445,14 +750,21 @@ int32_t rtems_sysmon_cpu_load_dispatch(uint32_t CommandCode, uint16_t Subchannel
         case CFE_PSP_IODriver_ANALOG_IO_READ_CHANNELS:
         {
             CFE_PSP_IODriver_AnalogRdWr_t *RdWr = Arg.Vptr;
+            const rtems_sysmon_snapshot_t *snap;
+            uint32_t                       seq;
             uint32_t                       ch;
 
             if (Subchannel < RTEMS_SYSMON_MAX_CPUS && (Subchannel + RdWr->NumChannels) <= RTEMS_SYSMON_MAX_CPUS)
             {
-                for (ch = Subchannel; ch < (Subchannel + RdWr->NumChannels); ++ch)
+                do
                 {
-                    RdWr->Samples[ch] = state->per_core[ch].avg_load;
-                }
+                    snap = rtems_sysmon_read_begin(state, &seq);
+                    for (ch = 0; ch < RdWr->NumChannels; ++ch)
+                    {
+                        RdWr->Samples[ch] = snap->cpu_load[window][Subchannel + ch];
+                    }
+                } while (!rtems_sysmon_read_end(state, seq));
+                StatusCode = CFE_PSP_SUCCESS;
             }
 
             break;
@@ -464,6 +776,87 @@ int32_t rtems_sysmon_cpu_load_dispatch(uint32_t CommandCode, uint16_t Subchannel
     return StatusCode;
 }
 
+/*
+ * Reads the CPU load of each task, where the subchannel of a task is found by looking
+ * up its name, and stays the same for as long as the task exists
+ */
+int32_t rtems_sysmon_task_dispatch(uint32_t CommandCode, uint16_t Subchannel, CFE_PSP_IODriver_Arg_t Arg)
+{
+    int32_t                        StatusCode;
+    rtems_sysmon_cpuload_state_t * state;
+    const rtems_sysmon_snapshot_t *snap;
+    uint32_t                       seq;
+
+    /* There is just one global cpuload object */
+    state      = &rtems_sysmon_global.cpu_load;
+    StatusCode = CFE_PSP_ERROR_NOT_IMPLEMENTED;
+    switch (CommandCode)
+    {
+        case CFE_PSP_IODriver_NOOP:
+        case CFE_PSP_IODriver_ANALOG_IO_NOOP:
+        {
+            StatusCode = CFE_PSP_SUCCESS;
+            break;
+        }
+        case CFE_PSP_IODriver_LOOKUP_SUBCHANNEL: /**< const char * argument, looks up task name and returns positive
+                                                    value for channel number, negative value for error */
+        {
+            uint16_t i;
+
+            do
+            {
+                snap       = rtems_sysmon_read_begin(state, &seq);
+                StatusCode = CFE_PSP_ERROR;
+                for (i = 0; i < RTEMS_SYSMON_MAX_TASKS; ++i)
+                {
+                    if (snap->task_name[i][0] != 0 &&
+                        strncmp(Arg.ConstStr, snap->task_name[i], RTEMS_SYSMON_TASK_NAME_LEN - 1) == 0)
+                    {
+                        StatusCode = i;
+                        break;
+                    }
+                }
+            } while (!rtems_sysmon_read_end(state, seq));
+            break;
+        }
+        case CFE_PSP_IODriver_ANALOG_IO_READ_CHANNELS:
+        {
+            CFE_PSP_IODriver_AnalogRdWr_t *RdWr = Arg.Vptr;
+            uint32_t                       ch;
+
+            /* Slots without a task read as zero */
+            if (Subchannel < RTEMS_SYSMON_MAX_TASKS && (Subchannel + RdWr->NumChannels) <= RTEMS_SYSMON_MAX_TASKS)
+            {
+                do
+                {
+                    snap = rtems_sysmon_read_begin(state, &seq);
+                    for (ch = 0; ch < RdWr->NumChannels; ++ch)
+                    {
+                        RdWr->Samples[ch] = snap->task_load[Subchannel + ch];
+                    }
+                } while (!rtems_sysmon_read_end(state, seq));
+                StatusCode = CFE_PSP_SUCCESS;
+            }
+            break;
+        }
+        default:
+            break;
+    }
+
+    return StatusCode;
+}
+
+/*
+ * Two concurrent starts would each create an RSM task, and a stop racing a start could
+ * delete a task id that is still being set, so these and configuration share one mutex.
+ * Reads do not take it, as rtems_sysmon_Start() leaves the snapshots in place.
+ */
+int32_t rtems_sysmon_DevMutex(uint32_t CommandCode, uint16_t SubsystemId, uint16_t SubchannelId,
+                              CFE_PSP_IODriver_Arg_t Arg)
+{
+    return 0;
+}
+
 /* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
 /*    rtems_sysmon_DevCmd()                               */
 /* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
@@ -495,7 +888,16 @@ int32_t rtems_sysmon_DevCmd(uint32_t CommandCode, uint16_t SubsystemId, uint16_t
             StatusCode = rtems_sysmon_aggregate_dispatch(CommandCode, SubchannelId, Arg);
             break;
         case RTEMS_SYSMON_CPULOAD_SUBSYS:
-            StatusCode = rtems_sysmon_cpu_load_dispatch(CommandCode, SubchannelId, Arg);
+            StatusCode = rtems_sysmon_cpu_load_dispatch(CommandCode, SubchannelId, Arg, 0);
+            break;
+        case RTEMS_SYSMON_CPUAVG_1S_SUBSYS:
+        case RTEMS_SYSMON_CPUAVG_10S_SUBSYS:
+        case RTEMS_SYSMON_CPUAVG_60S_SUBSYS:
+            StatusCode = rtems_sysmon_cpu_load_dispatch(CommandCode, SubchannelId, Arg,
+                                                        1 + SubsystemId - RTEMS_SYSMON_CPUAVG_1S_SUBSYS);
+            break;
+        case RTEMS_SYSMON_TASKLOAD_SUBSYS:
+            StatusCode = rtems_sysmon_task_dispatch(CommandCode, SubchannelId, Arg);
             break;
         default:
             /* not implemented */
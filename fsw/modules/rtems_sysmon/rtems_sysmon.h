@@ -0,0 +1,194 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,719-1, and identified as “core Flight System: 
+ * Draco
+ *
+ * Copyright (c) 2023 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ************************************************************************/
+
+/**
+ * \file
+ *
+ * Internal header for rtems_sysmon.c
+ */
+
+#ifndef RTEMS_SYSMON_H_
+#define RTEMS_SYSMON_H_
+
+/********************************************************************
+ * Local Defines
+ ********************************************************************/
+#ifdef OS_MAXIMUM_PROCESSORS
+    #define RTEMS_SYSMON_MAX_CPUS  OS_MAXIMUM_PROCESSORS
+#else
+    #define RTEMS_SYSMON_MAX_CPUS  1
+#endif
+
+#define RTEMS_SYSMON_AGGREGATE_SUBSYS   0
+#define RTEMS_SYSMON_CPULOAD_SUBSYS     1
+#define RTEMS_SYSMON_CPUAVG_1S_SUBSYS   2
+#define RTEMS_SYSMON_CPUAVG_10S_SUBSYS  3
+#define RTEMS_SYSMON_CPUAVG_60S_SUBSYS  4
+#define RTEMS_SYSMON_TASKLOAD_SUBSYS    5
+#define RTEMS_SYSMON_AGGR_CPULOAD_SUBCH 0
+#define RTEMS_SYSMON_SAMPLE_DELAY       1000
+#define RTEMS_SYSMON_TASK_PRIORITY      100
+#define RTEMS_SYSMON_STACK_SIZE         4096
+#define RTEMS_SYSMON_MAX_SCALE          100000
+
+/*
+ * Exponentially weighted averages of the CPU load over 1, 10 and 60 seconds
+ *
+ * These are the "cpu-load-1s", "cpu-load-10s" and "cpu-load-60s" subchannels
+ * of the aggregate and the "per-cpu-1s", "per-cpu-10s" and "per-cpu-60s"
+ * subsystems.  As the sample period is fixed the decay per sample is a constant,
+ * exp(-period/window) as a fraction of CFE_PSP_SYSMON_DECAY_ONE.
+ */
+#define RTEMS_SYSMON_NUM_AVG_WINDOWS 3
+
+#if RTEMS_SYSMON_SAMPLE_DELAY != 1000
+#error "rtems_sysmon_avg_decay is computed for a sample period of 1000 ms"
+#endif
+
+/*
+ * Size of the per-task table of the "per-task" subsystem
+ *
+ * Each task keeps the slot, and so the subchannel, found by hashing its ID for as
+ * long as it exists.  This must be a power of two, and should be comfortably more
+ * than the number of tasks so that most are found in the first slot tried.
+ */
+#ifndef RTEMS_SYSMON_MAX_TASKS
+#define RTEMS_SYSMON_MAX_TASKS 64
+#endif
+#define RTEMS_SYSMON_TASK_NAME_LEN 16
+
+#if (RTEMS_SYSMON_MAX_TASKS & (RTEMS_SYSMON_MAX_TASKS - 1)) != 0
+#error "RTEMS_SYSMON_MAX_TASKS must be a power of two"
+#endif
+
+#ifdef DEBUG_BUILD
+#define RTEMS_SYSMON_DEBUG(...) OS_printf(__VA_ARGS__)
+#else
+#define RTEMS_SYSMON_DEBUG(...)
+#endif
+
+/********************************************************************
+ * Local Type Definitions
+ ********************************************************************/
+typedef struct rtems_sysmon_cpuload_core
+{
+    CFE_PSP_IODriver_AdcCode_t avg_load;
+    Timestamp_Control last_run_time;
+    Timestamp_Control idle_last_uptime;
+    bool              has_avg;
+    uint32_t          avg[RTEMS_SYSMON_NUM_AVG_WINDOWS];
+
+} rtems_sysmon_cpuload_core_t;
+
+typedef struct rtems_sysmon_task_entry
+{
+    rtems_id                   id;     /* zero if the slot has never been used */
+    bool                       in_use; /* false once the task is deleted, so the slot can be reused */
+    bool                       seen;
+    Timestamp_Control          last_cpu_time;
+    CFE_PSP_IODriver_AdcCode_t load;
+    char                       name[RTEMS_SYSMON_TASK_NAME_LEN];
+} rtems_sysmon_task_entry_t;
+
+typedef struct rtems_sysmon_tasks_state
+{
+    Timestamp_Control last_uptime;
+    uint64_t          elapsed_ns; /* uptime elapsed over the current sample */
+    bool              tasks_dropped;
+
+    rtems_sysmon_task_entry_t entries[RTEMS_SYSMON_MAX_TASKS];
+} rtems_sysmon_tasks_state_t;
+
+/*
+ * The values of one complete sample, as seen by readers
+ *
+ * The sampler task fills in one of two snapshots while readers use the other,
+ * then switches them over by incrementing snapshot_seq.  Readers check that
+ * snapshot_seq is unchanged after reading, and only need to retry if they were
+ * preempted for a whole sample period.  The sampler never waits for readers.
+ */
+typedef struct rtems_sysmon_snapshot
+{
+    uint8_t                    num_cpus;
+    CFE_PSP_IODriver_AdcCode_t aggregate_load[1 + RTEMS_SYSMON_NUM_AVG_WINDOWS]; /* current, then the averages */
+
+    /* the current load of each CPU, followed by the same for each of the averages */
+    CFE_PSP_IODriver_AdcCode_t cpu_load[1 + RTEMS_SYSMON_NUM_AVG_WINDOWS][RTEMS_SYSMON_MAX_CPUS];
+
+    CFE_PSP_IODriver_AdcCode_t task_load[RTEMS_SYSMON_MAX_TASKS];
+    char                       task_name[RTEMS_SYSMON_MAX_TASKS][RTEMS_SYSMON_TASK_NAME_LEN]; /* empty if free */
+} rtems_sysmon_snapshot_t;
+
+typedef struct rtems_sysmon_cpuload_state
+{
+    volatile bool is_running;
+    volatile bool should_run;
+
+    rtems_id   task_id;
+    rtems_name task_name;
+
+    uint8_t    num_cpus;
+    rtems_sysmon_cpuload_core_t per_core[RTEMS_SYSMON_MAX_CPUS];
+
+    bool                       has_aggregate_avg;
+    CFE_PSP_IODriver_AdcCode_t aggregate_load;
+    uint32_t                   aggregate_avg[RTEMS_SYSMON_NUM_AVG_WINDOWS];
+
+    rtems_sysmon_tasks_state_t tasks;
+    CFE_PSP_SysmonRecorder_t   recorder; /* records each sample, if the platform reserves memory for it */
+
+    /* kept across stop/start of the sampler, as readers use these without locking */
+    volatile uint32_t       snapshot_seq; /* number of samples published, the latest is in snapshot[seq & 1] */
+    rtems_sysmon_snapshot_t snapshot[2];
+
+} rtems_sysmon_cpuload_state_t;
+
+typedef struct rtems_sysmon_state
+{
+    uint32_t                     local_module_id;
+    CFE_PSP_SysmonAlarmSet_t     alarms; /* kept across stop/start of the sampler */
+    rtems_sysmon_cpuload_state_t cpu_load;
+} rtems_sysmon_state_t;
+
+/********************************************************************
+ * Local Function Prototypes
+ ********************************************************************/
+void       rtems_sysmon_update_stat(rtems_sysmon_cpuload_state_t *state);
+rtems_task rtems_sysmon_Task(rtems_task_argument arg);
+
+int32_t rtems_sysmon_Start(rtems_sysmon_cpuload_state_t *state);
+int32_t rtems_sysmon_Stop(rtems_sysmon_cpuload_state_t *state);
+
+int32_t rtems_sysmon_set_config(const char *config_str);
+
+int32_t rtems_sysmon_aggregate_dispatch(uint32_t CommandCode, uint16_t Subchannel, CFE_PSP_IODriver_Arg_t Arg);
+int32_t rtems_sysmon_calc_aggregate_cpu(rtems_sysmon_cpuload_state_t *state, uint16_t Subchannel,
+                                        CFE_PSP_IODriver_AnalogRdWr_t *RdWr);
+int32_t rtems_sysmon_cpu_load_dispatch(uint32_t CommandCode, uint16_t Subchannel, CFE_PSP_IODriver_Arg_t Arg,
+                                       uint32_t window);
+int32_t rtems_sysmon_task_dispatch(uint32_t CommandCode, uint16_t Subchannel, CFE_PSP_IODriver_Arg_t Arg);
+
+/* Function that starts up rtems_sysmon driver. */
+int32_t rtems_sysmon_DevCmd(uint32_t CommandCode, uint16_t SubsystemId, uint16_t SubchannelId,
+                            CFE_PSP_IODriver_Arg_t Arg);
+int32_t rtems_sysmon_DevMutex(uint32_t CommandCode, uint16_t SubsystemId, uint16_t SubchannelId,
+                              CFE_PSP_IODriver_Arg_t Arg);
+
+
+#endif /* RTEMS_SYSMON_H_ */
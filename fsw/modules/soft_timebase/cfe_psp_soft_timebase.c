@@ -27,32 +27,540 @@
  * This module can be used on systems which do not have a hardware
  * source for the 1Hz signal or timing info (i.e. simulation, test
  * and debug platforms, etc).
+ *
+ * On Linux, if CFE_PSP_SOFT_TIMEBASE_TIMERFD is defined in cfe_psp_config.h,
+ * the timebase is instead driven by an external sync function that waits
+ * on a timerfd armed with absolute deadlines on CLOCK_MONOTONIC.  Late
+ * wakeups therefore never accumulate into drift, and the lateness of every
+ * wakeup is recorded so it can be retrieved via CFE_PSP_SoftTimebase_GetStats().
+ *
+ * Alternatively, another PSP module of type CFE_PSP_MODULE_TYPE_TIMEBASE_SOURCE
+ * may provide the sync function, for example to run the system in virtual time.
+ *
+ * Additional "derived" timebases may also be driven from the same master tick.
+ * Each of these is a callback whose period is a whole multiple (divider) of
+ * the master period, and which is invoked directly from the master tick on
+ * the ticks that are a multiple of its divider.  All derived timebases are
+ * therefore phase-aligned with each other and with the master, and no
+ * additional threads or timer sources are needed.
+ *
+ * The master tick also publishes the current time for CFE_PSP_GetTimeCoarse(),
+ * which can then be read without calling into the time source.
  */
 
 #include "cfe_psp.h"
 #include "cfe_psp_module.h"
 #include "cfe_psp_config.h"
+#include "cfe_psp_trace.h"
 
 #include <os-shared-globaldefs.h>
 
+#include <string.h>
+
+#ifdef CFE_PSP_SOFT_TIMEBASE_TIMERFD
+#include <stdio.h>
+#include <errno.h>
+#include <time.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sched.h>
+#include <sys/timerfd.h>
+
+/*
+ * If nonzero, the timebase thread is switched to SCHED_FIFO at this priority.
+ * This requires CAP_SYS_NICE (or root) on the host.
+ */
+#ifndef CFE_PSP_SOFT_TIMEBASE_RT_PRIORITY
+#define CFE_PSP_SOFT_TIMEBASE_RT_PRIORITY 0
+#endif
+
+/*
+ * If nonnegative, the timebase thread is pinned to this CPU
+ */
+#ifndef CFE_PSP_SOFT_TIMEBASE_CPU
+#define CFE_PSP_SOFT_TIMEBASE_CPU -1
+#endif
+
+/*
+ * The lateness histogram used for the percentile has 1 usec buckets,
+ * and anything beyond the last bucket is counted in the last bucket.
+ */
+#define SOFT_TIMEBASE_HIST_BUCKETS   1000
+#define SOFT_TIMEBASE_HIST_RES_NSEC  1000
+#define SOFT_TIMEBASE_NSEC_PER_SEC   1000000000ULL
+#define SOFT_TIMEBASE_NSEC_PER_USEC  1000ULL
+#endif
+
+/*
+ * The maximum number of derived timebases, including any configured
+ * via CFE_PSP_SOFT_TIMEBASE_DERIVED_LIST and those added at run time.
+ */
+#ifndef CFE_PSP_SOFT_TIMEBASE_MAX_DERIVED
+#define CFE_PSP_SOFT_TIMEBASE_MAX_DERIVED 8
+#endif
+
+/*
+ * How often the time read by CFE_PSP_GetTimeCoarse() is initially updated, in
+ * microseconds.  This is rounded down to a whole number of master periods
+ * (minimum of one), and may be changed with CFE_PSP_SoftTimebase_SetCoarsePeriod().
+ */
+#ifndef CFE_PSP_SOFT_TIMEBASE_COARSE_PERIOD
+#define CFE_PSP_SOFT_TIMEBASE_COARSE_PERIOD CFE_PSP_SOFT_TIMEBASE_PERIOD
+#endif
+
+#if (CFE_PSP_SOFT_TIMEBASE_COARSE_PERIOD < CFE_PSP_SOFT_TIMEBASE_PERIOD)
+#define SOFT_TIMEBASE_COARSE_DIVIDER 1
+#else
+#define SOFT_TIMEBASE_COARSE_DIVIDER (CFE_PSP_SOFT_TIMEBASE_COARSE_PERIOD / CFE_PSP_SOFT_TIMEBASE_PERIOD)
+#endif
+
+/*
+ * The published time is kept in its own cache line, so readers do
+ * not contend with writes to any other data.
+ */
+#ifndef CFE_PSP_SOFT_TIMEBASE_CACHE_LINE_SIZE
+#define CFE_PSP_SOFT_TIMEBASE_CACHE_LINE_SIZE 64
+#endif
+
 CFE_PSP_MODULE_DECLARE_SIMPLE(soft_timebase);
 
+/*
+ * The time published for CFE_PSP_GetTimeCoarse()
+ *
+ * This is a sequence lock with a single writer (the master tick).  The sequence
+ * is odd while an update is in progress, and zero if nothing was published yet.
+ */
+typedef struct
+{
+    uint32    seq;
+    OS_time_t time;
+} __attribute__((aligned(CFE_PSP_SOFT_TIMEBASE_CACHE_LINE_SIZE))) PSP_SoftTimebase_Coarse_t;
+
+static PSP_SoftTimebase_Coarse_t PSP_SoftTimebase_CoarseTime;
+
+/*
+ * State of a derived timebase
+ *
+ * Entries are only appended, and an entry is only serviced by the
+ * master tick once it is counted in num_derived.
+ */
+typedef struct
+{
+    char                            name[OS_MAX_API_NAME];
+    uint32                          divider;
+    CFE_PSP_SoftTimebase_Callback_t callback;
+    void                           *arg;
+} PSP_SoftTimebase_Derived_t;
+
+#ifdef CFE_PSP_SOFT_TIMEBASE_DERIVED_LIST
+/*
+ * The derived timebases to add at startup
+ */
+static const struct
+{
+    const char                     *Name;
+    uint32                          Divider;
+    CFE_PSP_SoftTimebase_Callback_t Callback;
+    void                           *Arg;
+} PSP_SoftTimebase_DerivedConfig[] = {CFE_PSP_SOFT_TIMEBASE_DERIVED_LIST};
+#endif
+
 /*
  * Global state data for this module (not exposed publicly)
  */
 static struct
 {
     osal_id_t sys_timebase_id;
+    osal_id_t master_timer_id;
+    uint64    master_tick_count;
+    uint32    coarse_divider;
+
+    osal_id_t                  derived_lock;
+    uint32                     num_derived;
+    PSP_SoftTimebase_Derived_t derived[CFE_PSP_SOFT_TIMEBASE_MAX_DERIVED];
+
+#ifdef CFE_PSP_SOFT_TIMEBASE_TIMERFD
+    int    timer_fd;
+    uint64 next_deadline_nsec;
+
+    pthread_mutex_t stats_lock;
+    uint64          tick_count;
+    uint64          missed_ticks;
+    uint64          num_wakeups;
+    uint64          sum_lateness_nsec;
+    uint32          min_lateness_nsec;
+    uint32          max_lateness_nsec;
+    uint32          hist[SOFT_TIMEBASE_HIST_BUCKETS];
+#endif
 } PSP_SoftTimebase_Global;
 
+#ifdef CFE_PSP_SOFT_TIMEBASE_TIMERFD
+
+/*
+ * Local helper: read CLOCK_MONOTONIC in nanoseconds
+ */
+static uint64 soft_timebase_now_nsec(void)
+{
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return ((uint64)now.tv_sec * SOFT_TIMEBASE_NSEC_PER_SEC) + (uint64)now.tv_nsec;
+}
+
+/*
+ * Local helper: clear the accumulated statistics
+ * Must be called with the stats lock held.
+ */
+static void soft_timebase_clear_stats(void)
+{
+    PSP_SoftTimebase_Global.tick_count        = 0;
+    PSP_SoftTimebase_Global.missed_ticks      = 0;
+    PSP_SoftTimebase_Global.num_wakeups       = 0;
+    PSP_SoftTimebase_Global.sum_lateness_nsec = 0;
+    PSP_SoftTimebase_Global.min_lateness_nsec = 0xFFFFFFFF;
+    PSP_SoftTimebase_Global.max_lateness_nsec = 0;
+    memset(PSP_SoftTimebase_Global.hist, 0, sizeof(PSP_SoftTimebase_Global.hist));
+}
+
+/*
+ * Local helper: Set up the scheduling of the calling (timebase) thread and
+ * arm the timer.  This is deferred to the first sync call, because that
+ * is the first time code runs in the context of the OSAL timebase thread.
+ */
+static int32 soft_timebase_timerfd_setup(void)
+{
+    struct itimerspec  spec;
+    struct sched_param param;
+    cpu_set_t          cpuset;
+    int                ret;
+
+    if (CFE_PSP_SOFT_TIMEBASE_CPU >= 0)
+    {
+        CPU_ZERO(&cpuset);
+        CPU_SET(CFE_PSP_SOFT_TIMEBASE_CPU, &cpuset);
+        ret = pthread_setaffinity_np(pthread_self(), sizeof(cpuset), &cpuset);
+        if (ret != 0)
+        {
+            OS_printf("CFE_PSP: Unable to pin software timebase to CPU %d: %s\n", (int)CFE_PSP_SOFT_TIMEBASE_CPU,
+                      strerror(ret));
+        }
+    }
+
+    if (CFE_PSP_SOFT_TIMEBASE_RT_PRIORITY > 0)
+    {
+        memset(&param, 0, sizeof(param));
+        param.sched_priority = CFE_PSP_SOFT_TIMEBASE_RT_PRIORITY;
+        ret                  = pthread_setschedparam(pthread_self(), SCHED_FIFO, &param);
+        if (ret != 0)
+        {
+            OS_printf("CFE_PSP: Unable to set SCHED_FIFO priority %d for software timebase: %s\n",
+                      (int)CFE_PSP_SOFT_TIMEBASE_RT_PRIORITY, strerror(ret));
+        }
+    }
+
+    PSP_SoftTimebase_Global.timer_fd = timerfd_create(CLOCK_MONOTONIC, TFD_CLOEXEC);
+    if (PSP_SoftTimebase_Global.timer_fd < 0)
+    {
+        return CFE_PSP_ERROR;
+    }
+
+    /*
+     * Arm with an absolute first deadline one period from now, after
+     * which the kernel maintains the deadlines at exact multiples of
+     * the period from that point, regardless of how late each wakeup is.
+     */
+    PSP_SoftTimebase_Global.next_deadline_nsec =
+        soft_timebase_now_nsec() + (CFE_PSP_SOFT_TIMEBASE_PERIOD * SOFT_TIMEBASE_NSEC_PER_USEC);
+
+    memset(&spec, 0, sizeof(spec));
+    spec.it_value.tv_sec     = PSP_SoftTimebase_Global.next_deadline_nsec / SOFT_TIMEBASE_NSEC_PER_SEC;
+    spec.it_value.tv_nsec    = PSP_SoftTimebase_Global.next_deadline_nsec % SOFT_TIMEBASE_NSEC_PER_SEC;
+    spec.it_interval.tv_sec  = CFE_PSP_SOFT_TIMEBASE_PERIOD / 1000000;
+    spec.it_interval.tv_nsec = (CFE_PSP_SOFT_TIMEBASE_PERIOD % 1000000) * SOFT_TIMEBASE_NSEC_PER_USEC;
+
+    if (timerfd_settime(PSP_SoftTimebase_Global.timer_fd, TFD_TIMER_ABSTIME, &spec, NULL) < 0)
+    {
+        close(PSP_SoftTimebase_Global.timer_fd);
+        PSP_SoftTimebase_Global.timer_fd = -1;
+        return CFE_PSP_ERROR;
+    }
+
+    return CFE_PSP_SUCCESS;
+}
+
+/*
+ * Local helper: record the lateness of one wakeup servicing the given number of periods
+ */
+static void soft_timebase_record(uint64 lateness_nsec, uint64 expirations)
+{
+    uint32 lateness;
+    uint32 bucket;
+
+    if (lateness_nsec > 0xFFFFFFFF)
+    {
+        lateness = 0xFFFFFFFF;
+    }
+    else
+    {
+        lateness = lateness_nsec;
+    }
+
+    bucket = lateness / SOFT_TIMEBASE_HIST_RES_NSEC;
+    if (bucket >= SOFT_TIMEBASE_HIST_BUCKETS)
+    {
+        bucket = SOFT_TIMEBASE_HIST_BUCKETS - 1;
+    }
+
+    pthread_mutex_lock(&PSP_SoftTimebase_Global.stats_lock);
+
+    PSP_SoftTimebase_Global.tick_count += expirations;
+    PSP_SoftTimebase_Global.missed_ticks += expirations - 1;
+    ++PSP_SoftTimebase_Global.num_wakeups;
+    PSP_SoftTimebase_Global.sum_lateness_nsec += lateness;
+    if (lateness < PSP_SoftTimebase_Global.min_lateness_nsec)
+    {
+        PSP_SoftTimebase_Global.min_lateness_nsec = lateness;
+    }
+    if (lateness > PSP_SoftTimebase_Global.max_lateness_nsec)
+    {
+        PSP_SoftTimebase_Global.max_lateness_nsec = lateness;
+    }
+    ++PSP_SoftTimebase_Global.hist[bucket];
+
+    pthread_mutex_unlock(&PSP_SoftTimebase_Global.stats_lock);
+}
+
+/*
+ * External sync function for the OSAL timebase
+ *
+ * Blocks until the next deadline, and returns the number of microseconds
+ * that elapsed in terms of whole timer periods.  If more than one period
+ * expired (i.e. the thread was delayed by more than a period) then all of
+ * them are reported, so OSAL still invokes the timer callbacks the correct
+ * number of times and time does not slip.
+ */
+static uint32 soft_timebase_timerfd_sync(osal_id_t timebase_id)
+{
+    uint64  expirations;
+    uint64  deadline;
+    uint64  now;
+    ssize_t ret;
+
+    if (PSP_SoftTimebase_Global.timer_fd < 0 && soft_timebase_timerfd_setup() != CFE_PSP_SUCCESS)
+    {
+        OS_printf("CFE_PSP: Unable to set up timerfd for software timebase: %s\n", strerror(errno));
+        OS_TaskDelay(CFE_PSP_SOFT_TIMEBASE_PERIOD / 1000);
+        return 0;
+    }
+
+    do
+    {
+        ret = read(PSP_SoftTimebase_Global.timer_fd, &expirations, sizeof(expirations));
+    } while (ret < 0 && errno == EINTR);
+
+    now = soft_timebase_now_nsec();
+
+    if (ret != sizeof(expirations) || expirations == 0)
+    {
+        return 0;
+    }
+
+    /* The deadline of the most recent expiration is the one this wakeup is late against */
+    deadline = PSP_SoftTimebase_Global.next_deadline_nsec +
+               ((expirations - 1) * CFE_PSP_SOFT_TIMEBASE_PERIOD * SOFT_TIMEBASE_NSEC_PER_USEC);
+    PSP_SoftTimebase_Global.next_deadline_nsec += expirations * CFE_PSP_SOFT_TIMEBASE_PERIOD * SOFT_TIMEBASE_NSEC_PER_USEC;
+
+    soft_timebase_record((now > deadline) ? (now - deadline) : 0, expirations);
+
+    return expirations * CFE_PSP_SOFT_TIMEBASE_PERIOD;
+}
+
+#endif /* CFE_PSP_SOFT_TIMEBASE_TIMERFD */
+
+/*
+ * Local helper: update the time read by CFE_PSP_GetTimeCoarse()
+ */
+static void soft_timebase_publish_time(void)
+{
+    OS_time_t now;
+    uint32    seq;
+
+    CFE_PSP_GetTime(&now);
+
+    seq = PSP_SoftTimebase_CoarseTime.seq;
+    __atomic_store_n(&PSP_SoftTimebase_CoarseTime.seq, seq + 1, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+
+    PSP_SoftTimebase_CoarseTime.time = now;
+
+    /* never publish a sequence of zero, which indicates no time was published */
+    seq += 2;
+    if (seq == 0)
+    {
+        seq = 2;
+    }
+    __atomic_store_n(&PSP_SoftTimebase_CoarseTime.seq, seq, __ATOMIC_RELEASE);
+}
+
+/*
+ * Callback on every tick of the master timebase
+ *
+ * Runs in the context of the master timebase thread, and invokes the callback
+ * of each derived timebase whose divider is a factor of the master tick count.
+ * The count is 64 bits so the derived ticks stay aligned for any uptime.
+ */
+static void soft_timebase_master_tick(osal_id_t timer_id, void *arg)
+{
+    PSP_SoftTimebase_Derived_t *entry;
+    uint64                      count;
+    uint32                      num_derived;
+    uint32                      i;
+
+    count       = ++PSP_SoftTimebase_Global.master_tick_count;
+    num_derived = __atomic_load_n(&PSP_SoftTimebase_Global.num_derived, __ATOMIC_ACQUIRE);
+
+    CFE_PSP_TRACE_INSTANT(CFE_PSP_TRACE_EVENT_TIMEBASE_TICK, (uint32)count);
+
+    if ((count % __atomic_load_n(&PSP_SoftTimebase_Global.coarse_divider, __ATOMIC_RELAXED)) == 0)
+    {
+        soft_timebase_publish_time();
+    }
+
+    for (i = 0; i < num_derived; ++i)
+    {
+        entry = &PSP_SoftTimebase_Global.derived[i];
+        if ((count % entry->divider) == 0)
+        {
+            entry->callback((uint32)(count / entry->divider), entry->arg);
+        }
+    }
+}
+
+/*----------------------------------------------------------------
+ *
+ * Implemented per public API
+ * See description in header file for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+int32 CFE_PSP_SoftTimebase_AddDerived(const char *Name, uint32 Divider, CFE_PSP_SoftTimebase_Callback_t Callback,
+                                      void *Arg)
+{
+    PSP_SoftTimebase_Derived_t *entry;
+    int32                       status;
+
+    if (Name == NULL || Callback == NULL)
+    {
+        return CFE_PSP_INVALID_POINTER;
+    }
+
+    if (Divider == 0 || strlen(Name) >= OS_MAX_API_NAME || (0xFFFFFFFF / Divider) < CFE_PSP_SOFT_TIMEBASE_PERIOD)
+    {
+        return CFE_PSP_ERROR;
+    }
+
+    if (!OS_ObjectIdDefined(PSP_SoftTimebase_Global.master_timer_id) ||
+        OS_MutSemTake(PSP_SoftTimebase_Global.derived_lock) != OS_SUCCESS)
+    {
+        return CFE_PSP_ERROR;
+    }
+
+    if (PSP_SoftTimebase_Global.num_derived >= CFE_PSP_SOFT_TIMEBASE_MAX_DERIVED)
+    {
+        OS_DEBUG("CFE_PSP: *** No slot for derived timebase \'%s\' ***\n", Name);
+        status = CFE_PSP_ERROR;
+    }
+    else
+    {
+        entry = &PSP_SoftTimebase_Global.derived[PSP_SoftTimebase_Global.num_derived];
+
+        memset(entry, 0, sizeof(*entry));
+        strncpy(entry->name, Name, sizeof(entry->name) - 1);
+        entry->divider  = Divider;
+        entry->callback = Callback;
+        entry->arg      = Arg;
+
+        /* Start servicing this timebase from the master tick */
+        __atomic_store_n(&PSP_SoftTimebase_Global.num_derived, PSP_SoftTimebase_Global.num_derived + 1,
+                         __ATOMIC_RELEASE);
+
+        OS_DEBUG("CFE_PSP: Added derived timebase \'%s\' running at %lu usec\n", entry->name,
+                 (unsigned long)(Divider * CFE_PSP_SOFT_TIMEBASE_PERIOD));
+        status = CFE_PSP_SUCCESS;
+    }
+
+    OS_MutSemGive(PSP_SoftTimebase_Global.derived_lock);
+
+    return status;
+}
+
+/*
+ * Local helper: find a module which provides the time source of the timebase
+ *
+ * This scans the module lists directly, because CFE_PSP_Module_FindByName()
+ * is not usable until all modules have been initialized.
+ */
+static OS_TimerSync_t soft_timebase_find_source(void)
+{
+    CFE_StaticModuleLoadEntry_t *entry;
+    CFE_PSP_ModuleApi_t         *api;
+    CFE_StaticModuleLoadEntry_t *lists[2];
+    uint32                       i;
+
+    lists[0] = CFE_PSP_BASE_MODULE_LIST;
+    lists[1] = GLOBAL_CONFIGDATA.PspModuleList;
+
+    for (i = 0; i < 2; ++i)
+    {
+        for (entry = lists[i]; entry != NULL && entry->Name != NULL; ++entry)
+        {
+            api = (CFE_PSP_ModuleApi_t *)entry->Api;
+            if (api->ModuleType == CFE_PSP_MODULE_TYPE_TIMEBASE_SOURCE && api->ExtendedApi != NULL)
+            {
+                return ((CFE_PSP_TimebaseSourceApi_t *)api->ExtendedApi)->SyncFunc;
+            }
+        }
+    }
+
+    return NULL;
+}
+
 void soft_timebase_Init(uint32 PspModuleId)
 {
-    int32 status;
+    int32          status;
+    OS_TimerSync_t sync_func;
+#ifdef CFE_PSP_SOFT_TIMEBASE_DERIVED_LIST
+    uint32         i;
+#endif
 
     memset(&PSP_SoftTimebase_Global, 0, sizeof(PSP_SoftTimebase_Global));
 
+    PSP_SoftTimebase_Global.coarse_divider = SOFT_TIMEBASE_COARSE_DIVIDER;
+
+#ifdef CFE_PSP_SOFT_TIMEBASE_TIMERFD
+    PSP_SoftTimebase_Global.timer_fd = -1;
+    pthread_mutex_init(&PSP_SoftTimebase_Global.stats_lock, NULL);
+    soft_timebase_clear_stats();
+#endif
+
+    /*
+     * If another module provides the time source (e.g. virtual time) then use it,
+     * otherwise this is driven by the real time clock.
+     */
+    sync_func = soft_timebase_find_source();
+    if (sync_func != NULL)
+    {
+        OS_DEBUG("CFE_PSP: Software timebase \'%s\' is driven by an external time source\n",
+                 CFE_PSP_SOFT_TIMEBASE_NAME);
+    }
+    else
+    {
+#ifdef CFE_PSP_SOFT_TIMEBASE_TIMERFD
+        sync_func = soft_timebase_timerfd_sync;
+#endif
+    }
+
     /* Set up the OSAL timebase using the well-known name */
-    status = OS_TimeBaseCreate(&PSP_SoftTimebase_Global.sys_timebase_id, CFE_PSP_SOFT_TIMEBASE_NAME, NULL);
+    status = OS_TimeBaseCreate(&PSP_SoftTimebase_Global.sys_timebase_id, CFE_PSP_SOFT_TIMEBASE_NAME, sync_func);
     if (status == OS_SUCCESS)
     {
         /* Set the timebase to trigger with desired resolution */
@@ -89,5 +597,166 @@ void soft_timebase_Init(uint32 PspModuleId)
         /* Inform the user that this module is in use */
         OS_DEBUG("CFE_PSP: Instantiated software timebase \'%s\' running at %lu usec\n", CFE_PSP_SOFT_TIMEBASE_NAME,
                (unsigned long)CFE_PSP_SOFT_TIMEBASE_PERIOD);
+
+        /*
+         * Set up the master tick callback, which drives the derived timebases.
+         */
+        status = OS_MutSemCreate(&PSP_SoftTimebase_Global.derived_lock, "PSP-Derived", 0);
+        if (status == OS_SUCCESS)
+        {
+            status = OS_TimerAdd(&PSP_SoftTimebase_Global.master_timer_id, "PSP-MasterTick",
+                                 PSP_SoftTimebase_Global.sys_timebase_id, soft_timebase_master_tick, NULL);
+        }
+        if (status == OS_SUCCESS)
+        {
+            status = OS_TimerSet(PSP_SoftTimebase_Global.master_timer_id, CFE_PSP_SOFT_TIMEBASE_PERIOD,
+                                 CFE_PSP_SOFT_TIMEBASE_PERIOD);
+        }
+        if (status != OS_SUCCESS)
+        {
+            OS_DEBUG("CFE_PSP: *** Failed to set up master tick for software timebase \'%s\', status = %d! ***\n",
+                     CFE_PSP_SOFT_TIMEBASE_NAME, (int)status);
+            PSP_SoftTimebase_Global.master_timer_id = OS_OBJECT_ID_UNDEFINED;
+        }
+
+#ifdef CFE_PSP_SOFT_TIMEBASE_DERIVED_LIST
+        for (i = 0; i < (sizeof(PSP_SoftTimebase_DerivedConfig) / sizeof(PSP_SoftTimebase_DerivedConfig[0])); ++i)
+        {
+            CFE_PSP_SoftTimebase_AddDerived(PSP_SoftTimebase_DerivedConfig[i].Name,
+                                            PSP_SoftTimebase_DerivedConfig[i].Divider,
+                                            PSP_SoftTimebase_DerivedConfig[i].Callback,
+                                            PSP_SoftTimebase_DerivedConfig[i].Arg);
+        }
+#endif
     }
 }
+
+/*----------------------------------------------------------------
+ *
+ * Implemented per public API
+ * See description in header file for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+void CFE_PSP_GetTimeCoarse(OS_time_t *LocalTime)
+{
+    uint32 seq_start;
+    uint32 seq_end;
+
+    do
+    {
+        seq_start = __atomic_load_n(&PSP_SoftTimebase_CoarseTime.seq, __ATOMIC_ACQUIRE);
+        if (seq_start == 0)
+        {
+            /* nothing published yet (master tick not running), so read the real time */
+            CFE_PSP_GetTime(LocalTime);
+            return;
+        }
+
+        *LocalTime = PSP_SoftTimebase_CoarseTime.time;
+
+        __atomic_thread_fence(__ATOMIC_ACQUIRE);
+        seq_end = __atomic_load_n(&PSP_SoftTimebase_CoarseTime.seq, __ATOMIC_RELAXED);
+    } while ((seq_start & 1) != 0 || seq_start != seq_end);
+}
+
+/*----------------------------------------------------------------
+ *
+ * Implemented per public API
+ * See description in header file for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+void CFE_PSP_SoftTimebase_SetCoarsePeriod(uint32 PeriodUsec)
+{
+    uint32 divider;
+
+    divider = PeriodUsec / CFE_PSP_SOFT_TIMEBASE_PERIOD;
+    if (divider == 0)
+    {
+        divider = 1;
+    }
+
+    __atomic_store_n(&PSP_SoftTimebase_Global.coarse_divider, divider, __ATOMIC_RELAXED);
+}
+
+/*----------------------------------------------------------------
+ *
+ * Implemented per public API
+ * See description in header file for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+int32 CFE_PSP_SoftTimebase_GetStats(CFE_PSP_SoftTimebase_Stats_t *Stats)
+{
+#ifdef CFE_PSP_SOFT_TIMEBASE_TIMERFD
+    uint64 threshold;
+    uint64 cumulative;
+    uint32 bucket;
+
+    if (Stats == NULL)
+    {
+        return CFE_PSP_INVALID_POINTER;
+    }
+
+    memset(Stats, 0, sizeof(*Stats));
+
+    pthread_mutex_lock(&PSP_SoftTimebase_Global.stats_lock);
+
+    Stats->TickCount   = PSP_SoftTimebase_Global.tick_count;
+    Stats->MissedTicks = PSP_SoftTimebase_Global.missed_ticks;
+    Stats->NumWakeups  = PSP_SoftTimebase_Global.num_wakeups;
+
+    if (PSP_SoftTimebase_Global.num_wakeups != 0)
+    {
+        Stats->MinLatenessNsec  = PSP_SoftTimebase_Global.min_lateness_nsec;
+        Stats->MaxLatenessNsec  = PSP_SoftTimebase_Global.max_lateness_nsec;
+        Stats->MeanLatenessNsec = PSP_SoftTimebase_Global.sum_lateness_nsec / PSP_SoftTimebase_Global.num_wakeups;
+
+        /* report the upper edge of the bucket containing the 99th percentile */
+        threshold  = ((PSP_SoftTimebase_Global.num_wakeups * 99) + 99) / 100;
+        cumulative = 0;
+        for (bucket = 0; bucket < (SOFT_TIMEBASE_HIST_BUCKETS - 1); ++bucket)
+        {
+            cumulative += PSP_SoftTimebase_Global.hist[bucket];
+            if (cumulative >= threshold)
+            {
+                break;
+            }
+        }
+
+        if (bucket < (SOFT_TIMEBASE_HIST_BUCKETS - 1))
+        {
+            Stats->P99LatenessNsec = (bucket + 1) * SOFT_TIMEBASE_HIST_RES_NSEC;
+        }
+        else
+        {
+            /* beyond the histogram range, the max is the best available bound */
+            Stats->P99LatenessNsec = PSP_SoftTimebase_Global.max_lateness_nsec;
+        }
+
+        if (Stats->P99LatenessNsec > Stats->MaxLatenessNsec)
+        {
+            Stats->P99LatenessNsec = Stats->MaxLatenessNsec;
+        }
+    }
+
+    pthread_mutex_unlock(&PSP_SoftTimebase_Global.stats_lock);
+
+    return CFE_PSP_SUCCESS;
+#else
+    return CFE_PSP_ERROR_NOT_IMPLEMENTED;
+#endif
+}
+
+/*----------------------------------------------------------------
+ *
+ * Implemented per public API
+ * See description in header file for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+void CFE_PSP_SoftTimebase_ResetStats(void)
+{
+#ifdef CFE_PSP_SOFT_TIMEBASE_TIMERFD
+    pthread_mutex_lock(&PSP_SoftTimebase_Global.stats_lock);
+    soft_timebase_clear_stats();
+    pthread_mutex_unlock(&PSP_SoftTimebase_Global.stats_lock);
+#endif
+}
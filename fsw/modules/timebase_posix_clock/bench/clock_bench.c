@@ -0,0 +1,117 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,719-1, and identified as “core Flight System: Bootes”
+ *
+ * Copyright (c) 2020 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ************************************************************************/
+
+/**
+ * \file
+ *
+ * Host benchmark for the clocks selectable in the timebase_posix_clock module
+ *
+ * For each clock this reports the resolution from clock_getres(), the
+ * per-call cost of clock_gettime(), and the smallest nonzero step actually
+ * observed between consecutive reads.
+ *
+ * This is standalone and not part of the CFE build.  To build and run:
+ *
+ *    cc -O2 -o clock_bench clock_bench.c
+ *    ./clock_bench [iterations]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <time.h>
+
+#define CLOCK_BENCH_DEFAULT_ITERATIONS 10000000
+
+typedef struct
+{
+    const char *Name;
+    clockid_t   ClockId;
+} clock_bench_entry_t;
+
+static const clock_bench_entry_t clock_bench_table[] = {
+    {"MONOTONIC", CLOCK_MONOTONIC},
+#ifdef CLOCK_MONOTONIC_COARSE
+    {"MONOTONIC_COARSE", CLOCK_MONOTONIC_COARSE},
+#endif
+#ifdef CLOCK_MONOTONIC_RAW
+    {"MONOTONIC_RAW", CLOCK_MONOTONIC_RAW},
+#endif
+#ifdef CLOCK_BOOTTIME
+    {"BOOTTIME", CLOCK_BOOTTIME},
+#endif
+    {NULL, 0}};
+
+static uint64_t clock_bench_nsec(clockid_t ClockId)
+{
+    struct timespec now;
+
+    clock_gettime(ClockId, &now);
+    return ((uint64_t)now.tv_sec * 1000000000ULL) + (uint64_t)now.tv_nsec;
+}
+
+int main(int argc, char *argv[])
+{
+    const clock_bench_entry_t *Entry;
+    struct timespec            res;
+    uint64_t                   iterations;
+    uint64_t                   i;
+    uint64_t                   start;
+    uint64_t                   prev;
+    uint64_t                   curr;
+    uint64_t                   min_step;
+    double                     cost;
+
+    iterations = (argc > 1) ? strtoull(argv[1], NULL, 0) : CLOCK_BENCH_DEFAULT_ITERATIONS;
+    if (iterations == 0)
+    {
+        iterations = CLOCK_BENCH_DEFAULT_ITERATIONS;
+    }
+
+    printf("%-18s %14s %12s %16s\n", "clock", "getres_ns", "ns/call", "min_step_ns");
+
+    for (Entry = clock_bench_table; Entry->Name != NULL; ++Entry)
+    {
+        if (clock_getres(Entry->ClockId, &res) != 0)
+        {
+            printf("%-18s %14s\n", Entry->Name, "unsupported");
+            continue;
+        }
+
+        /* cost is measured against CLOCK_MONOTONIC, so it is independent of the clock resolution */
+        min_step = UINT64_MAX;
+        prev     = clock_bench_nsec(Entry->ClockId);
+        start    = clock_bench_nsec(CLOCK_MONOTONIC);
+        for (i = 0; i < iterations; ++i)
+        {
+            curr = clock_bench_nsec(Entry->ClockId);
+            if (curr != prev && (curr - prev) < min_step)
+            {
+                min_step = curr - prev;
+            }
+            prev = curr;
+        }
+        cost = (double)(clock_bench_nsec(CLOCK_MONOTONIC) - start) / (double)iterations;
+
+        printf("%-18s %14llu %12.2f %16llu\n", Entry->Name,
+               (unsigned long long)res.tv_sec * 1000000000ULL + (unsigned long long)res.tv_nsec, cost,
+               (unsigned long long)((min_step == UINT64_MAX) ? 0 : min_step));
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -29,9 +29,9 @@
  * changes and is not settable.
  *
  * The POSIX interface uses a "struct timespec" which has units in
- * nanoseconds, but this is converted down to units of microseconds for
- * consistency with previous versions of PSP where CFE_PSP_Get_Timebase()
- * returned units of microseconds.
+ * nanoseconds.  The lower 32 bits of CFE_PSP_Get_Timebase() are reported
+ * in units of the resolution of the selected clock, as reported by
+ * clock_getres(), which is nanoseconds for a high resolution clock.
  */
 
 /*
@@ -39,13 +39,16 @@
 */
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+#include <strings.h>
 #include <time.h>
 
 #include "cfe_psp.h"
 #include "cfe_psp_module.h"
+#include "cfe_psp_config.h"
 
 /*
- * The specific clock ID to use with clock_gettime
+ * The default clock ID to use with clock_gettime
  *
  * Linux provides some special (non-posix) clock IDs that also
  * could be relevant/useful:
@@ -56,15 +59,152 @@
  *
  * Defaulting to the POSIX-specified "MONOTONIC" but it should be possible to use
  * one of the Linux-specific variants if the target system provides it.
+ *
+ * This default may be overridden at compile time, or at startup by setting the
+ * environment variable named by CFE_PSP_TIMEBASE_CLOCK_ENV to one of the names
+ * in the table below (the pc-linux PSP sets this from its --timebase-clock option).
  */
+#ifndef CFE_PSP_TIMEBASE_REF_CLOCK
 #define CFE_PSP_TIMEBASE_REF_CLOCK CLOCK_MONOTONIC
+#endif
+
+#ifndef CFE_PSP_TIMEBASE_CLOCK_ENV
+#define CFE_PSP_TIMEBASE_CLOCK_ENV "CFE_PSP_TIMEBASE_CLOCK"
+#endif
+
+#define CFE_PSP_TIMEBASE_NSEC_PER_SEC 1000000000
+
+typedef struct
+{
+    const char *Name;
+    clockid_t   ClockId;
+} PSP_PosixClock_Entry_t;
+
+typedef struct
+{
+    clockid_t ClockId;
+    uint32    ResolutionNsec;
+    uint32    TicksPerSecond;
+    uint32    Low32Rollover;
+} PSP_PosixClock_Timebase_Global_t;
+
+/*
+ * The clocks that may be selected at startup, by name
+ */
+static const PSP_PosixClock_Entry_t PSP_PosixClock_Table[] = {
+    {"MONOTONIC", CLOCK_MONOTONIC},
+#ifdef CLOCK_MONOTONIC_COARSE
+    {"MONOTONIC_COARSE", CLOCK_MONOTONIC_COARSE},
+#endif
+#ifdef CLOCK_MONOTONIC_RAW
+    {"MONOTONIC_RAW", CLOCK_MONOTONIC_RAW},
+#endif
+#ifdef CLOCK_BOOTTIME
+    {"BOOTTIME", CLOCK_BOOTTIME},
+#endif
+    {NULL, 0}};
+
+/*
+ * The clock in use, and its resolution
+ *
+ * Statically initialized to nanosecond units, so the time API works
+ * before the module init routine has run.
+ */
+static PSP_PosixClock_Timebase_Global_t PSP_PosixClock_Timebase_Global = {
+    .ClockId        = CFE_PSP_TIMEBASE_REF_CLOCK,
+    .ResolutionNsec = 1,
+    .TicksPerSecond = CFE_PSP_TIMEBASE_NSEC_PER_SEC,
+    .Low32Rollover  = CFE_PSP_TIMEBASE_NSEC_PER_SEC,
+};
 
 CFE_PSP_MODULE_DECLARE_SIMPLE(timebase_posix_clock);
 
+/*
+ * ----------------------------------------------------------------------
+ * Local helper: Find the clock ID corresponding to a name
+ *
+ * The "CLOCK_" prefix is optional, and matching is not case sensitive.
+ * ----------------------------------------------------------------------
+ */
+static const PSP_PosixClock_Entry_t *timebase_posix_clock_Lookup(const char *Name)
+{
+    const PSP_PosixClock_Entry_t *Entry;
+
+    if (strncasecmp(Name, "CLOCK_", 6) == 0)
+    {
+        Name += 6;
+    }
+
+    for (Entry = PSP_PosixClock_Table; Entry->Name != NULL; ++Entry)
+    {
+        if (strcasecmp(Name, Entry->Name) == 0)
+        {
+            return Entry;
+        }
+    }
+
+    return NULL;
+}
+
 void timebase_posix_clock_Init(uint32 PspModuleId)
 {
+    const PSP_PosixClock_Entry_t *Entry;
+    const char                   *ClockName;
+    struct timespec               res;
+
+    ClockName = getenv(CFE_PSP_TIMEBASE_CLOCK_ENV);
+    if (ClockName != NULL && ClockName[0] != 0)
+    {
+        Entry = timebase_posix_clock_Lookup(ClockName);
+        if (Entry == NULL)
+        {
+            printf("CFE_PSP: Unknown timebase clock '%s', using default\n", ClockName);
+        }
+        else if (clock_getres(Entry->ClockId, &res) != 0)
+        {
+            printf("CFE_PSP: Timebase clock '%s' not supported, using default\n", ClockName);
+        }
+        else
+        {
+            PSP_PosixClock_Timebase_Global.ClockId = Entry->ClockId;
+            ClockName                              = Entry->Name;
+        }
+    }
+    else
+    {
+        ClockName = "default";
+    }
+
+    /*
+     * The lower 32 bits of the timebase are reported in units of the
+     * clock resolution, so that consumers of CFE_PSP_GetTimerTicksPerSecond()
+     * see the real granularity of the selected clock.
+     *
+     * The tick is rounded up to the nearest divisor of one second, so that
+     * a whole number of ticks make up each second and the tick count wraps
+     * at exactly TicksPerSecond.
+     */
+    if (clock_getres(PSP_PosixClock_Timebase_Global.ClockId, &res) == 0 && res.tv_sec == 0 && res.tv_nsec > 0)
+    {
+        PSP_PosixClock_Timebase_Global.ResolutionNsec = res.tv_nsec;
+    }
+    else
+    {
+        PSP_PosixClock_Timebase_Global.ResolutionNsec = 1;
+    }
+
+    while ((CFE_PSP_TIMEBASE_NSEC_PER_SEC % PSP_PosixClock_Timebase_Global.ResolutionNsec) != 0)
+    {
+        ++PSP_PosixClock_Timebase_Global.ResolutionNsec;
+    }
+
+    PSP_PosixClock_Timebase_Global.TicksPerSecond =
+        CFE_PSP_TIMEBASE_NSEC_PER_SEC / PSP_PosixClock_Timebase_Global.ResolutionNsec;
+    PSP_PosixClock_Timebase_Global.Low32Rollover = PSP_PosixClock_Timebase_Global.TicksPerSecond;
+
     /* Inform the user that this module is in use */
-    printf("CFE_PSP: Using POSIX monotonic clock as CFE timebase\n");
+    printf("CFE_PSP: Using POSIX monotonic clock (%s, resolution %lu ns) as CFE timebase\n", ClockName,
+           (unsigned long)PSP_PosixClock_Timebase_Global.ResolutionNsec);
 }
 
 /*
@@ -72,7 +212,8 @@ void timebase_posix_clock_Init(uint32 PspModuleId)
  * The CFE_PSP_Get_Timebase() is a wrapper around clock_gettime()
  *
  * Reads the value of the monotonic POSIX clock, and output the value with
- * the whole seconds in the upper 32 and nanoseconds in the lower 32.
+ * the whole seconds in the upper 32 and units of the clock resolution
+ * (nanoseconds for a high resolution clock) in the lower 32.
  *
  * This variant does minimal conversions - just enough to meet the API.
  * For a normalized output use CFE_PSP_GetTime()
@@ -82,7 +223,7 @@ void CFE_PSP_Get_Timebase(uint32 *Tbu, uint32 *Tbl)
 {
     struct timespec now;
 
-    if (clock_gettime(CFE_PSP_TIMEBASE_REF_CLOCK, &now) != 0)
+    if (clock_gettime(PSP_PosixClock_Timebase_Global.ClockId, &now) != 0)
     {
         /* unlikely - but avoids undefined behavior */
         now.tv_sec  = 0;
@@ -90,7 +231,14 @@ void CFE_PSP_Get_Timebase(uint32 *Tbu, uint32 *Tbl)
     }
 
     *Tbu = now.tv_sec & 0xFFFFFFFF;
-    *Tbl = now.tv_nsec;
+    if (PSP_PosixClock_Timebase_Global.ResolutionNsec == 1)
+    {
+        *Tbl = now.tv_nsec;
+    }
+    else
+    {
+        *Tbl = now.tv_nsec / PSP_PosixClock_Timebase_Global.ResolutionNsec;
+    }
 }
 
 /*
@@ -105,7 +253,7 @@ void CFE_PSP_GetTime(OS_time_t *LocalTime)
 {
     struct timespec now;
 
-    if (clock_gettime(CFE_PSP_TIMEBASE_REF_CLOCK, &now) != 0)
+    if (clock_gettime(PSP_PosixClock_Timebase_Global.ClockId, &now) != 0)
     {
         /* unlikely - but avoids undefined behavior */
         now.tv_sec  = 0;
@@ -123,8 +271,8 @@ void CFE_PSP_GetTime(OS_time_t *LocalTime)
  *-----------------------------------------------------------------*/
 uint32 CFE_PSP_GetTimerTicksPerSecond(void)
 {
-    /* POSIX "struct timespec" resolution is defined as nanoseconds */
-    return 1000000000;
+    /* Lower 32 bits of the timebase are in units of the clock resolution */
+    return PSP_PosixClock_Timebase_Global.TicksPerSecond;
 }
 
 /*----------------------------------------------------------------
@@ -135,6 +283,6 @@ uint32 CFE_PSP_GetTimerTicksPerSecond(void)
  *-----------------------------------------------------------------*/
 uint32 CFE_PSP_GetTimerLow32Rollover(void)
 {
-    /* POSIX "struct timespec" resolution is defined as nanoseconds */
-    return 1000000000;
+    /* Lower 32 bits of the timebase are in units of the clock resolution */
+    return PSP_PosixClock_Timebase_Global.Low32Rollover;
 }
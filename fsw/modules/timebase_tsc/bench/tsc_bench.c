@@ -0,0 +1,141 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,719-1, and identified as “core Flight System: Bootes”
+ *
+ * Copyright (c) 2020 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ************************************************************************/
+
+/**
+ * \file
+ *
+ * Host benchmark for the timebase_tsc module
+ *
+ * Measures the per-call cost of a CLOCK_MONOTONIC read against a calibrated
+ * TSC read + conversion, using the same routines as the PSP module, then
+ * optionally tracks the drift of the converted TSC time relative to
+ * CLOCK_MONOTONIC over a longer run, both with the initial calibration only
+ * and with the periodic re-synchronization that the module does.
+ *
+ * This is standalone and not part of the CFE build.  To build and run:
+ *
+ *    cc -O2 -o tsc_bench tsc_bench.c
+ *    ./tsc_bench [drift_seconds] [report_interval_seconds]
+ *
+ * For example "./tsc_bench 14400 60" reports the drift every minute for 4 hours.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <time.h>
+
+#include "../timebase_tsc.h"
+
+#define TSC_BENCH_ITERATIONS 10000000
+
+static volatile uint64_t tsc_bench_sink;
+
+static double tsc_bench_elapsed(uint64_t start_nsec)
+{
+    return (double)(timebase_tsc_monotonic_nsec() - start_nsec);
+}
+
+int main(int argc, char *argv[])
+{
+    timebase_tsc_state_t       state;
+    timebase_tsc_calibration_t cal;
+    uint64_t                   start;
+    uint64_t                   next_report;
+    uint64_t                   drift_secs;
+    uint64_t                   report_secs;
+    uint64_t                   elapsed;
+    uint64_t                   tsc;
+    uint64_t                   mono;
+    int64_t                    offset;
+    int64_t                    resync_offset;
+    uint32_t                   i;
+
+    drift_secs  = (argc > 1) ? strtoull(argv[1], NULL, 0) : 0;
+    report_secs = (argc > 2) ? strtoull(argv[2], NULL, 0) : 10;
+    if (report_secs == 0)
+    {
+        report_secs = 1;
+    }
+
+    if (!timebase_tsc_init_state(&state, TIMEBASE_TSC_CALIBRATION_MSEC))
+    {
+        printf("TSC is not invariant or not available on this host\n");
+        return EXIT_FAILURE;
+    }
+
+    cal = state.cal[0];
+    printf("Calibrated TSC rate: %.3f MHz (mult=%llu, shift=%d)\n",
+           ((double)(1ULL << TIMEBASE_TSC_MULT_SHIFT) * 1000.0) / (double)cal.mult, (unsigned long long)cal.mult,
+           TIMEBASE_TSC_MULT_SHIFT);
+
+    start = timebase_tsc_monotonic_nsec();
+    for (i = 0; i < TSC_BENCH_ITERATIONS; ++i)
+    {
+        tsc_bench_sink = timebase_tsc_monotonic_nsec();
+    }
+    printf("clock_gettime(CLOCK_MONOTONIC): %6.2f ns/call\n", tsc_bench_elapsed(start) / TSC_BENCH_ITERATIONS);
+
+    start = timebase_tsc_monotonic_nsec();
+    for (i = 0; i < TSC_BENCH_ITERATIONS; ++i)
+    {
+        tsc_bench_sink = timebase_tsc_to_nsec(&cal, timebase_tsc_read());
+    }
+    printf("TSC read + conversion:          %6.2f ns/call\n", tsc_bench_elapsed(start) / TSC_BENCH_ITERATIONS);
+
+    start = timebase_tsc_monotonic_nsec();
+    for (i = 0; i < TSC_BENCH_ITERATIONS; ++i)
+    {
+        tsc_bench_sink = timebase_tsc_get_nsec(&state);
+    }
+    printf("With re-synchronization:        %6.2f ns/call\n", tsc_bench_elapsed(start) / TSC_BENCH_ITERATIONS);
+
+    if (drift_secs == 0)
+    {
+        return EXIT_SUCCESS;
+    }
+
+    /*
+     * Drift is reported as the converted TSC time minus CLOCK_MONOTONIC, with
+     * the initial calibration only and with re-synchronization.  The former
+     * includes any NTP adjustment applied to CLOCK_MONOTONIC since startup.
+     * The time is read every 10ms in between, as re-synchronization is done
+     * by the readers.
+     */
+    printf("\n%10s %14s %10s %14s\n", "elapsed_s", "drift_ns", "ppm", "resync_ns");
+    next_report = timebase_tsc_monotonic_nsec() + (report_secs * TIMEBASE_TSC_NSEC_PER_SEC);
+    for (elapsed = report_secs; elapsed <= drift_secs; elapsed += report_secs)
+    {
+        while (timebase_tsc_monotonic_nsec() < next_report)
+        {
+            usleep(10000);
+            tsc_bench_sink = timebase_tsc_get_nsec(&state);
+        }
+        next_report += report_secs * TIMEBASE_TSC_NSEC_PER_SEC;
+
+        timebase_tsc_sample(&tsc, &mono);
+        offset        = (int64_t)(timebase_tsc_to_nsec(&cal, tsc) - mono);
+        resync_offset = (int64_t)(timebase_tsc_get_nsec(&state) - timebase_tsc_monotonic_nsec());
+
+        printf("%10llu %14lld %10.4f %14lld\n", (unsigned long long)elapsed, (long long)offset,
+               (double)offset / (double)(mono - cal.base_nsec) * 1e6, (long long)resync_offset);
+        fflush(stdout);
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,144 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,719-1, and identified as “core Flight System: Bootes”
+ *
+ * Copyright (c) 2020 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ************************************************************************/
+
+/**
+ * \file
+ *
+ * A PSP module to satisfy the PSP time API on x86_64 systems using the
+ * processor time stamp counter (TSC).
+ *
+ * Reading the TSC is far cheaper than a clock_gettime() call, which matters
+ * for the CFE performance log that samples the timebase at very high rates.
+ *
+ * The TSC is only used if the processor reports an invariant TSC, i.e. one
+ * that runs at a constant rate regardless of power state.  Its rate is then
+ * calibrated at init against CLOCK_MONOTONIC, and TSC values are converted to
+ * nanoseconds on the CLOCK_MONOTONIC timeline with a fixed-point multiplier.
+ * The conversion is re-synchronized with CLOCK_MONOTONIC every
+ * TIMEBASE_TSC_RESYNC_MSEC, so it follows NTP frequency adjustments and does
+ * not accumulate the calibration error.
+ *
+ * If the TSC is not invariant (or not available), this module behaves like
+ * the timebase_posix_clock module and reads CLOCK_MONOTONIC directly.
+ *
+ * The outputs use the same nanosecond-based units as timebase_posix_clock.
+ */
+
+/*
+**  System Include Files
+*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "cfe_psp.h"
+#include "cfe_psp_module.h"
+
+#include "timebase_tsc.h"
+
+static timebase_tsc_state_t PSP_TSC_Timebase_Global;
+
+CFE_PSP_MODULE_DECLARE_SIMPLE(timebase_tsc);
+
+void timebase_tsc_Init(uint32 PspModuleId)
+{
+    uint64 TicksPerSecond;
+
+    if (timebase_tsc_init_state(&PSP_TSC_Timebase_Global, TIMEBASE_TSC_CALIBRATION_MSEC))
+    {
+        /* Inform the user that this module is in use, along with the calibrated rate */
+        TicksPerSecond = (((uint64)TIMEBASE_TSC_NSEC_PER_SEC) << TIMEBASE_TSC_MULT_SHIFT) /
+                         PSP_TSC_Timebase_Global.cal[0].mult;
+        printf("CFE_PSP: Using invariant TSC as CFE timebase, calibrated at %lu kHz\n",
+               (unsigned long)(TicksPerSecond / 1000));
+    }
+    else
+    {
+        printf("CFE_PSP: TSC is not invariant, using POSIX monotonic clock as CFE timebase\n");
+    }
+}
+
+/*
+ * ----------------------------------------------------------------------
+ * Local helper: Get the current time in nanoseconds, on the
+ * CLOCK_MONOTONIC timeline.
+ * ----------------------------------------------------------------------
+ */
+static inline uint64 timebase_tsc_now(void)
+{
+    if (PSP_TSC_Timebase_Global.cal[0].is_valid)
+    {
+        return timebase_tsc_get_nsec(&PSP_TSC_Timebase_Global);
+    }
+
+    return timebase_tsc_monotonic_nsec();
+}
+
+/*
+ * ----------------------------------------------------------------------
+ * The CFE_PSP_Get_Timebase() outputs the whole seconds in the upper 32
+ * and nanoseconds in the lower 32, the same as timebase_posix_clock.
+ * ----------------------------------------------------------------------
+ */
+void CFE_PSP_Get_Timebase(uint32 *Tbu, uint32 *Tbl)
+{
+    uint64 now;
+
+    now = timebase_tsc_now();
+
+    *Tbu = (now / TIMEBASE_TSC_NSEC_PER_SEC) & 0xFFFFFFFF;
+    *Tbl = now % TIMEBASE_TSC_NSEC_PER_SEC;
+}
+
+/*
+ * ----------------------------------------------------------------------
+ * The CFE_PSP_GetTime() outputs the same time normalized to an OS_time_t
+ * ----------------------------------------------------------------------
+ */
+void CFE_PSP_GetTime(OS_time_t *LocalTime)
+{
+    uint64 now;
+
+    now = timebase_tsc_now();
+
+    *LocalTime = OS_TimeAssembleFromNanoseconds(now / TIMEBASE_TSC_NSEC_PER_SEC, now % TIMEBASE_TSC_NSEC_PER_SEC);
+}
+
+/*----------------------------------------------------------------
+ *
+ * Implemented per public API
+ * See description in header file for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+uint32 CFE_PSP_GetTimerTicksPerSecond(void)
+{
+    /* Lower 32 bits of timebase are in nanoseconds */
+    return 1000000000;
+}
+
+/*----------------------------------------------------------------
+ *
+ * Implemented per public API
+ * See description in header file for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+uint32 CFE_PSP_GetTimerLow32Rollover(void)
+{
+    /* Lower 32 bits of timebase are in nanoseconds */
+    return 1000000000;
+}
@@ -0,0 +1,383 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,719-1, and identified as “core Flight System: Bootes”
+ *
+ * Copyright (c) 2020 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ************************************************************************/
+
+/**
+ * \file
+ *
+ * Internal header for cfe_psp_timebase_tsc.c
+ *
+ * Contains the TSC access, calibration and conversion routines.  These
+ * do not depend on OSAL or CFE so the same code can be used by the
+ * standalone benchmark in the "bench" subdirectory.
+ */
+
+#ifndef TIMEBASE_TSC_H_
+#define TIMEBASE_TSC_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <time.h>
+
+/*
+ * The conversion relies on a 128-bit intermediate product, so
+ * this is only enabled on x86_64.  Elsewhere the module falls
+ * back to CLOCK_MONOTONIC.
+ */
+#if defined(__x86_64__)
+#include <cpuid.h>
+#include <x86intrin.h>
+#define TIMEBASE_TSC_AVAILABLE
+#endif
+
+/********************************************************************
+ * Local Defines
+ ********************************************************************/
+
+/*
+ * Duration of the calibration interval against CLOCK_MONOTONIC
+ *
+ * The relative error of the calibrated rate is roughly the jitter of a
+ * single clock_gettime() sample divided by this interval, so 50ms gives
+ * well under 1ppm on typical hosts while keeping startup fast.
+ */
+#ifndef TIMEBASE_TSC_CALIBRATION_MSEC
+#define TIMEBASE_TSC_CALIBRATION_MSEC 50
+#endif
+
+/*
+ * Interval between re-synchronizations with CLOCK_MONOTONIC
+ *
+ * The initial calibration is only good to about 1ppm, and CLOCK_MONOTONIC is
+ * itself steered by NTP, so the conversion is corrected at this interval by
+ * the first reader to see that it has elapsed.
+ */
+#ifndef TIMEBASE_TSC_RESYNC_MSEC
+#define TIMEBASE_TSC_RESYNC_MSEC 1000
+#endif
+
+/*
+ * Largest rate change used to steer the converted time back to CLOCK_MONOTONIC
+ * over one interval, in parts per million.  The converted time is slewed rather
+ * than stepped so that it never goes backwards.
+ */
+#define TIMEBASE_TSC_MAX_SLEW_PPM 500
+
+/* Number of attempts when taking a paired TSC/CLOCK_MONOTONIC sample */
+#define TIMEBASE_TSC_SAMPLE_TRIES 8
+
+/* Fixed point shift of the TSC to nanosecond multiplier */
+#define TIMEBASE_TSC_MULT_SHIFT 32
+
+#define TIMEBASE_TSC_NSEC_PER_SEC 1000000000ULL
+
+/********************************************************************
+ * Local Type Definitions
+ ********************************************************************/
+typedef struct timebase_tsc_calibration
+{
+    bool     is_valid;
+    uint64_t base_tsc;   /* TSC value at the reference point */
+    uint64_t base_nsec;  /* converted time at the reference point, in ns */
+    uint64_t mult;       /* ns per TSC tick, scaled by 2^TIMEBASE_TSC_MULT_SHIFT */
+    uint64_t resync_tsc; /* TSC value after which the next re-synchronization is due */
+    uint64_t start_tsc;  /* TSC value at the start of the initial calibration */
+    uint64_t start_nsec; /* CLOCK_MONOTONIC at the start of the initial calibration, in ns */
+} timebase_tsc_calibration_t;
+
+/*
+ * The calibration in use, double buffered so that readers never wait: the
+ * current one is cal[seq & 1], and a re-synchronization fills in the other
+ * one before advancing seq.  Only one reader re-synchronizes at a time.
+ */
+typedef struct timebase_tsc_state
+{
+    uint32_t                   seq;
+    uint32_t                   resync_busy;
+    timebase_tsc_calibration_t cal[2];
+} timebase_tsc_state_t;
+
+/********************************************************************
+ * Inline Functions
+ ********************************************************************/
+
+static inline uint64_t timebase_tsc_read(void)
+{
+#ifdef TIMEBASE_TSC_AVAILABLE
+    return __rdtsc();
+#else
+    return 0;
+#endif
+}
+
+/*
+ * Checks for the "invariant TSC" feature (CPUID 0x80000007, EDX bit 8),
+ * which indicates the TSC runs at a constant rate in all ACPI P/C/T states.
+ * Without this the TSC is not usable as a timebase.
+ */
+static inline bool timebase_tsc_is_invariant(void)
+{
+#ifdef TIMEBASE_TSC_AVAILABLE
+    unsigned int eax, ebx, ecx, edx;
+
+    if (__get_cpuid(0x80000000, &eax, &ebx, &ecx, &edx) == 0 || eax < 0x80000007)
+    {
+        return false;
+    }
+
+    if (__get_cpuid(0x80000007, &eax, &ebx, &ecx, &edx) == 0)
+    {
+        return false;
+    }
+
+    return ((edx >> 8) & 1) != 0;
+#else
+    return false;
+#endif
+}
+
+static inline uint64_t timebase_tsc_monotonic_nsec(void)
+{
+    struct timespec now;
+
+    if (clock_gettime(CLOCK_MONOTONIC, &now) != 0)
+    {
+        return 0;
+    }
+
+    return ((uint64_t)now.tv_sec * TIMEBASE_TSC_NSEC_PER_SEC) + (uint64_t)now.tv_nsec;
+}
+
+/*
+ * Take a paired sample of the TSC and CLOCK_MONOTONIC
+ *
+ * The clock read is bracketed by two TSC reads, and the attempt with the
+ * narrowest bracket is kept so a preemption during one attempt does not
+ * skew the calibration.  The TSC value is the midpoint of the bracket.
+ */
+static inline void timebase_tsc_sample(uint64_t *tsc, uint64_t *nsec)
+{
+    uint64_t t0;
+    uint64_t t1;
+    uint64_t ns;
+    uint64_t best_width;
+    int      i;
+
+    *tsc       = 0;
+    *nsec      = 0;
+    best_width = UINT64_MAX;
+    for (i = 0; i < TIMEBASE_TSC_SAMPLE_TRIES; ++i)
+    {
+        t0 = timebase_tsc_read();
+        ns = timebase_tsc_monotonic_nsec();
+        t1 = timebase_tsc_read();
+
+        if ((t1 - t0) < best_width)
+        {
+            best_width = t1 - t0;
+            *tsc       = t0 + ((t1 - t0) / 2);
+            *nsec      = ns;
+        }
+    }
+}
+
+/*
+ * Calibrate the TSC rate against CLOCK_MONOTONIC over the given interval
+ *
+ * On success the reference point is the end of the interval, so converted
+ * values continue on from CLOCK_MONOTONIC with the same epoch.
+ */
+static inline bool timebase_tsc_calibrate(timebase_tsc_calibration_t *cal, uint32_t interval_msec)
+{
+    struct timespec delay;
+    uint64_t        tsc_start;
+    uint64_t        nsec_start;
+    uint64_t        tsc_end;
+    uint64_t        nsec_end;
+
+    cal->is_valid = false;
+
+    if (!timebase_tsc_is_invariant())
+    {
+        return false;
+    }
+
+    delay.tv_sec  = interval_msec / 1000;
+    delay.tv_nsec = (interval_msec % 1000) * 1000000L;
+
+    timebase_tsc_sample(&tsc_start, &nsec_start);
+    while (nanosleep(&delay, &delay) != 0)
+    {
+        /* resume after signal interruption */
+    }
+    timebase_tsc_sample(&tsc_end, &nsec_end);
+
+    if (tsc_end <= tsc_start || nsec_end <= nsec_start)
+    {
+        return false;
+    }
+
+#ifdef TIMEBASE_TSC_AVAILABLE
+    cal->mult = (uint64_t)((((unsigned __int128)(nsec_end - nsec_start)) << TIMEBASE_TSC_MULT_SHIFT) /
+                           (tsc_end - tsc_start));
+    cal->base_tsc   = tsc_end;
+    cal->base_nsec  = nsec_end;
+    cal->start_tsc  = tsc_start;
+    cal->start_nsec = nsec_start;
+    cal->is_valid   = (cal->mult != 0);
+    if (cal->is_valid)
+    {
+        cal->resync_tsc = tsc_end + (uint64_t)((((unsigned __int128)TIMEBASE_TSC_RESYNC_MSEC * 1000000)
+                                                << TIMEBASE_TSC_MULT_SHIFT) /
+                                               cal->mult);
+    }
+#endif
+
+    return cal->is_valid;
+}
+
+/*
+ * Convert a TSC value to nanoseconds on the CLOCK_MONOTONIC timeline
+ *
+ * The 64x64 multiply uses a 128-bit intermediate, so this does not overflow
+ * for any realistic uptime.
+ */
+static inline uint64_t timebase_tsc_to_nsec(const timebase_tsc_calibration_t *cal, uint64_t tsc)
+{
+#ifdef TIMEBASE_TSC_AVAILABLE
+    /*
+     * Guard against a reading slightly behind the reference point,
+     * e.g. from another core, which would otherwise wrap around
+     */
+    if ((int64_t)(tsc - cal->base_tsc) < 0)
+    {
+        return cal->base_nsec;
+    }
+
+    return cal->base_nsec +
+           (uint64_t)(((unsigned __int128)(tsc - cal->base_tsc) * cal->mult) >> TIMEBASE_TSC_MULT_SHIFT);
+#else
+    return cal->base_nsec;
+#endif
+}
+
+/*
+ * Re-synchronize the conversion with CLOCK_MONOTONIC
+ *
+ * The rate is measured again over the whole time since the initial
+ * calibration, which gets more accurate the longer the system runs.  The
+ * remaining offset from CLOCK_MONOTONIC is then steered out over the next
+ * interval by adjusting the rate, within TIMEBASE_TSC_MAX_SLEW_PPM, starting
+ * from the current converted time so there is no step.
+ */
+static inline void timebase_tsc_resync(timebase_tsc_state_t *state, const timebase_tsc_calibration_t *cur)
+{
+#ifdef TIMEBASE_TSC_AVAILABLE
+    timebase_tsc_calibration_t *next;
+    unsigned __int128           rate;
+    uint64_t                    tsc;
+    uint64_t                    nsec;
+    uint64_t                    conv;
+    uint64_t                    period_nsec;
+    uint64_t                    period_ticks;
+    int64_t                     offset;
+    int64_t                     max_offset;
+    uint32_t                    seq;
+
+    if (__atomic_exchange_n(&state->resync_busy, 1, __ATOMIC_ACQUIRE) != 0)
+    {
+        /* another reader is already doing it */
+        return;
+    }
+
+    seq = __atomic_load_n(&state->seq, __ATOMIC_RELAXED);
+    timebase_tsc_sample(&tsc, &nsec);
+    if (tsc > cur->base_tsc && nsec > cur->start_nsec)
+    {
+        conv = timebase_tsc_to_nsec(cur, tsc);
+        rate = (((unsigned __int128)(nsec - cur->start_nsec)) << TIMEBASE_TSC_MULT_SHIFT) / (tsc - cur->start_tsc);
+
+        period_nsec  = (uint64_t)TIMEBASE_TSC_RESYNC_MSEC * 1000000;
+        period_ticks = (rate != 0) ? (uint64_t)((((unsigned __int128)period_nsec) << TIMEBASE_TSC_MULT_SHIFT) / rate) : 0;
+
+        offset     = (int64_t)(nsec - conv);
+        max_offset = (int64_t)((period_nsec * TIMEBASE_TSC_MAX_SLEW_PPM) / 1000000);
+        if (offset > max_offset)
+        {
+            offset = max_offset;
+        }
+        else if (offset < -max_offset)
+        {
+            offset = -max_offset;
+        }
+
+        if (period_ticks != 0)
+        {
+            next             = &state->cal[(seq + 1) & 1];
+            *next            = *cur;
+            next->mult       = (uint64_t)((((unsigned __int128)(period_nsec + offset)) << TIMEBASE_TSC_MULT_SHIFT) /
+                                    period_ticks);
+            next->base_tsc   = tsc;
+            next->base_nsec  = conv;
+            next->resync_tsc = tsc + period_ticks;
+
+            __atomic_store_n(&state->seq, seq + 1, __ATOMIC_RELEASE);
+        }
+    }
+
+    __atomic_store_n(&state->resync_busy, 0, __ATOMIC_RELEASE);
+#endif
+}
+
+/*
+ * Set up the state from a calibration of the given interval
+ */
+static inline bool timebase_tsc_init_state(timebase_tsc_state_t *state, uint32_t interval_msec)
+{
+    state->seq         = 0;
+    state->resync_busy = 0;
+
+    return timebase_tsc_calibrate(&state->cal[0], interval_msec);
+}
+
+/*
+ * Get the current time in nanoseconds on the CLOCK_MONOTONIC timeline, from
+ * a state set up by timebase_tsc_init_state(), re-synchronizing when due
+ */
+static inline uint64_t timebase_tsc_get_nsec(timebase_tsc_state_t *state)
+{
+    timebase_tsc_calibration_t cal;
+    uint32_t                   seq;
+    uint64_t                   tsc;
+
+    do
+    {
+        seq = __atomic_load_n(&state->seq, __ATOMIC_ACQUIRE);
+        cal = state->cal[seq & 1];
+        __atomic_thread_fence(__ATOMIC_ACQUIRE);
+    } while (__atomic_load_n(&state->seq, __ATOMIC_RELAXED) != seq);
+
+    tsc = timebase_tsc_read();
+    if ((int64_t)(tsc - cal.resync_tsc) >= 0)
+    {
+        timebase_tsc_resync(state, &cal);
+    }
+
+    return timebase_tsc_to_nsec(&cal, tsc);
+}
+
+#endif /* TIMEBASE_TSC_H_ */
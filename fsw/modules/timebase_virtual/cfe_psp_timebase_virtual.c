@@ -0,0 +1,460 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,719-1, and identified as “core Flight System: Bootes”
+ *
+ * Copyright (c) 2020 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ************************************************************************/
+
+/**
+ * \file
+ *
+ * A PSP module that runs the system in virtual time, for simulation and test.
+ *
+ * This satisfies the PSP time API (CFE_PSP_GetTime() and CFE_PSP_Get_Timebase())
+ * from a virtual clock, and also acts as the time source of the software
+ * timebase, so the ticks that drive CFE TIME, SCH and any other OSAL timers
+ * follow the same virtual clock.  It should be used in place of the
+ * timebase_posix_clock module, together with soft_timebase.
+ *
+ * The virtual clock starts from zero and only advances in whole periods of
+ * the software timebase (CFE_PSP_SOFT_TIMEBASE_PERIOD).  There are two modes,
+ * selected by the CFE_PSP_TIMEBASE_VIRTUAL_MODE environment variable:
+ *
+ * "idle" (default):
+ *    The timebase thread runs with the SCHED_IDLE policy, so it only gets
+ *    to run when nothing else is runnable on its CPU, and it then advances the
+ *    clock by one period.  The system therefore runs as fast as it can keep up.
+ *    This only works if the software being tested shares that CPU, so the
+ *    process is pinned to a single CPU at init, before CFE creates its tasks:
+ *    the one in CFE_PSP_TIMEBASE_VIRTUAL_CPU, else CFE_PSP_SOFT_TIMEBASE_CPU
+ *    if configured, else the CPU the PSP is started on.  Otherwise the
+ *    timebase would keep an otherwise idle core busy.  The rate can be capped
+ *    with the CFE_PSP_TIMEBASE_VIRTUAL_MAX_SPEEDUP environment variable.
+ *
+ * "step":
+ *    The clock only advances when requested through a local datagram socket,
+ *    bound to the path in CFE_PSP_TIMEBASE_VIRTUAL_SOCKET.  Each request is an
+ *    ASCII decimal number of periods to advance (0 just queries the time).
+ *    Once the callbacks for all the requested periods have run, a reply with
+ *    the virtual time in nanoseconds (also ASCII decimal) is sent back to the
+ *    address of the requester, so the controller can run in lock step.
+ *    See tools/vtime_step.c for an example controller.
+ *
+ * Note that only the time API and the timebase ticks are virtual -- blocking
+ * calls with a timeout (e.g. OS_TaskDelay()) still wait in real time.
+ */
+
+/*
+**  System Include Files
+*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <errno.h>
+#include <time.h>
+#include <sched.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+
+#include "cfe_psp.h"
+#include "cfe_psp_module.h"
+#include "cfe_psp_config.h"
+
+/*
+ * Names of the environment variables that control this module
+ */
+#define CFE_PSP_TIMEBASE_VIRTUAL_MODE_ENV    "CFE_PSP_TIMEBASE_VIRTUAL_MODE"
+#define CFE_PSP_TIMEBASE_VIRTUAL_SOCKET_ENV  "CFE_PSP_TIMEBASE_VIRTUAL_SOCKET"
+#define CFE_PSP_TIMEBASE_VIRTUAL_SPEEDUP_ENV "CFE_PSP_TIMEBASE_VIRTUAL_MAX_SPEEDUP"
+#define CFE_PSP_TIMEBASE_VIRTUAL_CPU_ENV     "CFE_PSP_TIMEBASE_VIRTUAL_CPU"
+
+/*
+ * The CPU used in "idle" mode, if not set in the environment
+ * (negative for the CPU the PSP is started on)
+ */
+#ifndef CFE_PSP_SOFT_TIMEBASE_CPU
+#define CFE_PSP_SOFT_TIMEBASE_CPU -1
+#endif
+
+/*
+ * The socket path used in "step" mode, if not set in the environment
+ */
+#ifndef CFE_PSP_TIMEBASE_VIRTUAL_DEFAULT_SOCKET
+#define CFE_PSP_TIMEBASE_VIRTUAL_DEFAULT_SOCKET "./cfe_vtime.sock"
+#endif
+
+#define TIMEBASE_VIRTUAL_NSEC_PER_SEC  1000000000ULL
+#define TIMEBASE_VIRTUAL_NSEC_PER_USEC 1000ULL
+#define TIMEBASE_VIRTUAL_PERIOD_NSEC   (CFE_PSP_SOFT_TIMEBASE_PERIOD * TIMEBASE_VIRTUAL_NSEC_PER_USEC)
+#define TIMEBASE_VIRTUAL_MSG_SIZE      32
+
+typedef enum
+{
+    TIMEBASE_VIRTUAL_MODE_IDLE,
+    TIMEBASE_VIRTUAL_MODE_STEP
+} timebase_virtual_mode_t;
+
+/*
+ * Global state data for this module (not exposed publicly)
+ */
+static struct
+{
+    uint64 virtual_nsec;
+
+    volatile bool           is_initialized;
+    bool                    is_thread_setup;
+    timebase_virtual_mode_t mode;
+
+    /* "idle" mode */
+    uint32    max_speedup;
+    uint64    real_start_nsec;
+    cpu_set_t cpuset;
+
+    /* "step" mode */
+    int                sock_fd;
+    uint32             pending_steps;
+    bool               reply_pending;
+    struct sockaddr_un reply_addr;
+    socklen_t          reply_addr_len;
+} PSP_Virtual_Timebase_Global;
+
+static uint32 timebase_virtual_Sync(osal_id_t timebase_id);
+
+static CFE_PSP_TimebaseSourceApi_t timebase_virtual_SourceApi = {
+    .SyncFunc = timebase_virtual_Sync,
+};
+
+CFE_PSP_MODULE_DECLARE_TIMEBASE_SOURCE(timebase_virtual);
+
+/*
+ * ----------------------------------------------------------------------
+ * Local helper: read the real CLOCK_MONOTONIC in nanoseconds
+ * ----------------------------------------------------------------------
+ */
+static uint64 timebase_virtual_real_nsec(void)
+{
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return ((uint64)now.tv_sec * TIMEBASE_VIRTUAL_NSEC_PER_SEC) + (uint64)now.tv_nsec;
+}
+
+/*
+ * ----------------------------------------------------------------------
+ * Local helper: pin the process to a single CPU ("idle" mode)
+ *
+ * This is called from the main thread during PSP startup, so every
+ * task created afterwards inherits the same affinity.
+ * ----------------------------------------------------------------------
+ */
+static int32 timebase_virtual_PinCpu(void)
+{
+    const char *env;
+    int         cpu;
+
+    cpu = CFE_PSP_SOFT_TIMEBASE_CPU;
+
+    env = getenv(CFE_PSP_TIMEBASE_VIRTUAL_CPU_ENV);
+    if (env != NULL && env[0] != 0)
+    {
+        cpu = strtoul(env, NULL, 0);
+    }
+    else if (cpu < 0)
+    {
+        cpu = sched_getcpu();
+    }
+
+    if (cpu < 0 || cpu >= CPU_SETSIZE)
+    {
+        return CFE_PSP_ERROR;
+    }
+
+    CPU_ZERO(&PSP_Virtual_Timebase_Global.cpuset);
+    CPU_SET(cpu, &PSP_Virtual_Timebase_Global.cpuset);
+
+    if (sched_setaffinity(0, sizeof(PSP_Virtual_Timebase_Global.cpuset), &PSP_Virtual_Timebase_Global.cpuset) != 0)
+    {
+        return CFE_PSP_ERROR;
+    }
+
+    printf("CFE_PSP: Virtual timebase pinned all tasks to CPU %d\n", cpu);
+
+    return CFE_PSP_SUCCESS;
+}
+
+/*
+ * ----------------------------------------------------------------------
+ * Local helper: advance the virtual clock by one period
+ * ----------------------------------------------------------------------
+ */
+static void timebase_virtual_advance(void)
+{
+    __atomic_add_fetch(&PSP_Virtual_Timebase_Global.virtual_nsec, TIMEBASE_VIRTUAL_PERIOD_NSEC, __ATOMIC_RELEASE);
+}
+
+void timebase_virtual_Init(uint32 PspModuleId)
+{
+    struct sockaddr_un addr;
+    const char        *env;
+    const char        *path;
+
+    memset(&PSP_Virtual_Timebase_Global, 0, sizeof(PSP_Virtual_Timebase_Global));
+
+    PSP_Virtual_Timebase_Global.mode    = TIMEBASE_VIRTUAL_MODE_IDLE;
+    PSP_Virtual_Timebase_Global.sock_fd = -1;
+
+    env = getenv(CFE_PSP_TIMEBASE_VIRTUAL_SPEEDUP_ENV);
+    if (env != NULL)
+    {
+        PSP_Virtual_Timebase_Global.max_speedup = strtoul(env, NULL, 0);
+    }
+
+    env = getenv(CFE_PSP_TIMEBASE_VIRTUAL_MODE_ENV);
+    if (env != NULL && strcasecmp(env, "step") == 0)
+    {
+        path = getenv(CFE_PSP_TIMEBASE_VIRTUAL_SOCKET_ENV);
+        if (path == NULL || path[0] == 0)
+        {
+            path = CFE_PSP_TIMEBASE_VIRTUAL_DEFAULT_SOCKET;
+        }
+
+        memset(&addr, 0, sizeof(addr));
+        addr.sun_family = AF_UNIX;
+        strncpy(addr.sun_path, path, sizeof(addr.sun_path) - 1);
+
+        /* remove any stale socket from a previous run */
+        unlink(addr.sun_path);
+
+        PSP_Virtual_Timebase_Global.sock_fd = socket(AF_UNIX, SOCK_DGRAM | SOCK_CLOEXEC, 0);
+        if (PSP_Virtual_Timebase_Global.sock_fd < 0 ||
+            bind(PSP_Virtual_Timebase_Global.sock_fd, (const struct sockaddr *)&addr, sizeof(addr)) < 0)
+        {
+            perror("CFE_PSP - Cannot bind virtual time control socket");
+            CFE_PSP_Panic(CFE_PSP_ERROR);
+        }
+
+        PSP_Virtual_Timebase_Global.mode = TIMEBASE_VIRTUAL_MODE_STEP;
+        printf("CFE_PSP: Using virtual clock as CFE timebase, stepped via \'%s\'\n", addr.sun_path);
+    }
+    else
+    {
+        if (timebase_virtual_PinCpu() != CFE_PSP_SUCCESS)
+        {
+            perror("CFE_PSP - Cannot pin to a CPU for idle virtual time");
+            CFE_PSP_Panic(CFE_PSP_ERROR);
+        }
+
+        printf("CFE_PSP: Using virtual clock as CFE timebase, advancing when idle\n");
+    }
+
+    __atomic_store_n(&PSP_Virtual_Timebase_Global.is_initialized, true, __ATOMIC_RELEASE);
+}
+
+/*
+ * ----------------------------------------------------------------------
+ * Local helper: Wait for the system to go idle ("idle" mode)
+ * ----------------------------------------------------------------------
+ */
+static void timebase_virtual_WaitIdle(void)
+{
+    struct timespec delay;
+    uint64          real_elapsed;
+    uint64          virtual_elapsed;
+
+    /*
+     * As a SCHED_IDLE thread, simply getting the CPU back after
+     * yielding means nothing else was ready to run.
+     */
+    sched_yield();
+
+    /* Optionally limit the rate, relative to real time */
+    if (PSP_Virtual_Timebase_Global.max_speedup != 0)
+    {
+        real_elapsed    = timebase_virtual_real_nsec() - PSP_Virtual_Timebase_Global.real_start_nsec;
+        virtual_elapsed = __atomic_load_n(&PSP_Virtual_Timebase_Global.virtual_nsec, __ATOMIC_ACQUIRE) +
+                          TIMEBASE_VIRTUAL_PERIOD_NSEC;
+        if ((virtual_elapsed / PSP_Virtual_Timebase_Global.max_speedup) > real_elapsed)
+        {
+            real_elapsed  = (virtual_elapsed / PSP_Virtual_Timebase_Global.max_speedup) - real_elapsed;
+            delay.tv_sec  = real_elapsed / TIMEBASE_VIRTUAL_NSEC_PER_SEC;
+            delay.tv_nsec = real_elapsed % TIMEBASE_VIRTUAL_NSEC_PER_SEC;
+            nanosleep(&delay, NULL);
+        }
+    }
+}
+
+/*
+ * ----------------------------------------------------------------------
+ * Local helper: Wait for a step request ("step" mode)
+ *
+ * Returns the number of periods to advance
+ * ----------------------------------------------------------------------
+ */
+static uint32 timebase_virtual_WaitStep(void)
+{
+    char    msg[TIMEBASE_VIRTUAL_MSG_SIZE];
+    ssize_t len;
+    int     reply_len;
+
+    /*
+     * Getting here means the callbacks for all periods of the previous
+     * request have completed, so report back to the requester.
+     */
+    if (PSP_Virtual_Timebase_Global.reply_pending)
+    {
+        reply_len = snprintf(msg, sizeof(msg), "%llu\n",
+                             (unsigned long long)__atomic_load_n(&PSP_Virtual_Timebase_Global.virtual_nsec,
+                                                                 __ATOMIC_ACQUIRE));
+        sendto(PSP_Virtual_Timebase_Global.sock_fd, msg, reply_len, MSG_DONTWAIT,
+               (const struct sockaddr *)&PSP_Virtual_Timebase_Global.reply_addr,
+               PSP_Virtual_Timebase_Global.reply_addr_len);
+        PSP_Virtual_Timebase_Global.reply_pending = false;
+    }
+
+    PSP_Virtual_Timebase_Global.reply_addr_len = sizeof(PSP_Virtual_Timebase_Global.reply_addr);
+    len = recvfrom(PSP_Virtual_Timebase_Global.sock_fd, msg, sizeof(msg) - 1, 0,
+                   (struct sockaddr *)&PSP_Virtual_Timebase_Global.reply_addr,
+                   &PSP_Virtual_Timebase_Global.reply_addr_len);
+    if (len < 0)
+    {
+        if (errno != EINTR)
+        {
+            OS_TaskDelay(CFE_PSP_SOFT_TIMEBASE_PERIOD / 1000);
+        }
+        return 0;
+    }
+
+    msg[len] = 0;
+
+    /* an unbound (anonymous) requester cannot be replied to */
+    PSP_Virtual_Timebase_Global.reply_pending =
+        (PSP_Virtual_Timebase_Global.reply_addr_len > offsetof(struct sockaddr_un, sun_path));
+
+    return strtoul(msg, NULL, 10);
+}
+
+/*
+ * ----------------------------------------------------------------------
+ * External sync function for the software timebase
+ *
+ * Advances the virtual clock by one period each time it returns,
+ * according to the mode.
+ * ----------------------------------------------------------------------
+ */
+static uint32 timebase_virtual_Sync(osal_id_t timebase_id)
+{
+    struct sched_param param;
+
+    /* This may be called before the module is initialized */
+    if (!__atomic_load_n(&PSP_Virtual_Timebase_Global.is_initialized, __ATOMIC_ACQUIRE))
+    {
+        OS_TaskDelay(CFE_PSP_SOFT_TIMEBASE_PERIOD / 1000);
+        return 0;
+    }
+
+    if (!PSP_Virtual_Timebase_Global.is_thread_setup)
+    {
+        PSP_Virtual_Timebase_Global.is_thread_setup = true;
+        PSP_Virtual_Timebase_Global.real_start_nsec = timebase_virtual_real_nsec();
+
+        if (PSP_Virtual_Timebase_Global.mode == TIMEBASE_VIRTUAL_MODE_IDLE)
+        {
+            /* the timebase thread may have been created before the process was pinned */
+            if (sched_setaffinity(0, sizeof(PSP_Virtual_Timebase_Global.cpuset), &PSP_Virtual_Timebase_Global.cpuset) !=
+                0)
+            {
+                OS_printf("CFE_PSP: Unable to pin virtual timebase: %s\n", strerror(errno));
+            }
+
+            memset(&param, 0, sizeof(param));
+            if (sched_setscheduler(0, SCHED_IDLE, &param) != 0)
+            {
+                OS_printf("CFE_PSP: Unable to set SCHED_IDLE for virtual timebase: %s\n", strerror(errno));
+            }
+        }
+    }
+
+    if (PSP_Virtual_Timebase_Global.mode == TIMEBASE_VIRTUAL_MODE_STEP)
+    {
+        while (PSP_Virtual_Timebase_Global.pending_steps == 0)
+        {
+            PSP_Virtual_Timebase_Global.pending_steps = timebase_virtual_WaitStep();
+        }
+        --PSP_Virtual_Timebase_Global.pending_steps;
+    }
+    else
+    {
+        timebase_virtual_WaitIdle();
+    }
+
+    timebase_virtual_advance();
+
+    return CFE_PSP_SOFT_TIMEBASE_PERIOD;
+}
+
+/*
+ * ----------------------------------------------------------------------
+ * The CFE_PSP_Get_Timebase() outputs the virtual time with the whole
+ * seconds in the upper 32 and nanoseconds in the lower 32.
+ * ----------------------------------------------------------------------
+ */
+void CFE_PSP_Get_Timebase(uint32 *Tbu, uint32 *Tbl)
+{
+    uint64 now;
+
+    now = __atomic_load_n(&PSP_Virtual_Timebase_Global.virtual_nsec, __ATOMIC_ACQUIRE);
+
+    *Tbu = (now / TIMEBASE_VIRTUAL_NSEC_PER_SEC) & 0xFFFFFFFF;
+    *Tbl = now % TIMEBASE_VIRTUAL_NSEC_PER_SEC;
+}
+
+/*
+ * ----------------------------------------------------------------------
+ * The CFE_PSP_GetTime() outputs the virtual time normalized to an OS_time_t
+ * ----------------------------------------------------------------------
+ */
+void CFE_PSP_GetTime(OS_time_t *LocalTime)
+{
+    uint64 now;
+
+    now = __atomic_load_n(&PSP_Virtual_Timebase_Global.virtual_nsec, __ATOMIC_ACQUIRE);
+
+    *LocalTime = OS_TimeAssembleFromNanoseconds(now / TIMEBASE_VIRTUAL_NSEC_PER_SEC, now % TIMEBASE_VIRTUAL_NSEC_PER_SEC);
+}
+
+/*----------------------------------------------------------------
+ *
+ * Implemented per public API
+ * See description in header file for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+uint32 CFE_PSP_GetTimerTicksPerSecond(void)
+{
+    /* Lower 32 bits of timebase are in nanoseconds */
+    return 1000000000;
+}
+
+/*----------------------------------------------------------------
+ *
+ * Implemented per public API
+ * See description in header file for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+uint32 CFE_PSP_GetTimerLow32Rollover(void)
+{
+    /* Lower 32 bits of timebase are in nanoseconds */
+    return 1000000000;
+}
@@ -0,0 +1,106 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,719-1, and identified as “core Flight System: Bootes”
+ *
+ * Copyright (c) 2020 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ************************************************************************/
+
+/**
+ * \file
+ *
+ * Example controller for the timebase_virtual module in "step" mode
+ *
+ * Sends step requests to the virtual time control socket, and waits for
+ * each one to complete before sending the next.
+ *
+ * This is a host tool and not part of the CFE build.  To build and run:
+ *
+ *    cc -O2 -o vtime_step vtime_step.c
+ *    ./vtime_step <socket_path> <periods_per_step> [num_steps]
+ *
+ * For example "./vtime_step ./cfe_vtime.sock 100 3600" advances one hour
+ * of virtual time in 1 second steps with the default 10ms timebase period.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+
+#define VTIME_STEP_MSG_SIZE 32
+
+int main(int argc, char *argv[])
+{
+    struct sockaddr_un server;
+    struct sockaddr_un client;
+    char               msg[VTIME_STEP_MSG_SIZE];
+    unsigned long      steps;
+    unsigned long      i;
+    ssize_t            len;
+    int                fd;
+    int                status;
+
+    if (argc < 3)
+    {
+        fprintf(stderr, "usage: %s <socket_path> <periods_per_step> [num_steps]\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    steps = (argc > 3) ? strtoul(argv[3], NULL, 0) : 1;
+
+    memset(&server, 0, sizeof(server));
+    server.sun_family = AF_UNIX;
+    strncpy(server.sun_path, argv[1], sizeof(server.sun_path) - 1);
+
+    /* the client must be bound to an address to receive the replies */
+    memset(&client, 0, sizeof(client));
+    client.sun_family = AF_UNIX;
+    snprintf(client.sun_path, sizeof(client.sun_path), "/tmp/vtime_step.%d", (int)getpid());
+
+    fd = socket(AF_UNIX, SOCK_DGRAM, 0);
+    if (fd < 0 || bind(fd, (const struct sockaddr *)&client, sizeof(client)) < 0)
+    {
+        perror("socket");
+        return EXIT_FAILURE;
+    }
+
+    status = EXIT_SUCCESS;
+    for (i = 0; i < steps; ++i)
+    {
+        if (sendto(fd, argv[2], strlen(argv[2]), 0, (const struct sockaddr *)&server, sizeof(server)) < 0)
+        {
+            perror("sendto");
+            status = EXIT_FAILURE;
+            break;
+        }
+
+        len = recv(fd, msg, sizeof(msg) - 1, 0);
+        if (len < 0)
+        {
+            perror("recv");
+            status = EXIT_FAILURE;
+            break;
+        }
+
+        msg[len] = 0;
+        printf("%s", msg);
+    }
+
+    close(fd);
+    unlink(client.sun_path);
+
+    return status;
+}
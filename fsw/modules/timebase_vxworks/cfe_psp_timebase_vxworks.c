@@ -66,12 +66,41 @@ typedef struct
     uint32 TicksPerSecond;
     uint32 OSTimeConvNumerator;
     uint32 OSTimeConvDenominator;
+    uint64 OSTimeConvReciprocal;
 } PSP_VxWorks_Timebase_Global_t;
 
 PSP_VxWorks_Timebase_Global_t PSP_VxWorks_Timebase_Global;
 
 CFE_PSP_MODULE_DECLARE_SIMPLE(timebase_vxworks);
 
+/*
+ * Computes the upper 64 bits of the 128 bit product of two 64 bit values.
+ *
+ * This is built from 32x32->64 bit multiplies only, which the PowerPC
+ * targets that use this module can do inline, as opposed to a 64 bit divide
+ * which is always a call into a (slow) compiler support routine.
+ */
+static inline uint64 PSP_VxWorks_Timebase_MulHi64(uint64 a, uint64 b)
+{
+    uint64 aLo = a & 0xFFFFFFFF;
+    uint64 aHi = a >> 32;
+    uint64 bLo = b & 0xFFFFFFFF;
+    uint64 bHi = b >> 32;
+    uint64 LoLo;
+    uint64 LoHi;
+    uint64 HiLo;
+    uint64 Mid;
+
+    LoLo = aLo * bLo;
+    LoHi = aLo * bHi;
+    HiLo = aHi * bLo;
+
+    /* Sum the middle terms along with the carry out of the lower word */
+    Mid = (LoLo >> 32) + (LoHi & 0xFFFFFFFF) + (HiLo & 0xFFFFFFFF);
+
+    return (aHi * bHi) + (LoHi >> 32) + (HiLo >> 32) + (Mid >> 32);
+}
+
 void timebase_vxworks_Init(uint32 PspModuleId)
 {
     uint64 TicksPerSec;
@@ -141,6 +170,17 @@ void timebase_vxworks_Init(uint32 PspModuleId)
     PSP_VxWorks_Timebase_Global.OSTimeConvNumerator   = RatioN;
     PSP_VxWorks_Timebase_Global.OSTimeConvDenominator = RatioD;
     PSP_VxWorks_Timebase_Global.TicksPerSecond        = TicksPerSec & 0xFFFFFFFF;
+
+    /*
+     * Also precompute the reciprocal of the denominator as a 0.64 fixed point
+     * value, so that CFE_PSP_GetTime() can multiply rather than divide.
+     *
+     * This is floor((2^64 - 1) / RatioD), which is within one unit of 2^64/RatioD,
+     * so the quotient estimated from it is never more than one below the true
+     * quotient and never above it.  The one remaining unit is corrected exactly
+     * at runtime, so the result is identical to a real division.
+     */
+    PSP_VxWorks_Timebase_Global.OSTimeConvReciprocal = ~((uint64)0) / RatioD;
 }
 
 /*----------------------------------------------------------------
@@ -190,6 +230,7 @@ void CFE_PSP_Get_Timebase(uint32 *Tbu, uint32 *Tbl)
 void CFE_PSP_GetTime(OS_time_t *LocalTime)
 {
     uint64 NormalizedTicks;
+    uint64 Quotient;
     uint32 RegUpper;
     uint32 RegLower;
 
@@ -213,8 +254,19 @@ void CFE_PSP_GetTime(OS_time_t *LocalTime)
      * the impact on overall range of the 64-bit value.
      */
     NormalizedTicks *= PSP_VxWorks_Timebase_Global.OSTimeConvNumerator;
-    NormalizedTicks /= PSP_VxWorks_Timebase_Global.OSTimeConvDenominator;
+
+    /*
+     * Divide by the denominator using the precomputed reciprocal.  The
+     * estimate may be short by one, in which case the remainder is still
+     * at least the denominator and the quotient is bumped up to match.
+     */
+    Quotient = PSP_VxWorks_Timebase_MulHi64(NormalizedTicks, PSP_VxWorks_Timebase_Global.OSTimeConvReciprocal);
+    if ((NormalizedTicks - (Quotient * PSP_VxWorks_Timebase_Global.OSTimeConvDenominator)) >=
+        PSP_VxWorks_Timebase_Global.OSTimeConvDenominator)
+    {
+        ++Quotient;
+    }
 
     /* Output the value as an OS_time_t */
-    *LocalTime = (OS_time_t) {NormalizedTicks};
+    *LocalTime = (OS_time_t) {Quotient};
 }
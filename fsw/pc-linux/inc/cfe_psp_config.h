@@ -59,6 +59,14 @@
 /* use the "USR1" signal to wake the idle thread when an exception occurs */
 #define CFE_PSP_EXCEPTION_EVENT_SIGNAL SIGUSR1
 
+/*
+ * The maximum number of event sources that may be registered with the idle task,
+ * including the built-in shutdown and exception sources.
+ *
+ * See cfe_psp_idleevent.h for the API to register additional sources.
+ */
+#define CFE_PSP_MAX_IDLE_EVENT_SOURCES 16
+
 /*
  * The tick period that will be configured in the RTOS for the simulated
  * time base, in microseconds.  This in turn is used to drive the 1hz clock
@@ -72,6 +80,70 @@
  */
 #define CFE_PSP_SOFT_TIMEBASE_PERIOD 10000
 
+/*
+ * Drive the soft timebase from a timerfd with absolute deadlines, rather than
+ * the default OSAL (POSIX timer and signal based) implementation.  This avoids
+ * cumulative drift under load, and also records the lateness of each tick,
+ * which is reported by CFE_PSP_SoftTimebase_GetStats().
+ */
+#define CFE_PSP_SOFT_TIMEBASE_TIMERFD
+
+/*
+ * Scheduling of the soft timebase thread, when using the timerfd mode:
+ *
+ * If the priority is nonzero, the thread is switched to SCHED_FIFO at this priority
+ * (this requires CAP_SYS_NICE).  If the CPU is nonnegative, the thread is pinned
+ * to that CPU.  The defaults leave the thread as OSAL created it.
+ */
+#define CFE_PSP_SOFT_TIMEBASE_RT_PRIORITY 0
+#define CFE_PSP_SOFT_TIMEBASE_CPU         -1
+
+/*
+ * Timebases derived from the soft timebase master tick
+ *
+ * Up to CFE_PSP_SOFT_TIMEBASE_MAX_DERIVED timebases may be derived from the
+ * master tick, either configured here or added at run time through
+ * CFE_PSP_SoftTimebase_AddDerived().  Each entry in the list is a name,
+ * a divider, a callback and its argument, and the callback is invoked from
+ * the master tick every divider times CFE_PSP_SOFT_TIMEBASE_PERIOD.  The
+ * callbacks must be declared before this list is used.  For example:
+ *
+ *   #define CFE_PSP_SOFT_TIMEBASE_DERIVED_LIST {"cFS-10Hz", 10, My10HzTick, NULL}
+ *
+ * None are added by default.
+ */
+#define CFE_PSP_SOFT_TIMEBASE_MAX_DERIVED 8
+
+/*
+ * How often the soft timebase initially updates the time read by CFE_PSP_GetTimeCoarse(),
+ * in microseconds.  This is rounded down to a multiple of CFE_PSP_SOFT_TIMEBASE_PERIOD,
+ * so for a finer resolution the soft timebase period must also be reduced.  It can be
+ * changed at run time with CFE_PSP_SoftTimebase_SetCoarsePeriod().
+ */
+#define CFE_PSP_SOFT_TIMEBASE_COARSE_PERIOD CFE_PSP_SOFT_TIMEBASE_PERIOD
+
+/*
+ * Environment variable read by the timebase_posix_clock module to select its
+ * reference clock.  The --timebase-clock command line option sets this variable.
+ */
+#define CFE_PSP_TIMEBASE_CLOCK_ENV "CFE_PSP_TIMEBASE_CLOCK"
+
+/*
+ * PSP trace facility (see cfe_psp_trace.h)
+ *
+ * This is off by default.  Define CFE_PSP_TRACE_ENABLE to compile in the tracepoints,
+ * which store their rings in the reset area shared memory segment, after the exception
+ * storage.  Each ring is 64 bytes plus 16 bytes per entry, and the number of entries
+ * must be a power of two.  The default sizes add about 1 MB to the segment.
+ *
+ * Note that enabling the facility or changing these sizes changes the size of the reset
+ * area segment, so any existing segment must be removed (e.g. with ipcrm) before the
+ * next start, or the PSP fails to attach to it.
+ */
+/* #define CFE_PSP_TRACE_ENABLE */
+#define CFE_PSP_TRACE_MAX_RINGS    32
+#define CFE_PSP_TRACE_RING_ENTRIES 2048
+
 /*
 ** Global variables
 */
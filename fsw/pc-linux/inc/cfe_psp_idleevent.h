@@ -0,0 +1,119 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,719-1, and identified as “core Flight System: Bootes”
+ *
+ * Copyright (c) 2020 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ************************************************************************/
+
+/**
+ * \file
+ *
+ * Event sources serviced by the PC-Linux PSP "idle task"
+ *
+ * Once startup is complete, the original thread of the process waits in an
+ * epoll loop for any of the registered event sources to become ready.  Each
+ * source is backed by its own eventfd, so any number of them can be raised
+ * between wakeups and they are all serviced in the same pass.  CFE is notified
+ * (via the SystemNotify hook) at most once per pass.
+ *
+ * Exception events arrive as CFE_PSP_EXCEPTION_EVENT_SIGNAL through a signalfd,
+ * and a shutdown event is raised by CFE_PSP_Restart().  PSP modules may register
+ * additional sources of their own.
+ */
+
+#ifndef CFE_PSP_IDLEEVENT_H
+#define CFE_PSP_IDLEEVENT_H
+
+#include "common_types.h"
+
+/**
+ * \brief Source ID of the built-in shutdown event, raised by CFE_PSP_Restart()
+ */
+#define CFE_PSP_IDLEEVENT_SHUTDOWN 0
+
+/**
+ * \brief Source ID of the built-in exception event (CFE_PSP_EXCEPTION_EVENT_SIGNAL)
+ */
+#define CFE_PSP_IDLEEVENT_EXCEPTION 1
+
+/**
+ * \brief Handler for an idle task event source
+ *
+ * Invoked in the context of the idle task each time the source is found ready.
+ * Multiple raises of the same source between wakeups are coalesced, and the
+ * number of raises is passed in as Count.
+ *
+ * \param Arg   The opaque argument supplied at registration
+ * \param Count Number of times the source was raised since it was last serviced
+ *
+ * \returns true if CFE should be notified (via SystemNotify) as a result of this event
+ */
+typedef bool (*CFE_PSP_IdleEvent_Handler_t)(void *Arg, uint64 Count);
+
+/**
+ * \brief Set up the idle task event loop and the built-in event sources
+ *
+ * Must be called from the idle task (original thread) before any module
+ * registers an event source.
+ *
+ * \returns CFE_PSP_SUCCESS if successful
+ * \retval #CFE_PSP_ERROR if the epoll instance or a built-in source could not be set up
+ */
+int32 CFE_PSP_IdleEvent_Init(void);
+
+/**
+ * \brief Register a new event source with the idle task
+ *
+ * If Handler is NULL, raising the source simply notifies CFE.
+ *
+ * \param Name     Name of the event source, for informational purposes
+ * \param Handler  Function to invoke when the source is raised (may be NULL)
+ * \param Arg      Opaque argument to pass to the handler
+ * \param SourceId Set to the ID to pass to CFE_PSP_IdleEvent_Raise()
+ *
+ * \returns CFE_PSP_SUCCESS if successful
+ */
+int32 CFE_PSP_IdleEvent_Register(const char *Name, CFE_PSP_IdleEvent_Handler_t Handler, void *Arg, uint32 *SourceId);
+
+/**
+ * \brief Remove an event source previously registered via CFE_PSP_IdleEvent_Register()
+ *
+ * The eventfd of the source is kept open for the next source registered in
+ * its place, so a concurrent CFE_PSP_IdleEvent_Raise() never writes to a
+ * closed or reused descriptor.
+ *
+ * \param SourceId The source to remove
+ *
+ * \returns CFE_PSP_SUCCESS if successful
+ */
+int32 CFE_PSP_IdleEvent_Unregister(uint32 SourceId);
+
+/**
+ * \brief Raise an event source, waking the idle task
+ *
+ * This only performs a write() to the eventfd of the source, so it is safe
+ * to call from any thread, and also from a signal handler.
+ *
+ * \param SourceId The source to raise
+ */
+void CFE_PSP_IdleEvent_Raise(uint32 SourceId);
+
+/**
+ * \brief Service event sources until a shutdown is requested
+ *
+ * This is the body of the idle task, and must only be called from that thread.
+ */
+void CFE_PSP_IdleEvent_Loop(void);
+
+#endif
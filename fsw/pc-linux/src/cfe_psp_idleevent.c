@@ -0,0 +1,430 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,719-1, and identified as “core Flight System: Bootes”
+ *
+ * Copyright (c) 2020 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ************************************************************************/
+
+/******************************************************************************
+** File:  cfe_psp_idleevent.c
+**
+** Purpose:
+**   Event loop for the PSP "idle task" (the original thread of the process).
+**
+**   All event sources are file descriptors registered in a single epoll set:
+**   the exception signal is received through a signalfd, and every other
+**   source (including shutdown) is an eventfd.  This allows several
+**   independent sources to wake the idle task without sharing a single
+**   signal, and all ready sources are serviced in one pass.
+**
+******************************************************************************/
+
+/*
+**  Include Files
+*/
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include <errno.h>
+#include <signal.h>
+#include <pthread.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/signalfd.h>
+
+#include "common_types.h"
+#include "osapi.h"
+
+#include "cfe_psp.h"
+#include "cfe_psp_config.h"
+#include "cfe_psp_idleevent.h"
+
+#include "target_config.h"
+
+/*
+** Types and prototypes for this module
+*/
+/*
+ * The eventfd of a registered source is never closed, as CFE_PSP_IdleEvent_Raise()
+ * may be writing to it without the lock.  Once unregistered the slot keeps the fd
+ * (FdOpen stays set) and it is reused by the next source registered in the slot.
+ */
+typedef struct
+{
+    bool                        InUse;
+    bool                        FdOpen;
+    int                         fd;
+    const char                 *Name;
+    CFE_PSP_IdleEvent_Handler_t Handler;
+    void                       *Arg;
+} CFE_PSP_IdleEventSource_t;
+
+typedef struct
+{
+    int                       EpollFd;
+    pthread_mutex_t           Lock;
+    CFE_PSP_IdleEventSource_t Source[CFE_PSP_MAX_IDLE_EVENT_SOURCES];
+} CFE_PSP_IdleEventGlobal_t;
+
+static CFE_PSP_IdleEventGlobal_t CFE_PSP_IdleEvent_Global = {.EpollFd = -1, .Lock = PTHREAD_MUTEX_INITIALIZER};
+
+/*----------------------------------------------------------------
+ *
+ * Local helper: built-in handler for the shutdown source
+ *
+ *-----------------------------------------------------------------*/
+static bool CFE_PSP_IdleEvent_ShutdownHandler(void *Arg, uint64 Count)
+{
+    CFE_PSP_IdleTaskState.ShutdownReq = true;
+
+    /* no point notifying CFE, it is going away */
+    return false;
+}
+
+/*----------------------------------------------------------------
+ *
+ * Local helper: Add an fd to the table and to the epoll set
+ * Must be called with the lock held.
+ *
+ *-----------------------------------------------------------------*/
+static int32 CFE_PSP_IdleEvent_AddSource(uint32 SourceId, int fd, const char *Name,
+                                         CFE_PSP_IdleEvent_Handler_t Handler, void *Arg)
+{
+    CFE_PSP_IdleEventSource_t *SrcPtr;
+    struct epoll_event         ev;
+
+    memset(&ev, 0, sizeof(ev));
+    ev.events   = EPOLLIN;
+    ev.data.u32 = SourceId;
+
+    if (epoll_ctl(CFE_PSP_IdleEvent_Global.EpollFd, EPOLL_CTL_ADD, fd, &ev) < 0)
+    {
+        return CFE_PSP_ERROR;
+    }
+
+    SrcPtr          = &CFE_PSP_IdleEvent_Global.Source[SourceId];
+    SrcPtr->fd      = fd;
+    SrcPtr->FdOpen  = true;
+    SrcPtr->Name    = Name;
+    SrcPtr->Handler = Handler;
+    SrcPtr->Arg     = Arg;
+
+    /* publish the slot last, for CFE_PSP_IdleEvent_Raise() */
+    __atomic_store_n(&SrcPtr->InUse, true, __ATOMIC_RELEASE);
+
+    return CFE_PSP_SUCCESS;
+}
+
+/*----------------------------------------------------------------
+ *
+ * Local helper: Consume the pending data on a ready source
+ * Returns the number of events that were pending
+ *
+ *-----------------------------------------------------------------*/
+static uint64 CFE_PSP_IdleEvent_Drain(uint32 SourceId, int fd)
+{
+    struct signalfd_siginfo si;
+    uint64                  Count;
+    ssize_t                 ret;
+
+    Count = 0;
+    if (SourceId == CFE_PSP_IDLEEVENT_EXCEPTION)
+    {
+        /* signalfd is non-blocking, so read every pending signal */
+        while (read(fd, &si, sizeof(si)) == sizeof(si))
+        {
+            ++Count;
+        }
+    }
+    else
+    {
+        /* eventfd returns the accumulated count and resets it to zero */
+        ret = read(fd, &Count, sizeof(Count));
+        if (ret != sizeof(Count))
+        {
+            Count = 0;
+        }
+    }
+
+    return Count;
+}
+
+/*----------------------------------------------------------------
+ *
+ * Implemented per header file
+ * See description in header file for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+int32 CFE_PSP_IdleEvent_Init(void)
+{
+    sigset_t sigset;
+    int      fd;
+
+    memset(CFE_PSP_IdleEvent_Global.Source, 0, sizeof(CFE_PSP_IdleEvent_Global.Source));
+
+    CFE_PSP_IdleEvent_Global.EpollFd = epoll_create1(EPOLL_CLOEXEC);
+    if (CFE_PSP_IdleEvent_Global.EpollFd < 0)
+    {
+        perror("CFE_PSP - Cannot create idle task epoll instance");
+        return CFE_PSP_ERROR;
+    }
+
+    /*
+     * The exception signal is directed at this thread by pthread_kill(),
+     * and needs to be blocked here so it stays pending and is reported
+     * through the signalfd rather than delivered normally.
+     */
+    sigemptyset(&sigset);
+    sigaddset(&sigset, CFE_PSP_EXCEPTION_EVENT_SIGNAL);
+    pthread_sigmask(SIG_BLOCK, &sigset, NULL);
+
+    fd = signalfd(-1, &sigset, SFD_NONBLOCK | SFD_CLOEXEC);
+    if (fd < 0)
+    {
+        perror("CFE_PSP - Cannot create idle task exception signalfd");
+        return CFE_PSP_ERROR;
+    }
+    if (CFE_PSP_IdleEvent_AddSource(CFE_PSP_IDLEEVENT_EXCEPTION, fd, "exception", NULL, NULL) != CFE_PSP_SUCCESS)
+    {
+        perror("CFE_PSP - Cannot add idle task exception signalfd");
+        close(fd);
+        return CFE_PSP_ERROR;
+    }
+
+    fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (fd < 0)
+    {
+        perror("CFE_PSP - Cannot create idle task shutdown eventfd");
+        return CFE_PSP_ERROR;
+    }
+    if (CFE_PSP_IdleEvent_AddSource(CFE_PSP_IDLEEVENT_SHUTDOWN, fd, "shutdown", CFE_PSP_IdleEvent_ShutdownHandler,
+                                    NULL) != CFE_PSP_SUCCESS)
+    {
+        perror("CFE_PSP - Cannot add idle task shutdown eventfd");
+        close(fd);
+        return CFE_PSP_ERROR;
+    }
+
+    return CFE_PSP_SUCCESS;
+}
+
+/*----------------------------------------------------------------
+ *
+ * Implemented per header file
+ * See description in header file for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+int32 CFE_PSP_IdleEvent_Register(const char *Name, CFE_PSP_IdleEvent_Handler_t Handler, void *Arg, uint32 *SourceId)
+{
+    CFE_PSP_IdleEventSource_t *SrcPtr;
+    uint32                     i;
+    int                        fd;
+    int32                      Status;
+
+    if (SourceId == NULL || CFE_PSP_IdleEvent_Global.EpollFd < 0)
+    {
+        return CFE_PSP_ERROR;
+    }
+
+    Status = CFE_PSP_ERROR;
+    pthread_mutex_lock(&CFE_PSP_IdleEvent_Global.Lock);
+
+    for (i = 0; i < CFE_PSP_MAX_IDLE_EVENT_SOURCES; ++i)
+    {
+        SrcPtr = &CFE_PSP_IdleEvent_Global.Source[i];
+        if (!SrcPtr->InUse)
+        {
+            if (SrcPtr->FdOpen)
+            {
+                /* discard anything raised on the previous source in this slot */
+                fd = SrcPtr->fd;
+                CFE_PSP_IdleEvent_Drain(i, fd);
+            }
+            else
+            {
+                fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+            }
+
+            if (fd >= 0)
+            {
+                Status = CFE_PSP_IdleEvent_AddSource(i, fd, Name, Handler, Arg);
+                if (Status != CFE_PSP_SUCCESS && !SrcPtr->FdOpen)
+                {
+                    close(fd);
+                }
+            }
+            break;
+        }
+    }
+
+    pthread_mutex_unlock(&CFE_PSP_IdleEvent_Global.Lock);
+
+    if (Status == CFE_PSP_SUCCESS)
+    {
+        *SourceId = i;
+    }
+
+    return Status;
+}
+
+/*----------------------------------------------------------------
+ *
+ * Implemented per header file
+ * See description in header file for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+int32 CFE_PSP_IdleEvent_Unregister(uint32 SourceId)
+{
+    CFE_PSP_IdleEventSource_t *SrcPtr;
+    int32                      Status;
+
+    /* the built-in sources cannot be removed */
+    if (SourceId <= CFE_PSP_IDLEEVENT_EXCEPTION || SourceId >= CFE_PSP_MAX_IDLE_EVENT_SOURCES)
+    {
+        return CFE_PSP_ERROR;
+    }
+
+    Status = CFE_PSP_ERROR;
+    SrcPtr = &CFE_PSP_IdleEvent_Global.Source[SourceId];
+
+    pthread_mutex_lock(&CFE_PSP_IdleEvent_Global.Lock);
+
+    if (SrcPtr->InUse)
+    {
+        /* the fd stays open for a CFE_PSP_IdleEvent_Raise() which already saw InUse */
+        __atomic_store_n(&SrcPtr->InUse, false, __ATOMIC_RELAXED);
+        epoll_ctl(CFE_PSP_IdleEvent_Global.EpollFd, EPOLL_CTL_DEL, SrcPtr->fd, NULL);
+        SrcPtr->Name    = NULL;
+        SrcPtr->Handler = NULL;
+        SrcPtr->Arg     = NULL;
+        Status          = CFE_PSP_SUCCESS;
+    }
+
+    pthread_mutex_unlock(&CFE_PSP_IdleEvent_Global.Lock);
+
+    return Status;
+}
+
+/*----------------------------------------------------------------
+ *
+ * Implemented per header file
+ * See description in header file for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+void CFE_PSP_IdleEvent_Raise(uint32 SourceId)
+{
+    static const uint64 One = 1;
+    ssize_t             ret;
+
+    /*
+     * This must remain async-signal-safe: no locking here.
+     * The exception source is a signalfd and cannot be written to.
+     * The fd of a slot is never closed once it is in use, so at worst a
+     * concurrent unregister makes this a stray count on an idle eventfd,
+     * which is discarded when the slot is registered again.
+     */
+    if (SourceId != CFE_PSP_IDLEEVENT_EXCEPTION && SourceId < CFE_PSP_MAX_IDLE_EVENT_SOURCES &&
+        __atomic_load_n(&CFE_PSP_IdleEvent_Global.Source[SourceId].InUse, __ATOMIC_ACQUIRE))
+    {
+        ret = write(CFE_PSP_IdleEvent_Global.Source[SourceId].fd, &One, sizeof(One));
+        (void)ret;
+    }
+}
+
+/*----------------------------------------------------------------
+ *
+ * Implemented per header file
+ * See description in header file for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+void CFE_PSP_IdleEvent_Loop(void)
+{
+    struct epoll_event          Events[CFE_PSP_MAX_IDLE_EVENT_SOURCES];
+    CFE_PSP_IdleEventSource_t  *SrcPtr;
+    CFE_PSP_IdleEvent_Handler_t Handler;
+    void                       *Arg;
+    uint32                      SourceId;
+    uint64                      Count;
+    bool                        NotifyReq;
+    int                         NumReady;
+    int                         i;
+
+    /*
+    ** just wait for events to occur and notify CFE
+    **
+    ** "shutdownreq" will become true if CFE calls CFE_PSP_Restart(),
+    ** indicating a request to gracefully exit and restart CFE.
+    */
+    while (!CFE_PSP_IdleTaskState.ShutdownReq)
+    {
+        /* go idle and wait for an event */
+        NumReady = epoll_wait(CFE_PSP_IdleEvent_Global.EpollFd, Events, CFE_PSP_MAX_IDLE_EVENT_SOURCES, -1);
+        if (NumReady < 0)
+        {
+            if (errno != EINTR)
+            {
+                OS_printf("CFE_PSP: %s(): epoll_wait() failed: %s\n", __func__, strerror(errno));
+                OS_TaskDelay(100);
+            }
+            continue;
+        }
+
+        NotifyReq = false;
+        for (i = 0; i < NumReady; ++i)
+        {
+            SourceId = Events[i].data.u32;
+            if (SourceId >= CFE_PSP_MAX_IDLE_EVENT_SOURCES)
+            {
+                continue;
+            }
+
+            /*
+             * Consume the event under lock so the source cannot be
+             * unregistered concurrently, but invoke the handler outside
+             * of it so the handler may itself register/unregister sources.
+             */
+            SrcPtr = &CFE_PSP_IdleEvent_Global.Source[SourceId];
+            pthread_mutex_lock(&CFE_PSP_IdleEvent_Global.Lock);
+            if (SrcPtr->InUse)
+            {
+                Count   = CFE_PSP_IdleEvent_Drain(SourceId, SrcPtr->fd);
+                Handler = SrcPtr->Handler;
+                Arg     = SrcPtr->Arg;
+            }
+            else
+            {
+                Count   = 0;
+                Handler = NULL;
+                Arg     = NULL;
+            }
+            pthread_mutex_unlock(&CFE_PSP_IdleEvent_Global.Lock);
+
+            if (Count == 0)
+            {
+                continue;
+            }
+
+            if (Handler == NULL || Handler(Arg, Count))
+            {
+                NotifyReq = true;
+            }
+        }
+
+        if (NotifyReq && !CFE_PSP_IdleTaskState.ShutdownReq && GLOBAL_CFE_CONFIGDATA.SystemNotify != NULL)
+        {
+            /* notify the CFE of the event(s), once for all sources serviced in this pass */
+            GLOBAL_CFE_CONFIGDATA.SystemNotify();
+        }
+    }
+}
@@ -61,6 +61,7 @@
 */
 #include "cfe_psp_config.h"
 #include "cfe_psp_memory.h"
+#include "cfe_psp_trace.h"
 
 #define CFE_PSP_CDS_KEY_FILE      ".cdskeyfile"
 #define CFE_PSP_RESET_KEY_FILE    ".resetkeyfile"
@@ -80,6 +81,9 @@ typedef struct
 {
     CFE_PSP_ReservedMemoryBootRecord_t BootRecord;
     CFE_PSP_ExceptionStorage_t         ExceptionStorage;
+#ifdef CFE_PSP_TRACE_ENABLE
+    CFE_PSP_TraceStorage_t TraceStorage;
+#endif
 } CFE_PSP_LinuxReservedAreaFixedLayout_t;
 
 /*
@@ -236,10 +240,14 @@ int32 CFE_PSP_WriteToCDS(const void *PtrToDataToWrite, uint32 CDSOffset, uint32
     {
         if ((CDSOffset < CFE_PSP_CDS_SIZE) && ((CDSOffset + NumBytes) <= CFE_PSP_CDS_SIZE))
         {
+            CFE_PSP_TRACE_BEGIN(CFE_PSP_TRACE_EVENT_CDS_WRITE, NumBytes);
+
             CopyPtr = CFE_PSP_ReservedMemoryMap.CDSMemory.BlockPtr;
             CopyPtr += CDSOffset;
             memcpy(CopyPtr, (char *)PtrToDataToWrite, NumBytes);
 
+            CFE_PSP_TRACE_END(CFE_PSP_TRACE_EVENT_CDS_WRITE, NumBytes);
+
             return_code = CFE_PSP_SUCCESS;
         }
         else
@@ -271,10 +279,14 @@ int32 CFE_PSP_ReadFromCDS(void *PtrToDataToRead, uint32 CDSOffset, uint32 NumByt
     {
         if ((CDSOffset < CFE_PSP_CDS_SIZE) && ((CDSOffset + NumBytes) <= CFE_PSP_CDS_SIZE))
         {
+            CFE_PSP_TRACE_BEGIN(CFE_PSP_TRACE_EVENT_CDS_READ, NumBytes);
+
             CopyPtr = CFE_PSP_ReservedMemoryMap.CDSMemory.BlockPtr;
             CopyPtr += CDSOffset;
             memcpy((char *)PtrToDataToRead, CopyPtr, NumBytes);
 
+            CFE_PSP_TRACE_END(CFE_PSP_TRACE_EVENT_CDS_READ, NumBytes);
+
             return_code = CFE_PSP_SUCCESS;
         }
         else
@@ -359,6 +371,9 @@ void CFE_PSP_InitResetArea(void)
 
     CFE_PSP_ReservedMemoryMap.BootPtr             = &FixedBlocksPtr->BootRecord;
     CFE_PSP_ReservedMemoryMap.ExceptionStoragePtr = &FixedBlocksPtr->ExceptionStorage;
+#ifdef CFE_PSP_TRACE_ENABLE
+    CFE_PSP_ReservedMemoryMap.TraceStoragePtr = &FixedBlocksPtr->TraceStorage;
+#endif
 
     CFE_PSP_ReservedMemoryMap.ResetMemory.BlockPtr  = (void *)block_addr;
     CFE_PSP_ReservedMemoryMap.ResetMemory.BlockSize = CFE_PSP_RESET_AREA_SIZE;
@@ -53,6 +53,8 @@
 
 #include "cfe_psp.h"
 #include "cfe_psp_memory.h"
+#include "cfe_psp_idleevent.h"
+#include "cfe_psp_trace.h"
 
 /*
  * The preferred way to obtain the CFE tunable values at runtime is via
@@ -127,7 +129,7 @@ CFE_PSP_IdleTaskState_t CFE_PSP_IdleTaskState;
 /*
 ** getopts parameter passing options string
 */
-static const char *optString = "R:S:C:I:N:h";
+static const char *optString = "R:S:C:I:N:T:h";
 
 /*
 ** getopts_long long form argument table
@@ -137,6 +139,7 @@ static const struct option longOpts[] = {{"reset", required_argument, NULL, 'R'}
                                          {"cpuid", required_argument, NULL, 'C'},
                                          {"scid", required_argument, NULL, 'I'},
                                          {"cpuname", required_argument, NULL, 'N'},
+                                         {"timebase-clock", required_argument, NULL, 'T'},
                                          {"help", no_argument, NULL, 'h'},
                                          {NULL, no_argument, NULL, 0}};
 
@@ -295,6 +298,16 @@ void OS_Application_Startup(void)
                 CommandData.GotSpacecraftId = 1;
                 break;
 
+            case 'T':
+                /*
+                 * The timebase module (if any) reads this when it is initialized.
+                 * It is passed via the environment as the module is not part of
+                 * the platform-specific code.
+                 */
+                setenv(CFE_PSP_TIMEBASE_CLOCK_ENV, optarg, 1);
+                printf("CFE_PSP: Timebase Clock: %s\n", optarg);
+                break;
+
             case 'h':
                 CFE_PSP_DisplayUsage(argv[0]);
                 break;
@@ -350,6 +363,13 @@ void OS_Application_Startup(void)
      */
     memset(&CFE_PSP_IdleTaskState, 0, sizeof(CFE_PSP_IdleTaskState));
     CFE_PSP_IdleTaskState.ThreadID = pthread_self();
+    Status = CFE_PSP_IdleEvent_Init();
+    if (Status != CFE_PSP_SUCCESS)
+    {
+        /* without the idle task events, exceptions and shutdown requests cannot be serviced */
+        printf("CFE_PSP: CFE_PSP_IdleEvent_Init() failure\n");
+        CFE_PSP_Panic(Status);
+    }
 
     /*
     ** Set up the virtual FS mapping for the "/cf" directory
@@ -423,6 +443,11 @@ void OS_Application_Startup(void)
         CFE_PSP_Panic(Status);
     }
 
+    /*
+    ** Start recording trace events, keeping the previous ones on a processor reset
+    */
+    CFE_PSP_Trace_Init(reset_type);
+
     /*
     ** Call cFE entry point.
     */
@@ -431,13 +456,11 @@ void OS_Application_Startup(void)
 
 void OS_Application_Run(void)
 {
-    int      sig;
-    int      ret;
     sigset_t sigset;
 
     /*
      * Now that all main tasks are created,
-     * this original thread will exist just to service signals
+     * this original thread will exist just to service events
      * that aren't directed to a specific task.
      *
      * OSAL sets a very conservative signal mask that
@@ -454,29 +477,10 @@ void OS_Application_Run(void)
     pthread_sigmask(SIG_UNBLOCK, &sigset, NULL);
 
     /*
-     * Reset to the signal for background events (SIGUSR1)
+     * Service the exception signal, shutdown requests and any
+     * sources registered by PSP modules until shutdown is requested
      */
-    sigemptyset(&sigset);
-    sigaddset(&sigset, CFE_PSP_EXCEPTION_EVENT_SIGNAL);
-
-    /*
-    ** just wait for events to occur and notify CFE
-    **
-    ** "shutdownreq" will become true if CFE calls CFE_PSP_Restart(),
-    ** indicating a request to gracefully exit and restart CFE.
-    */
-    while (!CFE_PSP_IdleTaskState.ShutdownReq)
-    {
-        /* go idle and wait for an event */
-        ret = sigwait(&sigset, &sig);
-
-        if (ret == 0 && !CFE_PSP_IdleTaskState.ShutdownReq && sig == CFE_PSP_EXCEPTION_EVENT_SIGNAL &&
-            GLOBAL_CFE_CONFIGDATA.SystemNotify != NULL)
-        {
-            /* notify the CFE of the event */
-            GLOBAL_CFE_CONFIGDATA.SystemNotify();
-        }
-    }
+    CFE_PSP_IdleEvent_Loop();
 
     /*
      * This happens if an unhandled exception occurs, or if the user presses CTRL+C
@@ -500,7 +504,7 @@ void OS_Application_Run(void)
 */
 void CFE_PSP_DisplayUsage(char *Name)
 {
-    printf("usage : %s [-R <value>] [-S <value>] [-C <value] [-N <value] [-I <value] [-h] \n", Name);
+    printf("usage : %s [-R <value>] [-S <value>] [-C <value] [-N <value] [-I <value] [-T <value>] [-h] \n", Name);
     printf("\n");
     printf("        All parameters are optional and can be used in any order\n");
     printf("\n");
@@ -521,6 +525,10 @@ void CFE_PSP_DisplayUsage(char *Name)
     printf("        -I [ --scid ]    Spacecraft ID is an integer Spacecraft identifier.\n");
     printf("             The default Spacecraft ID is from the mission configuration file: %d\n",
            CFE_PSP_SPACECRAFT_ID);
+    printf("        -T [ --timebase-clock ]\n");
+    printf("             Clock used by the timebase module, one of:\n");
+    printf("             MONOTONIC ( default ), MONOTONIC_COARSE, MONOTONIC_RAW, BOOTTIME\n");
+    printf("             May also be set via the %s environment variable.\n", CFE_PSP_TIMEBASE_CLOCK_ENV);
     printf("        -h [ --help ]    This message.\n");
     printf("\n");
     printf("       Example invocation:\n");
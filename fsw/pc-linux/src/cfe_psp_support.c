@@ -43,6 +43,7 @@
 #include "cfe_psp.h"
 #include "cfe_psp_config.h"
 #include "cfe_psp_memory.h"
+#include "cfe_psp_idleevent.h"
 
 /*
 ** External Variables
@@ -85,7 +86,7 @@ void CFE_PSP_Restart(uint32 resetType)
      * and start the shutdown procedure.
      */
     CFE_PSP_IdleTaskState.ShutdownReq = true;
-    pthread_kill(CFE_PSP_IdleTaskState.ThreadID, CFE_PSP_EXCEPTION_EVENT_SIGNAL);
+    CFE_PSP_IdleEvent_Raise(CFE_PSP_IDLEEVENT_SHUTDOWN);
 
     /*
      * Give time for the orderly shutdown to occur.
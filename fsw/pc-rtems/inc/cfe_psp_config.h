@@ -97,4 +97,11 @@ typedef struct
  */
 #define CFE_PSP_MEMALIGN_MASK ((cpuaddr)0x7F)
 
+/*
+ * Size of the reserved memory block for the sysmon sample recorder (see
+ * cfe_psp_sysmonrecord.h), which holds a 320 byte header and 16 bytes per
+ * recorded channel value.  No block is reserved if this is not defined.
+ */
+/* #define CFE_PSP_SYSMON_RECORD_MEMORY_SIZE (256 * 1024) */
+
 #endif
@@ -303,6 +303,7 @@ void CFE_PSP_SetupReservedMemoryMap(void)
     size_t                                  CDSSize;
     size_t                                  UserReservedSize;
     size_t                                  VolatileDiskSize;
+    size_t                                  SysmonRecordSize;
     size_t                                  RequiredSize;
 
     /*
@@ -314,12 +315,18 @@ void CFE_PSP_SetupReservedMemoryMap(void)
     VolatileDiskSize = (CFE_PSP_RAM_DISK_SECTOR_SIZE * CFE_PSP_RAM_DISK_NUM_SECTORS);
     CDSSize          = CFE_PSP_CDS_SIZE;
     UserReservedSize = CFE_PSP_USER_RESERVED_SIZE;
+#ifdef CFE_PSP_SYSMON_RECORD_MEMORY_SIZE
+    SysmonRecordSize = CFE_PSP_SYSMON_RECORD_MEMORY_SIZE;
+#else
+    SysmonRecordSize = 0;
+#endif
 
     FixedSize        = (FixedSize + CFE_PSP_MEMALIGN_MASK) & ~CFE_PSP_MEMALIGN_MASK;
     ResetSize        = (ResetSize + CFE_PSP_MEMALIGN_MASK) & ~CFE_PSP_MEMALIGN_MASK;
     CDSSize          = (CDSSize + CFE_PSP_MEMALIGN_MASK) & ~CFE_PSP_MEMALIGN_MASK;
     VolatileDiskSize = (VolatileDiskSize + CFE_PSP_MEMALIGN_MASK) & ~CFE_PSP_MEMALIGN_MASK;
     UserReservedSize = (UserReservedSize + CFE_PSP_MEMALIGN_MASK) & ~CFE_PSP_MEMALIGN_MASK;
+    SysmonRecordSize = (SysmonRecordSize + CFE_PSP_MEMALIGN_MASK) & ~CFE_PSP_MEMALIGN_MASK;
 
     /*  Calculate the required size, adding padding so that each element is aligned */
     RequiredSize = FixedSize;
@@ -327,6 +334,7 @@ void CFE_PSP_SetupReservedMemoryMap(void)
     RequiredSize += VolatileDiskSize;
     RequiredSize += CDSSize;
     RequiredSize += UserReservedSize;
+    RequiredSize += SysmonRecordSize;
 
     OS_printf("Size of BSP reserved memory = %u bytes\n", (unsigned int)RequiredSize);
 
@@ -367,6 +375,10 @@ void CFE_PSP_SetupReservedMemoryMap(void)
     CFE_PSP_ReservedMemoryMap.UserReservedMemory.BlockSize = CFE_PSP_USER_RESERVED_SIZE;
     ReservedMemoryAddr += UserReservedSize;
 
+    CFE_PSP_ReservedMemoryMap.SysmonRecordMemory.BlockPtr  = (void *)ReservedMemoryAddr;
+    CFE_PSP_ReservedMemoryMap.SysmonRecordMemory.BlockSize = SysmonRecordSize;
+    ReservedMemoryAddr += SysmonRecordSize;
+
     /*
      * displaying the final address shows how much was actually used,
      * and additionally avoids a warning about the result of the final increment not being used.
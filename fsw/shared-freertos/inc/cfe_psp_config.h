@@ -30,6 +30,10 @@
 // Memory tables
 // cfe_psp_memory.c
 #define CFE_PSP_MEMALIGN_MASK ((cpuaddr) 0x3F)  // RISC-V and Arm may be designed with 64 byte processor cache line/block
+
+// size of the reserved block for the sysmon sample recorder (cfe_psp_sysmonrecord.h),
+// a 320 byte header plus 16 bytes per recorded channel value; none if not defined
+// #define CFE_PSP_SYSMON_RECORD_MEMORY_SIZE (16 * 1024)
 typedef struct
 {
     uint32 bsp_reset_type;
@@ -116,6 +116,7 @@ void CFE_PSP_SetupReservedMemoryMap(void)
     size_t CDSSize;
     size_t UserReservedSize;
     size_t VolatileDiskSize;
+    size_t SysmonRecordSize;
     size_t RequiredSize;
 
     // FBV 2024-01-10 Paranoid
@@ -135,6 +136,11 @@ void CFE_PSP_SetupReservedMemoryMap(void)
     VolatileDiskSize = (CFE_PSP_RAM_DISK_SECTOR_SIZE * CFE_PSP_RAM_DISK_NUM_SECTORS);
     CDSSize = CFE_PSP_CDS_SIZE;
     UserReservedSize = CFE_PSP_USER_RESERVED_SIZE;
+#ifdef CFE_PSP_SYSMON_RECORD_MEMORY_SIZE
+    SysmonRecordSize = CFE_PSP_SYSMON_RECORD_MEMORY_SIZE;
+#else
+    SysmonRecordSize = 0;
+#endif
 
     BootRecordSize = (BootRecordSize + CFE_PSP_MEMALIGN_MASK) & ~CFE_PSP_MEMALIGN_MASK;
     ExcRecordSize = (ExcRecordSize + CFE_PSP_MEMALIGN_MASK) & ~CFE_PSP_MEMALIGN_MASK;
@@ -142,6 +148,7 @@ void CFE_PSP_SetupReservedMemoryMap(void)
     CDSSize = (CDSSize + CFE_PSP_MEMALIGN_MASK) & ~CFE_PSP_MEMALIGN_MASK;
     VolatileDiskSize = (VolatileDiskSize + CFE_PSP_MEMALIGN_MASK) & ~CFE_PSP_MEMALIGN_MASK;
     UserReservedSize = (UserReservedSize + CFE_PSP_MEMALIGN_MASK) & ~CFE_PSP_MEMALIGN_MASK;
+    SysmonRecordSize = (SysmonRecordSize + CFE_PSP_MEMALIGN_MASK) & ~CFE_PSP_MEMALIGN_MASK;
 
     // calculate the required size and warn if not able to malloc
     RequiredSize = 0;
@@ -151,6 +158,7 @@ void CFE_PSP_SetupReservedMemoryMap(void)
     RequiredSize += VolatileDiskSize;
     RequiredSize += CDSSize;
     RequiredSize += UserReservedSize;
+    RequiredSize += SysmonRecordSize;
 
     if((unsigned int) RequiredSize > CFE_PSP_RESERVED_MEMORY_SIZE){
         OS_DebugPrintf(1, __func__, __LINE__, "PSP required reserved memory = %u bytes\n", (unsigned int) RequiredSize);
@@ -175,6 +183,7 @@ void CFE_PSP_SetupReservedMemoryMap(void)
         OS_DebugPrintf(1, __func__, __LINE__, "PSP required VolatileDiskSize memory = %u bytes\n", (unsigned int) VolatileDiskSize);
         OS_DebugPrintf(1, __func__, __LINE__, "PSP required CDSSize/CDS segment size memory = %u bytes\n", (unsigned int) CDSSize);
         OS_DebugPrintf(1, __func__, __LINE__, "PSP required UserReservedSize/User reserved area segment size memory = %u bytes\n", (unsigned int) UserReservedSize);
+        OS_DebugPrintf(1, __func__, __LINE__, "PSP required SysmonRecordSize memory = %u bytes\n", (unsigned int) SysmonRecordSize);
 
         CFE_PSP_Panic(CFE_PSP_PANIC_MEMORY_ALLOC);
         return;
@@ -203,6 +212,11 @@ void CFE_PSP_SetupReservedMemoryMap(void)
     CFE_PSP_ReservedMemoryMap.UserReservedMemory.BlockPtr = (void*) ReservedMemoryAddr;
     CFE_PSP_ReservedMemoryMap.UserReservedMemory.BlockSize = CFE_PSP_USER_RESERVED_SIZE;
     ReservedMemoryAddr += UserReservedSize;
+
+    // sysmon recorder ring, not cleared on reset so it keeps the samples from before one
+    CFE_PSP_ReservedMemoryMap.SysmonRecordMemory.BlockPtr = (void*) ReservedMemoryAddr;
+    CFE_PSP_ReservedMemoryMap.SysmonRecordMemory.BlockSize = SysmonRecordSize;
+    ReservedMemoryAddr += SysmonRecordSize;
 }
 
 /*
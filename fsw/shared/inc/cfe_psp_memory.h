@@ -37,6 +37,7 @@
 #include "common_types.h"
 #include "cfe_psp_config.h"
 #include "cfe_psp_exceptionstorage_types.h"
+#include "cfe_psp_trace_types.h"
 
 /*
 ** Memory table type
@@ -60,11 +61,13 @@ typedef struct
 {
     CFE_PSP_ReservedMemoryBootRecord_t *BootPtr;
     CFE_PSP_ExceptionStorage_t *        ExceptionStoragePtr;
+    CFE_PSP_TraceStorage_t *            TraceStoragePtr; /**< NULL if the platform does not provide trace storage */
 
     CFE_PSP_MemoryBlock_t ResetMemory;
     CFE_PSP_MemoryBlock_t VolatileDiskMemory;
     CFE_PSP_MemoryBlock_t CDSMemory;
     CFE_PSP_MemoryBlock_t UserReservedMemory;
+    CFE_PSP_MemoryBlock_t SysmonRecordMemory; /**< Zero size if the platform does not provide sysmon recorder storage */
 
     /**
      * \brief The system memory table
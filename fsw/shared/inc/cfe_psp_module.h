@@ -36,6 +36,7 @@ typedef enum
     CFE_PSP_MODULE_TYPE_INVALID = 0,
     CFE_PSP_MODULE_TYPE_SIMPLE,
     CFE_PSP_MODULE_TYPE_DEVICEDRIVER,
+    CFE_PSP_MODULE_TYPE_TIMEBASE_SOURCE,
     /* May be extended in the future */
 } CFE_PSP_ModuleType_t;
 
@@ -70,6 +71,33 @@ typedef const struct
         .Init           = name##_Init,                   \
     }
 
+/**
+ * Extended API for a module of type CFE_PSP_MODULE_TYPE_TIMEBASE_SOURCE
+ *
+ * Such a module drives the software timebase (if present) in place of
+ * the real time clock.  The sync function is passed to OS_TimeBaseCreate()
+ * as the external sync for the software timebase, and so may be called
+ * before the init function of the module.
+ */
+typedef const struct
+{
+    OS_TimerSync_t SyncFunc;
+} CFE_PSP_TimebaseSourceApi_t;
+
+/**
+ * Macro to simplify declaration of a module which provides the time
+ * source of the software timebase.  The module must also define a
+ * CFE_PSP_TimebaseSourceApi_t object named name##_SourceApi.
+ */
+#define CFE_PSP_MODULE_DECLARE_TIMEBASE_SOURCE(name)           \
+    void                name##_Init(uint32 PspModuleId);       \
+    CFE_PSP_ModuleApi_t CFE_PSP_##name##_API = {               \
+        .ModuleType     = CFE_PSP_MODULE_TYPE_TIMEBASE_SOURCE, \
+        .OperationFlags = 0,                                   \
+        .Init           = name##_Init,                         \
+        .ExtendedApi    = &name##_SourceApi,                   \
+    }
+
 /**
  * Initialize the included PSP modules.
  *
@@ -0,0 +1,194 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,719-1, and identified as “core Flight System: Bootes”
+ *
+ * Copyright (c) 2020 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ************************************************************************/
+
+/**
+ * \file
+ *
+ * Sysmon threshold alarms
+ *
+ * A sysmon module may check any of its channels against a high and/or a low
+ * limit on every sample.  Each alarm is configured through
+ * CFE_PSP_IODriver_SET_CONFIGURATION on the module with a string of the form
+ *
+ *    alarm=<subsystem>/<subchannel>,<low>,<high>[,<hysteresis>]
+ *
+ * where the subsystem is given by name or number, and the limits are in the
+ * units of the channel, e.g. 24 bit analog codes for a load.  Either limit may
+ * be left empty, and leaving both empty removes the alarm.  For example,
+ * "alarm=aggregate/0,,0xE66666,0x199999" raises an alarm when the aggregate
+ * CPU load reaches 90%, which clears once it is back under 80%.
+ *
+ * The alarm is raised when the value reaches a limit, and only clears once the
+ * value is back inside the limit by more than the hysteresis.  Each crossing,
+ * in either direction, is reported to the console and then to CFE through the
+ * same asynchronous notification used for exceptions (the SystemNotify hook),
+ * at most once per sample.  The current state of all alarms may be read back
+ * with CFE_PSP_SysmonAlarm_GetStatus(), which modules provide through
+ * CFE_PSP_IODriver_GET_CONFIGURATION.
+ *
+ * Alarms are checked by the sampling task of the module, from the values it
+ * has just published, and configured by the caller of the module under the
+ * iodriver lock.  Neither waits for the other: a change to an alarm is picked
+ * up at the next sample, and an alarm being changed is skipped for one sample.
+ */
+
+#ifndef CFE_PSP_SYSMONALARM_H
+#define CFE_PSP_SYSMONALARM_H
+
+#include "cfe_psp.h"
+
+/**
+ * \brief The number of alarms each module can have, at most 32
+ */
+#ifndef CFE_PSP_SYSMONALARM_MAX_ALARMS
+#define CFE_PSP_SYSMONALARM_MAX_ALARMS 16
+#endif
+
+/**
+ * \brief State of an alarm
+ */
+enum
+{
+    CFE_PSP_SysmonAlarm_State_NORMAL = 0, /**< Within the limits, or not yet checked */
+    CFE_PSP_SysmonAlarm_State_HIGH   = 1, /**< Reached the high limit */
+    CFE_PSP_SysmonAlarm_State_LOW    = 2  /**< Reached the low limit */
+};
+
+/**
+ * \brief Reads the latest value of a channel of the module
+ *
+ * \returns true if the channel exists and has a valid value
+ */
+typedef bool (*CFE_PSP_SysmonAlarm_ValueFunc_t)(void *Arg, uint16 Subsystem, uint16 Subchannel, uint32 *Value);
+
+/**
+ * \brief Notifies CFE of alarm crossings, see CFE_PSP_SysmonAlarm_SetNotify()
+ */
+typedef void (*CFE_PSP_SysmonAlarm_NotifyFunc_t)(void *Arg);
+
+/**
+ * \brief One alarm
+ *
+ * The limits are protected by Generation, which is odd while they are being
+ * changed.  The state is only used by the sampling task.
+ */
+typedef struct
+{
+    volatile uint32 Generation;
+    uint16          Subsystem;
+    uint16          Subchannel;
+    bool            HasLow;
+    bool            HasHigh;
+    uint32          LowLimit;
+    uint32          HighLimit;
+    uint32          Hysteresis;
+
+    uint32 CheckedGeneration; /**< Generation of the limits the state applies to */
+    uint8  State;
+} CFE_PSP_SysmonAlarm_Entry_t;
+
+/**
+ * \brief All alarms of a module, held by the module across stop/start of its sampler
+ */
+typedef struct
+{
+    const char *                     ModuleName;
+    const char *const *              SubsystemNames;
+    CFE_PSP_SysmonAlarm_NotifyFunc_t NotifyFunc;
+    void *                           NotifyArg;
+
+    volatile uint32 HighMask;      /**< Bit N is set while alarm N is in the HIGH state */
+    volatile uint32 LowMask;       /**< Bit N is set while alarm N is in the LOW state */
+    volatile uint32 CrossingCount; /**< Number of crossings in either direction */
+
+    CFE_PSP_SysmonAlarm_Entry_t Entry[CFE_PSP_SYSMONALARM_MAX_ALARMS];
+} CFE_PSP_SysmonAlarmSet_t;
+
+/**
+ * \brief The state of the alarms of a module, as read by CFE_PSP_IODriver_GET_CONFIGURATION
+ */
+typedef struct
+{
+    uint32 HighMask;      /**< Bit N is set while alarm N is in the HIGH state */
+    uint32 LowMask;       /**< Bit N is set while alarm N is in the LOW state */
+    uint32 CrossingCount; /**< Number of crossings in either direction since the module was loaded */
+} CFE_PSP_SysmonAlarmStatus_t;
+
+/**
+ * \brief Initialize a set of alarms, with none configured
+ *
+ * \param Set            The alarms of the module
+ * \param ModuleName     Name of the module, used in messages
+ * \param SubsystemNames NULL terminated list of the subsystem names of the module
+ */
+void CFE_PSP_SysmonAlarm_Init(CFE_PSP_SysmonAlarmSet_t *Set, const char *ModuleName,
+                              const char *const *SubsystemNames);
+
+/**
+ * \brief Set the function used to notify CFE of crossings
+ *
+ * By default GLOBAL_CFE_CONFIGDATA.SystemNotify is called directly from the
+ * sampling task.  A platform with an idle task event loop would instead
+ * set a function that raises an event there.  This must only be called while
+ * the sampler is not running.
+ *
+ * \param Set        The alarms of the module
+ * \param NotifyFunc The function to call, or NULL for the default
+ * \param NotifyArg  Opaque argument to pass to the function
+ */
+void CFE_PSP_SysmonAlarm_SetNotify(CFE_PSP_SysmonAlarmSet_t *Set, CFE_PSP_SysmonAlarm_NotifyFunc_t NotifyFunc,
+                                   void *NotifyArg);
+
+/**
+ * \brief Add, change or remove an alarm
+ *
+ * \param Set  The alarms of the module
+ * \param Spec The value of the "alarm" configuration key, see above
+ *
+ * \retval CFE_PSP_SUCCESS if the alarm was changed
+ * \retval CFE_PSP_ERROR if the string is not valid or all alarms are in use
+ */
+int32 CFE_PSP_SysmonAlarm_Configure(CFE_PSP_SysmonAlarmSet_t *Set, const char *Spec);
+
+/**
+ * \brief Set all alarms back to the normal state, when the sampler starts
+ */
+void CFE_PSP_SysmonAlarm_Reset(CFE_PSP_SysmonAlarmSet_t *Set);
+
+/**
+ * \brief Check all alarms against the latest sample, from the sampling task
+ *
+ * \param Set       The alarms of the module
+ * \param ValueFunc Reads each channel with an alarm
+ * \param Arg       Opaque argument to pass to ValueFunc
+ *
+ * \returns the number of crossings, which were also notified
+ */
+uint32 CFE_PSP_SysmonAlarm_Check(CFE_PSP_SysmonAlarmSet_t *Set, CFE_PSP_SysmonAlarm_ValueFunc_t ValueFunc, void *Arg);
+
+/**
+ * \brief Notify CFE of an alarm, for modules that check fixed alarms of their own
+ */
+void CFE_PSP_SysmonAlarm_Notify(CFE_PSP_SysmonAlarmSet_t *Set);
+
+/**
+ * \brief Read the state of all alarms
+ */
+void CFE_PSP_SysmonAlarm_GetStatus(const CFE_PSP_SysmonAlarmSet_t *Set, CFE_PSP_SysmonAlarmStatus_t *Status);
+
+#endif
@@ -0,0 +1,144 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,719-1, and identified as “core Flight System: Bootes”
+ *
+ * Copyright (c) 2020 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ************************************************************************/
+
+/**
+ * \file
+ *
+ * Sysmon sample recorder
+ *
+ * Optionally records every sample taken by a sysmon module into a ring of
+ * fixed size records, either in a file mapped into memory (on Linux) or in a
+ * block of reserved memory (CFE_PSP_ReservedMemoryMap.SysmonRecordMemory), so
+ * the history of the monitored channels can be examined offline.  See
+ * fsw/shared/tools/psp_sysmon_record_csv.c to convert the ring to CSV.
+ *
+ * Only the sampling task of the module writes to the ring, and a record is
+ * just a few stores into memory, so recording needs no lock and no system
+ * call and never blocks the sampler.  A module that is not recording pays
+ * for a single NULL check per channel.
+ *
+ * The recorder must only be attached or detached while the sampler is not
+ * running.
+ */
+
+#ifndef CFE_PSP_SYSMONRECORD_H
+#define CFE_PSP_SYSMONRECORD_H
+
+#include "cfe_psp.h"
+#include "cfe_psp_sysmonrecord_types.h"
+
+/**
+ * \brief State of a recorder, held by the sysmon module
+ */
+typedef struct
+{
+    CFE_PSP_SysmonRecordHeader_t *Header;  /**< NULL when not recording */
+    CFE_PSP_SysmonRecordEntry_t * Records; /**< The ring, following the header */
+    uint32                        Mask;    /**< NumRecords - 1 */
+    uint32                        WriteCount;
+    uint32                        TimebaseUpper; /**< Timestamp of the current sample */
+    uint32                        TimebaseLower;
+} CFE_PSP_SysmonRecorder_t;
+
+/**
+ * \brief Start recording into a block of memory
+ *
+ * If the memory already holds a ring of the same geometry written by the
+ * same module, such as from before a processor reset or a previous run using
+ * the same file, the new samples are appended to it.  Otherwise the memory is
+ * initialized, using the largest power-of-two number of records that fits.
+ *
+ * \param Recorder       The recorder state
+ * \param Memory         The storage, which must be aligned to at least 4 bytes
+ * \param Size           The size of the storage in bytes
+ * \param ModuleName     Name of the sysmon module, saved in the header
+ * \param SubsystemNames NULL terminated list of the subsystem names of the module, saved in the header
+ *
+ * \retval CFE_PSP_SUCCESS if recording started
+ * \retval CFE_PSP_ERROR if the storage is too small for the header and at least one record
+ */
+int32 CFE_PSP_SysmonRecord_Attach(CFE_PSP_SysmonRecorder_t *Recorder, void *Memory, size_t Size,
+                                  const char *ModuleName, const char *const *SubsystemNames);
+
+/**
+ * \brief Start recording into the reserved memory block of the platform
+ *
+ * As CFE_PSP_SysmonRecord_Attach(), using CFE_PSP_ReservedMemoryMap.SysmonRecordMemory.
+ *
+ * \retval CFE_PSP_SUCCESS if recording started
+ * \retval CFE_PSP_ERROR_NOT_IMPLEMENTED if the platform does not reserve memory for a recorder
+ * \retval CFE_PSP_ERROR if the reserved block is too small
+ */
+int32 CFE_PSP_SysmonRecord_AttachReserved(CFE_PSP_SysmonRecorder_t *Recorder, const char *ModuleName,
+                                          const char *const *SubsystemNames);
+
+/**
+ * \brief Stop recording
+ *
+ * The storage is left as it is, and may be unmapped or freed afterwards.
+ */
+void CFE_PSP_SysmonRecord_Detach(CFE_PSP_SysmonRecorder_t *Recorder);
+
+/**
+ * \brief Start a sample, reading the timestamp used by all of its records
+ */
+void CFE_PSP_SysmonRecord_BeginSample(CFE_PSP_SysmonRecorder_t *Recorder);
+
+/**
+ * \brief Record one channel value of the current sample
+ *
+ * \param Recorder   The recorder state
+ * \param Subsystem  The subsystem number of the channel, as used in CFE_PSP_IODriver_Command()
+ * \param Subchannel The subchannel number of the channel
+ * \param Value      The value of the channel
+ */
+static inline void CFE_PSP_SysmonRecord_Add(CFE_PSP_SysmonRecorder_t *Recorder, uint16 Subsystem, uint16 Subchannel,
+                                            uint32 Value)
+{
+    CFE_PSP_SysmonRecordEntry_t *Entry;
+
+    if (Recorder->Header == NULL)
+    {
+        return;
+    }
+
+    Entry = &Recorder->Records[Recorder->WriteCount & Recorder->Mask];
+
+    Entry->TimebaseUpper = Recorder->TimebaseUpper;
+    Entry->TimebaseLower = Recorder->TimebaseLower;
+    Entry->Subsystem     = Subsystem;
+    Entry->Subchannel    = Subchannel;
+    Entry->Value         = Value;
+
+    ++Recorder->WriteCount;
+}
+
+/**
+ * \brief Finish a sample, making all of its records visible to readers at once
+ */
+static inline void CFE_PSP_SysmonRecord_EndSample(CFE_PSP_SysmonRecorder_t *Recorder)
+{
+    if (Recorder->Header == NULL)
+    {
+        return;
+    }
+
+    __atomic_store_n(&Recorder->Header->WriteCount, Recorder->WriteCount, __ATOMIC_RELEASE);
+}
+
+#endif
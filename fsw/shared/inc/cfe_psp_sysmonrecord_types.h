@@ -0,0 +1,101 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,719-1, and identified as “core Flight System: Bootes”
+ *
+ * Copyright (c) 2020 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ************************************************************************/
+
+/**
+ * \file
+ *
+ * Layout of the sysmon sample recorder storage
+ *
+ * The storage is a header followed by a power-of-two number of fixed size
+ * records, used as a ring.  Each record is a single channel value from a
+ * sysmon module sample, tagged with the subsystem and subchannel it was read
+ * from, so a sample of N channels is N consecutive records with the same
+ * timestamp.  The header records the geometry, the timebase rate and the
+ * subsystem names, so that tools can decode the storage without knowing the
+ * configuration of the target it came from.
+ *
+ * This only depends on common_types.h, so that it can also be used by host tools.
+ */
+
+#ifndef CFE_PSP_SYSMONRECORD_TYPES_H
+#define CFE_PSP_SYSMONRECORD_TYPES_H
+
+#include "common_types.h"
+
+/**
+ * \brief Value of the storage header signature when the storage is initialized
+ */
+#define CFE_PSP_SYSMONRECORD_SIGNATURE ((uint32)0x50535352) /* "PSSR" */
+
+/**
+ * \brief Version of the storage layout, incremented on any incompatible change
+ */
+#define CFE_PSP_SYSMONRECORD_VERSION 1
+
+/**
+ * \brief Length of the module and subsystem names held in the header
+ */
+#define CFE_PSP_SYSMONRECORD_NAME_LENGTH 16
+
+/**
+ * \brief Number of subsystem names held in the header
+ *
+ * Records of higher subsystem numbers are still kept, but are not named.
+ */
+#define CFE_PSP_SYSMONRECORD_MAX_SUBSYSTEMS 16
+
+/**
+ * \brief A single recorded channel value
+ *
+ * The timestamp is the raw value of CFE_PSP_Get_Timebase() at the start of
+ * the sample, which is converted to real time offline using the rate saved
+ * in the storage header.  The value is as returned by the sysmon module,
+ * e.g. a 24 bit analog code for a load, or a count.
+ */
+typedef struct
+{
+    uint32 TimebaseUpper;
+    uint32 TimebaseLower;
+    uint16 Subsystem;
+    uint16 Subchannel;
+    uint32 Value;
+} CFE_PSP_SysmonRecordEntry_t;
+
+/**
+ * \brief Header of the recorder storage
+ *
+ * WriteCount is the total number of records ever written, so the valid
+ * records are the last (up to) NumRecords before WriteCount.  It is only
+ * advanced at the end of each sample, so a reader never sees part of one.
+ */
+typedef struct
+{
+    uint32          Signature;
+    uint32          Version;
+    uint32          HeaderSize;     /**< Offset of the first record from the start of the storage */
+    uint32          NumRecords;     /**< Size of the ring, a power of two */
+    uint32          TicksPerSecond; /**< Value of CFE_PSP_GetTimerTicksPerSecond() */
+    uint32          Low32Rollover;  /**< Value of CFE_PSP_GetTimerLow32Rollover() */
+    uint32          AttachCount;    /**< Number of times recording was started into this storage */
+    volatile uint32 WriteCount;     /**< Number of records written */
+    char            ModuleName[CFE_PSP_SYSMONRECORD_NAME_LENGTH];
+    uint32          Spare[4];
+    char            SubsystemNames[CFE_PSP_SYSMONRECORD_MAX_SUBSYSTEMS][CFE_PSP_SYSMONRECORD_NAME_LENGTH];
+} CFE_PSP_SysmonRecordHeader_t;
+
+#endif
@@ -0,0 +1,132 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,719-1, and identified as “core Flight System: Bootes”
+ *
+ * Copyright (c) 2020 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ************************************************************************/
+
+/**
+ * \file
+ *
+ * Helpers common to the sysmon modules
+ *
+ * Configuration strings given through CFE_PSP_IODriver_SET_CONFIGURATION are
+ * of the form "<key>=<value>", one key per command.
+ *
+ * The load averages are exponentially weighted, and updated once per sample.
+ * Each is kept with CFE_PSP_SYSMON_AVG_FRAC_BITS below the 24 bit load, and
+ * decays by a factor which is a fraction of CFE_PSP_SYSMON_DECAY_ONE.  The
+ * helpers are inline as they run for every CPU on every sample.
+ */
+
+#ifndef CFE_PSP_SYSMONUTIL_H
+#define CFE_PSP_SYSMONUTIL_H
+
+#include <string.h>
+
+#include "cfe_psp.h"
+
+/**
+ * \brief Checks if a configuration string is of the form "<key>=<value>"
+ *
+ * \param[in] ConfigStr The configuration string
+ * \param[in] Key       The key to match
+ *
+ * \returns a pointer to the value within ConfigStr, or NULL if it is for another key
+ */
+static inline const char *CFE_PSP_SysmonConfig_GetValue(const char *ConfigStr, const char *Key)
+{
+    size_t KeyLen = strlen(Key);
+
+    if (strncmp(ConfigStr, Key, KeyLen) != 0 || ConfigStr[KeyLen] != '=')
+    {
+        return NULL;
+    }
+
+    return &ConfigStr[KeyLen + 1];
+}
+
+/**
+ * \brief Opcodes which the sysmon modules answer without the device mutex
+ *
+ * For the ReentrantBaseOps and ReentrantClassOps of the sysmon drivers.  These
+ * only read the published snapshots or state set once at init, which the
+ * modules keep across stop/start of the sampler.  The iodriver headers must be
+ * included before use.
+ */
+#define CFE_PSP_SYSMON_REENTRANT_BASE_OPS                              \
+    (CFE_PSP_IODRIVER_OPCODE_BIT(CFE_PSP_IODriver_NOOP) |              \
+     CFE_PSP_IODRIVER_OPCODE_BIT(CFE_PSP_IODriver_GET_RUNNING) |       \
+     CFE_PSP_IODRIVER_OPCODE_BIT(CFE_PSP_IODriver_GET_CONFIGURATION) | \
+     CFE_PSP_IODRIVER_OPCODE_BIT(CFE_PSP_IODriver_LOOKUP_SUBSYSTEM) |  \
+     CFE_PSP_IODRIVER_OPCODE_BIT(CFE_PSP_IODriver_LOOKUP_SUBCHANNEL) | \
+     CFE_PSP_IODRIVER_OPCODE_BIT(CFE_PSP_IODriver_QUERY_DIRECTION))
+#define CFE_PSP_SYSMON_REENTRANT_CLASS_OPS                          \
+    (CFE_PSP_IODRIVER_OPCODE_BIT(CFE_PSP_IODriver_ANALOG_IO_NOOP) | \
+     CFE_PSP_IODRIVER_OPCODE_BIT(CFE_PSP_IODriver_ANALOG_IO_READ_CHANNELS))
+
+/**
+ * \brief Bits of fraction kept below the load in an average
+ */
+#define CFE_PSP_SYSMON_AVG_FRAC_BITS 8
+
+/**
+ * \brief Decay factors are fractions of CFE_PSP_SYSMON_DECAY_ONE
+ */
+#define CFE_PSP_SYSMON_DECAY_SHIFT 16
+#define CFE_PSP_SYSMON_DECAY_ONE   (1 << CFE_PSP_SYSMON_DECAY_SHIFT)
+
+/**
+ * \brief Updates a set of averages with a new load value
+ *
+ * The first value just sets the averages, so they do not start from zero.
+ *
+ * \param[inout] Avg        The averages, one per window
+ * \param[inout] HasAvg     Whether the averages have been set
+ * \param[in]    Load       The load of the latest sample
+ * \param[in]    Decay      The fraction of each average remaining after one sample
+ * \param[in]    NumWindows The number of averages
+ */
+static inline void CFE_PSP_SysmonAvg_Update(uint32 *Avg, bool *HasAvg, int32 Load, const uint32 *Decay,
+                                            uint32 NumWindows)
+{
+    uint64 Value;
+    uint32 w;
+
+    Value = (uint64)Load << CFE_PSP_SYSMON_AVG_FRAC_BITS;
+    for (w = 0; w < NumWindows; ++w)
+    {
+        if (*HasAvg)
+        {
+            Avg[w] = ((Avg[w] * (uint64)Decay[w]) + (Value * (CFE_PSP_SYSMON_DECAY_ONE - Decay[w]))) >>
+                     CFE_PSP_SYSMON_DECAY_SHIFT;
+        }
+        else
+        {
+            Avg[w] = Value;
+        }
+    }
+
+    *HasAvg = true;
+}
+
+/**
+ * \brief Converts an average back to a load, rounding to the nearest
+ */
+static inline int32 CFE_PSP_SysmonAvg_ToLoad(uint32 Avg)
+{
+    return (Avg + (1 << (CFE_PSP_SYSMON_AVG_FRAC_BITS - 1))) >> CFE_PSP_SYSMON_AVG_FRAC_BITS;
+}
+
+#endif /* CFE_PSP_SYSMONUTIL_H */
@@ -0,0 +1,168 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,719-1, and identified as “core Flight System: Bootes”
+ *
+ * Copyright (c) 2020 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ************************************************************************/
+
+/**
+ * \file
+ *
+ * PSP trace facility
+ *
+ * Records timestamped begin/end/instant events from within the PSP into
+ * per-thread rings located in reserved memory.  Each thread claims a ring of
+ * its own on first use and is the only writer of that ring, so recording an
+ * event needs no lock and no atomic read-modify-write.
+ *
+ * Tracing is compiled in only when the platform defines CFE_PSP_TRACE_ENABLE
+ * in cfe_psp_config.h, otherwise the CFE_PSP_TRACE_* macros expand to nothing
+ * (and their arguments are not evaluated).  This requires compiler support
+ * for thread-local storage, and POSIX thread-specific data so that the ring
+ * of a thread is given back when it exits.
+ *
+ * Because the rings are in reserved memory they are preserved across a
+ * processor reset.  See fsw/shared/tools/psp_trace_dump.c to convert them
+ * into the Chrome/Perfetto JSON trace format.
+ */
+
+#ifndef CFE_PSP_TRACE_H
+#define CFE_PSP_TRACE_H
+
+#include "cfe_psp.h"
+#include "cfe_psp_config.h"
+#include "cfe_psp_trace_types.h"
+
+/*
+ * Number of rings, which is the number of threads that can record events at
+ * the same time.  Events from other threads are dropped until a ring is freed.
+ */
+#ifndef CFE_PSP_TRACE_MAX_RINGS
+#define CFE_PSP_TRACE_MAX_RINGS 16
+#endif
+
+/*
+ * Number of entries in each ring.  This must be a power of two.
+ */
+#ifndef CFE_PSP_TRACE_RING_ENTRIES
+#define CFE_PSP_TRACE_RING_ENTRIES 1024
+#endif
+
+#define CFE_PSP_TRACE_RING_MASK (CFE_PSP_TRACE_RING_ENTRIES - 1)
+
+typedef struct
+{
+    CFE_PSP_TraceRingHeader_t Header;
+    CFE_PSP_TraceEntry_t      Entries[CFE_PSP_TRACE_RING_ENTRIES];
+} CFE_PSP_TraceRing_t;
+
+struct CFE_PSP_TraceStorage
+{
+    CFE_PSP_TraceStorageHeader_t Header;
+    CFE_PSP_TraceRing_t          Rings[CFE_PSP_TRACE_MAX_RINGS];
+};
+
+/**
+ * \brief Initialize the trace storage and enable recording
+ *
+ * This must be called once the reset type is known and the timebase is
+ * available, after CFE_PSP_InitProcessorReservedMemory().  Events recorded
+ * before this are discarded.
+ *
+ * On a processor reset, the content of the rings is preserved and the events
+ * recorded by the previous boot remain available until they are overwritten.
+ * Otherwise the storage is cleared.
+ *
+ * This does nothing if CFE_PSP_TRACE_ENABLE is not defined, or if the
+ * platform did not provide a CFE_PSP_ReservedMemoryMap.TraceStoragePtr.
+ *
+ * \param RestartType The type of reset (CFE_PSP_RST_TYPE_POWERON or CFE_PSP_RST_TYPE_PROCESSOR)
+ */
+void CFE_PSP_Trace_Init(uint32 RestartType);
+
+#ifdef CFE_PSP_TRACE_ENABLE
+
+/**
+ * \brief The ring of the calling thread, or NULL if it does not have one yet
+ */
+extern __thread CFE_PSP_TraceRing_t *CFE_PSP_Trace_LocalRing;
+
+/**
+ * \brief Claim a ring for the calling thread
+ *
+ * Called on the first event recorded by each thread.  Not for direct use.
+ *
+ * \returns The ring for the calling thread, or NULL if tracing is not yet initialized or no ring is free
+ */
+CFE_PSP_TraceRing_t *CFE_PSP_Trace_ClaimRing(void);
+
+/**
+ * \brief Give back a ring claimed by CFE_PSP_Trace_ClaimRing()
+ *
+ * Called when the thread which owns the ring exits.  Not for direct use.
+ *
+ * \param Arg The ring
+ */
+void CFE_PSP_Trace_ReleaseRing(void *Arg);
+
+/**
+ * \brief Record an event into the ring of the calling thread
+ *
+ * Use the CFE_PSP_TRACE_* macros rather than calling this directly.
+ *
+ * \param EventId The CFE_PSP_TRACE_EVENT_* ID of the event
+ * \param Phase   The CFE_PSP_TRACE_PHASE_* of the event
+ * \param Arg     An event-specific argument
+ */
+static inline void CFE_PSP_Trace_Record(uint16 EventId, uint8 Phase, uint32 Arg)
+{
+    CFE_PSP_TraceRing_t * Ring;
+    CFE_PSP_TraceEntry_t *Entry;
+    uint32                Seq;
+
+    Ring = CFE_PSP_Trace_LocalRing;
+    if (Ring == NULL)
+    {
+        Ring = CFE_PSP_Trace_ClaimRing();
+        if (Ring == NULL)
+        {
+            return;
+        }
+    }
+
+    Seq   = Ring->Header.WriteCount;
+    Entry = &Ring->Entries[Seq & CFE_PSP_TRACE_RING_MASK];
+
+    CFE_PSP_Get_Timebase(&Entry->TimebaseUpper, &Entry->TimebaseLower);
+    Entry->EventId = EventId;
+    Entry->Phase   = Phase;
+    Entry->Arg     = Arg;
+
+    /* publish the entry only once it is complete */
+    __atomic_store_n(&Ring->Header.WriteCount, Seq + 1, __ATOMIC_RELEASE);
+}
+
+#define CFE_PSP_TRACE_BEGIN(EventId, Arg)   CFE_PSP_Trace_Record((EventId), CFE_PSP_TRACE_PHASE_BEGIN, (Arg))
+#define CFE_PSP_TRACE_END(EventId, Arg)     CFE_PSP_Trace_Record((EventId), CFE_PSP_TRACE_PHASE_END, (Arg))
+#define CFE_PSP_TRACE_INSTANT(EventId, Arg) CFE_PSP_Trace_Record((EventId), CFE_PSP_TRACE_PHASE_INSTANT, (Arg))
+
+#else
+
+#define CFE_PSP_TRACE_BEGIN(EventId, Arg)   ((void)0)
+#define CFE_PSP_TRACE_END(EventId, Arg)     ((void)0)
+#define CFE_PSP_TRACE_INSTANT(EventId, Arg) ((void)0)
+
+#endif
+
+#endif
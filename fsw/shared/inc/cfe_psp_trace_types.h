@@ -0,0 +1,128 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,719-1, and identified as “core Flight System: Bootes”
+ *
+ * Copyright (c) 2020 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ************************************************************************/
+
+/**
+ * \file
+ *
+ * Layout of the PSP trace buffers in reserved memory
+ *
+ * The storage consists of a header followed by a number of rings, each of
+ * which is a ring header followed by a power-of-two number of entries.  The
+ * counts are recorded in the storage header, so that tools can decode a
+ * memory image without knowing the configuration of the target it came from.
+ *
+ * This only depends on common_types.h, so that it can also be used by host tools.
+ */
+
+#ifndef CFE_PSP_TRACE_TYPES_H
+#define CFE_PSP_TRACE_TYPES_H
+
+#include "common_types.h"
+
+/**
+ * \brief Value of the storage header signature when the storage is initialized
+ */
+#define CFE_PSP_TRACE_SIGNATURE ((uint32)0x50535054) /* "PSPT" */
+
+/**
+ * \brief Version of the storage layout, incremented on any incompatible change
+ */
+#define CFE_PSP_TRACE_VERSION 1
+
+/**
+ * \brief Length of the thread names held in each ring header
+ */
+#define CFE_PSP_TRACE_NAME_LENGTH 24
+
+/*
+ * Phase of a trace entry
+ *
+ * These are the same characters that the Chrome trace event format uses
+ * for the "ph" field, so they can be passed through directly.
+ */
+#define CFE_PSP_TRACE_PHASE_BEGIN   'B'
+#define CFE_PSP_TRACE_PHASE_END     'E'
+#define CFE_PSP_TRACE_PHASE_INSTANT 'i'
+
+/*
+ * Event IDs of the tracepoints built into the PSP
+ *
+ * PSP modules may define their own event IDs starting at CFE_PSP_TRACE_EVENT_MODULE_BASE.
+ */
+#define CFE_PSP_TRACE_EVENT_IODRIVER_COMMAND 1 /**< CFE_PSP_IODriver_Command(), Arg is command code / result */
+#define CFE_PSP_TRACE_EVENT_CDS_WRITE        2 /**< CFE_PSP_WriteToCDS(), Arg is number of bytes */
+#define CFE_PSP_TRACE_EVENT_CDS_READ         3 /**< CFE_PSP_ReadFromCDS(), Arg is number of bytes */
+#define CFE_PSP_TRACE_EVENT_EXCEPTION        4 /**< Exception log entry retrieved, Arg is the context ID */
+#define CFE_PSP_TRACE_EVENT_TIMEBASE_TICK    5 /**< Soft timebase master tick, Arg is the tick count */
+#define CFE_PSP_TRACE_EVENT_MODULE_BASE      0x100
+
+/**
+ * \brief A single trace entry
+ *
+ * The timestamp is the raw value of CFE_PSP_Get_Timebase(), which is
+ * converted to real time offline using the rate saved in the storage header.
+ */
+typedef struct
+{
+    uint32 TimebaseUpper;
+    uint32 TimebaseLower;
+    uint16 EventId;
+    uint8  Phase;
+    uint8  Spare;
+    uint32 Arg;
+} CFE_PSP_TraceEntry_t;
+
+/**
+ * \brief Header of a per-thread ring (64 bytes, one cache line)
+ *
+ * WriteCount is the total number of entries ever written to the ring, so the
+ * valid entries are the last (up to) RingEntries before WriteCount.  Entries
+ * before RestartCount were written by the previous owner of the ring, which is
+ * identified in PrevTaskId / PrevName.  That is a thread which has exited, or
+ * one from before the most recent processor reset.
+ */
+typedef struct
+{
+    volatile uint32 WriteCount;
+    uint32          RestartCount;
+    uint32          TaskId;
+    uint32          PrevTaskId;
+    char            Name[CFE_PSP_TRACE_NAME_LENGTH];
+    char            PrevName[CFE_PSP_TRACE_NAME_LENGTH];
+} CFE_PSP_TraceRingHeader_t;
+
+/**
+ * \brief Header of the trace storage (64 bytes, one cache line)
+ */
+typedef struct
+{
+    uint32          Signature;
+    uint32          Version;
+    uint32          NumRings;
+    uint32          RingEntries;
+    uint32          TicksPerSecond; /**< Value of CFE_PSP_GetTimerTicksPerSecond() */
+    uint32          Low32Rollover;  /**< Value of CFE_PSP_GetTimerLow32Rollover() */
+    uint32          BootCount;      /**< Number of times the storage was initialized since it was cleared */
+    volatile uint32 RingsClaimed;   /**< Number of times a thread has claimed a ring during this boot */
+    volatile uint32 EventsDropped;  /**< Number of events lost during this boot as no ring was free */
+    uint32          Spare[7];
+} CFE_PSP_TraceStorageHeader_t;
+
+typedef struct CFE_PSP_TraceStorage CFE_PSP_TraceStorage_t;
+
+#endif
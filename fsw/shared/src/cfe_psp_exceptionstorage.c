@@ -48,6 +48,7 @@
 #include "cfe_psp_exceptionstorage_types.h"
 #include "cfe_psp_exceptionstorage_api.h"
 #include "cfe_psp_memory.h"
+#include "cfe_psp_trace.h"
 
 #include "target_config.h"
 
@@ -205,6 +206,12 @@ int32 CFE_PSP_Exception_GetSummary(uint32 *ContextLogId, osal_id_t *TaskId, char
 
     ++CFE_PSP_ReservedMemoryMap.ExceptionStoragePtr->NumRead;
 
+    /*
+     * This is traced here rather than when the entry is written, because
+     * that may be in a signal handler where the trace facility is not safe.
+     */
+    CFE_PSP_TRACE_INSTANT(CFE_PSP_TRACE_EVENT_EXCEPTION, Buffer->context_id);
+
     /*
      * returning SUCCESS to indicate an entry was popped from the queue
      *
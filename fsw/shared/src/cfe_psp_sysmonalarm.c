@@ -0,0 +1,406 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,719-1, and identified as “core Flight System: Bootes”
+ *
+ * Copyright (c) 2020 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ************************************************************************/
+
+/**
+ * \file
+ *
+ * Implementation of the sysmon threshold alarms
+ *
+ * See cfe_psp_sysmonalarm.h for a description of the alarms.
+ */
+
+/*
+**  Include Files
+*/
+#include <stdlib.h>
+#include <string.h>
+
+/*
+** cFE includes
+*/
+#include "common_types.h"
+#include "osapi.h"
+#include "target_config.h"
+
+#include "cfe_psp.h"
+#include "cfe_psp_sysmonalarm.h"
+
+/* the alarm states are reported as 32 bit masks */
+#if CFE_PSP_SYSMONALARM_MAX_ALARMS > 32
+#error "CFE_PSP_SYSMONALARM_MAX_ALARMS must be 32 or less"
+#endif
+
+/*
+ * Finds the name of a subsystem, for messages
+ */
+static const char *CFE_PSP_SysmonAlarm_SubsystemName(const CFE_PSP_SysmonAlarmSet_t *Set, uint16 Subsystem)
+{
+    uint16 i;
+
+    for (i = 0; Set->SubsystemNames[i] != NULL; ++i)
+    {
+        if (i == Subsystem)
+        {
+            return Set->SubsystemNames[i];
+        }
+    }
+
+    return "unknown";
+}
+
+/*
+ * Parses one limit of an alarm specification, which is either empty or a
+ * number, and moves past the comma following it.
+ */
+static bool CFE_PSP_SysmonAlarm_ParseLimit(const char **Pos, bool *HasLimit, uint32 *Limit)
+{
+    char *        End;
+    unsigned long Value;
+
+    *HasLimit = false;
+    *Limit    = 0;
+
+    if (**Pos != ',' && **Pos != 0)
+    {
+        Value = strtoul(*Pos, &End, 0);
+        if (End == *Pos || (*End != ',' && *End != 0) || Value > 0xFFFFFFFF)
+        {
+            return false;
+        }
+
+        *HasLimit = true;
+        *Limit    = Value;
+        *Pos      = End;
+    }
+
+    if (**Pos == ',')
+    {
+        ++(*Pos);
+    }
+
+    return true;
+}
+
+/*
+ * Decides the state of an alarm from a new value
+ */
+static uint8 CFE_PSP_SysmonAlarm_NextState(const CFE_PSP_SysmonAlarm_Entry_t *Limits, uint8 State, uint32 Value)
+{
+    if (Limits->HasHigh && Value >= Limits->HighLimit)
+    {
+        return CFE_PSP_SysmonAlarm_State_HIGH;
+    }
+    if (Limits->HasLow && Value <= Limits->LowLimit)
+    {
+        return CFE_PSP_SysmonAlarm_State_LOW;
+    }
+
+    /* inside both limits, but an alarm only clears once it is beyond the hysteresis */
+    if (State == CFE_PSP_SysmonAlarm_State_HIGH && Limits->HasHigh &&
+        (Limits->HighLimit - Value) <= Limits->Hysteresis)
+    {
+        return CFE_PSP_SysmonAlarm_State_HIGH;
+    }
+    if (State == CFE_PSP_SysmonAlarm_State_LOW && Limits->HasLow && (Value - Limits->LowLimit) <= Limits->Hysteresis)
+    {
+        return CFE_PSP_SysmonAlarm_State_LOW;
+    }
+
+    return CFE_PSP_SysmonAlarm_State_NORMAL;
+}
+
+/*---------------------------------------------------------------------------
+ * CFE_PSP_SysmonAlarm_Init
+ * See description in prototype
+ *---------------------------------------------------------------------------*/
+void CFE_PSP_SysmonAlarm_Init(CFE_PSP_SysmonAlarmSet_t *Set, const char *ModuleName,
+                              const char *const *SubsystemNames)
+{
+    memset(Set, 0, sizeof(*Set));
+
+    Set->ModuleName     = ModuleName;
+    Set->SubsystemNames = SubsystemNames;
+}
+
+/*---------------------------------------------------------------------------
+ * CFE_PSP_SysmonAlarm_SetNotify
+ * See description in prototype
+ *---------------------------------------------------------------------------*/
+void CFE_PSP_SysmonAlarm_SetNotify(CFE_PSP_SysmonAlarmSet_t *Set, CFE_PSP_SysmonAlarm_NotifyFunc_t NotifyFunc,
+                                   void *NotifyArg)
+{
+    Set->NotifyFunc = NotifyFunc;
+    Set->NotifyArg  = NotifyArg;
+}
+
+/*---------------------------------------------------------------------------
+ * CFE_PSP_SysmonAlarm_Configure
+ * See description in prototype
+ *---------------------------------------------------------------------------*/
+int32 CFE_PSP_SysmonAlarm_Configure(CFE_PSP_SysmonAlarmSet_t *Set, const char *Spec)
+{
+    CFE_PSP_SysmonAlarm_Entry_t *Entry;
+    CFE_PSP_SysmonAlarm_Entry_t  Limits;
+    const char *                 Sep;
+    const char *                 Pos;
+    char *                       End;
+    unsigned long                Value;
+    uint32                       Generation;
+    uint32                       i;
+    bool                         HasHysteresis;
+
+    if (Spec == NULL)
+    {
+        return CFE_PSP_INVALID_POINTER;
+    }
+
+    memset(&Limits, 0, sizeof(Limits));
+
+    /* the subsystem, by name or number */
+    Sep = strchr(Spec, '/');
+    if (Sep == NULL || Sep == Spec)
+    {
+        OS_printf("CFE_PSP(%s): Invalid alarm \'%s\', expected <subsystem>/<subchannel>,<low>,<high>\n",
+                  Set->ModuleName, Spec);
+        return CFE_PSP_ERROR;
+    }
+
+    for (i = 0; Set->SubsystemNames[i] != NULL; ++i)
+    {
+        if (strncmp(Spec, Set->SubsystemNames[i], Sep - Spec) == 0 && Set->SubsystemNames[i][Sep - Spec] == 0)
+        {
+            break;
+        }
+    }
+    if (Set->SubsystemNames[i] != NULL)
+    {
+        Limits.Subsystem = i;
+    }
+    else
+    {
+        Value = strtoul(Spec, &End, 10);
+        if (End != Sep || Value > 0xFFFF)
+        {
+            OS_printf("CFE_PSP(%s): Invalid alarm subsystem in \'%s\'\n", Set->ModuleName, Spec);
+            return CFE_PSP_ERROR;
+        }
+        Limits.Subsystem = Value;
+    }
+
+    Pos   = Sep + 1;
+    Value = strtoul(Pos, &End, 10);
+    if (End == Pos || (*End != ',' && *End != 0) || Value > 0xFFFF)
+    {
+        OS_printf("CFE_PSP(%s): Invalid alarm subchannel in \'%s\'\n", Set->ModuleName, Spec);
+        return CFE_PSP_ERROR;
+    }
+    Limits.Subchannel = Value;
+
+    Pos = End;
+    if (*Pos == ',')
+    {
+        ++Pos;
+    }
+    if (!CFE_PSP_SysmonAlarm_ParseLimit(&Pos, &Limits.HasLow, &Limits.LowLimit) ||
+        !CFE_PSP_SysmonAlarm_ParseLimit(&Pos, &Limits.HasHigh, &Limits.HighLimit) ||
+        !CFE_PSP_SysmonAlarm_ParseLimit(&Pos, &HasHysteresis, &Limits.Hysteresis) ||
+        *Pos != 0 || (Limits.HasLow && Limits.HasHigh && Limits.LowLimit >= Limits.HighLimit))
+    {
+        OS_printf("CFE_PSP(%s): Invalid alarm limits in \'%s\'\n", Set->ModuleName, Spec);
+        return CFE_PSP_ERROR;
+    }
+
+    /* an alarm already on this channel is changed, otherwise a free one is used */
+    Entry = NULL;
+    for (i = 0; i < CFE_PSP_SYSMONALARM_MAX_ALARMS; ++i)
+    {
+        if (Set->Entry[i].HasLow || Set->Entry[i].HasHigh)
+        {
+            if (Set->Entry[i].Subsystem == Limits.Subsystem && Set->Entry[i].Subchannel == Limits.Subchannel)
+            {
+                Entry = &Set->Entry[i];
+                break;
+            }
+        }
+        else if (Entry == NULL)
+        {
+            Entry = &Set->Entry[i];
+        }
+    }
+
+    if (!Limits.HasLow && !Limits.HasHigh && (Entry == NULL || (!Entry->HasLow && !Entry->HasHigh)))
+    {
+        /* removing an alarm which does not exist */
+        return CFE_PSP_SUCCESS;
+    }
+
+    if (Entry == NULL)
+    {
+        OS_printf("CFE_PSP(%s): No free alarm for \'%s\', %u in use\n", Set->ModuleName, Spec,
+                  (unsigned int)CFE_PSP_SYSMONALARM_MAX_ALARMS);
+        return CFE_PSP_ERROR;
+    }
+
+    /* the sampler skips the alarm while the generation is odd, or if it changed while reading */
+    Generation = Entry->Generation;
+    __atomic_store_n(&Entry->Generation, Generation + 1, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+
+    Entry->Subsystem  = Limits.Subsystem;
+    Entry->Subchannel = Limits.Subchannel;
+    Entry->HasLow     = Limits.HasLow;
+    Entry->HasHigh    = Limits.HasHigh;
+    Entry->LowLimit   = Limits.LowLimit;
+    Entry->HighLimit  = Limits.HighLimit;
+    Entry->Hysteresis = Limits.Hysteresis;
+
+    __atomic_store_n(&Entry->Generation, Generation + 2, __ATOMIC_RELEASE);
+
+    return CFE_PSP_SUCCESS;
+}
+
+/*---------------------------------------------------------------------------
+ * CFE_PSP_SysmonAlarm_Reset
+ * See description in prototype
+ *---------------------------------------------------------------------------*/
+void CFE_PSP_SysmonAlarm_Reset(CFE_PSP_SysmonAlarmSet_t *Set)
+{
+    uint32 i;
+
+    for (i = 0; i < CFE_PSP_SYSMONALARM_MAX_ALARMS; ++i)
+    {
+        Set->Entry[i].State = CFE_PSP_SysmonAlarm_State_NORMAL;
+    }
+
+    Set->HighMask = 0;
+    Set->LowMask  = 0;
+}
+
+/*---------------------------------------------------------------------------
+ * CFE_PSP_SysmonAlarm_Check
+ * See description in prototype
+ *---------------------------------------------------------------------------*/
+uint32 CFE_PSP_SysmonAlarm_Check(CFE_PSP_SysmonAlarmSet_t *Set, CFE_PSP_SysmonAlarm_ValueFunc_t ValueFunc, void *Arg)
+{
+    static const char *const StateNames[] = {"cleared", "HIGH", "LOW"};
+
+    CFE_PSP_SysmonAlarm_Entry_t *Entry;
+    CFE_PSP_SysmonAlarm_Entry_t  Limits;
+    uint32                       Generation;
+    uint32                       Value;
+    uint32                       Crossings;
+    uint32                       HighMask;
+    uint32                       LowMask;
+    uint32                       i;
+    uint8                        State;
+
+    Crossings = 0;
+    HighMask  = 0;
+    LowMask   = 0;
+
+    for (i = 0; i < CFE_PSP_SYSMONALARM_MAX_ALARMS; ++i)
+    {
+        Entry = &Set->Entry[i];
+
+        /* an alarm which is being changed keeps its state until the next sample */
+        Generation = __atomic_load_n(&Entry->Generation, __ATOMIC_ACQUIRE);
+        if ((Generation & 1) == 0)
+        {
+            Limits.Subsystem  = Entry->Subsystem;
+            Limits.Subchannel = Entry->Subchannel;
+            Limits.HasLow     = Entry->HasLow;
+            Limits.HasHigh    = Entry->HasHigh;
+            Limits.LowLimit   = Entry->LowLimit;
+            Limits.HighLimit  = Entry->HighLimit;
+            Limits.Hysteresis = Entry->Hysteresis;
+
+            __atomic_thread_fence(__ATOMIC_ACQUIRE);
+            if (__atomic_load_n(&Entry->Generation, __ATOMIC_RELAXED) == Generation)
+            {
+                /* new limits start over from the normal state */
+                if (Entry->CheckedGeneration != Generation)
+                {
+                    Entry->CheckedGeneration = Generation;
+                    Entry->State             = CFE_PSP_SysmonAlarm_State_NORMAL;
+                }
+
+                if ((Limits.HasLow || Limits.HasHigh) && ValueFunc(Arg, Limits.Subsystem, Limits.Subchannel, &Value))
+                {
+                    State = CFE_PSP_SysmonAlarm_NextState(&Limits, Entry->State, Value);
+                    if (State != Entry->State)
+                    {
+                        OS_printf("CFE_PSP(%s): Alarm %s/%u %s, value %lu (0x%lx)\n", Set->ModuleName,
+                                  CFE_PSP_SysmonAlarm_SubsystemName(Set, Limits.Subsystem),
+                                  (unsigned int)Limits.Subchannel, StateNames[State], (unsigned long)Value,
+                                  (unsigned long)Value);
+
+                        Entry->State = State;
+                        ++Crossings;
+                    }
+                }
+            }
+        }
+
+        if (Entry->State == CFE_PSP_SysmonAlarm_State_HIGH)
+        {
+            HighMask |= 1UL << i;
+        }
+        else if (Entry->State == CFE_PSP_SysmonAlarm_State_LOW)
+        {
+            LowMask |= 1UL << i;
+        }
+    }
+
+    Set->HighMask = HighMask;
+    Set->LowMask  = LowMask;
+
+    if (Crossings != 0)
+    {
+        Set->CrossingCount += Crossings;
+        CFE_PSP_SysmonAlarm_Notify(Set);
+    }
+
+    return Crossings;
+}
+
+/*---------------------------------------------------------------------------
+ * CFE_PSP_SysmonAlarm_Notify
+ * See description in prototype
+ *---------------------------------------------------------------------------*/
+void CFE_PSP_SysmonAlarm_Notify(CFE_PSP_SysmonAlarmSet_t *Set)
+{
+    if (Set->NotifyFunc != NULL)
+    {
+        Set->NotifyFunc(Set->NotifyArg);
+    }
+    else if (GLOBAL_CFE_CONFIGDATA.SystemNotify != NULL)
+    {
+        GLOBAL_CFE_CONFIGDATA.SystemNotify();
+    }
+}
+
+/*---------------------------------------------------------------------------
+ * CFE_PSP_SysmonAlarm_GetStatus
+ * See description in prototype
+ *---------------------------------------------------------------------------*/
+void CFE_PSP_SysmonAlarm_GetStatus(const CFE_PSP_SysmonAlarmSet_t *Set, CFE_PSP_SysmonAlarmStatus_t *Status)
+{
+    Status->HighMask      = Set->HighMask;
+    Status->LowMask       = Set->LowMask;
+    Status->CrossingCount = Set->CrossingCount;
+}
@@ -0,0 +1,144 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,719-1, and identified as “core Flight System: Bootes”
+ *
+ * Copyright (c) 2020 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ************************************************************************/
+
+/**
+ * \file
+ *
+ * Implementation of the sysmon sample recorder
+ *
+ * See cfe_psp_sysmonrecord.h for a description of the recorder.
+ */
+
+/*
+**  Include Files
+*/
+#include <string.h>
+
+/*
+** cFE includes
+*/
+#include "common_types.h"
+#include "osapi.h"
+
+#include "cfe_psp.h"
+#include "cfe_psp_config.h"
+#include "cfe_psp_memory.h"
+#include "cfe_psp_sysmonrecord.h"
+
+/*---------------------------------------------------------------------------
+ * CFE_PSP_SysmonRecord_Attach
+ * See description in prototype
+ *---------------------------------------------------------------------------*/
+int32 CFE_PSP_SysmonRecord_Attach(CFE_PSP_SysmonRecorder_t *Recorder, void *Memory, size_t Size,
+                                  const char *ModuleName, const char *const *SubsystemNames)
+{
+    CFE_PSP_SysmonRecordHeader_t *Header;
+    size_t                        NumRecords;
+    uint32                        i;
+
+    memset(Recorder, 0, sizeof(*Recorder));
+
+    if (Memory == NULL || Size < (sizeof(CFE_PSP_SysmonRecordHeader_t) + sizeof(CFE_PSP_SysmonRecordEntry_t)))
+    {
+        return CFE_PSP_ERROR;
+    }
+
+    /* use the largest power of two that fits, and that the 32 bit counts can index */
+    NumRecords = (Size - sizeof(CFE_PSP_SysmonRecordHeader_t)) / sizeof(CFE_PSP_SysmonRecordEntry_t);
+    if (NumRecords > 0x80000000)
+    {
+        NumRecords = 0x80000000;
+    }
+    while ((NumRecords & (NumRecords - 1)) != 0)
+    {
+        NumRecords &= NumRecords - 1;
+    }
+
+    Header = Memory;
+    if (Header->Signature != CFE_PSP_SYSMONRECORD_SIGNATURE || Header->Version != CFE_PSP_SYSMONRECORD_VERSION ||
+        Header->HeaderSize != sizeof(CFE_PSP_SysmonRecordHeader_t) || Header->NumRecords != NumRecords ||
+        strncmp(Header->ModuleName, ModuleName, sizeof(Header->ModuleName)) != 0)
+    {
+        /* only the header needs to be cleared, records beyond the write count are never read */
+        memset(Header, 0, sizeof(*Header));
+        Header->Signature  = CFE_PSP_SYSMONRECORD_SIGNATURE;
+        Header->Version    = CFE_PSP_SYSMONRECORD_VERSION;
+        Header->HeaderSize = sizeof(CFE_PSP_SysmonRecordHeader_t);
+        Header->NumRecords = NumRecords;
+        strncpy(Header->ModuleName, ModuleName, sizeof(Header->ModuleName));
+    }
+
+    memset(Header->SubsystemNames, 0, sizeof(Header->SubsystemNames));
+    for (i = 0; i < CFE_PSP_SYSMONRECORD_MAX_SUBSYSTEMS && SubsystemNames[i] != NULL; ++i)
+    {
+        strncpy(Header->SubsystemNames[i], SubsystemNames[i], sizeof(Header->SubsystemNames[i]));
+    }
+
+    Header->TicksPerSecond = CFE_PSP_GetTimerTicksPerSecond();
+    Header->Low32Rollover  = CFE_PSP_GetTimerLow32Rollover();
+    ++Header->AttachCount;
+
+    Recorder->Records    = (CFE_PSP_SysmonRecordEntry_t *)(Header + 1);
+    Recorder->Mask       = NumRecords - 1;
+    Recorder->WriteCount = Header->WriteCount;
+    Recorder->Header     = Header;
+
+    OS_printf("CFE_PSP: %s recording %lu channel values at 0x%08lx, %lu already recorded\n", ModuleName,
+              (unsigned long)NumRecords, (unsigned long)(cpuaddr)Memory, (unsigned long)Recorder->WriteCount);
+
+    return CFE_PSP_SUCCESS;
+}
+
+/*---------------------------------------------------------------------------
+ * CFE_PSP_SysmonRecord_AttachReserved
+ * See description in prototype
+ *---------------------------------------------------------------------------*/
+int32 CFE_PSP_SysmonRecord_AttachReserved(CFE_PSP_SysmonRecorder_t *Recorder, const char *ModuleName,
+                                          const char *const *SubsystemNames)
+{
+    if (CFE_PSP_ReservedMemoryMap.SysmonRecordMemory.BlockSize == 0)
+    {
+        memset(Recorder, 0, sizeof(*Recorder));
+        return CFE_PSP_ERROR_NOT_IMPLEMENTED;
+    }
+
+    return CFE_PSP_SysmonRecord_Attach(Recorder, CFE_PSP_ReservedMemoryMap.SysmonRecordMemory.BlockPtr,
+                                       CFE_PSP_ReservedMemoryMap.SysmonRecordMemory.BlockSize, ModuleName,
+                                       SubsystemNames);
+}
+
+/*---------------------------------------------------------------------------
+ * CFE_PSP_SysmonRecord_Detach
+ * See description in prototype
+ *---------------------------------------------------------------------------*/
+void CFE_PSP_SysmonRecord_Detach(CFE_PSP_SysmonRecorder_t *Recorder)
+{
+    memset(Recorder, 0, sizeof(*Recorder));
+}
+
+/*---------------------------------------------------------------------------
+ * CFE_PSP_SysmonRecord_BeginSample
+ * See description in prototype
+ *---------------------------------------------------------------------------*/
+void CFE_PSP_SysmonRecord_BeginSample(CFE_PSP_SysmonRecorder_t *Recorder)
+{
+    if (Recorder->Header != NULL)
+    {
+        CFE_PSP_Get_Timebase(&Recorder->TimebaseUpper, &Recorder->TimebaseLower);
+    }
+}
@@ -0,0 +1,247 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,719-1, and identified as “core Flight System: Bootes”
+ *
+ * Copyright (c) 2020 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ************************************************************************/
+
+/**
+ * \file
+ *
+ * Implementation of the PSP trace facility
+ *
+ * See cfe_psp_trace.h for a description of the facility.
+ */
+
+/*
+**  Include Files
+*/
+#include <stdio.h>
+#include <string.h>
+
+#ifdef CFE_PSP_TRACE_ENABLE
+#include <pthread.h>
+#endif
+
+/*
+** cFE includes
+*/
+#include "common_types.h"
+#include "osapi.h"
+
+#include "cfe_psp.h"
+#include "cfe_psp_config.h"
+#include "cfe_psp_memory.h"
+#include "cfe_psp_trace.h"
+
+#ifdef CFE_PSP_TRACE_ENABLE
+
+/*
+ * The storage in use, which remains NULL until CFE_PSP_Trace_Init()
+ * so that any events recorded during early startup are discarded.
+ */
+static CFE_PSP_TraceStorage_t *CFE_PSP_Trace_Storage;
+
+/*
+ * Which rings are owned by a running thread.  This does not survive a reset,
+ * so it is kept in normal memory.  A ring is given back by the destructor of
+ * CFE_PSP_Trace_RingKey when its thread exits, and the count of owned rings
+ * lets threads find out that none is free without scanning them all.
+ */
+static uint8         CFE_PSP_Trace_RingOwned[CFE_PSP_TRACE_MAX_RINGS];
+static uint32        CFE_PSP_Trace_RingsOwned;
+static pthread_key_t CFE_PSP_Trace_RingKey;
+static bool          CFE_PSP_Trace_RingKeyValid;
+
+__thread CFE_PSP_TraceRing_t *CFE_PSP_Trace_LocalRing;
+
+/*---------------------------------------------------------------------------
+ * CFE_PSP_Trace_RetireOwner
+ *
+ * Keeps the events of the last thread which owned a ring, and remembers
+ * which thread wrote them, as the ring is about to be claimed by another one.
+ *---------------------------------------------------------------------------*/
+static void CFE_PSP_Trace_RetireOwner(CFE_PSP_TraceRing_t *Ring)
+{
+    memcpy(Ring->Header.PrevName, Ring->Header.Name, sizeof(Ring->Header.PrevName));
+    Ring->Header.PrevTaskId   = Ring->Header.TaskId;
+    Ring->Header.RestartCount = Ring->Header.WriteCount;
+    Ring->Header.TaskId       = 0;
+    memset(Ring->Header.Name, 0, sizeof(Ring->Header.Name));
+}
+
+/*---------------------------------------------------------------------------
+ * CFE_PSP_Trace_ClaimRing
+ * Internal function - see description in prototype
+ *---------------------------------------------------------------------------*/
+CFE_PSP_TraceRing_t *CFE_PSP_Trace_ClaimRing(void)
+{
+    CFE_PSP_TraceStorage_t *Storage;
+    CFE_PSP_TraceRing_t *   Ring;
+    osal_id_t               TaskId;
+    uint32                  Index;
+    uint8                   Owned;
+    char                    TaskName[OS_MAX_API_NAME];
+
+    Storage = __atomic_load_n(&CFE_PSP_Trace_Storage, __ATOMIC_ACQUIRE);
+    if (Storage == NULL)
+    {
+        return NULL;
+    }
+
+    Index = CFE_PSP_TRACE_MAX_RINGS;
+    if (__atomic_load_n(&CFE_PSP_Trace_RingsOwned, __ATOMIC_RELAXED) < CFE_PSP_TRACE_MAX_RINGS)
+    {
+        for (Index = 0; Index < CFE_PSP_TRACE_MAX_RINGS; ++Index)
+        {
+            Owned = 0;
+            if (__atomic_compare_exchange_n(&CFE_PSP_Trace_RingOwned[Index], &Owned, 1, false, __ATOMIC_ACQUIRE,
+                                            __ATOMIC_RELAXED))
+            {
+                break;
+            }
+        }
+    }
+
+    if (Index >= CFE_PSP_TRACE_MAX_RINGS)
+    {
+        /* No ring is free, so this event is lost and the next one tries again */
+        __atomic_fetch_add(&Storage->Header.EventsDropped, 1, __ATOMIC_RELAXED);
+        return NULL;
+    }
+
+    __atomic_fetch_add(&CFE_PSP_Trace_RingsOwned, 1, __ATOMIC_RELAXED);
+    __atomic_fetch_add(&Storage->Header.RingsClaimed, 1, __ATOMIC_RELAXED);
+
+    Ring = &Storage->Rings[Index];
+    if (Ring->Header.Name[0] != 0)
+    {
+        /* owned earlier in this boot by a thread which has since exited */
+        CFE_PSP_Trace_RetireOwner(Ring);
+    }
+
+    TaskId              = OS_TaskGetId();
+    Ring->Header.TaskId = OS_ObjectIdToInteger(TaskId);
+    if (OS_GetResourceName(TaskId, TaskName, sizeof(TaskName)) != OS_SUCCESS || TaskName[0] == 0)
+    {
+        /* Not an OSAL task, e.g. the startup/idle thread, and the ring needs a name to be seen as used */
+        snprintf(TaskName, sizeof(TaskName), "thread-%u", (unsigned int)Index);
+    }
+    strncpy(Ring->Header.Name, TaskName, sizeof(Ring->Header.Name) - 1);
+    Ring->Header.Name[sizeof(Ring->Header.Name) - 1] = 0;
+
+    if (CFE_PSP_Trace_RingKeyValid)
+    {
+        pthread_setspecific(CFE_PSP_Trace_RingKey, Ring);
+    }
+
+    CFE_PSP_Trace_LocalRing = Ring;
+
+    return Ring;
+}
+
+/*---------------------------------------------------------------------------
+ * CFE_PSP_Trace_ReleaseRing
+ * Internal function - see description in prototype
+ *---------------------------------------------------------------------------*/
+void CFE_PSP_Trace_ReleaseRing(void *Arg)
+{
+    CFE_PSP_TraceStorage_t *Storage;
+    CFE_PSP_TraceRing_t *   Ring;
+
+    Storage = __atomic_load_n(&CFE_PSP_Trace_Storage, __ATOMIC_ACQUIRE);
+    Ring    = Arg;
+    if (Storage == NULL || Ring < &Storage->Rings[0] || Ring >= &Storage->Rings[CFE_PSP_TRACE_MAX_RINGS])
+    {
+        return;
+    }
+
+    if (__atomic_exchange_n(&CFE_PSP_Trace_RingOwned[Ring - Storage->Rings], 0, __ATOMIC_RELEASE) != 0)
+    {
+        __atomic_fetch_sub(&CFE_PSP_Trace_RingsOwned, 1, __ATOMIC_RELAXED);
+    }
+}
+
+#endif /* CFE_PSP_TRACE_ENABLE */
+
+/*---------------------------------------------------------------------------
+ * CFE_PSP_Trace_Init
+ * Internal function - see description in prototype
+ *---------------------------------------------------------------------------*/
+void CFE_PSP_Trace_Init(uint32 RestartType)
+{
+#ifdef CFE_PSP_TRACE_ENABLE
+    CFE_PSP_TraceStorage_t *Storage;
+    CFE_PSP_TraceRing_t *   Ring;
+    uint32                  i;
+
+    /* stop recording while the storage is set up */
+    __atomic_store_n(&CFE_PSP_Trace_Storage, NULL, __ATOMIC_RELEASE);
+
+    Storage = CFE_PSP_ReservedMemoryMap.TraceStoragePtr;
+    if (Storage == NULL)
+    {
+        return;
+    }
+
+    if (!CFE_PSP_Trace_RingKeyValid)
+    {
+        /* without it rings are not given back when their thread exits */
+        CFE_PSP_Trace_RingKeyValid = (pthread_key_create(&CFE_PSP_Trace_RingKey, CFE_PSP_Trace_ReleaseRing) == 0);
+    }
+
+    if (RestartType == CFE_PSP_RST_TYPE_PROCESSOR && Storage->Header.Signature == CFE_PSP_TRACE_SIGNATURE &&
+        Storage->Header.Version == CFE_PSP_TRACE_VERSION && Storage->Header.NumRings == CFE_PSP_TRACE_MAX_RINGS &&
+        Storage->Header.RingEntries == CFE_PSP_TRACE_RING_ENTRIES)
+    {
+        /*
+         * Keep the events from the previous boot, as the ring may be claimed
+         * by a different thread this time.
+         *
+         * Rings which were not claimed during the previous boot still hold
+         * older events, so those are left as they are.
+         */
+        for (i = 0; i < CFE_PSP_TRACE_MAX_RINGS; ++i)
+        {
+            Ring = &Storage->Rings[i];
+            if (Ring->Header.Name[0] != 0)
+            {
+                CFE_PSP_Trace_RetireOwner(Ring);
+            }
+        }
+    }
+    else
+    {
+        memset(Storage, 0, sizeof(*Storage));
+        Storage->Header.Signature   = CFE_PSP_TRACE_SIGNATURE;
+        Storage->Header.Version     = CFE_PSP_TRACE_VERSION;
+        Storage->Header.NumRings    = CFE_PSP_TRACE_MAX_RINGS;
+        Storage->Header.RingEntries = CFE_PSP_TRACE_RING_ENTRIES;
+    }
+
+    Storage->Header.TicksPerSecond = CFE_PSP_GetTimerTicksPerSecond();
+    Storage->Header.Low32Rollover  = CFE_PSP_GetTimerLow32Rollover();
+    Storage->Header.RingsClaimed   = 0;
+    Storage->Header.EventsDropped  = 0;
+    ++Storage->Header.BootCount;
+
+    memset(CFE_PSP_Trace_RingOwned, 0, sizeof(CFE_PSP_Trace_RingOwned));
+    CFE_PSP_Trace_RingsOwned = 0;
+
+    OS_printf("CFE_PSP: Trace enabled, %u rings of %u entries, boot %u\n", (unsigned int)CFE_PSP_TRACE_MAX_RINGS,
+              (unsigned int)CFE_PSP_TRACE_RING_ENTRIES, (unsigned int)Storage->Header.BootCount);
+
+    __atomic_store_n(&CFE_PSP_Trace_Storage, Storage, __ATOMIC_RELEASE);
+#endif
+}
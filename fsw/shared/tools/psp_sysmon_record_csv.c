@@ -0,0 +1,350 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,719-1, and identified as “core Flight System: Bootes”
+ *
+ * Copyright (c) 2020 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ************************************************************************/
+
+/**
+ * \file
+ *
+ * Host tool to convert the samples recorded by a sysmon module (see
+ * cfe_psp_sysmonrecord.h) into CSV, with one row per channel value:
+ *
+ *    time,subsystem,subsystem_name,subchannel,value
+ *
+ * where time is in seconds from the timebase of the target, and the value
+ * is as read from the sysmon module, e.g. a 24 bit analog code for a load.
+ *
+ * The input is either the record file of linux_sysmon, which may be read
+ * while cFE is still running, or a memory image containing the recorder
+ * storage, such as a dump of the reserved memory from a target:
+ *
+ *    psp_sysmon_record_csv /dev/shm/sysmon.rec > sysmon.csv
+ *
+ * The storage is located by its signature, and images from a target of
+ * the opposite byte order are converted.  Records which the module may have
+ * overwritten while the file was being read are left out.
+ *
+ * CSV can be loaded directly into most analysis tools, or converted into a
+ * columnar format such as Parquet, e.g. with pandas or DuckDB, if needed.
+ *
+ * This is a standalone program, not part of the PSP build:
+ *
+ *    cc -O2 -I fsw/shared/inc -I <osal>/src/os/inc -o psp_sysmon_record_csv fsw/shared/tools/psp_sysmon_record_csv.c
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "cfe_psp_sysmonrecord_types.h"
+
+typedef struct
+{
+    const uint8 *                Base;
+    size_t                       Size;
+    size_t                       Offset; /* of the storage within the image */
+    bool                         Swap;
+    CFE_PSP_SysmonRecordHeader_t Header;
+} PSP_SysmonRecordCsv_State_t;
+
+static uint32 psp_sysmon_record_csv_u32(const PSP_SysmonRecordCsv_State_t *State, uint32 Val)
+{
+    if (State->Swap)
+    {
+        Val = __builtin_bswap32(Val);
+    }
+    return Val;
+}
+
+static uint16 psp_sysmon_record_csv_u16(const PSP_SysmonRecordCsv_State_t *State, uint16 Val)
+{
+    if (State->Swap)
+    {
+        Val = __builtin_bswap16(Val);
+    }
+    return Val;
+}
+
+/*
+ * Convert the numeric fields of a storage header to host byte order, which
+ * are all before the names
+ */
+static void psp_sysmon_record_csv_fix_header(const PSP_SysmonRecordCsv_State_t *State,
+                                             CFE_PSP_SysmonRecordHeader_t *     Header)
+{
+    Header->Signature      = psp_sysmon_record_csv_u32(State, Header->Signature);
+    Header->Version        = psp_sysmon_record_csv_u32(State, Header->Version);
+    Header->HeaderSize     = psp_sysmon_record_csv_u32(State, Header->HeaderSize);
+    Header->NumRecords     = psp_sysmon_record_csv_u32(State, Header->NumRecords);
+    Header->TicksPerSecond = psp_sysmon_record_csv_u32(State, Header->TicksPerSecond);
+    Header->Low32Rollover  = psp_sysmon_record_csv_u32(State, Header->Low32Rollover);
+    Header->AttachCount    = psp_sysmon_record_csv_u32(State, Header->AttachCount);
+    Header->WriteCount     = psp_sysmon_record_csv_u32(State, Header->WriteCount);
+}
+
+/*
+ * Find the recorder storage within the image, checking that the whole of it fits.
+ */
+static bool psp_sysmon_record_csv_locate(PSP_SysmonRecordCsv_State_t *State)
+{
+    CFE_PSP_SysmonRecordHeader_t Header;
+    size_t                       Offset;
+    uint32                       Signature;
+
+    for (Offset = 0; (Offset + sizeof(Header)) <= State->Size; Offset += sizeof(uint32))
+    {
+        memcpy(&Signature, State->Base + Offset, sizeof(Signature));
+        if (Signature == CFE_PSP_SYSMONRECORD_SIGNATURE)
+        {
+            State->Swap = false;
+        }
+        else if (Signature == __builtin_bswap32(CFE_PSP_SYSMONRECORD_SIGNATURE))
+        {
+            State->Swap = true;
+        }
+        else
+        {
+            continue;
+        }
+
+        memcpy(&Header, State->Base + Offset, sizeof(Header));
+        psp_sysmon_record_csv_fix_header(State, &Header);
+        if (Header.Version != CFE_PSP_SYSMONRECORD_VERSION || Header.HeaderSize != sizeof(Header) ||
+            Header.NumRecords == 0 || (Header.NumRecords & (Header.NumRecords - 1)) != 0)
+        {
+            continue;
+        }
+
+        if ((State->Size - Offset - sizeof(Header)) / sizeof(CFE_PSP_SysmonRecordEntry_t) < Header.NumRecords)
+        {
+            fprintf(stderr, "Recorder storage at offset 0x%lx is truncated\n", (unsigned long)Offset);
+            continue;
+        }
+
+        State->Offset = Offset;
+        State->Header = Header;
+        return true;
+    }
+
+    return false;
+}
+
+static void *psp_sysmon_record_csv_read_file(const char *FileName, size_t *Size)
+{
+    FILE * File;
+    uint8 *Data;
+    long   FileSize;
+
+    File = fopen(FileName, "rb");
+    if (File == NULL)
+    {
+        perror(FileName);
+        return NULL;
+    }
+
+    Data = NULL;
+    if (fseek(File, 0, SEEK_END) == 0 && (FileSize = ftell(File)) > 0 && fseek(File, 0, SEEK_SET) == 0)
+    {
+        Data = malloc(FileSize);
+        if (Data != NULL && fread(Data, 1, FileSize, File) != (size_t)FileSize)
+        {
+            free(Data);
+            Data = NULL;
+        }
+        *Size = FileSize;
+    }
+    if (Data == NULL)
+    {
+        fprintf(stderr, "%s: cannot read file\n", FileName);
+    }
+
+    fclose(File);
+    return Data;
+}
+
+/*
+ * Read the write count of the storage from the file again, after the records
+ * were read.  If the module was still recording, any records that it wrote
+ * since the first read may have overwritten older ones in the copy.
+ */
+static uint32 psp_sysmon_record_csv_reread_count(const PSP_SysmonRecordCsv_State_t *State, const char *FileName)
+{
+    CFE_PSP_SysmonRecordHeader_t Header;
+    FILE *                       File;
+    uint32                       WriteCount;
+
+    WriteCount = State->Header.WriteCount;
+
+    File = fopen(FileName, "rb");
+    if (File != NULL)
+    {
+        if (fseek(File, State->Offset, SEEK_SET) == 0 && fread(&Header, sizeof(Header), 1, File) == 1)
+        {
+            psp_sysmon_record_csv_fix_header(State, &Header);
+            WriteCount = Header.WriteCount;
+        }
+        fclose(File);
+    }
+
+    return WriteCount;
+}
+
+/*
+ * Find the largest number of records in one sample, among the records from Start to End
+ *
+ * The records of a sample all have the same timestamp.  The module may have been
+ * part way through a sample when the file was read, with those records written
+ * but not yet counted in the write count, so this many more of the oldest
+ * records in the copy may have been overwritten.
+ */
+static uint32 psp_sysmon_record_csv_max_sample(const PSP_SysmonRecordCsv_State_t *State,
+                                               const CFE_PSP_SysmonRecordEntry_t *Records, uint32 Start, uint32 End)
+{
+    const CFE_PSP_SysmonRecordEntry_t *Entry;
+    const CFE_PSP_SysmonRecordEntry_t *Prev;
+    uint32                             Seq;
+    uint32                             Count;
+    uint32                             MaxCount;
+
+    Prev     = NULL;
+    Count    = 0;
+    MaxCount = 0;
+    for (Seq = Start; (int32)(End - Seq) > 0; ++Seq)
+    {
+        Entry = &Records[Seq & (State->Header.NumRecords - 1)];
+        if (Prev != NULL && Entry->TimebaseUpper == Prev->TimebaseUpper && Entry->TimebaseLower == Prev->TimebaseLower)
+        {
+            ++Count;
+        }
+        else
+        {
+            Count = 1;
+        }
+        if (Count > MaxCount)
+        {
+            MaxCount = Count;
+        }
+        Prev = Entry;
+    }
+
+    return MaxCount;
+}
+
+static void psp_sysmon_record_csv_row(const PSP_SysmonRecordCsv_State_t *State, const CFE_PSP_SysmonRecordEntry_t *Entry)
+{
+    uint64 Ticks;
+    uint64 Secs;
+    uint64 Nsecs;
+    uint32 TicksPerSecond;
+    uint16 Subsystem;
+
+    TicksPerSecond = State->Header.TicksPerSecond;
+    if (TicksPerSecond == 0)
+    {
+        TicksPerSecond = 1000000000;
+    }
+
+    Ticks = psp_sysmon_record_csv_u32(State, Entry->TimebaseUpper);
+    if (State->Header.Low32Rollover != 0)
+    {
+        Ticks *= State->Header.Low32Rollover;
+    }
+    else
+    {
+        Ticks <<= 32;
+    }
+    Ticks += psp_sysmon_record_csv_u32(State, Entry->TimebaseLower);
+
+    Secs  = Ticks / TicksPerSecond;
+    Nsecs = ((Ticks % TicksPerSecond) * 1000000000) / TicksPerSecond;
+
+    Subsystem = psp_sysmon_record_csv_u16(State, Entry->Subsystem);
+    printf("%llu.%09llu,%u,", (unsigned long long)Secs, (unsigned long long)Nsecs, (unsigned int)Subsystem);
+    if (Subsystem < CFE_PSP_SYSMONRECORD_MAX_SUBSYSTEMS)
+    {
+        printf("%.*s", (int)CFE_PSP_SYSMONRECORD_NAME_LENGTH, State->Header.SubsystemNames[Subsystem]);
+    }
+    printf(",%u,%lu\n", (unsigned int)psp_sysmon_record_csv_u16(State, Entry->Subchannel),
+           (unsigned long)psp_sysmon_record_csv_u32(State, Entry->Value));
+}
+
+int main(int argc, char *argv[])
+{
+    PSP_SysmonRecordCsv_State_t        State;
+    const CFE_PSP_SysmonRecordEntry_t *Records;
+    void *                             Image;
+    uint32                             WriteCount;
+    uint32                             Start;
+    uint32                             Oldest;
+    uint32                             Seq;
+
+    if (argc != 2)
+    {
+        fprintf(stderr, "Usage: %s record-file | image-file\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    memset(&State, 0, sizeof(State));
+    Image = psp_sysmon_record_csv_read_file(argv[1], &State.Size);
+    if (Image == NULL)
+    {
+        return EXIT_FAILURE;
+    }
+
+    State.Base = Image;
+    if (!psp_sysmon_record_csv_locate(&State))
+    {
+        fprintf(stderr, "No sysmon recorder storage found\n");
+        return EXIT_FAILURE;
+    }
+
+    fprintf(stderr, "%.*s: %lu records of %lu written, %lu ticks/sec, attached %lu times\n",
+            (int)CFE_PSP_SYSMONRECORD_NAME_LENGTH, State.Header.ModuleName, (unsigned long)State.Header.NumRecords,
+            (unsigned long)State.Header.WriteCount, (unsigned long)State.Header.TicksPerSecond,
+            (unsigned long)State.Header.AttachCount);
+
+    Records = (const CFE_PSP_SysmonRecordEntry_t *)(State.Base + State.Offset + State.Header.HeaderSize);
+
+    /* Only the most recent NumRecords records are in the ring */
+    Start = 0;
+    if (State.Header.WriteCount > State.Header.NumRecords)
+    {
+        Start = State.Header.WriteCount - State.Header.NumRecords;
+    }
+
+    /*
+     * and fewer if it was written to while being read, by the samples completed
+     * since and the one which may still be in progress.  The counts are compared
+     * as differences, so this also holds once they wrap around.
+     */
+    WriteCount = psp_sysmon_record_csv_reread_count(&State, argv[1]);
+    Oldest     = psp_sysmon_record_csv_max_sample(&State, Records, Start, State.Header.WriteCount);
+    Oldest += WriteCount - State.Header.NumRecords;
+    if ((int32)(Oldest - Start) > 0)
+    {
+        Start = Oldest;
+    }
+
+    printf("time,subsystem,subsystem_name,subchannel,value\n");
+    for (Seq = Start; (int32)(State.Header.WriteCount - Seq) > 0; ++Seq)
+    {
+        psp_sysmon_record_csv_row(&State, &Records[Seq & (State.Header.NumRecords - 1)]);
+    }
+
+    free(Image);
+
+    return EXIT_SUCCESS;
+}
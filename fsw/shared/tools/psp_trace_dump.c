@@ -0,0 +1,435 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,719-1, and identified as “core Flight System: Bootes”
+ *
+ * Copyright (c) 2020 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ************************************************************************/
+
+/**
+ * \file
+ *
+ * Host tool to convert the PSP trace rings into the Chrome trace event
+ * JSON format, which can be loaded into Perfetto (ui.perfetto.dev) or
+ * chrome://tracing.
+ *
+ * The input is either a memory image containing the trace storage, such as
+ * a dump of the reserved memory from a target, or the reset area shared
+ * memory segment of a pc-linux cFE instance, which persists after the
+ * process exits:
+ *
+ *    psp_trace_dump image.bin > trace.json
+ *    psp_trace_dump -s .resetkeyfile > trace.json   (from the cFE working directory)
+ *
+ * The storage is located by its signature, and images from a target of
+ * the opposite byte order are converted.  Events written by the previous
+ * owner of a ring, from before the most recent processor reset or by a thread
+ * which has exited, are shown as a separate "previous owners" process.
+ *
+ * This is a standalone program, not part of the PSP build:
+ *
+ *    cc -O2 -I fsw/shared/inc -I <osal>/src/os/inc -o psp_trace_dump fsw/shared/tools/psp_trace_dump.c
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/ipc.h>
+#include <sys/shm.h>
+
+#include "cfe_psp_trace_types.h"
+
+#define PSP_TRACE_DUMP_PID_CURRENT  1
+#define PSP_TRACE_DUMP_PID_PREVIOUS 2
+
+typedef struct
+{
+    const uint8 *Base;
+    size_t       Size;
+    bool         Swap;
+
+    CFE_PSP_TraceStorageHeader_t Header;
+    bool                         FirstEvent;
+} PSP_TraceDump_State_t;
+
+static const char *PSP_TraceDump_EventNames[] = {
+    [CFE_PSP_TRACE_EVENT_IODRIVER_COMMAND] = "IODriver_Command",
+    [CFE_PSP_TRACE_EVENT_CDS_WRITE]        = "CDS_Write",
+    [CFE_PSP_TRACE_EVENT_CDS_READ]         = "CDS_Read",
+    [CFE_PSP_TRACE_EVENT_EXCEPTION]        = "Exception",
+    [CFE_PSP_TRACE_EVENT_TIMEBASE_TICK]    = "Timebase_Tick",
+};
+
+static uint32 psp_trace_dump_u32(const PSP_TraceDump_State_t *State, uint32 Val)
+{
+    if (State->Swap)
+    {
+        Val = __builtin_bswap32(Val);
+    }
+    return Val;
+}
+
+static uint16 psp_trace_dump_u16(const PSP_TraceDump_State_t *State, uint16 Val)
+{
+    if (State->Swap)
+    {
+        Val = __builtin_bswap16(Val);
+    }
+    return Val;
+}
+
+/*
+ * Read a storage header at the given offset, with the fields in host byte order.
+ */
+static void psp_trace_dump_read_header(PSP_TraceDump_State_t *State, size_t Offset, CFE_PSP_TraceStorageHeader_t *Header)
+{
+    uint32 *Field;
+    size_t  i;
+
+    memcpy(Header, State->Base + Offset, sizeof(*Header));
+    Field = (uint32 *)Header;
+    for (i = 0; i < (sizeof(*Header) / sizeof(uint32)); ++i)
+    {
+        Field[i] = psp_trace_dump_u32(State, Field[i]);
+    }
+}
+
+/*
+ * Find the trace storage within the image, checking that the whole of it fits.
+ */
+static bool psp_trace_dump_locate(PSP_TraceDump_State_t *State)
+{
+    CFE_PSP_TraceStorageHeader_t Header;
+    size_t                       Offset;
+    size_t                       RingSize;
+    uint32                       Signature;
+
+    for (Offset = 0; (Offset + sizeof(Header)) <= State->Size; Offset += sizeof(uint32))
+    {
+        memcpy(&Signature, State->Base + Offset, sizeof(Signature));
+        if (Signature == CFE_PSP_TRACE_SIGNATURE)
+        {
+            State->Swap = false;
+        }
+        else if (Signature == __builtin_bswap32(CFE_PSP_TRACE_SIGNATURE))
+        {
+            State->Swap = true;
+        }
+        else
+        {
+            continue;
+        }
+
+        psp_trace_dump_read_header(State, Offset, &Header);
+        if (Header.Version != CFE_PSP_TRACE_VERSION || Header.RingEntries == 0 ||
+            (Header.RingEntries & (Header.RingEntries - 1)) != 0)
+        {
+            continue;
+        }
+
+        RingSize = sizeof(CFE_PSP_TraceRingHeader_t) + (Header.RingEntries * sizeof(CFE_PSP_TraceEntry_t));
+        if ((State->Size - Offset - sizeof(Header)) / RingSize < Header.NumRings)
+        {
+            fprintf(stderr, "Trace storage at offset 0x%lx is truncated\n", (unsigned long)Offset);
+            continue;
+        }
+
+        State->Base += Offset;
+        State->Size -= Offset;
+        State->Header = Header;
+        return true;
+    }
+
+    return false;
+}
+
+/*
+ * Write a string as JSON, escaping as necessary
+ */
+static void psp_trace_dump_string(const char *Str, size_t MaxLen)
+{
+    size_t i;
+
+    putchar('"');
+    for (i = 0; i < MaxLen && Str[i] != 0; ++i)
+    {
+        if (Str[i] == '"' || Str[i] == '\\')
+        {
+            printf("\\%c", Str[i]);
+        }
+        else if ((unsigned char)Str[i] < 0x20)
+        {
+            printf("\\u%04x", (unsigned int)(unsigned char)Str[i]);
+        }
+        else
+        {
+            putchar(Str[i]);
+        }
+    }
+    putchar('"');
+}
+
+static void psp_trace_dump_separator(PSP_TraceDump_State_t *State)
+{
+    if (!State->FirstEvent)
+    {
+        printf(",\n");
+    }
+    State->FirstEvent = false;
+}
+
+static void psp_trace_dump_metadata(PSP_TraceDump_State_t *State, const char *Type, int Pid, int Tid, const char *Name,
+                                    size_t MaxLen)
+{
+    psp_trace_dump_separator(State);
+    printf("{\"ph\":\"M\",\"name\":\"%s\",\"pid\":%d,\"tid\":%d,\"args\":{\"name\":", Type, Pid, Tid);
+    psp_trace_dump_string(Name, MaxLen);
+    printf("}}");
+}
+
+/*
+ * Write a single event.  The timebase is converted to microseconds, which
+ * is the unit of the "ts" field, keeping nanosecond precision.
+ */
+static void psp_trace_dump_event(PSP_TraceDump_State_t *State, const CFE_PSP_TraceEntry_t *RawEntry, int Pid, int Tid)
+{
+    uint64 Ticks;
+    uint64 Secs;
+    uint64 Nsecs;
+    uint32 EventId;
+    uint32 TicksPerSecond;
+
+    TicksPerSecond = State->Header.TicksPerSecond;
+    if (TicksPerSecond == 0)
+    {
+        TicksPerSecond = 1000000000;
+    }
+
+    Ticks = psp_trace_dump_u32(State, RawEntry->TimebaseUpper);
+    if (State->Header.Low32Rollover != 0)
+    {
+        Ticks *= State->Header.Low32Rollover;
+    }
+    else
+    {
+        Ticks <<= 32;
+    }
+    Ticks += psp_trace_dump_u32(State, RawEntry->TimebaseLower);
+
+    Secs  = Ticks / TicksPerSecond;
+    Nsecs = ((Ticks % TicksPerSecond) * 1000000000) / TicksPerSecond;
+
+    psp_trace_dump_separator(State);
+    EventId = psp_trace_dump_u16(State, RawEntry->EventId);
+    if (EventId < (sizeof(PSP_TraceDump_EventNames) / sizeof(PSP_TraceDump_EventNames[0])) &&
+        PSP_TraceDump_EventNames[EventId] != NULL)
+    {
+        printf("{\"name\":\"%s\"", PSP_TraceDump_EventNames[EventId]);
+    }
+    else
+    {
+        printf("{\"name\":\"Event_0x%x\"", (unsigned int)EventId);
+    }
+    printf(",\"ph\":\"%c\",\"pid\":%d,\"tid\":%d,\"ts\":%llu.%03llu", RawEntry->Phase, Pid, Tid,
+           (unsigned long long)(Secs * 1000000 + Nsecs / 1000), (unsigned long long)(Nsecs % 1000));
+    if (RawEntry->Phase == CFE_PSP_TRACE_PHASE_INSTANT)
+    {
+        printf(",\"s\":\"t\"");
+    }
+    printf(",\"args\":{\"arg\":%lu}}", (unsigned long)psp_trace_dump_u32(State, RawEntry->Arg));
+}
+
+static void psp_trace_dump_ring(PSP_TraceDump_State_t *State, uint32 RingNum)
+{
+    const uint8 *                RingBase;
+    CFE_PSP_TraceRingHeader_t    RingHeader;
+    const CFE_PSP_TraceEntry_t * Entries;
+    uint32                       WriteCount;
+    uint32                       RestartCount;
+    uint32                       Seq;
+    uint32                       Start;
+
+    RingBase = State->Base + sizeof(CFE_PSP_TraceStorageHeader_t) +
+               (RingNum * (sizeof(RingHeader) + (State->Header.RingEntries * sizeof(CFE_PSP_TraceEntry_t))));
+    memcpy(&RingHeader, RingBase, sizeof(RingHeader));
+    Entries = (const CFE_PSP_TraceEntry_t *)(RingBase + sizeof(RingHeader));
+
+    WriteCount   = psp_trace_dump_u32(State, RingHeader.WriteCount);
+    RestartCount = psp_trace_dump_u32(State, RingHeader.RestartCount);
+
+    if (WriteCount == 0)
+    {
+        return;
+    }
+
+    if (RingHeader.Name[0] != 0)
+    {
+        psp_trace_dump_metadata(State, "thread_name", PSP_TRACE_DUMP_PID_CURRENT, RingNum, RingHeader.Name,
+                                sizeof(RingHeader.Name));
+    }
+    if (RingHeader.PrevName[0] != 0)
+    {
+        psp_trace_dump_metadata(State, "thread_name", PSP_TRACE_DUMP_PID_PREVIOUS, RingNum, RingHeader.PrevName,
+                                sizeof(RingHeader.PrevName));
+    }
+
+    /* Only the most recent RingEntries entries are still in the ring */
+    Start = 0;
+    if (WriteCount > State->Header.RingEntries)
+    {
+        Start = WriteCount - State->Header.RingEntries;
+    }
+
+    for (Seq = Start; Seq != WriteCount; ++Seq)
+    {
+        psp_trace_dump_event(State, &Entries[Seq & (State->Header.RingEntries - 1)],
+                             (Seq < RestartCount) ? PSP_TRACE_DUMP_PID_PREVIOUS : PSP_TRACE_DUMP_PID_CURRENT, RingNum);
+    }
+}
+
+static void *psp_trace_dump_attach_shm(const char *KeyFile, size_t *Size)
+{
+    key_t           Key;
+    int             ShmId;
+    void *          Addr;
+    struct shmid_ds ShmInfo;
+
+    Key = ftok(KeyFile, 'R');
+    if (Key == -1)
+    {
+        perror(KeyFile);
+        return NULL;
+    }
+
+    ShmId = shmget(Key, 0, 0);
+    if (ShmId == -1 || shmctl(ShmId, IPC_STAT, &ShmInfo) != 0)
+    {
+        perror("shmget");
+        return NULL;
+    }
+
+    Addr = shmat(ShmId, NULL, SHM_RDONLY);
+    if (Addr == (void *)-1)
+    {
+        perror("shmat");
+        return NULL;
+    }
+
+    *Size = ShmInfo.shm_segsz;
+    return Addr;
+}
+
+static void *psp_trace_dump_read_file(const char *FileName, size_t *Size)
+{
+    FILE * File;
+    uint8 *Data;
+    long   FileSize;
+
+    File = fopen(FileName, "rb");
+    if (File == NULL)
+    {
+        perror(FileName);
+        return NULL;
+    }
+
+    Data = NULL;
+    if (fseek(File, 0, SEEK_END) == 0 && (FileSize = ftell(File)) > 0 && fseek(File, 0, SEEK_SET) == 0)
+    {
+        Data = malloc(FileSize);
+        if (Data != NULL && fread(Data, 1, FileSize, File) != (size_t)FileSize)
+        {
+            free(Data);
+            Data = NULL;
+        }
+        *Size = FileSize;
+    }
+    if (Data == NULL)
+    {
+        fprintf(stderr, "%s: cannot read file\n", FileName);
+    }
+
+    fclose(File);
+    return Data;
+}
+
+int main(int argc, char *argv[])
+{
+    PSP_TraceDump_State_t State;
+    const void *          Image;
+    uint32                NumRings;
+    uint32                i;
+    int                   opt;
+    const char *          KeyFile;
+
+    KeyFile = NULL;
+    while ((opt = getopt(argc, argv, "s:")) != -1)
+    {
+        switch (opt)
+        {
+            case 's':
+                KeyFile = optarg;
+                break;
+            default:
+                fprintf(stderr, "Usage: %s [-s keyfile | image-file]\n", argv[0]);
+                return EXIT_FAILURE;
+        }
+    }
+
+    memset(&State, 0, sizeof(State));
+    if (KeyFile != NULL)
+    {
+        Image = psp_trace_dump_attach_shm(KeyFile, &State.Size);
+    }
+    else if (optind < argc)
+    {
+        Image = psp_trace_dump_read_file(argv[optind], &State.Size);
+    }
+    else
+    {
+        fprintf(stderr, "Usage: %s [-s keyfile | image-file]\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    if (Image == NULL)
+    {
+        return EXIT_FAILURE;
+    }
+
+    State.Base = Image;
+    if (!psp_trace_dump_locate(&State))
+    {
+        fprintf(stderr, "No PSP trace storage found\n");
+        return EXIT_FAILURE;
+    }
+
+    fprintf(stderr, "PSP trace: %lu rings of %lu entries, %lu ticks/sec, boot %lu, %lu events dropped\n",
+            (unsigned long)State.Header.NumRings, (unsigned long)State.Header.RingEntries,
+            (unsigned long)State.Header.TicksPerSecond, (unsigned long)State.Header.BootCount,
+            (unsigned long)State.Header.EventsDropped);
+
+    State.FirstEvent = true;
+    printf("{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n");
+    psp_trace_dump_metadata(&State, "process_name", PSP_TRACE_DUMP_PID_CURRENT, 0, "cFE", 4);
+    psp_trace_dump_metadata(&State, "process_name", PSP_TRACE_DUMP_PID_PREVIOUS, 0, "cFE (previous owners)", 22);
+
+    NumRings = State.Header.NumRings;
+    for (i = 0; i < NumRings; ++i)
+    {
+        psp_trace_dump_ring(&State, i);
+    }
+
+    printf("\n]}\n");
+
+    return EXIT_SUCCESS;
+}
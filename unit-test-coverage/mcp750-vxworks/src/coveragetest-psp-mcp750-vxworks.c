@@ -75,4 +75,18 @@ void UtTest_Setup(void)
     ADD_TEST(CFE_PSP_Exception_GetNextContextBuffer);
     ADD_TEST(CFE_PSP_Exception_GetSummary);
     ADD_TEST(CFE_PSP_Exception_CopyContext);
+
+    ADD_TEST(CFE_PSP_SysmonAlarm_Configure);
+    ADD_TEST(CFE_PSP_SysmonAlarm_Slots);
+    ADD_TEST(CFE_PSP_SysmonAlarm_Check);
+    ADD_TEST(CFE_PSP_SysmonAlarm_Generation);
+    ADD_TEST(CFE_PSP_SysmonAlarm_Notify);
+
+    ADD_TEST(CFE_PSP_SysmonRecord_Attach);
+    ADD_TEST(CFE_PSP_SysmonRecord_AttachReserved);
+    ADD_TEST(CFE_PSP_SysmonRecord_Sample);
+
+    ADD_TEST(CFE_PSP_Trace_Init);
+    ADD_TEST(CFE_PSP_Trace_ClaimRing);
+    ADD_TEST(CFE_PSP_Trace_Overflow);
 }
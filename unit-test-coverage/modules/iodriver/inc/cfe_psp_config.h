@@ -0,0 +1,32 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,719-1, and identified as “core Flight System: 
+ * Draco
+ *
+ * Copyright (c) 2023 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ **********************************************************************/
+
+/**
+ * \file
+ * \ingroup  modules
+ *
+ * Stub for "cfe_psp_config.h" to use with coverage testing
+ *
+ * CFE_PSP_TRACE_ENABLE is left undefined, so iodriver is tested without tracing.
+ */
+
+#ifndef CFE_PSP_CONFIG_H
+#define CFE_PSP_CONFIG_H
+
+#endif
@@ -0,0 +1,38 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,719-1, and identified as “core Flight System: 
+ * Draco
+ *
+ * Copyright (c) 2023 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ **********************************************************************/
+
+/**
+ * \file
+ * \ingroup  modules
+ *
+ * Declarations for the iodriver coverage test
+ */
+
+#ifndef COVERAGETEST_IODRIVER_H
+#define COVERAGETEST_IODRIVER_H
+
+#include "utassert.h"
+#include "uttest.h"
+#include "utstubs.h"
+
+void Test_Command_NoDriver(void);
+void Test_Command_Locking(void);
+void Test_Command_Reentrant(void);
+
+#endif
@@ -0,0 +1,187 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,719-1, and identified as “core Flight System: 
+ * Draco
+ *
+ * Copyright (c) 2023 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ **********************************************************************/
+
+/**
+ * \file
+ * \ingroup  modules
+ *
+ * Coverage test for the iodriver module
+ */
+
+#include "utassert.h"
+#include "utstubs.h"
+#include "uttest.h"
+
+#include "cfe_psp.h"
+#include "cfe_psp_module.h"
+#include "iodriver_base.h"
+#include "iodriver_impl.h"
+#include "iodriver_analog_io.h"
+
+#include "coveragetest-iodriver.h"
+
+#define UT_DRIVER_MODULE_ID 0x70000001
+
+extern CFE_PSP_ModuleApi_t CFE_PSP_iodriver_API;
+
+int32 UT_DriverCommand(uint32 CommandCode, uint16 Instance, uint16 SubChannel, CFE_PSP_IODriver_Arg_t Arg);
+int32 UT_DriverMutex(uint32 CommandCode, uint16 Instance, uint16 SubChannel, CFE_PSP_IODriver_Arg_t Arg);
+
+/*
+ * A driver marking one common and one analog opcode as reentrant.  NOOP is
+ * also marked, as the low bits of many other opcodes select the same bit.
+ */
+CFE_PSP_IODriver_API_t UT_DriverApi = {
+    .DeviceCommand     = UT_DriverCommand,
+    .DeviceMutex       = UT_DriverMutex,
+    .ReentrantBaseOps  = CFE_PSP_IODRIVER_OPCODE_BIT(CFE_PSP_IODriver_NOOP) |
+                        CFE_PSP_IODRIVER_OPCODE_BIT(CFE_PSP_IODriver_GET_RUNNING),
+    .ReentrantClassOps = CFE_PSP_IODRIVER_OPCODE_BIT(CFE_PSP_IODriver_ANALOG_IO_READ_CHANNELS)};
+
+CFE_PSP_ModuleApi_t UT_DriverModule = {.ModuleType  = CFE_PSP_MODULE_TYPE_DEVICEDRIVER,
+                                       .ExtendedApi = &UT_DriverApi};
+
+CFE_PSP_IODriver_Location_t UT_DriverLocation = {.PspModuleId = UT_DRIVER_MODULE_ID};
+
+/*
+ * The PSP itself is not linked into this test
+ */
+int32 CFE_PSP_Module_GetAPIEntry(uint32 PspModuleId, CFE_PSP_ModuleApi_t **API)
+{
+    int32 Status;
+
+    UT_Stub_RegisterContextGenericArg(UT_KEY(CFE_PSP_Module_GetAPIEntry), PspModuleId);
+    Status = UT_DEFAULT_IMPL(CFE_PSP_Module_GetAPIEntry);
+    if (Status == CFE_PSP_SUCCESS && PspModuleId == UT_DRIVER_MODULE_ID)
+    {
+        *API = &UT_DriverModule;
+    }
+    else if (Status == CFE_PSP_SUCCESS)
+    {
+        *API = &CFE_PSP_iodriver_API;
+    }
+
+    return Status;
+}
+
+int32 CFE_PSP_Module_FindByName(const char *ModuleName, uint32 *PspModuleId)
+{
+    *PspModuleId = UT_DRIVER_MODULE_ID;
+    return UT_DEFAULT_IMPL(CFE_PSP_Module_FindByName);
+}
+
+int32 UT_DriverCommand(uint32 CommandCode, uint16 Instance, uint16 SubChannel, CFE_PSP_IODriver_Arg_t Arg)
+{
+    return UT_DEFAULT_IMPL(UT_DriverCommand);
+}
+
+int32 UT_DriverMutex(uint32 CommandCode, uint16 Instance, uint16 SubChannel, CFE_PSP_IODriver_Arg_t Arg)
+{
+    return UT_DEFAULT_IMPL(UT_DriverMutex);
+}
+
+void ModuleTest_ResetState(void)
+{
+    UT_ResetState(0);
+    CFE_PSP_iodriver_API.Init(0);
+}
+
+/*
+ * Runs a command through the driver, and checks if it held the device mutex
+ */
+void UT_CheckCommand(uint32 CommandCode, bool ExpectLocked)
+{
+    UT_ResetState(UT_KEY(UT_DriverCommand));
+    UT_ResetState(UT_KEY(UT_DriverMutex));
+    UT_ResetState(UT_KEY(OS_MutSemTake));
+    UT_ResetState(UT_KEY(OS_MutSemGive));
+
+    UtAssert_INT32_EQ(CFE_PSP_IODriver_Command(&UT_DriverLocation, CommandCode, CFE_PSP_IODriver_U32ARG(0)),
+                      CFE_PSP_SUCCESS);
+    UtAssert_STUB_COUNT(UT_DriverCommand, 1);
+    UtAssert_STUB_COUNT(UT_DriverMutex, ExpectLocked ? 1 : 0);
+    UtAssert_STUB_COUNT(OS_MutSemTake, ExpectLocked ? 1 : 0);
+    UtAssert_STUB_COUNT(OS_MutSemGive, ExpectLocked ? 1 : 0);
+}
+
+void Test_Command_NoDriver(void)
+{
+    CFE_PSP_IODriver_Location_t Location = {.PspModuleId = 1};
+
+    /* Error Case: A module which is not a device driver */
+    UtAssert_INT32_EQ(CFE_PSP_IODriver_Command(&Location, CFE_PSP_IODriver_NOOP, CFE_PSP_IODriver_U32ARG(0)),
+                      CFE_PSP_ERROR_NOT_IMPLEMENTED);
+
+    /* Error Case: A module which does not exist */
+    UT_SetDefaultReturnValue(UT_KEY(CFE_PSP_Module_GetAPIEntry), CFE_PSP_INVALID_MODULE_ID);
+    UtAssert_INT32_EQ(
+        CFE_PSP_IODriver_Command(&UT_DriverLocation, CFE_PSP_IODriver_NOOP, CFE_PSP_IODriver_U32ARG(0)),
+        CFE_PSP_ERROR_NOT_IMPLEMENTED);
+    UtAssert_STUB_COUNT(UT_DriverCommand, 0);
+}
+
+void Test_Command_Locking(void)
+{
+    /* Nominal Case: Commands not marked reentrant hold the mutex selected by the driver */
+    UT_CheckCommand(CFE_PSP_IODriver_SET_RUNNING, true);
+    UT_CheckCommand(CFE_PSP_IODriver_SET_CONFIGURATION, true);
+
+    /* Nominal Case: A negative hash from the driver selects no mutex */
+    UT_ResetState(UT_KEY(UT_DriverMutex));
+    UT_ResetState(UT_KEY(OS_MutSemTake));
+    UT_SetDefaultReturnValue(UT_KEY(UT_DriverMutex), -1);
+    CFE_PSP_IODriver_Command(&UT_DriverLocation, CFE_PSP_IODriver_SET_RUNNING, CFE_PSP_IODriver_U32ARG(0));
+    UtAssert_STUB_COUNT(UT_DriverMutex, 1);
+    UtAssert_STUB_COUNT(OS_MutSemTake, 0);
+}
+
+void Test_Command_Reentrant(void)
+{
+    /* Nominal Case: Marked opcodes skip the driver mutex */
+    UT_CheckCommand(CFE_PSP_IODriver_NOOP, false);
+    UT_CheckCommand(CFE_PSP_IODriver_GET_RUNNING, false);
+    UT_CheckCommand(CFE_PSP_IODriver_ANALOG_IO_READ_CHANNELS, false);
+
+    /* Nominal Case: The bits of one mask do not apply to the opcodes of the other */
+    UT_CheckCommand(CFE_PSP_IODriver_ANALOG_IO_CLASS_BASE + CFE_PSP_IODriver_GET_RUNNING, true);
+    UT_CheckCommand(CFE_PSP_IODriver_ANALOG_IO_NOOP, true);
+
+    /* Nominal Case: Opcodes past the 32 that can be marked alias no bit */
+    UT_CheckCommand(CFE_PSP_IODriver_NOOP + 32, true);
+    UT_CheckCommand(CFE_PSP_IODriver_ANALOG_IO_READ_CHANNELS + 32, true);
+
+    /* Nominal Case: Extended opcodes are never reentrant */
+    UT_CheckCommand(CFE_PSP_IODriver_EXTENDED_BASE, true);
+    UT_CheckCommand(CFE_PSP_IODriver_EXTENDED_BASE + CFE_PSP_IODriver_GET_RUNNING, true);
+}
+
+/*
+ * Macro to add a test case to the list of tests to execute
+ */
+#define ADD_TEST(test) UtTest_Add(test, ModuleTest_ResetState, NULL, #test)
+
+/*
+ * Register the test cases to execute with the unit test tool
+ */
+void UtTest_Setup(void)
+{
+    ADD_TEST(Test_Command_NoDriver);
+    ADD_TEST(Test_Command_Locking);
+    ADD_TEST(Test_Command_Reentrant);
+}
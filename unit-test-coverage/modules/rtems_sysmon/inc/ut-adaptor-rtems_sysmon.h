@@ -0,0 +1,51 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,719-1, and identified as “core Flight System: 
+ * Draco
+ *
+ * Copyright (c) 2023 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ **********************************************************************/
+
+/**
+ * \file
+ * \ingroup  adaptors
+ *
+ * Access to the internal state of the RTEMS sysmon module, which
+ * cannot be included by the test code as it uses RTEMS types
+ */
+
+#ifndef UT_ADAPTOR_RTEMS_SYSMON_H
+#define UT_ADAPTOR_RTEMS_SYSMON_H
+
+#include "common_types.h"
+
+uint32 UT_RtemsSysmon_GetMaxCpus(void);
+uint32 UT_RtemsSysmon_GetMaxTasks(void);
+
+void   UT_RtemsSysmon_ResetState(void);
+uint32 UT_RtemsSysmon_GetLocalModuleId(void);
+void   UT_RtemsSysmon_SetShouldRun(bool ShouldRun);
+uint32 UT_RtemsSysmon_GetCpuLoad(uint32 Cpu);
+bool   UT_RtemsSysmon_GetTasksDropped(void);
+
+/* Records each sample into the given storage, as CFE_PSP_SysmonRecord_AttachReserved() would */
+void UT_RtemsSysmon_AttachRecorder(void *Storage, uint32 NumRecords);
+
+/* Takes one sample, as the sysmon task does after each delay */
+void UT_RtemsSysmon_UpdateStat(void);
+
+/* Runs the sysmon task, which returns once UT_RtemsSysmon_SetShouldRun(false) is called */
+void UT_RtemsSysmon_RunTask(void);
+
+#endif
@@ -0,0 +1,644 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,719-1, and identified as “core Flight System: 
+ * Draco
+ *
+ * Copyright (c) 2023 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ **********************************************************************/
+
+/**
+ * \file
+ * \ingroup  modules
+ *
+ * Coverage test for RTEMS Sysmon
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "utassert.h"
+#include "utstubs.h"
+#include "uttest.h"
+
+#include "cfe_psp.h"
+#include "cfe_psp_module.h"
+#include "cfe_psp_sysmonalarm.h"
+#include "cfe_psp_sysmonrecord.h"
+
+#include "coveragetest-rtems_sysmon.h"
+
+/* IDs of the test threads, where IDLE and TSK1 hash to the same slot */
+#define UT_IDLE_ID 0x09010001
+#define UT_TSK1_ID 0x0A010001
+#define UT_TSK2_ID 0x0A010002
+
+#define UT_SECOND 1000000000LL
+
+/*
+ * Reference to the API entry point for the module
+ */
+extern CFE_PSP_ModuleApi_t CFE_PSP_rtems_sysmon_API;
+const CFE_PSP_ModuleApi_t *TgtAPI = &CFE_PSP_rtems_sysmon_API;
+
+/* Hook */
+void UT_TaskDelay_Hook(void *UserObj)
+{
+    int *DelayCounter = UserObj;
+
+    UT_RtemsSysmon_SetShouldRun(false);
+    (*DelayCounter)++;
+}
+
+/*
+ * Captures the channel reader passed to the alarm check of the latest sample
+ */
+typedef struct
+{
+    CFE_PSP_SysmonAlarm_ValueFunc_t ValueFunc;
+    void *                          Arg;
+} UT_AlarmCheck_t;
+
+static int32 UT_AlarmCheck_Hook(void *UserObj, int32 StubRetcode, uint32 CallCount, const UT_StubContext_t *Context)
+{
+    UT_AlarmCheck_t *Check = UserObj;
+
+    Check->ValueFunc = UT_Hook_GetArgValueByName(Context, "ValueFunc", CFE_PSP_SysmonAlarm_ValueFunc_t);
+    Check->Arg       = UT_Hook_GetArgValueByName(Context, "Arg", void *);
+
+    return StubRetcode;
+}
+
+void ModuleTest_ResetState(void)
+{
+    UT_RtemsSysmon_ResetState();
+    UT_ResetState(0);
+}
+
+static void UT_SetThread(PCS_Thread_Control *Thread, PCS_rtems_id Id, const char *Name,
+                         PCS_Timestamp_Control CpuTime)
+{
+    memset(Thread, 0, sizeof(*Thread));
+    Thread->Object.id          = Id;
+    Thread->Object.name.name_p = Name;
+    Thread->cpu_time_used      = CpuTime;
+}
+
+/*
+ * Takes one sample of the given threads at the given uptime, which is used
+ * both for the per-task loads and for each IDLE thread
+ */
+static void UT_Sample(PCS_Thread_Control *Threads, size_t NumThreads, PCS_Timestamp_Control Uptime)
+{
+    static PCS_Timestamp_Control Uptimes[64];
+    size_t                       i;
+
+    for (i = 0; i < (sizeof(Uptimes) / sizeof(Uptimes[0])); ++i)
+    {
+        Uptimes[i] = Uptime;
+    }
+
+    UT_SetDataBuffer(UT_KEY(PCS__TOD_Get_uptime), Uptimes, sizeof(Uptimes), false);
+    UT_SetDataBuffer(UT_KEY(PCS_rtems_task_iterate), Threads, NumThreads * sizeof(*Threads), false);
+    UT_RtemsSysmon_UpdateStat();
+    UT_ResetState(UT_KEY(PCS__TOD_Get_uptime));
+    UT_ResetState(UT_KEY(PCS_rtems_task_iterate));
+}
+
+static int32 UT_LookupSubsystem(const char *Name)
+{
+    CFE_PSP_IODriver_API_t *EntryAPI = TgtAPI->ExtendedApi;
+
+    return EntryAPI->DeviceCommand(CFE_PSP_IODriver_LOOKUP_SUBSYSTEM, 0, 0, CFE_PSP_IODriver_CONST_STR(Name));
+}
+
+static int32 UT_LookupTask(const char *Name)
+{
+    CFE_PSP_IODriver_API_t *EntryAPI = TgtAPI->ExtendedApi;
+
+    return EntryAPI->DeviceCommand(CFE_PSP_IODriver_LOOKUP_SUBCHANNEL, UT_LookupSubsystem("per-task"), 0,
+                                   CFE_PSP_IODriver_CONST_STR(Name));
+}
+
+static CFE_PSP_IODriver_AdcCode_t UT_ReadTask(int32 Subchannel)
+{
+    CFE_PSP_IODriver_API_t *      EntryAPI = TgtAPI->ExtendedApi;
+    CFE_PSP_IODriver_AdcCode_t    Sample   = -1;
+    CFE_PSP_IODriver_AnalogRdWr_t RdWr     = {.NumChannels = 1, .Samples = &Sample};
+
+    EntryAPI->DeviceCommand(CFE_PSP_IODriver_ANALOG_IO_READ_CHANNELS, UT_LookupSubsystem("per-task"), Subchannel,
+                            CFE_PSP_IODriver_VPARG(&RdWr));
+
+    return Sample;
+}
+
+void Test_Init_Nominal(void)
+{
+    TgtAPI->Init(1); /* Init RTEMS Sysmon */
+    UtAssert_True(UT_RtemsSysmon_GetLocalModuleId() == 1, "Nominal Case: Init RTEMS Sysmon");
+}
+
+void Test_Entry_Nominal(void)
+{
+    int32                   StatusCode;
+    CFE_PSP_IODriver_API_t *EntryAPI = TgtAPI->ExtendedApi;
+
+    /* Nominal Case: Cpuload and average Subsystems */
+    StatusCode = EntryAPI->DeviceCommand(CFE_PSP_IODriver_NOOP, UT_LookupSubsystem("per-cpu"), 0,
+                                         CFE_PSP_IODriver_U32ARG(0));
+    UtAssert_True(StatusCode == CFE_PSP_SUCCESS, "Nominal Case: Cpuload Subsystem");
+    StatusCode = EntryAPI->DeviceCommand(CFE_PSP_IODriver_NOOP, UT_LookupSubsystem("per-cpu-60s"), 0,
+                                         CFE_PSP_IODriver_U32ARG(0));
+    UtAssert_True(StatusCode == CFE_PSP_SUCCESS, "Nominal Case: Cpuload 60s Average Subsystem");
+
+    /* Nominal Case: Per-task Subsystem */
+    StatusCode = EntryAPI->DeviceCommand(CFE_PSP_IODriver_NOOP, UT_LookupSubsystem("per-task"), 0,
+                                         CFE_PSP_IODriver_U32ARG(0));
+    UtAssert_True(StatusCode == CFE_PSP_SUCCESS, "Nominal Case: Per-task Subsystem");
+
+    /* Nominal Case: No Subsystem */
+    StatusCode = EntryAPI->DeviceCommand(CFE_PSP_IODriver_NOOP, UT_LookupSubsystem("per-task") + 1, 0,
+                                         CFE_PSP_IODriver_U32ARG(0));
+    UtAssert_True(StatusCode == CFE_PSP_ERROR_NOT_IMPLEMENTED, "Nominal Case: No Subsystem");
+}
+
+void Test_Entry_Locking(void)
+{
+    CFE_PSP_IODriver_API_t *EntryAPI = TgtAPI->ExtendedApi;
+
+    /* Nominal Case: Commands that change the module hold its mutex */
+    UtAssert_True(EntryAPI->DeviceMutex(CFE_PSP_IODriver_SET_RUNNING, 0, 0, CFE_PSP_IODriver_U32ARG(1)) >= 0,
+                  "Nominal Case: Mutex for start/stop");
+    UtAssert_True((EntryAPI->ReentrantBaseOps & CFE_PSP_IODRIVER_OPCODE_BIT(CFE_PSP_IODriver_SET_RUNNING)) == 0,
+                  "Nominal Case: Start/stop not reentrant");
+    UtAssert_True((EntryAPI->ReentrantBaseOps & CFE_PSP_IODRIVER_OPCODE_BIT(CFE_PSP_IODriver_SET_CONFIGURATION)) == 0,
+                  "Nominal Case: Configuration not reentrant");
+
+    /* Nominal Case: Reads of the snapshots do not */
+    UtAssert_True((EntryAPI->ReentrantBaseOps & CFE_PSP_IODRIVER_OPCODE_BIT(CFE_PSP_IODriver_LOOKUP_SUBCHANNEL)) != 0,
+                  "Nominal Case: Lookup reentrant");
+    UtAssert_True(
+        (EntryAPI->ReentrantClassOps & CFE_PSP_IODRIVER_OPCODE_BIT(CFE_PSP_IODriver_ANALOG_IO_READ_CHANNELS)) != 0,
+        "Nominal Case: Read reentrant");
+}
+
+void Test_Aggregate_Nominal(void)
+{
+    int32                         StatusCode;
+    int32                         IsRunningStatus;
+    CFE_PSP_IODriver_AdcCode_t    Sample;
+    CFE_PSP_IODriver_AnalogRdWr_t RdWr = {.NumChannels = 1, .Samples = &Sample};
+    CFE_PSP_IODriver_Direction_t  QueryDirArg;
+    CFE_PSP_IODriver_API_t *      EntryAPI = TgtAPI->ExtendedApi;
+
+    /* Nominal Case: Start RTEMS Sysmon */
+    StatusCode      = EntryAPI->DeviceCommand(CFE_PSP_IODriver_SET_RUNNING, 0, 0, CFE_PSP_IODriver_U32ARG(1));
+    IsRunningStatus = EntryAPI->DeviceCommand(CFE_PSP_IODriver_GET_RUNNING, 0, 0, CFE_PSP_IODriver_U32ARG(1));
+    UtAssert_True(StatusCode == CFE_PSP_SUCCESS, "Nominal Case: Start RTEMS Sysmon");
+    UtAssert_True(IsRunningStatus == true, "Nominal Case: RTEMS Sysmon running status set");
+
+    /* Nominal Case: RTEMS Sysmon already running */
+    StatusCode = EntryAPI->DeviceCommand(CFE_PSP_IODriver_SET_RUNNING, 0, 0, CFE_PSP_IODriver_U32ARG(1));
+    UtAssert_True(StatusCode == CFE_PSP_SUCCESS, "Nominal Case: RTEMS Sysmon Already Running");
+    UtAssert_True(UT_GetStubCount(UT_KEY(PCS_rtems_task_create)) == 1, "Nominal Case: RTEMS Sysmon task created once");
+
+    /* Nominal Case: Stop RTEMS Sysmon */
+    StatusCode      = EntryAPI->DeviceCommand(CFE_PSP_IODriver_SET_RUNNING, 0, 0, CFE_PSP_IODriver_U32ARG(0));
+    IsRunningStatus = EntryAPI->DeviceCommand(CFE_PSP_IODriver_GET_RUNNING, 0, 0, CFE_PSP_IODriver_U32ARG(1));
+    UtAssert_True(StatusCode == CFE_PSP_SUCCESS, "Nominal Case: Stop RTEMS Sysmon");
+    UtAssert_True(IsRunningStatus == false, "Nominal Case: RTEMS Sysmon running status disabled");
+
+    /* Nominal Case: Look Up Subsystems */
+    UtAssert_True(UT_LookupSubsystem("per-cpu") == 1, "Nominal Case: Look up per-cpu subsytem");
+    UtAssert_True(UT_LookupSubsystem("per-task") == 5, "Nominal Case: Look up per-task subsytem");
+
+    /* Nominal Case: Look Up cpu-load subchannel */
+    StatusCode = EntryAPI->DeviceCommand(CFE_PSP_IODriver_LOOKUP_SUBCHANNEL, 0, 0,
+                                         CFE_PSP_IODriver_CONST_STR("cpu-load-10s"));
+    UtAssert_True(StatusCode == 2, "Nominal Case: Look up cpu-load-10s subchannel");
+
+    /* Nominal Case: Query Direction */
+    QueryDirArg = CFE_PSP_IODriver_Direction_DISABLED;
+    StatusCode  = EntryAPI->DeviceCommand(CFE_PSP_IODriver_QUERY_DIRECTION, 0, 0, CFE_PSP_IODriver_VPARG(&QueryDirArg));
+    UtAssert_True(StatusCode == CFE_PSP_SUCCESS, "Nominal Case: RTEMS Sysmon Query Direction Status Code");
+    UtAssert_True(QueryDirArg == CFE_PSP_IODriver_Direction_INPUT_ONLY, "Nominal Case: RTEMS Sysmon Direction");
+
+    /* Nominal Case: Analog IO Read Channel */
+    Sample     = -1;
+    StatusCode = EntryAPI->DeviceCommand(CFE_PSP_IODriver_ANALOG_IO_READ_CHANNELS, 0, 0, CFE_PSP_IODriver_VPARG(&RdWr));
+    UtAssert_True(StatusCode == CFE_PSP_SUCCESS && Sample == 0, "Nominal Case: RTEMS Sysmon Aggregate CPU");
+}
+
+void Test_Aggregate_Error(void)
+{
+    int32                         StatusCode;
+    int32                         IsRunningStatus;
+    CFE_PSP_IODriver_AdcCode_t    Sample;
+    CFE_PSP_IODriver_AnalogRdWr_t RdWr     = {.NumChannels = 1, .Samples = &Sample};
+    CFE_PSP_IODriver_API_t *      EntryAPI = TgtAPI->ExtendedApi;
+
+    /* Error Case: Look Up Subsystem and Subchannel Not Found */
+    UtAssert_True(UT_LookupSubsystem("Empty") == CFE_PSP_ERROR_NOT_IMPLEMENTED, "Error Case: Subsystem Not Found");
+    StatusCode = EntryAPI->DeviceCommand(CFE_PSP_IODriver_LOOKUP_SUBCHANNEL, 0, 0, CFE_PSP_IODriver_CONST_STR("Empty"));
+    UtAssert_True(StatusCode == CFE_PSP_ERROR_NOT_IMPLEMENTED, "Error Case: Subchannel Not Found");
+
+    /* Error Case: NULL Query Direction */
+    StatusCode = EntryAPI->DeviceCommand(CFE_PSP_IODriver_QUERY_DIRECTION, 0, 0, CFE_PSP_IODriver_VPARG(NULL));
+    UtAssert_True(StatusCode == CFE_PSP_ERROR_NOT_IMPLEMENTED, "Error Case: NULL Query Direction Status Code");
+
+    /* Error Case: Analog IO Read, Wrong Subchannel (the current load and three averages) */
+    StatusCode = EntryAPI->DeviceCommand(CFE_PSP_IODriver_ANALOG_IO_READ_CHANNELS, 0, 4, CFE_PSP_IODriver_VPARG(&RdWr));
+    UtAssert_True(StatusCode == CFE_PSP_ERROR_NOT_IMPLEMENTED, "Error Case: Analog IO Read, Wrong Subchannel");
+
+    /* Error Case: Unable To Create Task */
+    UT_SetDeferredRetcode(UT_KEY(PCS_rtems_task_create), 1, PCS_RTEMS_TOO_MANY);
+    StatusCode      = EntryAPI->DeviceCommand(CFE_PSP_IODriver_SET_RUNNING, 0, 0, CFE_PSP_IODriver_U32ARG(1));
+    IsRunningStatus = EntryAPI->DeviceCommand(CFE_PSP_IODriver_GET_RUNNING, 0, 0, CFE_PSP_IODriver_U32ARG(1));
+    UtAssert_True(StatusCode == CFE_PSP_ERROR, "Error Case: Creating Task, Status Code");
+    UtAssert_True(IsRunningStatus == false, "Error Case: Creating Task, Running Status");
+
+    /* Error Case: Unable To Start Task */
+    UT_SetDeferredRetcode(UT_KEY(PCS_rtems_task_start), 1, PCS_RTEMS_TOO_MANY);
+    StatusCode      = EntryAPI->DeviceCommand(CFE_PSP_IODriver_SET_RUNNING, 0, 0, CFE_PSP_IODriver_U32ARG(1));
+    IsRunningStatus = EntryAPI->DeviceCommand(CFE_PSP_IODriver_GET_RUNNING, 0, 0, CFE_PSP_IODriver_U32ARG(1));
+    UtAssert_True(StatusCode == CFE_PSP_ERROR, "Error Case: Starting Task, Status Code");
+    UtAssert_True(IsRunningStatus == false, "Error Case: Starting Task, Running Status");
+    UtAssert_True(UT_GetStubCount(UT_KEY(PCS_rtems_task_delete)) == 1, "Error Case: Starting Task, Task Deleted");
+}
+
+void Test_CpuLoad_Dispatch(void)
+{
+    int32                         StatusCode;
+    CFE_PSP_IODriver_AdcCode_t    Sample[2];
+    CFE_PSP_IODriver_AnalogRdWr_t RdWr     = {.NumChannels = 1, .Samples = Sample};
+    CFE_PSP_IODriver_API_t *      EntryAPI = TgtAPI->ExtendedApi;
+
+    /* Nominal Case: Dispatch Analog Read Channels */
+    Sample[0]  = -1;
+    Sample[1]  = -1;
+    StatusCode = EntryAPI->DeviceCommand(CFE_PSP_IODriver_ANALOG_IO_READ_CHANNELS, UT_LookupSubsystem("per-cpu"), 0,
+                                         CFE_PSP_IODriver_VPARG(&RdWr));
+    UtAssert_True(StatusCode == CFE_PSP_SUCCESS && Sample[0] == 0 && Sample[1] == -1, "Nominal Case: Dispatch cpuload");
+
+    /* Error Case: Dispatch Analog Read Channels, Subchannel >= Max Cpu */
+    StatusCode = EntryAPI->DeviceCommand(CFE_PSP_IODriver_ANALOG_IO_READ_CHANNELS, UT_LookupSubsystem("per-cpu"),
+                                         UT_RtemsSysmon_GetMaxCpus(), CFE_PSP_IODriver_VPARG(&RdWr));
+    UtAssert_True(StatusCode == CFE_PSP_ERROR_NOT_IMPLEMENTED, "Error Case: Dispatch cpuload, subchannel >= max cpu");
+
+    /* Error Case: Command Code Not Found */
+    StatusCode = EntryAPI->DeviceCommand(40, UT_LookupSubsystem("per-cpu"), 0, CFE_PSP_IODriver_U32ARG(0));
+    UtAssert_True(StatusCode == CFE_PSP_ERROR_NOT_IMPLEMENTED, "Error Case: Command Code Not Found");
+}
+
+void Test_UpdateStat_Nominal(void)
+{
+    PCS_Thread_Control Threads[2];
+    uint32             AvgLoad;
+
+    /* Nominal Case: IDLE for a quarter of the first second, then half of the next */
+    UT_SetThread(&Threads[0], UT_IDLE_ID, "IDLE", UT_SECOND / 4);
+    UT_SetThread(&Threads[1], UT_TSK1_ID, "TSK1", 0);
+    UT_Sample(Threads, 2, UT_SECOND);
+
+    AvgLoad = (0x1000 * 75) / 100;
+    AvgLoad |= (AvgLoad << 12);
+    UtAssert_True(UT_RtemsSysmon_GetCpuLoad(0) == AvgLoad, "Nominal Case: 75 percents cpuload");
+
+    Threads[0].cpu_time_used += UT_SECOND / 2;
+    UT_Sample(Threads, 2, 2 * UT_SECOND);
+
+    AvgLoad = (0x1000 * 50) / 100;
+    AvgLoad |= (AvgLoad << 12);
+    UtAssert_True(UT_RtemsSysmon_GetCpuLoad(0) == AvgLoad, "Nominal Case: 50 percents cpuload");
+
+    /* Nominal Case: Idle for all of the sample */
+    Threads[0].cpu_time_used += UT_SECOND;
+    UT_Sample(Threads, 2, 3 * UT_SECOND);
+    UtAssert_True(UT_RtemsSysmon_GetCpuLoad(0) == 0xFFFFFF, "Nominal Case: IDLE over 100 percent");
+
+    /* Nominal Case: No time elapsed */
+    UT_Sample(Threads, 2, 3 * UT_SECOND);
+    UtAssert_True(UT_RtemsSysmon_GetCpuLoad(0) == 0, "Nominal Case: No time elapsed");
+}
+
+void Test_TaskLoad_Nominal(void)
+{
+    PCS_Thread_Control Threads[3];
+    int32              Slot1;
+    int32              Slot2;
+
+    UT_SetThread(&Threads[0], UT_IDLE_ID, "IDLE", UT_SECOND / 2);
+    UT_SetThread(&Threads[1], UT_TSK1_ID, "TSK1", UT_SECOND / 4);
+    UT_SetThread(&Threads[2], UT_TSK2_ID, "TSK2", UT_SECOND / 4);
+    UT_Sample(Threads, 3, UT_SECOND);
+
+    /* Nominal Case: IDLE has the slot of its ID, so TSK1 and then TSK2 are in the following slots */
+    Slot1 = UT_LookupTask("TSK1");
+    Slot2 = UT_LookupTask("TSK2");
+    UtAssert_True(UT_LookupTask("IDLE") == (UT_IDLE_ID & (UT_RtemsSysmon_GetMaxTasks() - 1)),
+                  "Nominal Case: IDLE slot");
+    UtAssert_True(Slot1 == UT_LookupTask("IDLE") + 1, "Nominal Case: TSK1 slot after collision");
+    UtAssert_True(Slot2 == Slot1 + 1, "Nominal Case: TSK2 slot after collision");
+
+    /* Nominal Case: New tasks read zero load */
+    UtAssert_True(UT_ReadTask(Slot1) == 0 && UT_ReadTask(Slot2) == 0, "Nominal Case: New tasks zero load");
+
+    /* Nominal Case: TSK1 half of the second sample, TSK2 a quarter */
+    Threads[0].cpu_time_used += UT_SECOND / 4;
+    Threads[1].cpu_time_used += UT_SECOND / 2;
+    Threads[2].cpu_time_used += UT_SECOND / 4;
+    UT_Sample(Threads, 3, 2 * UT_SECOND);
+    UtAssert_True(UT_ReadTask(Slot1) == 0x800800, "Nominal Case: TSK1 half load");
+    UtAssert_True(UT_ReadTask(Slot2) == 0x400400, "Nominal Case: TSK2 quarter load");
+    UtAssert_True(UT_LookupTask("TSK1") == Slot1 && UT_LookupTask("TSK2") == Slot2, "Nominal Case: Slots stable");
+
+    /* Nominal Case: CPU usage reset, so the time used goes backwards */
+    Threads[1].cpu_time_used = 0;
+    UT_Sample(Threads, 3, 3 * UT_SECOND);
+    UtAssert_True(UT_ReadTask(Slot1) == 0, "Nominal Case: CPU usage reset");
+
+    /* Nominal Case: More time used than elapsed */
+    Threads[1].cpu_time_used += 2 * UT_SECOND;
+    UT_Sample(Threads, 3, 4 * UT_SECOND);
+    UtAssert_True(UT_ReadTask(Slot1) == 0xFFFFFF, "Nominal Case: Task load limited");
+}
+
+void Test_TaskLoad_Slots(void)
+{
+    PCS_Thread_Control Threads[2];
+    int32              Slot1;
+    int32              Slot2;
+
+    /* TSK1 and TSK2 have the same hash, so TSK2 is in the slot after TSK1 */
+    UT_SetThread(&Threads[0], UT_TSK1_ID, "TSK1", 0);
+    UT_SetThread(&Threads[1], UT_TSK1_ID + UT_RtemsSysmon_GetMaxTasks(), "TSK2", 0);
+    UT_Sample(Threads, 2, UT_SECOND);
+    Slot1 = UT_LookupTask("TSK1");
+    Slot2 = UT_LookupTask("TSK2");
+    UtAssert_True(Slot2 == Slot1 + 1, "Nominal Case: Same hash, next slot");
+
+    /* Nominal Case: TSK1 deleted, TSK2 is still found by passing over its slot */
+    Threads[0] = Threads[1];
+    Threads[0].cpu_time_used += UT_SECOND / 2;
+    UT_Sample(Threads, 1, 2 * UT_SECOND);
+    UtAssert_True(UT_LookupTask("TSK1") == CFE_PSP_ERROR, "Nominal Case: Deleted task not found");
+    UtAssert_True(UT_ReadTask(Slot1) == 0, "Nominal Case: Deleted task reads zero");
+    UtAssert_True(UT_LookupTask("TSK2") == Slot2, "Nominal Case: Other task keeps its slot");
+    UtAssert_True(UT_ReadTask(Slot2) == 0x800800, "Nominal Case: Task found after deleted slot");
+
+    /* Nominal Case: a new task with the same hash reuses the slot of TSK1 */
+    UT_SetThread(&Threads[1], UT_TSK1_ID + 2 * UT_RtemsSysmon_GetMaxTasks(), "TSK3", 0);
+    UT_Sample(Threads, 2, 3 * UT_SECOND);
+    UtAssert_True(UT_LookupTask("TSK3") == Slot1, "Nominal Case: New task reuses deleted slot");
+    UtAssert_True(UT_LookupTask("TSK2") == Slot2, "Nominal Case: Slot unchanged by new task");
+}
+
+void Test_TaskLoad_Full(void)
+{
+    static PCS_Thread_Control Threads[256];
+    static char               Names[256][12];
+    uint32                    NumThreads;
+    uint32                    i;
+
+    /* Error Case: One more task than the table holds */
+    NumThreads = UT_RtemsSysmon_GetMaxTasks() + 1;
+    UtAssert_True(NumThreads <= 256, "Test setup: Task table size");
+    for (i = 0; i < NumThreads; ++i)
+    {
+        snprintf(Names[i], sizeof(Names[i]), "T%u", (unsigned int)i);
+        UT_SetThread(&Threads[i], UT_TSK1_ID + i, Names[i], 0);
+    }
+
+    UT_Sample(Threads, NumThreads, UT_SECOND);
+    UtAssert_True(UT_RtemsSysmon_GetTasksDropped(), "Error Case: Task table full");
+    UtAssert_True(UT_LookupTask(Names[NumThreads - 2]) >= 0, "Error Case: Last task which fits");
+    UtAssert_True(UT_LookupTask(Names[NumThreads - 1]) == CFE_PSP_ERROR, "Error Case: Task which does not fit");
+
+    /* Error Case: Reported only once */
+    UT_Sample(Threads, NumThreads, 2 * UT_SECOND);
+    UtAssert_True(UT_GetStubCount(UT_KEY(OS_printf)) == 1, "Error Case: Task table full reported once");
+}
+
+void Test_TaskLoad_Dispatch(void)
+{
+    int32                         StatusCode;
+    CFE_PSP_IODriver_AdcCode_t    Sample[2];
+    CFE_PSP_IODriver_AnalogRdWr_t RdWr     = {.NumChannels = 2, .Samples = Sample};
+    CFE_PSP_IODriver_API_t *      EntryAPI = TgtAPI->ExtendedApi;
+    uint32                        MaxTasks = UT_RtemsSysmon_GetMaxTasks();
+
+    /* Nominal Case: Analog IO NOOP */
+    StatusCode = EntryAPI->DeviceCommand(CFE_PSP_IODriver_ANALOG_IO_NOOP, UT_LookupSubsystem("per-task"), 0,
+                                         CFE_PSP_IODriver_U32ARG(0));
+    UtAssert_True(StatusCode == CFE_PSP_SUCCESS, "Nominal Case: Per-task Analog IO NOOP");
+
+    /* Nominal Case: Read the last two slots, both free */
+    Sample[0]  = -1;
+    Sample[1]  = -1;
+    StatusCode = EntryAPI->DeviceCommand(CFE_PSP_IODriver_ANALOG_IO_READ_CHANNELS, UT_LookupSubsystem("per-task"),
+                                         MaxTasks - 2, CFE_PSP_IODriver_VPARG(&RdWr));
+    UtAssert_True(StatusCode == CFE_PSP_SUCCESS && Sample[0] == 0 && Sample[1] == 0, "Nominal Case: Free slots");
+
+    /* Error Case: Read past the last slot */
+    StatusCode = EntryAPI->DeviceCommand(CFE_PSP_IODriver_ANALOG_IO_READ_CHANNELS, UT_LookupSubsystem("per-task"),
+                                         MaxTasks - 1, CFE_PSP_IODriver_VPARG(&RdWr));
+    UtAssert_True(StatusCode == CFE_PSP_ERROR_NOT_IMPLEMENTED, "Error Case: Read past the last slot");
+
+    /* Error Case: Unknown task */
+    UtAssert_True(UT_LookupTask("NONE") == CFE_PSP_ERROR, "Error Case: Unknown task");
+
+    /* Error Case: Command Code Not Found */
+    StatusCode = EntryAPI->DeviceCommand(40, UT_LookupSubsystem("per-task"), 0, CFE_PSP_IODriver_U32ARG(0));
+    UtAssert_True(StatusCode == CFE_PSP_ERROR_NOT_IMPLEMENTED, "Error Case: Command Code Not Found");
+}
+
+void Test_Record_Nominal(void)
+{
+    PCS_Thread_Control Threads[2];
+    struct
+    {
+        CFE_PSP_SysmonRecordHeader_t Header;
+        CFE_PSP_SysmonRecordEntry_t  Records[16];
+    } Storage;
+    CFE_PSP_IODriver_API_t *EntryAPI = TgtAPI->ExtendedApi;
+
+    /* Nominal Case: Start tries to attach to the reserved memory */
+    EntryAPI->DeviceCommand(CFE_PSP_IODriver_SET_RUNNING, 0, 0, CFE_PSP_IODriver_U32ARG(1));
+    EntryAPI->DeviceCommand(CFE_PSP_IODriver_SET_RUNNING, 0, 0, CFE_PSP_IODriver_U32ARG(0));
+    UtAssert_True(UT_GetStubCount(UT_KEY(CFE_PSP_SysmonRecord_AttachReserved)) == 1,
+                  "Nominal Case: Recorder attached at start");
+
+    /* Nominal Case: Not recording */
+    UT_SetThread(&Threads[0], UT_IDLE_ID, "IDLE", UT_SECOND / 2);
+    UT_SetThread(&Threads[1], UT_TSK1_ID, "TSK1", UT_SECOND / 2);
+    UT_Sample(Threads, 2, UT_SECOND);
+    UtAssert_True(UT_GetStubCount(UT_KEY(CFE_PSP_SysmonRecord_BeginSample)) == 0, "Nominal Case: Not recording");
+
+    /* Nominal Case: The aggregate, one CPU and two tasks are recorded in subsystem order */
+    memset(&Storage, 0, sizeof(Storage));
+    UT_RtemsSysmon_AttachRecorder(&Storage, 16);
+    Threads[0].cpu_time_used += UT_SECOND / 2;
+    UT_Sample(Threads, 2, 2 * UT_SECOND);
+    UtAssert_True(UT_GetStubCount(UT_KEY(CFE_PSP_SysmonRecord_BeginSample)) == 1, "Nominal Case: Sample recorded");
+    UtAssert_UINT32_EQ(Storage.Header.WriteCount, 4 + 4 + 2);
+    UtAssert_UINT32_EQ(Storage.Records[0].Subsystem, 0);
+    UtAssert_UINT32_EQ(Storage.Records[0].Value, 0x800800);
+    UtAssert_UINT32_EQ(Storage.Records[4].Subsystem, UT_LookupSubsystem("per-cpu"));
+    UtAssert_UINT32_EQ(Storage.Records[7].Subsystem, UT_LookupSubsystem("per-cpu-60s"));
+    UtAssert_UINT32_EQ(Storage.Records[9].Subsystem, UT_LookupSubsystem("per-task"));
+    UtAssert_UINT32_EQ(Storage.Records[9].Subchannel, UT_LookupTask("TSK1"));
+
+    /* Nominal Case: The ring wraps */
+    Threads[0].cpu_time_used += UT_SECOND / 2;
+    UT_Sample(Threads, 2, 3 * UT_SECOND);
+    UtAssert_UINT32_EQ(Storage.Header.WriteCount, 20);
+    UtAssert_UINT32_EQ(Storage.Records[3].Subsystem, UT_LookupSubsystem("per-task"));
+}
+
+void Test_Alarm_Config(void)
+{
+    CFE_PSP_SysmonAlarmStatus_t Status;
+    CFE_PSP_SysmonAlarmStatus_t StatusIn = {.HighMask = 0x1, .LowMask = 0x4, .CrossingCount = 3};
+    CFE_PSP_IODriver_API_t *    EntryAPI = TgtAPI->ExtendedApi;
+
+    /* Nominal Case: Init sets up the alarms */
+    TgtAPI->Init(1);
+    UtAssert_True(UT_GetStubCount(UT_KEY(CFE_PSP_SysmonAlarm_Init)) == 1, "Nominal Case: Alarms initialized");
+
+    /* Nominal Case: An alarm is configured */
+    UtAssert_INT32_EQ(EntryAPI->DeviceCommand(CFE_PSP_IODriver_SET_CONFIGURATION, 0, 0,
+                                              CFE_PSP_IODriver_CONST_STR("alarm=aggregate/0,,0xC00C00")),
+                      CFE_PSP_SUCCESS);
+    UtAssert_True(UT_GetStubCount(UT_KEY(CFE_PSP_SysmonAlarm_Configure)) == 1, "Nominal Case: Alarm configured");
+
+    /* Error Case: The alarm is rejected */
+    UT_SetDefaultReturnValue(UT_KEY(CFE_PSP_SysmonAlarm_Configure), CFE_PSP_ERROR);
+    UtAssert_INT32_EQ(EntryAPI->DeviceCommand(CFE_PSP_IODriver_SET_CONFIGURATION, 0, 0,
+                                              CFE_PSP_IODriver_CONST_STR("alarm=bogus")),
+                      CFE_PSP_ERROR);
+
+    /* Error Case: Unknown setting */
+    UtAssert_INT32_EQ(EntryAPI->DeviceCommand(CFE_PSP_IODriver_SET_CONFIGURATION, 0, 0,
+                                              CFE_PSP_IODriver_CONST_STR("alarms=aggregate/0,,1")),
+                      CFE_PSP_ERROR_NOT_IMPLEMENTED);
+    UtAssert_INT32_EQ(EntryAPI->DeviceCommand(CFE_PSP_IODriver_SET_CONFIGURATION, 0, 0,
+                                              CFE_PSP_IODriver_CONST_STR(NULL)),
+                      CFE_PSP_INVALID_POINTER);
+    UtAssert_True(UT_GetStubCount(UT_KEY(CFE_PSP_SysmonAlarm_Configure)) == 2, "Error Case: Not configured");
+
+    /* Nominal Case: The status of the alarms is read back */
+    memset(&Status, 0xFF, sizeof(Status));
+    UT_SetDataBuffer(UT_KEY(CFE_PSP_SysmonAlarm_GetStatus), &StatusIn, sizeof(StatusIn), false);
+    UtAssert_INT32_EQ(
+        EntryAPI->DeviceCommand(CFE_PSP_IODriver_GET_CONFIGURATION, 0, 0, CFE_PSP_IODriver_VPARG(&Status)),
+        CFE_PSP_SUCCESS);
+    UtAssert_UINT32_EQ(Status.HighMask, 0x1);
+    UtAssert_UINT32_EQ(Status.LowMask, 0x4);
+    UtAssert_UINT32_EQ(Status.CrossingCount, 3);
+
+    /* Error Case: No buffer for the status */
+    UtAssert_INT32_EQ(EntryAPI->DeviceCommand(CFE_PSP_IODriver_GET_CONFIGURATION, 0, 0, CFE_PSP_IODriver_VPARG(NULL)),
+                      CFE_PSP_ERROR_NOT_IMPLEMENTED);
+
+    /* Nominal Case: The alarm states start over when the sampler is started */
+    EntryAPI->DeviceCommand(CFE_PSP_IODriver_SET_RUNNING, 0, 0, CFE_PSP_IODriver_U32ARG(1));
+    EntryAPI->DeviceCommand(CFE_PSP_IODriver_SET_RUNNING, 0, 0, CFE_PSP_IODriver_U32ARG(0));
+    UtAssert_True(UT_GetStubCount(UT_KEY(CFE_PSP_SysmonAlarm_Reset)) == 1, "Nominal Case: Alarms reset at start");
+}
+
+void Test_Alarm_Values(void)
+{
+    PCS_Thread_Control Threads[2];
+    UT_AlarmCheck_t    Check;
+    uint32             Value;
+
+    memset(&Check, 0, sizeof(Check));
+    UT_SetHookFunction(UT_KEY(CFE_PSP_SysmonAlarm_Check), UT_AlarmCheck_Hook, &Check);
+
+    /* Nominal Case: Every sample is checked against the alarms */
+    UT_SetThread(&Threads[0], UT_IDLE_ID, "IDLE", UT_SECOND / 4);
+    UT_SetThread(&Threads[1], UT_TSK1_ID, "TSK1", 3 * UT_SECOND / 4);
+    UT_Sample(Threads, 2, UT_SECOND);
+    UtAssert_True(UT_GetStubCount(UT_KEY(CFE_PSP_SysmonAlarm_Check)) == 1, "Nominal Case: Alarms checked");
+    UtAssert_NOT_NULL(Check.ValueFunc);
+
+    /* Nominal Case: The alarms read the values just published */
+    Value = 0;
+    UtAssert_True(Check.ValueFunc(Check.Arg, 0, 0, &Value), "Nominal Case: Aggregate load");
+    UtAssert_UINT32_EQ(Value, 0xC00C00);
+    UtAssert_True(Check.ValueFunc(Check.Arg, UT_LookupSubsystem("per-cpu"), 0, &Value), "Nominal Case: CPU load");
+    UtAssert_UINT32_EQ(Value, 0xC00C00);
+    UtAssert_True(Check.ValueFunc(Check.Arg, UT_LookupSubsystem("per-cpu-60s"), 0, &Value),
+                  "Nominal Case: CPU average");
+    UtAssert_True(Check.ValueFunc(Check.Arg, UT_LookupSubsystem("per-task"), UT_LookupTask("TSK1"), &Value),
+                  "Nominal Case: Task load");
+    UtAssert_UINT32_EQ(Value, 0);
+
+    /* Nominal Case: The next sample is read from the other snapshot */
+    Threads[0].cpu_time_used += UT_SECOND / 2;
+    Threads[1].cpu_time_used += UT_SECOND / 2;
+    UT_Sample(Threads, 2, 2 * UT_SECOND);
+    UtAssert_True(Check.ValueFunc(Check.Arg, UT_LookupSubsystem("per-task"), UT_LookupTask("TSK1"), &Value),
+                  "Nominal Case: Task load");
+    UtAssert_UINT32_EQ(Value, 0x800800);
+
+    /* Error Case: Channels that do not exist */
+    UtAssert_True(!Check.ValueFunc(Check.Arg, 0, 4, &Value), "Error Case: No such average");
+    UtAssert_True(!Check.ValueFunc(Check.Arg, UT_LookupSubsystem("per-cpu"), 1, &Value), "Error Case: No such CPU");
+    UtAssert_True(!Check.ValueFunc(Check.Arg, UT_LookupSubsystem("per-task"), UT_RtemsSysmon_GetMaxTasks(), &Value),
+                  "Error Case: No such task slot");
+    UtAssert_True(!Check.ValueFunc(Check.Arg, UT_LookupSubsystem("per-task"), UT_LookupTask("TSK1") ^ 1, &Value),
+                  "Error Case: Empty task slot");
+    UtAssert_True(!Check.ValueFunc(Check.Arg, 40, 0, &Value), "Error Case: No such subsystem");
+}
+
+void Test_Task_Nominal(void)
+{
+    int DelayCounter = 0;
+
+    /* Nominal Case: RTEMS sysmon task */
+    UT_RtemsSysmon_SetShouldRun(true);
+    UT_SetHookFunction(UT_KEY(OS_TaskDelay), (UT_HookFunc_t)UT_TaskDelay_Hook, &DelayCounter);
+    UT_RtemsSysmon_RunTask();
+
+    UtAssert_True(DelayCounter == 1, "Nominal Case: RTEMS Sysmon Task");
+    UtAssert_True(UT_GetStubCount(UT_KEY(PCS_rtems_cpu_usage_reset)) == 1, "Nominal Case: CPU usage reset");
+    UtAssert_True(UT_GetStubCount(UT_KEY(PCS_rtems_task_delete)) == 1, "Nominal Case: Task deleted itself");
+}
+
+/*
+ * Macro to add a test case to the list of tests to execute
+ */
+#define ADD_TEST(test) UtTest_Add(test, ModuleTest_ResetState, NULL, #test)
+
+/*
+ * Register the test cases to execute with the unit test tool
+ */
+void UtTest_Setup(void)
+{
+    ADD_TEST(Test_Init_Nominal);
+    ADD_TEST(Test_Entry_Nominal);
+    ADD_TEST(Test_Entry_Locking);
+    ADD_TEST(Test_Aggregate_Nominal);
+    ADD_TEST(Test_Aggregate_Error);
+    ADD_TEST(Test_CpuLoad_Dispatch);
+    ADD_TEST(Test_UpdateStat_Nominal);
+    ADD_TEST(Test_TaskLoad_Nominal);
+    ADD_TEST(Test_TaskLoad_Slots);
+    ADD_TEST(Test_TaskLoad_Full);
+    ADD_TEST(Test_TaskLoad_Dispatch);
+    ADD_TEST(Test_Record_Nominal);
+    ADD_TEST(Test_Alarm_Config);
+    ADD_TEST(Test_Alarm_Values);
+    ADD_TEST(Test_Task_Nominal);
+}
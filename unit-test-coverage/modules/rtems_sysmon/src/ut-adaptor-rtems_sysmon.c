@@ -0,0 +1,98 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,719-1, and identified as “core Flight System: 
+ * Draco
+ *
+ * Copyright (c) 2023 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ **********************************************************************/
+
+/**
+ * \file
+ * \ingroup  adaptors
+ *
+ * Access to the internal state of the RTEMS sysmon module
+ */
+
+#include "cfe_psp.h"
+#include "cfe_psp_sysmonalarm.h"
+#include "cfe_psp_sysmonrecord.h"
+#include "iodriver_impl.h"
+#include "iodriver_analog_io.h"
+
+#include <rtems.h>
+#include <rtems/score/threadimpl.h>
+#include <rtems/rtems/tasks.h>
+
+#include "rtems_sysmon.h"
+#include "ut-adaptor-rtems_sysmon.h"
+
+extern rtems_sysmon_state_t rtems_sysmon_global;
+
+uint32 UT_RtemsSysmon_GetMaxCpus(void)
+{
+    return RTEMS_SYSMON_MAX_CPUS;
+}
+
+uint32 UT_RtemsSysmon_GetMaxTasks(void)
+{
+    return RTEMS_SYSMON_MAX_TASKS;
+}
+
+void UT_RtemsSysmon_ResetState(void)
+{
+    static const rtems_sysmon_state_t UT_RtemsSysmon_ZeroState;
+
+    /* not memset(), which is a stub here */
+    rtems_sysmon_global = UT_RtemsSysmon_ZeroState;
+}
+
+uint32 UT_RtemsSysmon_GetLocalModuleId(void)
+{
+    return rtems_sysmon_global.local_module_id;
+}
+
+void UT_RtemsSysmon_SetShouldRun(bool ShouldRun)
+{
+    rtems_sysmon_global.cpu_load.should_run = ShouldRun;
+}
+
+uint32 UT_RtemsSysmon_GetCpuLoad(uint32 Cpu)
+{
+    return rtems_sysmon_global.cpu_load.per_core[Cpu].avg_load;
+}
+
+bool UT_RtemsSysmon_GetTasksDropped(void)
+{
+    return rtems_sysmon_global.cpu_load.tasks.tasks_dropped;
+}
+
+void UT_RtemsSysmon_AttachRecorder(void *Storage, uint32 NumRecords)
+{
+    CFE_PSP_SysmonRecorder_t *Recorder = &rtems_sysmon_global.cpu_load.recorder;
+
+    Recorder->Header     = Storage;
+    Recorder->Records    = (CFE_PSP_SysmonRecordEntry_t *)(Recorder->Header + 1);
+    Recorder->Mask       = NumRecords - 1;
+    Recorder->WriteCount = 0;
+}
+
+void UT_RtemsSysmon_UpdateStat(void)
+{
+    rtems_sysmon_update_stat(&rtems_sysmon_global.cpu_load);
+}
+
+void UT_RtemsSysmon_RunTask(void)
+{
+    rtems_sysmon_Task((rtems_task_argument)&rtems_sysmon_global.cpu_load);
+}
@@ -0,0 +1,49 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,719-1, and identified as “core Flight System: 
+ * Draco
+ *
+ * Copyright (c) 2023 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ **********************************************************************/
+
+/**
+ * \file
+ * \ingroup  modules
+ *
+ * Declarations for the virtual timebase coverage test
+ */
+
+#ifndef COVERAGETEST_TIMEBASE_VIRTUAL_H
+#define COVERAGETEST_TIMEBASE_VIRTUAL_H
+
+#include "utassert.h"
+#include "uttest.h"
+#include "utstubs.h"
+
+#include "PCS_sched.h"
+#include "PCS_stdlib.h"
+#include "PCS_sys_socket.h"
+#include "PCS_time.h"
+#include "PCS_unistd.h"
+
+void Test_Sync_NotInitialized(void);
+void Test_Init_Idle(void);
+void Test_Init_IdlePinError(void);
+void Test_Sync_Idle(void);
+void Test_Sync_IdleSpeedup(void);
+void Test_Init_Step(void);
+void Test_Sync_Step(void);
+void Test_Timer_Info(void);
+
+#endif
@@ -0,0 +1,389 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,719-1, and identified as “core Flight System: 
+ * Draco
+ *
+ * Copyright (c) 2023 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ **********************************************************************/
+
+/**
+ * \file
+ * \ingroup  modules
+ *
+ * Coverage test for the virtual timebase module
+ */
+
+#include <errno.h>
+#include <string.h>
+
+#include "utassert.h"
+#include "utstubs.h"
+#include "uttest.h"
+
+#include "cfe_psp.h"
+#include "cfe_psp_config.h"
+#include "cfe_psp_module.h"
+
+#include "coveragetest-timebase_virtual.h"
+
+#define UT_PERIOD_NSEC (CFE_PSP_SOFT_TIMEBASE_PERIOD * 1000)
+
+/*
+ * Reference to the API entry point for the module
+ */
+extern CFE_PSP_ModuleApi_t CFE_PSP_timebase_virtual_API;
+
+const CFE_PSP_ModuleApi_t *TgtAPI = &CFE_PSP_timebase_virtual_API;
+
+/*
+ * One datagram (or error) returned by recvfrom() in "step" mode
+ */
+typedef struct
+{
+    const char   *Msg;
+    int           Errno;
+    PCS_socklen_t AddrLen;
+} UT_StepRequest_t;
+
+typedef struct
+{
+    const UT_StepRequest_t *Requests;
+    uint32                  NumRequests;
+} UT_StepQueue_t;
+
+/*
+ * The PSP itself is not linked into this test
+ */
+void CFE_PSP_Panic(int32 ErrorCode)
+{
+    UT_Stub_RegisterContextGenericArg(UT_KEY(CFE_PSP_Panic), ErrorCode);
+    UT_DEFAULT_IMPL(CFE_PSP_Panic);
+}
+
+void ModuleTest_ResetState(void)
+{
+    UT_ResetState(0);
+}
+
+/* Hook to return the requests of a UT_StepQueue_t in turn */
+int32 UT_recvfrom_Hook(void *UserObj, int32 StubRetcode, uint32 CallCount, const UT_StubContext_t *Context)
+{
+    UT_StepQueue_t         *Queue   = UserObj;
+    void                   *buf     = UT_Hook_GetArgValueByName(Context, "buf", void *);
+    size_t                  n       = UT_Hook_GetArgValueByName(Context, "n", size_t);
+    PCS_socklen_t          *AddrLen = UT_Hook_GetArgValueByName(Context, "addr_len", PCS_socklen_t *);
+    const UT_StepRequest_t *Req;
+
+    if (CallCount > Queue->NumRequests)
+    {
+        UtAssert_Failed("Unexpected step request %lu", (unsigned long)CallCount);
+        return -1;
+    }
+
+    Req = &Queue->Requests[CallCount - 1];
+    if (Req->Msg == NULL)
+    {
+        errno = Req->Errno;
+        return -1;
+    }
+
+    if (Req->AddrLen != 0)
+    {
+        *AddrLen = Req->AddrLen;
+    }
+
+    strncpy(buf, Req->Msg, n);
+    return strlen(Req->Msg);
+}
+
+/* Hook to save each reply sent in "step" mode */
+int32 UT_sendto_Hook(void *UserObj, int32 StubRetcode, uint32 CallCount, const UT_StubContext_t *Context)
+{
+    char       (*Replies)[32] = UserObj;
+    const void *buf           = UT_Hook_GetArgValueByName(Context, "buf", const void *);
+    size_t      n             = UT_Hook_GetArgValueByName(Context, "n", size_t);
+
+    if (CallCount <= 2 && n < sizeof(Replies[0]))
+    {
+        memcpy(Replies[CallCount - 1], buf, n);
+        Replies[CallCount - 1][n] = 0;
+    }
+
+    return StubRetcode;
+}
+
+/* Hook to save the CPU set the module pins to */
+int32 UT_sched_setaffinity_Hook(void *UserObj, int32 StubRetcode, uint32 CallCount, const UT_StubContext_t *Context)
+{
+    PCS_cpu_set_t *CpuSet = UserObj;
+
+    *CpuSet = *UT_Hook_GetArgValueByName(Context, "mask", const PCS_cpu_set_t *);
+
+    return StubRetcode;
+}
+
+/* Hook to save the delay of nanosleep() */
+int32 UT_nanosleep_Hook(void *UserObj, int32 StubRetcode, uint32 CallCount, const UT_StubContext_t *Context)
+{
+    struct PCS_timespec *Delay = UserObj;
+
+    *Delay = *UT_Hook_GetArgValueByName(Context, "req", const struct PCS_timespec *);
+
+    return StubRetcode;
+}
+
+void Test_Sync_NotInitialized(void)
+{
+    const CFE_PSP_TimebaseSourceApi_t *SourceApi = TgtAPI->ExtendedApi;
+
+    /* This must run before any test calls Init; the sync waits until the module is ready */
+    UtAssert_UINT32_EQ(SourceApi->SyncFunc(OS_OBJECT_ID_UNDEFINED), 0);
+    UtAssert_STUB_COUNT(OS_TaskDelay, 1);
+    UtAssert_STUB_COUNT(PCS_sched_yield, 0);
+}
+
+void Test_Init_Idle(void)
+{
+    PCS_cpu_set_t CpuSet;
+    const char   *Env[3];
+
+    /* Nominal, pinned to the CPU that Init runs on */
+    UT_SetHookFunction(UT_KEY(PCS_sched_setaffinity), UT_sched_setaffinity_Hook, &CpuSet);
+    UT_SetDefaultReturnValue(UT_KEY(PCS_sched_getcpu), 3);
+    memset(&CpuSet, 0, sizeof(CpuSet));
+    TgtAPI->Init(0);
+    UtAssert_STUB_COUNT(PCS_sched_setaffinity, 1);
+    UtAssert_True(CpuSet.bits[0] == (1 << 3), "Pinned to CPU 3");
+    UtAssert_STUB_COUNT(PCS_socket, 0);
+    UtAssert_STUB_COUNT(CFE_PSP_Panic, 0);
+
+    /* The CPU from the environment takes precedence */
+    UT_ResetState(0);
+    UT_SetHookFunction(UT_KEY(PCS_sched_setaffinity), UT_sched_setaffinity_Hook, &CpuSet);
+    Env[0] = NULL;
+    Env[1] = "idle";
+    Env[2] = "5";
+    UT_SetDataBuffer(UT_KEY(PCS_getenv), Env, sizeof(Env), false);
+    memset(&CpuSet, 0, sizeof(CpuSet));
+    TgtAPI->Init(0);
+    UtAssert_STUB_COUNT(PCS_sched_getcpu, 0);
+    UtAssert_True(CpuSet.bits[0] == (1 << 5), "Pinned to CPU 5");
+    UtAssert_STUB_COUNT(CFE_PSP_Panic, 0);
+}
+
+void Test_Init_IdlePinError(void)
+{
+    const char *Env[3];
+
+    /* The current CPU is not known */
+    UT_SetDefaultReturnValue(UT_KEY(PCS_sched_getcpu), -1);
+    TgtAPI->Init(0);
+    UtAssert_STUB_COUNT(PCS_sched_setaffinity, 0);
+    UtAssert_STUB_COUNT(CFE_PSP_Panic, 1);
+
+    /* The CPU from the environment is out of range */
+    UT_ResetState(0);
+    Env[0] = NULL;
+    Env[1] = NULL;
+    Env[2] = "64";
+    UT_SetDataBuffer(UT_KEY(PCS_getenv), Env, sizeof(Env), false);
+    TgtAPI->Init(0);
+    UtAssert_STUB_COUNT(PCS_sched_setaffinity, 0);
+    UtAssert_STUB_COUNT(CFE_PSP_Panic, 1);
+
+    /* The affinity cannot be set */
+    UT_ResetState(0);
+    UT_SetDefaultReturnValue(UT_KEY(PCS_sched_setaffinity), -1);
+    TgtAPI->Init(0);
+    UtAssert_STUB_COUNT(PCS_sched_setaffinity, 1);
+    UtAssert_STUB_COUNT(CFE_PSP_Panic, 1);
+}
+
+void Test_Sync_Idle(void)
+{
+    const CFE_PSP_TimebaseSourceApi_t *SourceApi = TgtAPI->ExtendedApi;
+    OS_time_t                          LocalTime;
+    uint32                             Tbu;
+    uint32                             Tbl;
+
+    TgtAPI->Init(0);
+
+    /* The first sync sets up the thread, which is pinned again and made SCHED_IDLE */
+    UtAssert_UINT32_EQ(SourceApi->SyncFunc(OS_OBJECT_ID_UNDEFINED), CFE_PSP_SOFT_TIMEBASE_PERIOD);
+    UtAssert_UINT32_EQ(SourceApi->SyncFunc(OS_OBJECT_ID_UNDEFINED), CFE_PSP_SOFT_TIMEBASE_PERIOD);
+    UtAssert_STUB_COUNT(PCS_sched_setaffinity, 2);
+    UtAssert_STUB_COUNT(PCS_sched_setscheduler, 1);
+    UtAssert_STUB_COUNT(PCS_sched_yield, 2);
+    UtAssert_STUB_COUNT(PCS_nanosleep, 0);
+    UtAssert_STUB_COUNT(OS_printf, 0);
+
+    /* Each sync advanced the clock by one period */
+    CFE_PSP_GetTime(&LocalTime);
+    UtAssert_True(OS_TimeGetTotalNanoseconds(LocalTime) == (2 * UT_PERIOD_NSEC), "Virtual time is 2 periods");
+    CFE_PSP_Get_Timebase(&Tbu, &Tbl);
+    UtAssert_UINT32_EQ(Tbu, 0);
+    UtAssert_UINT32_EQ(Tbl, 2 * UT_PERIOD_NSEC);
+
+    /* Failure to set up the thread is reported, but it still runs */
+    UT_ResetState(0);
+    TgtAPI->Init(0);
+    UT_SetDefaultReturnValue(UT_KEY(PCS_sched_setaffinity), -1);
+    UT_SetDefaultReturnValue(UT_KEY(PCS_sched_setscheduler), -1);
+    UtAssert_UINT32_EQ(SourceApi->SyncFunc(OS_OBJECT_ID_UNDEFINED), CFE_PSP_SOFT_TIMEBASE_PERIOD);
+    UtAssert_STUB_COUNT(OS_printf, 2);
+}
+
+void Test_Sync_IdleSpeedup(void)
+{
+    const CFE_PSP_TimebaseSourceApi_t *SourceApi = TgtAPI->ExtendedApi;
+    struct PCS_timespec                Delay;
+    struct PCS_timespec                RealTimes[2];
+    const char                        *Env[3];
+
+    /* Limited to 2x real time; real time has not moved, so it waits for half a period */
+    Env[0] = "2";
+    Env[1] = NULL;
+    Env[2] = NULL;
+    UT_SetDataBuffer(UT_KEY(PCS_getenv), Env, sizeof(Env), false);
+    UT_SetHookFunction(UT_KEY(PCS_nanosleep), UT_nanosleep_Hook, &Delay);
+    memset(&Delay, 0, sizeof(Delay));
+    TgtAPI->Init(0);
+    UtAssert_UINT32_EQ(SourceApi->SyncFunc(OS_OBJECT_ID_UNDEFINED), CFE_PSP_SOFT_TIMEBASE_PERIOD);
+    UtAssert_STUB_COUNT(PCS_nanosleep, 1);
+    UtAssert_True(Delay.tv_sec == 0 && Delay.tv_nsec == (UT_PERIOD_NSEC / 2), "Delay (%ld) == half a period",
+                  (long)Delay.tv_nsec);
+
+    /* Real time is already ahead, so no wait */
+    UT_ResetState(0);
+    UT_SetDataBuffer(UT_KEY(PCS_getenv), Env, sizeof(Env), false);
+    memset(RealTimes, 0, sizeof(RealTimes));
+    RealTimes[1].tv_sec = 1;
+    UT_SetDataBuffer(UT_KEY(PCS_clock_gettime), RealTimes, sizeof(RealTimes), false);
+    TgtAPI->Init(0);
+    UtAssert_UINT32_EQ(SourceApi->SyncFunc(OS_OBJECT_ID_UNDEFINED), CFE_PSP_SOFT_TIMEBASE_PERIOD);
+    UtAssert_STUB_COUNT(PCS_clock_gettime, 2);
+    UtAssert_STUB_COUNT(PCS_nanosleep, 0);
+}
+
+void Test_Init_Step(void)
+{
+    const char *Env[3];
+
+    Env[0] = NULL;
+    Env[1] = "STEP";
+    Env[2] = NULL;
+
+    /* Nominal, stepped mode is not pinned */
+    UT_SetDataBuffer(UT_KEY(PCS_getenv), Env, sizeof(Env), false);
+    TgtAPI->Init(0);
+    UtAssert_STUB_COUNT(PCS_unlink, 1);
+    UtAssert_STUB_COUNT(PCS_socket, 1);
+    UtAssert_STUB_COUNT(PCS_bind, 1);
+    UtAssert_STUB_COUNT(PCS_sched_setaffinity, 0);
+    UtAssert_STUB_COUNT(CFE_PSP_Panic, 0);
+
+    /* The socket cannot be created */
+    UT_ResetState(0);
+    UT_SetDataBuffer(UT_KEY(PCS_getenv), Env, sizeof(Env), false);
+    UT_SetDefaultReturnValue(UT_KEY(PCS_socket), -1);
+    TgtAPI->Init(0);
+    UtAssert_STUB_COUNT(PCS_bind, 0);
+    UtAssert_STUB_COUNT(CFE_PSP_Panic, 1);
+
+    /* The socket cannot be bound */
+    UT_ResetState(0);
+    UT_SetDataBuffer(UT_KEY(PCS_getenv), Env, sizeof(Env), false);
+    UT_SetDefaultReturnValue(UT_KEY(PCS_bind), -1);
+    TgtAPI->Init(0);
+    UtAssert_STUB_COUNT(CFE_PSP_Panic, 1);
+}
+
+void Test_Sync_Step(void)
+{
+    const CFE_PSP_TimebaseSourceApi_t *SourceApi = TgtAPI->ExtendedApi;
+    OS_time_t                          LocalTime;
+    UT_StepQueue_t                     Queue;
+    char                               Replies[2][32];
+    const char                        *Env[3];
+
+    static const UT_StepRequest_t REQUESTS[] = {
+        {"2", 0, 0},                         /* advance 2 periods */
+        {NULL, EAGAIN, 0},                   /* receive error, retried after a delay */
+        {NULL, EINTR, 0},                    /* interrupted, retried immediately */
+        {"1", 0, sizeof(PCS_sa_family_t)},   /* advance 1 period, from an anonymous requester */
+        {"0", 0, 0},                         /* query only */
+        {"1", 0, 0},                         /* advance 1 period */
+    };
+
+    Env[0] = NULL;
+    Env[1] = "step";
+    Env[2] = NULL;
+    UT_SetDataBuffer(UT_KEY(PCS_getenv), Env, sizeof(Env), false);
+    TgtAPI->Init(0);
+
+    Queue.Requests    = REQUESTS;
+    Queue.NumRequests = sizeof(REQUESTS) / sizeof(REQUESTS[0]);
+    UT_SetHookFunction(UT_KEY(PCS_recvfrom), UT_recvfrom_Hook, &Queue);
+    UT_SetHookFunction(UT_KEY(PCS_sendto), UT_sendto_Hook, Replies);
+    memset(Replies, 0, sizeof(Replies));
+
+    /* The first request covers two syncs, then the reply is sent on the third */
+    UtAssert_UINT32_EQ(SourceApi->SyncFunc(OS_OBJECT_ID_UNDEFINED), CFE_PSP_SOFT_TIMEBASE_PERIOD);
+    UtAssert_UINT32_EQ(SourceApi->SyncFunc(OS_OBJECT_ID_UNDEFINED), CFE_PSP_SOFT_TIMEBASE_PERIOD);
+    UtAssert_STUB_COUNT(PCS_recvfrom, 1);
+    UtAssert_STUB_COUNT(PCS_sendto, 0);
+
+    UtAssert_UINT32_EQ(SourceApi->SyncFunc(OS_OBJECT_ID_UNDEFINED), CFE_PSP_SOFT_TIMEBASE_PERIOD);
+    UtAssert_STUB_COUNT(PCS_recvfrom, 4);
+    UtAssert_STUB_COUNT(PCS_sendto, 1);
+    UtAssert_STUB_COUNT(OS_TaskDelay, 1);
+    UtAssert_STRINGBUF_EQ(Replies[0], sizeof(Replies[0]), "20000000\n", UTASSERT_STRINGBUF_NULL_TERM);
+
+    /* No reply to the anonymous requester, but the query is answered */
+    UtAssert_UINT32_EQ(SourceApi->SyncFunc(OS_OBJECT_ID_UNDEFINED), CFE_PSP_SOFT_TIMEBASE_PERIOD);
+    UtAssert_STUB_COUNT(PCS_recvfrom, 6);
+    UtAssert_STUB_COUNT(PCS_sendto, 2);
+    UtAssert_STRINGBUF_EQ(Replies[1], sizeof(Replies[1]), "30000000\n", UTASSERT_STRINGBUF_NULL_TERM);
+
+    UtAssert_STUB_COUNT(PCS_sched_setscheduler, 0);
+    CFE_PSP_GetTime(&LocalTime);
+    UtAssert_True(OS_TimeGetTotalNanoseconds(LocalTime) == (4 * UT_PERIOD_NSEC), "Virtual time is 4 periods");
+}
+
+void Test_Timer_Info(void)
+{
+    /* Both are in nanoseconds */
+    UtAssert_UINT32_EQ(CFE_PSP_GetTimerTicksPerSecond(), 1000000000);
+    UtAssert_UINT32_EQ(CFE_PSP_GetTimerLow32Rollover(), 1000000000);
+}
+
+/*
+ * Macro to add a test case to the list of tests to execute
+ */
+#define ADD_TEST(test) UtTest_Add(test, ModuleTest_ResetState, NULL, #test)
+
+/*
+ * Register the test cases to execute with the unit test tool
+ */
+void UtTest_Setup(void)
+{
+    ADD_TEST(Test_Sync_NotInitialized);
+    ADD_TEST(Test_Init_Idle);
+    ADD_TEST(Test_Init_IdlePinError);
+    ADD_TEST(Test_Sync_Idle);
+    ADD_TEST(Test_Sync_IdleSpeedup);
+    ADD_TEST(Test_Init_Step);
+    ADD_TEST(Test_Sync_Step);
+    ADD_TEST(Test_Timer_Info);
+}
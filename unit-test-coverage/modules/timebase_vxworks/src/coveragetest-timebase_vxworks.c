@@ -195,6 +195,98 @@ void Test_Reducible_2(void)
                   (long long)TestTime);
 }
 
+/*
+ * Checks the converted value of a single raw timebase value against
+ * the straightforward multiply-then-divide conversion.
+ */
+static bool Check_Reciprocal_Value(PSP_VxWorks_TimeBaseVal_t *VxTime, uint64 RawTicks, uint32 ConvN, uint32 ConvD)
+{
+    OS_time_t OsTime;
+    uint64    Expected;
+
+    VxTime->u = RawTicks >> 32;
+    VxTime->l = RawTicks & 0xFFFFFFFF;
+    CFE_PSP_GetTime(&OsTime);
+
+    Expected = RawTicks;
+    Expected *= ConvN;
+    Expected /= ConvD;
+
+    return ((uint64)OsTime.ticks == Expected);
+}
+
+void Test_Reciprocal_Exact(void)
+{
+    /*
+     * Each entry is a timebase period, followed by the reduced
+     * conversion ratio to OS_time_t (100ns) ticks that it should produce.
+     */
+    static const struct
+    {
+        uint32 PeriodN;
+        uint32 PeriodD;
+        uint32 ConvN;
+        uint32 ConvD;
+    } RATIOS[] = {
+        {1, 1, 1, 100},
+        {43 * 3, 53 * 2, 129, 10600},
+        {84000, 350, 12, 5},
+        {60, 1, 3, 5},
+        {7, 3, 7, 300},
+        {4294967291UL, 1, 4294967291UL, 100},
+        {1, 42949672, 1, 4294967200UL},
+    };
+
+    PSP_VxWorks_TimeBaseVal_t VxTime;
+    uint32                    i;
+    uint32                    j;
+    uint32                    Failures;
+    uint64                    RawTicks;
+    uint64                    Lcg;
+
+    UT_SetHookFunction(UT_KEY(PCS_vxTimeBaseGet), UTHOOK_vxTimeBaseGet, &VxTime);
+
+    for (i = 0; i < (sizeof(RATIOS) / sizeof(RATIOS[0])); ++i)
+    {
+        UT_PSP_TIMEBASE_VXWORKS_TESTCONFIG.PeriodNumerator   = RATIOS[i].PeriodN;
+        UT_PSP_TIMEBASE_VXWORKS_TESTCONFIG.PeriodDenominator = RATIOS[i].PeriodD;
+        TgtAPI->Init(0);
+
+        Failures = 0;
+
+        /* The extremes of the range, and either side of the denominator */
+        Failures += !Check_Reciprocal_Value(&VxTime, 0, RATIOS[i].ConvN, RATIOS[i].ConvD);
+        Failures += !Check_Reciprocal_Value(&VxTime, 1, RATIOS[i].ConvN, RATIOS[i].ConvD);
+        Failures += !Check_Reciprocal_Value(&VxTime, RATIOS[i].ConvD - 1, RATIOS[i].ConvN, RATIOS[i].ConvD);
+        Failures += !Check_Reciprocal_Value(&VxTime, RATIOS[i].ConvD, RATIOS[i].ConvN, RATIOS[i].ConvD);
+        Failures += !Check_Reciprocal_Value(&VxTime, 0xFFFFFFFFFFFFFFFF, RATIOS[i].ConvN, RATIOS[i].ConvD);
+
+        /* Each power of two, and one either side of it */
+        for (j = 0; j < 64; ++j)
+        {
+            RawTicks = (uint64)1 << j;
+            Failures += !Check_Reciprocal_Value(&VxTime, RawTicks - 1, RATIOS[i].ConvN, RATIOS[i].ConvD);
+            Failures += !Check_Reciprocal_Value(&VxTime, RawTicks, RATIOS[i].ConvN, RATIOS[i].ConvD);
+            Failures += !Check_Reciprocal_Value(&VxTime, RawTicks + 1, RATIOS[i].ConvN, RATIOS[i].ConvD);
+        }
+
+        /*
+         * Pseudo-random values spread over the full 64 bit range.  Shifting by
+         * a varying amount also exercises values of every magnitude.
+         */
+        Lcg = 0x0123456789ABCDEF;
+        for (j = 0; j < 100000; ++j)
+        {
+            Lcg      = (Lcg * 6364136223846793005ULL) + 1442695040888963407ULL;
+            RawTicks = Lcg >> (j % 64);
+            Failures += !Check_Reciprocal_Value(&VxTime, RawTicks, RATIOS[i].ConvN, RATIOS[i].ConvD);
+        }
+
+        UtAssert_True(Failures == 0, "Ratio %lu/%lu: CFE_PSP_GetTime() mismatches (%lu) == 0",
+                      (unsigned long)RATIOS[i].ConvN, (unsigned long)RATIOS[i].ConvD, (unsigned long)Failures);
+    }
+}
+
 void Test_Rollover(void)
 {
     /* This function always returns 0 */
@@ -244,6 +336,7 @@ void UtTest_Setup(void)
     ADD_TEST(Test_Non_Reducible);
     ADD_TEST(Test_Reducible_1);
     ADD_TEST(Test_Reducible_2);
+    ADD_TEST(Test_Reciprocal_Exact);
     ADD_TEST(Test_Rollover);
     ADD_TEST(Test_Get_Timebase);
 }
@@ -67,4 +67,21 @@ void UtTest_Setup(void)
     ADD_TEST(CFE_PSP_WatchdogService);
     ADD_TEST(CFE_PSP_WatchdogGet);
     ADD_TEST(CFE_PSP_WatchdogSet);
+
+    /* Coverage test cases for the shared cfe_psp_sysmonalarm.c */
+    ADD_TEST(CFE_PSP_SysmonAlarm_Configure);
+    ADD_TEST(CFE_PSP_SysmonAlarm_Slots);
+    ADD_TEST(CFE_PSP_SysmonAlarm_Check);
+    ADD_TEST(CFE_PSP_SysmonAlarm_Generation);
+    ADD_TEST(CFE_PSP_SysmonAlarm_Notify);
+
+    /* Coverage test cases for the shared cfe_psp_sysmonrecord.c */
+    ADD_TEST(CFE_PSP_SysmonRecord_Attach);
+    ADD_TEST(CFE_PSP_SysmonRecord_AttachReserved);
+    ADD_TEST(CFE_PSP_SysmonRecord_Sample);
+
+    /* Coverage test cases for the shared cfe_psp_trace.c */
+    ADD_TEST(CFE_PSP_Trace_Init);
+    ADD_TEST(CFE_PSP_Trace_ClaimRing);
+    ADD_TEST(CFE_PSP_Trace_Overflow);
 }
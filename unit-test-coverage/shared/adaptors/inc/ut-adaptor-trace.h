@@ -0,0 +1,53 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,719-1, and identified as “core Flight System: 
+ * Draco
+ *
+ * Copyright (c) 2023 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ **********************************************************************/
+
+/**
+ * \file
+ * \ingroup  adaptors
+ *
+ * Access to the trace storage and the ring of the calling thread, which
+ * cannot be reached by the test code as their size depends on the PSP config
+ */
+
+#ifndef UT_ADAPTOR_TRACE_H
+#define UT_ADAPTOR_TRACE_H
+
+#include "common_types.h"
+#include "cfe_psp_trace_types.h"
+
+/* Points the reserved memory map at the test storage, or at nothing, and forgets the ring of the calling thread */
+void UT_Setup_TraceStorage(bool Provided);
+
+/* Forgets the ring of the calling thread, as if the next event came from another thread */
+void UT_Clear_TraceLocalRing(void);
+
+void *UT_Get_TraceLocalRing(void);
+void *UT_Get_TraceRing(uint32 RingIndex);
+
+CFE_PSP_TraceStorageHeader_t *UT_Get_TraceHeader(void);
+CFE_PSP_TraceRingHeader_t *   UT_Get_TraceRingHeader(uint32 RingIndex);
+CFE_PSP_TraceEntry_t *        UT_Get_TraceEntry(uint32 RingIndex, uint32 EntryIndex);
+
+uint32 UT_Get_TraceMaxRings(void);
+uint32 UT_Get_TraceRingEntries(void);
+
+/* Records an event from the calling thread, as the CFE_PSP_TRACE_* macros do */
+void UT_Trace_Record(uint16 EventId, uint8 Phase, uint32 Arg);
+
+#endif
@@ -0,0 +1,33 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,719-1, and identified as “core Flight System: 
+ * Draco
+ *
+ * Copyright (c) 2023 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ **********************************************************************/
+
+/**
+ * \file
+ * \ingroup  adaptors
+ */
+
+#include "ut-adaptor-sysmonrecord.h"
+#include "cfe_psp_config.h"
+#include "cfe_psp_memory.h"
+
+void UT_Setup_ReservedMem_SysmonRecord(void *BlockPtr, size_t BlockSize)
+{
+    CFE_PSP_ReservedMemoryMap.SysmonRecordMemory.BlockPtr  = BlockPtr;
+    CFE_PSP_ReservedMemoryMap.SysmonRecordMemory.BlockSize = BlockSize;
+}
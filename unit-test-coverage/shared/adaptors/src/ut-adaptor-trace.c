@@ -0,0 +1,89 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,719-1, and identified as “core Flight System: 
+ * Draco
+ *
+ * Copyright (c) 2023 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ **********************************************************************/
+
+/**
+ * \file
+ * \ingroup  adaptors
+ */
+
+#include "ut-adaptor-trace.h"
+#include "cfe_psp_config.h"
+#include "cfe_psp_memory.h"
+#include "cfe_psp_trace.h"
+
+static CFE_PSP_TraceStorage_t UT_TRACE_STORAGE;
+
+void UT_Setup_TraceStorage(bool Provided)
+{
+    if (Provided)
+    {
+        CFE_PSP_ReservedMemoryMap.TraceStoragePtr = &UT_TRACE_STORAGE;
+    }
+    else
+    {
+        CFE_PSP_ReservedMemoryMap.TraceStoragePtr = NULL;
+    }
+
+    CFE_PSP_Trace_LocalRing = NULL;
+}
+
+void UT_Clear_TraceLocalRing(void)
+{
+    CFE_PSP_Trace_LocalRing = NULL;
+}
+
+void *UT_Get_TraceLocalRing(void)
+{
+    return CFE_PSP_Trace_LocalRing;
+}
+
+void *UT_Get_TraceRing(uint32 RingIndex)
+{
+    return &UT_TRACE_STORAGE.Rings[RingIndex];
+}
+
+CFE_PSP_TraceStorageHeader_t *UT_Get_TraceHeader(void)
+{
+    return &UT_TRACE_STORAGE.Header;
+}
+
+CFE_PSP_TraceRingHeader_t *UT_Get_TraceRingHeader(uint32 RingIndex)
+{
+    return &UT_TRACE_STORAGE.Rings[RingIndex].Header;
+}
+
+CFE_PSP_TraceEntry_t *UT_Get_TraceEntry(uint32 RingIndex, uint32 EntryIndex)
+{
+    return &UT_TRACE_STORAGE.Rings[RingIndex].Entries[EntryIndex];
+}
+
+uint32 UT_Get_TraceMaxRings(void)
+{
+    return CFE_PSP_TRACE_MAX_RINGS;
+}
+
+uint32 UT_Get_TraceRingEntries(void)
+{
+    return CFE_PSP_TRACE_RING_ENTRIES;
+}
+
+void UT_Trace_Record(uint16 EventId, uint8 Phase, uint32 Arg)
+{
+    CFE_PSP_Trace_Record(EventId, Phase, Arg);
+}
@@ -47,4 +47,18 @@ void Test_CFE_PSP_Exception_GetNextContextBuffer(void);
 void Test_CFE_PSP_Exception_GetSummary(void);
 void Test_CFE_PSP_Exception_CopyContext(void);
 
+void Test_CFE_PSP_SysmonAlarm_Configure(void);
+void Test_CFE_PSP_SysmonAlarm_Slots(void);
+void Test_CFE_PSP_SysmonAlarm_Check(void);
+void Test_CFE_PSP_SysmonAlarm_Generation(void);
+void Test_CFE_PSP_SysmonAlarm_Notify(void);
+
+void Test_CFE_PSP_SysmonRecord_Attach(void);
+void Test_CFE_PSP_SysmonRecord_AttachReserved(void);
+void Test_CFE_PSP_SysmonRecord_Sample(void);
+
+void Test_CFE_PSP_Trace_Init(void);
+void Test_CFE_PSP_Trace_ClaimRing(void);
+void Test_CFE_PSP_Trace_Overflow(void);
+
 #endif
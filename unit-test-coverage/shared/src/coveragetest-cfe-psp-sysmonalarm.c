@@ -0,0 +1,301 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,719-1, and identified as “core Flight System: 
+ * Draco
+ *
+ * Copyright (c) 2023 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ **********************************************************************/
+
+/**
+ * \file
+ *
+ * Coverage tests for the shared sysmon threshold alarms, cfe_psp_sysmonalarm.c
+ */
+
+#include <stdio.h>
+
+#include "utassert.h"
+#include "utstubs.h"
+
+#include "cfe_psp.h"
+#include "cfe_psp_sysmonalarm.h"
+#include "target_config.h"
+
+#include "PCS_cfe_configdata.h"
+
+static const char *const UT_SysmonAlarm_SubsystemNames[] = {"alpha", "beta", NULL};
+
+static CFE_PSP_SysmonAlarmSet_t UT_SysmonAlarm_Set;
+
+/* the channel value returned to CFE_PSP_SysmonAlarm_Check() */
+static uint32 UT_SysmonAlarm_Value;
+static bool   UT_SysmonAlarm_Valid;
+static uint32 UT_SysmonAlarm_NotifyCount;
+
+static bool UT_SysmonAlarm_ValueFunc(void *Arg, uint16 Subsystem, uint16 Subchannel, uint32 *Value)
+{
+    *Value = UT_SysmonAlarm_Value;
+    return UT_SysmonAlarm_Valid;
+}
+
+static void UT_SysmonAlarm_NotifyFunc(void *Arg)
+{
+    UtAssert_True(Arg == &UT_SysmonAlarm_Set, "Notify argument (%p) == &UT_SysmonAlarm_Set", Arg);
+    ++UT_SysmonAlarm_NotifyCount;
+}
+
+/* checks the value against the alarms, and returns the number of crossings */
+static uint32 UT_SysmonAlarm_CheckValue(uint32 Value)
+{
+    UT_SysmonAlarm_Value = Value;
+    UT_SysmonAlarm_Valid = true;
+    return CFE_PSP_SysmonAlarm_Check(&UT_SysmonAlarm_Set, UT_SysmonAlarm_ValueFunc, NULL);
+}
+
+static void UT_SysmonAlarm_Setup(void)
+{
+    UT_SysmonAlarm_NotifyCount = 0;
+    CFE_PSP_SysmonAlarm_Init(&UT_SysmonAlarm_Set, "ut_sysmon", UT_SysmonAlarm_SubsystemNames);
+}
+
+void Test_CFE_PSP_SysmonAlarm_Configure(void)
+{
+    /*
+     * Test Case For:
+     * int32 CFE_PSP_SysmonAlarm_Configure(CFE_PSP_SysmonAlarmSet_t *Set, const char *Spec)
+     */
+    CFE_PSP_SysmonAlarm_Entry_t *Entry;
+
+    UT_SysmonAlarm_Setup();
+    Entry = UT_SysmonAlarm_Set.Entry;
+
+    UtAssert_INT32_EQ(CFE_PSP_SysmonAlarm_Configure(&UT_SysmonAlarm_Set, NULL), CFE_PSP_INVALID_POINTER);
+
+    /* subsystem by name, both limits and no hysteresis */
+    UtAssert_INT32_EQ(CFE_PSP_SysmonAlarm_Configure(&UT_SysmonAlarm_Set, "beta/3,10,20"), CFE_PSP_SUCCESS);
+    UtAssert_UINT32_EQ(Entry[0].Subsystem, 1);
+    UtAssert_UINT32_EQ(Entry[0].Subchannel, 3);
+    UtAssert_True(Entry[0].HasLow && Entry[0].HasHigh, "Low and high limits set");
+    UtAssert_UINT32_EQ(Entry[0].LowLimit, 10);
+    UtAssert_UINT32_EQ(Entry[0].HighLimit, 20);
+    UtAssert_ZERO(Entry[0].Hysteresis);
+
+    /* subsystem by number, only a high limit, in hex, with hysteresis */
+    UtAssert_INT32_EQ(CFE_PSP_SysmonAlarm_Configure(&UT_SysmonAlarm_Set, "5/1,,0x100,0x10"), CFE_PSP_SUCCESS);
+    UtAssert_UINT32_EQ(Entry[1].Subsystem, 5);
+    UtAssert_UINT32_EQ(Entry[1].Subchannel, 1);
+    UtAssert_True(!Entry[1].HasLow && Entry[1].HasHigh, "Only high limit set");
+    UtAssert_UINT32_EQ(Entry[1].HighLimit, 0x100);
+    UtAssert_UINT32_EQ(Entry[1].Hysteresis, 0x10);
+
+    /* only a low limit */
+    UtAssert_INT32_EQ(CFE_PSP_SysmonAlarm_Configure(&UT_SysmonAlarm_Set, "alpha/0,7"), CFE_PSP_SUCCESS);
+    UtAssert_True(Entry[2].HasLow && !Entry[2].HasHigh, "Only low limit set");
+    UtAssert_UINT32_EQ(Entry[2].LowLimit, 7);
+
+    /* invalid specifications leave the alarms as they were */
+    UtAssert_INT32_EQ(CFE_PSP_SysmonAlarm_Configure(&UT_SysmonAlarm_Set, "alpha"), CFE_PSP_ERROR);
+    UtAssert_INT32_EQ(CFE_PSP_SysmonAlarm_Configure(&UT_SysmonAlarm_Set, "/0,1,2"), CFE_PSP_ERROR);
+    UtAssert_INT32_EQ(CFE_PSP_SysmonAlarm_Configure(&UT_SysmonAlarm_Set, "gamma/0,1,2"), CFE_PSP_ERROR);
+    UtAssert_INT32_EQ(CFE_PSP_SysmonAlarm_Configure(&UT_SysmonAlarm_Set, "70000/0,1,2"), CFE_PSP_ERROR);
+    UtAssert_INT32_EQ(CFE_PSP_SysmonAlarm_Configure(&UT_SysmonAlarm_Set, "alpha/x,1,2"), CFE_PSP_ERROR);
+    UtAssert_INT32_EQ(CFE_PSP_SysmonAlarm_Configure(&UT_SysmonAlarm_Set, "alpha/70000,1,2"), CFE_PSP_ERROR);
+    UtAssert_INT32_EQ(CFE_PSP_SysmonAlarm_Configure(&UT_SysmonAlarm_Set, "alpha/0;1,2"), CFE_PSP_ERROR);
+    UtAssert_INT32_EQ(CFE_PSP_SysmonAlarm_Configure(&UT_SysmonAlarm_Set, "alpha/0,abc,2"), CFE_PSP_ERROR);
+    UtAssert_INT32_EQ(CFE_PSP_SysmonAlarm_Configure(&UT_SysmonAlarm_Set, "alpha/0,1,2x"), CFE_PSP_ERROR);
+    UtAssert_INT32_EQ(CFE_PSP_SysmonAlarm_Configure(&UT_SysmonAlarm_Set, "alpha/0,1,2,3,4"), CFE_PSP_ERROR);
+    UtAssert_INT32_EQ(CFE_PSP_SysmonAlarm_Configure(&UT_SysmonAlarm_Set, "alpha/0,20,10"), CFE_PSP_ERROR);
+    UtAssert_INT32_EQ(CFE_PSP_SysmonAlarm_Configure(&UT_SysmonAlarm_Set, "alpha/0,10,10"), CFE_PSP_ERROR);
+    UtAssert_True(!Entry[3].HasLow && !Entry[3].HasHigh, "No alarm added by invalid specifications");
+
+    /* removing an alarm which does not exist does nothing */
+    UtAssert_INT32_EQ(CFE_PSP_SysmonAlarm_Configure(&UT_SysmonAlarm_Set, "alpha/9,,"), CFE_PSP_SUCCESS);
+    UtAssert_INT32_EQ(CFE_PSP_SysmonAlarm_Configure(&UT_SysmonAlarm_Set, "alpha/9"), CFE_PSP_SUCCESS);
+    UtAssert_True(!Entry[3].HasLow && !Entry[3].HasHigh, "No alarm added by removal");
+    UtAssert_ZERO(Entry[3].Generation);
+}
+
+void Test_CFE_PSP_SysmonAlarm_Slots(void)
+{
+    /*
+     * Test Case For:
+     * int32 CFE_PSP_SysmonAlarm_Configure(CFE_PSP_SysmonAlarmSet_t *Set, const char *Spec)
+     */
+    CFE_PSP_SysmonAlarm_Entry_t *Entry;
+    char                         Spec[32];
+    uint32                       i;
+
+    UT_SysmonAlarm_Setup();
+    Entry = UT_SysmonAlarm_Set.Entry;
+
+    /* an alarm on the same channel is changed in place */
+    UtAssert_INT32_EQ(CFE_PSP_SysmonAlarm_Configure(&UT_SysmonAlarm_Set, "alpha/0,,100"), CFE_PSP_SUCCESS);
+    UtAssert_INT32_EQ(CFE_PSP_SysmonAlarm_Configure(&UT_SysmonAlarm_Set, "alpha/1,,100"), CFE_PSP_SUCCESS);
+    UtAssert_INT32_EQ(CFE_PSP_SysmonAlarm_Configure(&UT_SysmonAlarm_Set, "0/0,5,200"), CFE_PSP_SUCCESS);
+    UtAssert_UINT32_EQ(Entry[0].LowLimit, 5);
+    UtAssert_UINT32_EQ(Entry[0].HighLimit, 200);
+    UtAssert_UINT32_EQ(Entry[1].Subchannel, 1);
+    UtAssert_True(!Entry[2].HasLow && !Entry[2].HasHigh, "Third slot still free");
+
+    /* a removed alarm frees its slot, which is the first to be used again */
+    UtAssert_INT32_EQ(CFE_PSP_SysmonAlarm_Configure(&UT_SysmonAlarm_Set, "alpha/0,,"), CFE_PSP_SUCCESS);
+    UtAssert_True(!Entry[0].HasLow && !Entry[0].HasHigh, "First slot freed");
+    UtAssert_INT32_EQ(CFE_PSP_SysmonAlarm_Configure(&UT_SysmonAlarm_Set, "beta/2,,100"), CFE_PSP_SUCCESS);
+    UtAssert_UINT32_EQ(Entry[0].Subsystem, 1);
+    UtAssert_UINT32_EQ(Entry[0].Subchannel, 2);
+    UtAssert_True(!Entry[2].HasLow && !Entry[2].HasHigh, "Third slot still free");
+
+    /* once all are in use, only existing alarms can be changed */
+    for (i = 2; i < CFE_PSP_SYSMONALARM_MAX_ALARMS; ++i)
+    {
+        snprintf(Spec, sizeof(Spec), "beta/%u,,100", (unsigned int)(100 + i));
+        UtAssert_INT32_EQ(CFE_PSP_SysmonAlarm_Configure(&UT_SysmonAlarm_Set, Spec), CFE_PSP_SUCCESS);
+    }
+    UtAssert_INT32_EQ(CFE_PSP_SysmonAlarm_Configure(&UT_SysmonAlarm_Set, "beta/99,,100"), CFE_PSP_ERROR);
+    UtAssert_INT32_EQ(CFE_PSP_SysmonAlarm_Configure(&UT_SysmonAlarm_Set, "beta/2,,50"), CFE_PSP_SUCCESS);
+    UtAssert_UINT32_EQ(Entry[0].HighLimit, 50);
+    UtAssert_INT32_EQ(CFE_PSP_SysmonAlarm_Configure(&UT_SysmonAlarm_Set, "beta/99,,"), CFE_PSP_SUCCESS);
+}
+
+void Test_CFE_PSP_SysmonAlarm_Check(void)
+{
+    /*
+     * Test Case For:
+     * uint32 CFE_PSP_SysmonAlarm_Check(CFE_PSP_SysmonAlarmSet_t *Set, CFE_PSP_SysmonAlarm_ValueFunc_t ValueFunc,
+     *                                  void *Arg)
+     * void CFE_PSP_SysmonAlarm_GetStatus(const CFE_PSP_SysmonAlarmSet_t *Set, CFE_PSP_SysmonAlarmStatus_t *Status)
+     * void CFE_PSP_SysmonAlarm_Reset(CFE_PSP_SysmonAlarmSet_t *Set)
+     */
+    CFE_PSP_SysmonAlarmStatus_t Status;
+
+    UT_SysmonAlarm_Setup();
+    UtAssert_INT32_EQ(CFE_PSP_SysmonAlarm_Configure(&UT_SysmonAlarm_Set, "alpha/0,10,100,5"), CFE_PSP_SUCCESS);
+
+    UtAssert_UINT32_EQ(UT_SysmonAlarm_CheckValue(50), 0);
+    UtAssert_STUB_COUNT(PCS_SystemNotify, 0);
+
+    /* the high alarm is raised at the limit, and only clears once below it by more than the hysteresis */
+    UtAssert_UINT32_EQ(UT_SysmonAlarm_CheckValue(100), 1);
+    UtAssert_UINT32_EQ(UT_SysmonAlarm_Set.HighMask, 0x1);
+    UtAssert_ZERO(UT_SysmonAlarm_Set.LowMask);
+    UtAssert_STUB_COUNT(PCS_SystemNotify, 1);
+    UtAssert_UINT32_EQ(UT_SysmonAlarm_CheckValue(95), 0);
+    UtAssert_UINT32_EQ(UT_SysmonAlarm_Set.HighMask, 0x1);
+    UtAssert_UINT32_EQ(UT_SysmonAlarm_CheckValue(94), 1);
+    UtAssert_ZERO(UT_SysmonAlarm_Set.HighMask);
+    UtAssert_STUB_COUNT(PCS_SystemNotify, 2);
+
+    /* likewise for the low alarm */
+    UtAssert_UINT32_EQ(UT_SysmonAlarm_CheckValue(10), 1);
+    UtAssert_UINT32_EQ(UT_SysmonAlarm_Set.LowMask, 0x1);
+    UtAssert_UINT32_EQ(UT_SysmonAlarm_CheckValue(15), 0);
+    UtAssert_UINT32_EQ(UT_SysmonAlarm_Set.LowMask, 0x1);
+    UtAssert_UINT32_EQ(UT_SysmonAlarm_CheckValue(16), 1);
+    UtAssert_ZERO(UT_SysmonAlarm_Set.LowMask);
+
+    /* straight from low to high is one crossing */
+    UtAssert_UINT32_EQ(UT_SysmonAlarm_CheckValue(0), 1);
+    UtAssert_UINT32_EQ(UT_SysmonAlarm_CheckValue(0xFFFFFFFF), 1);
+    UtAssert_UINT32_EQ(UT_SysmonAlarm_Set.HighMask, 0x1);
+
+    /* a channel without a valid value keeps its state */
+    UT_SysmonAlarm_Valid = false;
+    UtAssert_UINT32_EQ(CFE_PSP_SysmonAlarm_Check(&UT_SysmonAlarm_Set, UT_SysmonAlarm_ValueFunc, NULL), 0);
+    UtAssert_UINT32_EQ(UT_SysmonAlarm_Set.HighMask, 0x1);
+
+    CFE_PSP_SysmonAlarm_GetStatus(&UT_SysmonAlarm_Set, &Status);
+    UtAssert_UINT32_EQ(Status.HighMask, 0x1);
+    UtAssert_ZERO(Status.LowMask);
+    UtAssert_UINT32_EQ(Status.CrossingCount, 6);
+
+    /* a reset returns to the normal state, but keeps the count */
+    CFE_PSP_SysmonAlarm_Reset(&UT_SysmonAlarm_Set);
+    CFE_PSP_SysmonAlarm_GetStatus(&UT_SysmonAlarm_Set, &Status);
+    UtAssert_ZERO(Status.HighMask);
+    UtAssert_UINT32_EQ(Status.CrossingCount, 6);
+    UtAssert_UINT32_EQ(UT_SysmonAlarm_CheckValue(50), 0);
+
+    /* subsystems without a name are still checked */
+    UtAssert_INT32_EQ(CFE_PSP_SysmonAlarm_Configure(&UT_SysmonAlarm_Set, "7/0,,40"), CFE_PSP_SUCCESS);
+    UtAssert_UINT32_EQ(UT_SysmonAlarm_CheckValue(50), 1);
+    UtAssert_UINT32_EQ(UT_SysmonAlarm_Set.HighMask, 0x2);
+}
+
+void Test_CFE_PSP_SysmonAlarm_Generation(void)
+{
+    /*
+     * Test Case For:
+     * The generation protocol between CFE_PSP_SysmonAlarm_Configure() and CFE_PSP_SysmonAlarm_Check()
+     */
+    CFE_PSP_SysmonAlarm_Entry_t *Entry;
+    uint32                       Generation;
+
+    UT_SysmonAlarm_Setup();
+    Entry = UT_SysmonAlarm_Set.Entry;
+
+    /* each change advances the generation by two, so it is even when not being changed */
+    UtAssert_INT32_EQ(CFE_PSP_SysmonAlarm_Configure(&UT_SysmonAlarm_Set, "alpha/0,,100"), CFE_PSP_SUCCESS);
+    UtAssert_UINT32_EQ(Entry[0].Generation, 2);
+    UtAssert_UINT32_EQ(UT_SysmonAlarm_CheckValue(100), 1);
+    UtAssert_UINT32_EQ(Entry[0].CheckedGeneration, 2);
+
+    /* an alarm part way through a change is skipped, and keeps its state */
+    Generation = Entry[0].Generation;
+    Entry[0].Generation = Generation + 1;
+    UtAssert_UINT32_EQ(UT_SysmonAlarm_CheckValue(0), 0);
+    UtAssert_UINT32_EQ(UT_SysmonAlarm_Set.HighMask, 0x1);
+    Entry[0].Generation = Generation;
+
+    /* new limits start over from the normal state, without counting a crossing */
+    UtAssert_INT32_EQ(CFE_PSP_SysmonAlarm_Configure(&UT_SysmonAlarm_Set, "alpha/0,,200"), CFE_PSP_SUCCESS);
+    UtAssert_UINT32_EQ(Entry[0].Generation, 4);
+    UtAssert_UINT32_EQ(UT_SysmonAlarm_CheckValue(100), 0);
+    UtAssert_UINT32_EQ(Entry[0].CheckedGeneration, 4);
+    UtAssert_ZERO(UT_SysmonAlarm_Set.HighMask);
+
+    /* a removed alarm is no longer checked */
+    UtAssert_UINT32_EQ(UT_SysmonAlarm_CheckValue(200), 1);
+    UtAssert_INT32_EQ(CFE_PSP_SysmonAlarm_Configure(&UT_SysmonAlarm_Set, "alpha/0,,"), CFE_PSP_SUCCESS);
+    UtAssert_UINT32_EQ(Entry[0].Generation, 6);
+    UtAssert_UINT32_EQ(UT_SysmonAlarm_CheckValue(200), 0);
+    UtAssert_ZERO(UT_SysmonAlarm_Set.HighMask);
+}
+
+void Test_CFE_PSP_SysmonAlarm_Notify(void)
+{
+    /*
+     * Test Case For:
+     * void CFE_PSP_SysmonAlarm_SetNotify(CFE_PSP_SysmonAlarmSet_t *Set, CFE_PSP_SysmonAlarm_NotifyFunc_t NotifyFunc,
+     *                                    void *NotifyArg)
+     * void CFE_PSP_SysmonAlarm_Notify(CFE_PSP_SysmonAlarmSet_t *Set)
+     */
+    UT_SysmonAlarm_Setup();
+
+    /* by default CFE is notified directly */
+    CFE_PSP_SysmonAlarm_Notify(&UT_SysmonAlarm_Set);
+    UtAssert_STUB_COUNT(PCS_SystemNotify, 1);
+
+    /* which is skipped if CFE has no notification function */
+    GLOBAL_CFE_CONFIGDATA.SystemNotify = NULL;
+    CFE_PSP_SysmonAlarm_Notify(&UT_SysmonAlarm_Set);
+    GLOBAL_CFE_CONFIGDATA.SystemNotify = PCS_SystemNotify;
+    UtAssert_STUB_COUNT(PCS_SystemNotify, 1);
+
+    /* or the module's own function is used */
+    CFE_PSP_SysmonAlarm_SetNotify(&UT_SysmonAlarm_Set, UT_SysmonAlarm_NotifyFunc, &UT_SysmonAlarm_Set);
+    UtAssert_INT32_EQ(CFE_PSP_SysmonAlarm_Configure(&UT_SysmonAlarm_Set, "alpha/0,,100"), CFE_PSP_SUCCESS);
+    UtAssert_UINT32_EQ(UT_SysmonAlarm_CheckValue(100), 1);
+    UtAssert_UINT32_EQ(UT_SysmonAlarm_NotifyCount, 1);
+    UtAssert_STUB_COUNT(PCS_SystemNotify, 1);
+}
@@ -0,0 +1,276 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,719-1, and identified as “core Flight System: 
+ * Draco
+ *
+ * Copyright (c) 2023 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ **********************************************************************/
+
+/**
+ * \file
+ *
+ * Coverage tests for the shared sysmon sample recorder, cfe_psp_sysmonrecord.c
+ */
+
+#include <string.h>
+
+#include "utassert.h"
+#include "utstubs.h"
+#include "ut-adaptor-sysmonrecord.h"
+
+#include "cfe_psp.h"
+#include "cfe_psp_sysmonrecord.h"
+
+/* size of storage holding the header and the given number of records */
+#define UT_SYSMONRECORD_SIZE(n) (sizeof(CFE_PSP_SysmonRecordHeader_t) + (n) * sizeof(CFE_PSP_SysmonRecordEntry_t))
+
+static const char *const UT_SysmonRecord_SubsystemNames[] = {"alpha", "beta", NULL};
+
+static uint32 UT_SysmonRecord_Memory[UT_SYSMONRECORD_SIZE(8) / sizeof(uint32)];
+
+static CFE_PSP_SysmonRecorder_t UT_SysmonRecord_Recorder;
+
+/* attaches to the test storage, as a ring of the given number of records */
+static int32 UT_SysmonRecord_Attach(uint32 NumRecords, const char *ModuleName)
+{
+    return CFE_PSP_SysmonRecord_Attach(&UT_SysmonRecord_Recorder, UT_SysmonRecord_Memory,
+                                       UT_SYSMONRECORD_SIZE(NumRecords), ModuleName, UT_SysmonRecord_SubsystemNames);
+}
+
+void Test_CFE_PSP_SysmonRecord_Attach(void)
+{
+    /*
+     * Test Case For:
+     * int32 CFE_PSP_SysmonRecord_Attach(CFE_PSP_SysmonRecorder_t *Recorder, void *Memory, size_t Size,
+     *                                   const char *ModuleName, const char *const *SubsystemNames)
+     */
+    CFE_PSP_SysmonRecordHeader_t *Header   = (CFE_PSP_SysmonRecordHeader_t *)UT_SysmonRecord_Memory;
+    CFE_PSP_SysmonRecorder_t *    Recorder = &UT_SysmonRecord_Recorder;
+    const char *                  ManyNames[CFE_PSP_SYSMONRECORD_MAX_SUBSYSTEMS + 2];
+    uint32                        i;
+
+    memset(UT_SysmonRecord_Memory, 0xA5, sizeof(UT_SysmonRecord_Memory));
+
+    /* Error case: no storage */
+    Recorder->Header = Header;
+    UtAssert_INT32_EQ(CFE_PSP_SysmonRecord_Attach(Recorder, NULL, sizeof(UT_SysmonRecord_Memory), "test",
+                                                  UT_SysmonRecord_SubsystemNames),
+                      CFE_PSP_ERROR);
+    UtAssert_NULL(Recorder->Header);
+
+    /* Error case: storage too small for the header and one record */
+    Recorder->Header = Header;
+    UtAssert_INT32_EQ(CFE_PSP_SysmonRecord_Attach(Recorder, UT_SysmonRecord_Memory, UT_SYSMONRECORD_SIZE(1) - 1,
+                                                  "test", UT_SysmonRecord_SubsystemNames),
+                      CFE_PSP_ERROR);
+    UtAssert_NULL(Recorder->Header);
+    UtAssert_STUB_COUNT(OS_printf, 0);
+
+    /* Nominal case: uninitialized storage is initialized, using the largest power of two that fits */
+    UT_SetDefaultReturnValue(UT_KEY(CFE_PSP_GetTimerTicksPerSecond), 1000000);
+    UT_SetDefaultReturnValue(UT_KEY(CFE_PSP_GetTimerLow32Rollover), 0);
+    UtAssert_INT32_EQ(CFE_PSP_SysmonRecord_Attach(Recorder, UT_SysmonRecord_Memory, UT_SYSMONRECORD_SIZE(7) + 3,
+                                                  "test", UT_SysmonRecord_SubsystemNames),
+                      CFE_PSP_SUCCESS);
+    UtAssert_STUB_COUNT(OS_printf, 1);
+    UtAssert_ADDRESS_EQ(Recorder->Header, Header);
+    UtAssert_ADDRESS_EQ(Recorder->Records, Header + 1);
+    UtAssert_UINT32_EQ(Recorder->Mask, 3);
+    UtAssert_ZERO(Recorder->WriteCount);
+    UtAssert_UINT32_EQ(Header->Signature, CFE_PSP_SYSMONRECORD_SIGNATURE);
+    UtAssert_UINT32_EQ(Header->Version, CFE_PSP_SYSMONRECORD_VERSION);
+    UtAssert_UINT32_EQ(Header->HeaderSize, sizeof(CFE_PSP_SysmonRecordHeader_t));
+    UtAssert_UINT32_EQ(Header->NumRecords, 4);
+    UtAssert_UINT32_EQ(Header->TicksPerSecond, 1000000);
+    UtAssert_ZERO(Header->Low32Rollover);
+    UtAssert_UINT32_EQ(Header->AttachCount, 1);
+    UtAssert_ZERO(Header->WriteCount);
+    UtAssert_STRINGBUF_EQ(Header->ModuleName, sizeof(Header->ModuleName), "test", -1);
+    UtAssert_STRINGBUF_EQ(Header->SubsystemNames[0], sizeof(Header->SubsystemNames[0]), "alpha", -1);
+    UtAssert_STRINGBUF_EQ(Header->SubsystemNames[1], sizeof(Header->SubsystemNames[1]), "beta", -1);
+    UtAssert_ZERO(Header->SubsystemNames[2][0]);
+
+    /* Nominal case: the smallest storage holds a single record */
+    UtAssert_INT32_EQ(UT_SysmonRecord_Attach(1, "test"), CFE_PSP_SUCCESS);
+    UtAssert_UINT32_EQ(Header->NumRecords, 1);
+    UtAssert_ZERO(Recorder->Mask);
+
+    /* Nominal case: storage of the same geometry written by the same module is appended to */
+    UtAssert_INT32_EQ(UT_SysmonRecord_Attach(4, "test"), CFE_PSP_SUCCESS);
+    Header->WriteCount = 6;
+    UtAssert_INT32_EQ(UT_SysmonRecord_Attach(4, "test"), CFE_PSP_SUCCESS);
+    UtAssert_UINT32_EQ(Header->AttachCount, 2);
+    UtAssert_UINT32_EQ(Header->WriteCount, 6);
+    UtAssert_UINT32_EQ(Recorder->WriteCount, 6);
+
+    /* Nominal case: a different signature, version, geometry or module is initialized again */
+    Header->Signature = ~CFE_PSP_SYSMONRECORD_SIGNATURE;
+    UtAssert_INT32_EQ(UT_SysmonRecord_Attach(4, "test"), CFE_PSP_SUCCESS);
+    UtAssert_UINT32_EQ(Header->Signature, CFE_PSP_SYSMONRECORD_SIGNATURE);
+    UtAssert_UINT32_EQ(Header->AttachCount, 1);
+    UtAssert_ZERO(Recorder->WriteCount);
+
+    Header->Version    = CFE_PSP_SYSMONRECORD_VERSION + 1;
+    Header->WriteCount = 6;
+    UtAssert_INT32_EQ(UT_SysmonRecord_Attach(4, "test"), CFE_PSP_SUCCESS);
+    UtAssert_UINT32_EQ(Header->Version, CFE_PSP_SYSMONRECORD_VERSION);
+    UtAssert_ZERO(Recorder->WriteCount);
+
+    Header->HeaderSize = sizeof(CFE_PSP_SysmonRecordHeader_t) + 4;
+    Header->WriteCount = 6;
+    UtAssert_INT32_EQ(UT_SysmonRecord_Attach(4, "test"), CFE_PSP_SUCCESS);
+    UtAssert_UINT32_EQ(Header->HeaderSize, sizeof(CFE_PSP_SysmonRecordHeader_t));
+    UtAssert_ZERO(Recorder->WriteCount);
+
+    Header->WriteCount = 6;
+    UtAssert_INT32_EQ(UT_SysmonRecord_Attach(8, "test"), CFE_PSP_SUCCESS);
+    UtAssert_UINT32_EQ(Header->NumRecords, 8);
+    UtAssert_ZERO(Recorder->WriteCount);
+
+    Header->WriteCount = 6;
+    UtAssert_INT32_EQ(UT_SysmonRecord_Attach(8, "other"), CFE_PSP_SUCCESS);
+    UtAssert_STRINGBUF_EQ(Header->ModuleName, sizeof(Header->ModuleName), "other", -1);
+    UtAssert_UINT32_EQ(Header->AttachCount, 1);
+    UtAssert_ZERO(Recorder->WriteCount);
+
+    /* Nominal case: only as many subsystem names as the header holds are kept */
+    for (i = 0; i < CFE_PSP_SYSMONRECORD_MAX_SUBSYSTEMS + 1; ++i)
+    {
+        ManyNames[i] = "many";
+    }
+    ManyNames[i] = NULL;
+    UtAssert_INT32_EQ(CFE_PSP_SysmonRecord_Attach(Recorder, UT_SysmonRecord_Memory, UT_SYSMONRECORD_SIZE(8), "other",
+                                                  ManyNames),
+                      CFE_PSP_SUCCESS);
+    UtAssert_STRINGBUF_EQ(Header->SubsystemNames[CFE_PSP_SYSMONRECORD_MAX_SUBSYSTEMS - 1],
+                          sizeof(Header->SubsystemNames[0]), "many", -1);
+
+    /* Nominal case: the ring is limited to what the 32 bit counts can index */
+    if (sizeof(size_t) > sizeof(uint32))
+    {
+        UtAssert_INT32_EQ(CFE_PSP_SysmonRecord_Attach(Recorder, UT_SysmonRecord_Memory, ~(size_t)0, "other",
+                                                      UT_SysmonRecord_SubsystemNames),
+                          CFE_PSP_SUCCESS);
+        UtAssert_UINT32_EQ(Header->NumRecords, 0x80000000);
+        UtAssert_UINT32_EQ(Recorder->Mask, 0x7FFFFFFF);
+    }
+
+    CFE_PSP_SysmonRecord_Detach(Recorder);
+    UtAssert_NULL(Recorder->Header);
+}
+
+void Test_CFE_PSP_SysmonRecord_AttachReserved(void)
+{
+    /*
+     * Test Case For:
+     * int32 CFE_PSP_SysmonRecord_AttachReserved(CFE_PSP_SysmonRecorder_t *Recorder, const char *ModuleName,
+     *                                           const char *const *SubsystemNames)
+     */
+    CFE_PSP_SysmonRecorder_t *Recorder = &UT_SysmonRecord_Recorder;
+
+    memset(UT_SysmonRecord_Memory, 0, sizeof(UT_SysmonRecord_Memory));
+
+    /* Error case: the platform does not reserve memory for a recorder */
+    UT_Setup_ReservedMem_SysmonRecord(NULL, 0);
+    Recorder->Header = (CFE_PSP_SysmonRecordHeader_t *)UT_SysmonRecord_Memory;
+    UtAssert_INT32_EQ(CFE_PSP_SysmonRecord_AttachReserved(Recorder, "test", UT_SysmonRecord_SubsystemNames),
+                      CFE_PSP_ERROR_NOT_IMPLEMENTED);
+    UtAssert_NULL(Recorder->Header);
+
+    /* Error case: the reserved block is too small */
+    UT_Setup_ReservedMem_SysmonRecord(UT_SysmonRecord_Memory, UT_SYSMONRECORD_SIZE(0));
+    UtAssert_INT32_EQ(CFE_PSP_SysmonRecord_AttachReserved(Recorder, "test", UT_SysmonRecord_SubsystemNames),
+                      CFE_PSP_ERROR);
+    UtAssert_NULL(Recorder->Header);
+
+    /* Nominal case: recording into the reserved block */
+    UT_Setup_ReservedMem_SysmonRecord(UT_SysmonRecord_Memory, sizeof(UT_SysmonRecord_Memory));
+    UtAssert_INT32_EQ(CFE_PSP_SysmonRecord_AttachReserved(Recorder, "test", UT_SysmonRecord_SubsystemNames),
+                      CFE_PSP_SUCCESS);
+    UtAssert_ADDRESS_EQ(Recorder->Header, UT_SysmonRecord_Memory);
+    UtAssert_UINT32_EQ(Recorder->Header->NumRecords, 8);
+
+    CFE_PSP_SysmonRecord_Detach(Recorder);
+    UT_Setup_ReservedMem_SysmonRecord(NULL, 0);
+}
+
+void Test_CFE_PSP_SysmonRecord_Sample(void)
+{
+    /*
+     * Test Case For:
+     * void CFE_PSP_SysmonRecord_BeginSample(CFE_PSP_SysmonRecorder_t *Recorder)
+     * void CFE_PSP_SysmonRecord_Add(CFE_PSP_SysmonRecorder_t *Recorder, uint16 Subsystem, uint16 Subchannel,
+     *                               uint32 Value)
+     * void CFE_PSP_SysmonRecord_EndSample(CFE_PSP_SysmonRecorder_t *Recorder)
+     */
+    CFE_PSP_SysmonRecorder_t *    Recorder = &UT_SysmonRecord_Recorder;
+    CFE_PSP_SysmonRecordHeader_t *Header   = (CFE_PSP_SysmonRecordHeader_t *)UT_SysmonRecord_Memory;
+
+    memset(UT_SysmonRecord_Memory, 0, sizeof(UT_SysmonRecord_Memory));
+
+    /* Nominal case: a recorder which is not attached records nothing */
+    CFE_PSP_SysmonRecord_Detach(Recorder);
+    CFE_PSP_SysmonRecord_BeginSample(Recorder);
+    CFE_PSP_SysmonRecord_Add(Recorder, 1, 2, 3);
+    CFE_PSP_SysmonRecord_EndSample(Recorder);
+    UtAssert_STUB_COUNT(CFE_PSP_Get_Timebase, 0);
+    UtAssert_ZERO(Recorder->WriteCount);
+
+    /* Nominal case: the records of a sample share its timestamp and are published together */
+    UtAssert_INT32_EQ(UT_SysmonRecord_Attach(4, "test"), CFE_PSP_SUCCESS);
+    CFE_PSP_SysmonRecord_BeginSample(Recorder);
+    UtAssert_STUB_COUNT(CFE_PSP_Get_Timebase, 1);
+    Recorder->TimebaseUpper = 1;
+    Recorder->TimebaseLower = 2;
+    CFE_PSP_SysmonRecord_Add(Recorder, 0, 0, 10);
+    CFE_PSP_SysmonRecord_Add(Recorder, 0, 1, 11);
+    CFE_PSP_SysmonRecord_Add(Recorder, 1, 0, 12);
+    UtAssert_UINT32_EQ(Recorder->WriteCount, 3);
+    UtAssert_ZERO(Header->WriteCount);
+    CFE_PSP_SysmonRecord_EndSample(Recorder);
+    UtAssert_UINT32_EQ(Header->WriteCount, 3);
+    UtAssert_UINT32_EQ(Recorder->Records[1].TimebaseUpper, 1);
+    UtAssert_UINT32_EQ(Recorder->Records[1].TimebaseLower, 2);
+    UtAssert_UINT32_EQ(Recorder->Records[1].Subchannel, 1);
+    UtAssert_UINT32_EQ(Recorder->Records[2].Subsystem, 1);
+    UtAssert_UINT32_EQ(Recorder->Records[2].Value, 12);
+
+    /* Nominal case: the ring wraps around, overwriting the oldest records */
+    CFE_PSP_SysmonRecord_BeginSample(Recorder);
+    CFE_PSP_SysmonRecord_Add(Recorder, 0, 0, 20);
+    CFE_PSP_SysmonRecord_Add(Recorder, 0, 1, 21);
+    CFE_PSP_SysmonRecord_Add(Recorder, 1, 0, 22);
+    CFE_PSP_SysmonRecord_EndSample(Recorder);
+    UtAssert_UINT32_EQ(Header->WriteCount, 6);
+    UtAssert_UINT32_EQ(Recorder->Records[3].Value, 20);
+    UtAssert_UINT32_EQ(Recorder->Records[0].Value, 21);
+    UtAssert_UINT32_EQ(Recorder->Records[1].Value, 22);
+    UtAssert_UINT32_EQ(Recorder->Records[2].Value, 12);
+
+    /* Nominal case: the ring position follows the write count when it wraps around too */
+    Recorder->WriteCount = 0xFFFFFFFF;
+    CFE_PSP_SysmonRecord_Add(Recorder, 0, 0, 30);
+    CFE_PSP_SysmonRecord_Add(Recorder, 0, 1, 31);
+    CFE_PSP_SysmonRecord_EndSample(Recorder);
+    UtAssert_UINT32_EQ(Header->WriteCount, 1);
+    UtAssert_UINT32_EQ(Recorder->Records[3].Value, 30);
+    UtAssert_UINT32_EQ(Recorder->Records[0].Value, 31);
+
+    /* Nominal case: nothing is recorded once detached */
+    CFE_PSP_SysmonRecord_Detach(Recorder);
+    CFE_PSP_SysmonRecord_Add(Recorder, 0, 0, 40);
+    CFE_PSP_SysmonRecord_EndSample(Recorder);
+    UtAssert_UINT32_EQ(Header->WriteCount, 1);
+    UtAssert_UINT32_EQ(((CFE_PSP_SysmonRecordEntry_t *)(Header + 1))[1].Value, 22);
+}
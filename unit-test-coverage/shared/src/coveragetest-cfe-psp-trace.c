@@ -0,0 +1,257 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,719-1, and identified as “core Flight System: 
+ * Draco
+ *
+ * Copyright (c) 2023 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ **********************************************************************/
+
+/**
+ * \file
+ *
+ * Coverage tests for the shared trace facility, cfe_psp_trace.c
+ *
+ * The testrunners build the shared code with CFE_PSP_TRACE_ENABLE, as a
+ * platform which opts in to tracing would.
+ */
+
+#include "utassert.h"
+#include "utstubs.h"
+#include "ut-adaptor-trace.h"
+
+#include "cfe_psp.h"
+
+#include "PCS_pthread.h"
+
+extern void CFE_PSP_Trace_Init(uint32 RestartType);
+extern void CFE_PSP_Trace_ReleaseRing(void *Arg);
+
+/* stops recording, so other tests do not write to the test storage */
+static void UT_Trace_Teardown(void)
+{
+    UT_Setup_TraceStorage(false);
+    CFE_PSP_Trace_Init(CFE_PSP_RST_TYPE_POWERON);
+}
+
+void Test_CFE_PSP_Trace_Init(void)
+{
+    /*
+     * Test Case For:
+     * void CFE_PSP_Trace_Init(uint32 RestartType)
+     */
+    CFE_PSP_TraceStorageHeader_t *Header;
+    CFE_PSP_TraceRingHeader_t *   Ring;
+
+    Header = UT_Get_TraceHeader();
+    Ring   = UT_Get_TraceRingHeader(0);
+
+    /* Nominal case: no storage from the platform */
+    UT_Setup_TraceStorage(false);
+    CFE_PSP_Trace_Init(CFE_PSP_RST_TYPE_POWERON);
+    UtAssert_STUB_COUNT(OS_printf, 0);
+    UT_Trace_Record(CFE_PSP_TRACE_EVENT_MODULE_BASE, CFE_PSP_TRACE_PHASE_INSTANT, 1);
+    UtAssert_NULL(UT_Get_TraceLocalRing());
+
+    /* Nominal case: power on reset clears the storage */
+    Header->BootCount = 5;
+    Ring->WriteCount  = 5;
+    Ring->PrevName[0] = 'x';
+    UT_Setup_TraceStorage(true);
+    UT_SetDefaultReturnValue(UT_KEY(CFE_PSP_GetTimerTicksPerSecond), 1000000);
+    CFE_PSP_Trace_Init(CFE_PSP_RST_TYPE_POWERON);
+    UtAssert_STUB_COUNT(OS_printf, 1);
+    UtAssert_STUB_COUNT(PCS_pthread_key_create, 1);
+    UtAssert_UINT32_EQ(Header->Signature, CFE_PSP_TRACE_SIGNATURE);
+    UtAssert_UINT32_EQ(Header->Version, CFE_PSP_TRACE_VERSION);
+    UtAssert_UINT32_EQ(Header->NumRings, UT_Get_TraceMaxRings());
+    UtAssert_UINT32_EQ(Header->RingEntries, UT_Get_TraceRingEntries());
+    UtAssert_UINT32_EQ(Header->TicksPerSecond, 1000000);
+    UtAssert_UINT32_EQ(Header->BootCount, 1);
+    UtAssert_ZERO(Ring->WriteCount);
+    UtAssert_ZERO(Ring->PrevName[0]);
+
+    /* Nominal case: processor reset keeps the events and gives them to the previous owner */
+    Ring->WriteCount = 5;
+    Ring->TaskId     = 7;
+    Ring->Name[0]    = 'a';
+
+    UT_Get_TraceRingHeader(1)->WriteCount = 3;
+    Header->RingsClaimed                  = 1;
+    Header->EventsDropped                 = 1;
+    CFE_PSP_Trace_Init(CFE_PSP_RST_TYPE_PROCESSOR);
+    UtAssert_UINT32_EQ(Header->BootCount, 2);
+    UtAssert_ZERO(Header->RingsClaimed);
+    UtAssert_ZERO(Header->EventsDropped);
+    UtAssert_UINT32_EQ(Ring->WriteCount, 5);
+    UtAssert_UINT32_EQ(Ring->RestartCount, 5);
+    UtAssert_UINT32_EQ(Ring->PrevTaskId, 7);
+    UtAssert_STRINGBUF_EQ(Ring->PrevName, sizeof(Ring->PrevName), "a", -1);
+    UtAssert_ZERO(Ring->TaskId);
+    UtAssert_ZERO(Ring->Name[0]);
+
+    /* Nominal case: a ring not claimed in the previous boot is left as it is */
+    UtAssert_UINT32_EQ(UT_Get_TraceRingHeader(1)->WriteCount, 3);
+    UtAssert_ZERO(UT_Get_TraceRingHeader(1)->RestartCount);
+
+    /* Nominal case: the thread-specific key is only created once */
+    UtAssert_STUB_COUNT(PCS_pthread_key_create, 1);
+
+    /* Error case: processor reset on storage with a different layout is cleared */
+    Header->Version = CFE_PSP_TRACE_VERSION + 1;
+    CFE_PSP_Trace_Init(CFE_PSP_RST_TYPE_PROCESSOR);
+    UtAssert_UINT32_EQ(Header->Version, CFE_PSP_TRACE_VERSION);
+    UtAssert_UINT32_EQ(Header->BootCount, 1);
+    UtAssert_ZERO(Ring->WriteCount);
+    UtAssert_ZERO(Ring->PrevName[0]);
+
+    Header->NumRings = UT_Get_TraceMaxRings() + 1;
+    Ring->WriteCount = 5;
+    CFE_PSP_Trace_Init(CFE_PSP_RST_TYPE_PROCESSOR);
+    UtAssert_UINT32_EQ(Header->NumRings, UT_Get_TraceMaxRings());
+    UtAssert_ZERO(Ring->WriteCount);
+
+    Header->RingEntries = UT_Get_TraceRingEntries() / 2;
+    Ring->WriteCount    = 5;
+    CFE_PSP_Trace_Init(CFE_PSP_RST_TYPE_PROCESSOR);
+    UtAssert_UINT32_EQ(Header->RingEntries, UT_Get_TraceRingEntries());
+    UtAssert_ZERO(Ring->WriteCount);
+
+    Header->Signature = ~CFE_PSP_TRACE_SIGNATURE;
+    Ring->WriteCount  = 5;
+    CFE_PSP_Trace_Init(CFE_PSP_RST_TYPE_PROCESSOR);
+    UtAssert_UINT32_EQ(Header->Signature, CFE_PSP_TRACE_SIGNATURE);
+    UtAssert_ZERO(Ring->WriteCount);
+
+    UT_Trace_Teardown();
+}
+
+void Test_CFE_PSP_Trace_ClaimRing(void)
+{
+    /*
+     * Test Case For:
+     * CFE_PSP_TraceRing_t *CFE_PSP_Trace_ClaimRing(void)
+     * void CFE_PSP_Trace_ReleaseRing(void *Arg)
+     */
+    CFE_PSP_TraceRingHeader_t *Ring;
+    CFE_PSP_TraceEntry_t *     Entry;
+    char                       TaskName[] = "ut-task";
+
+    UT_Setup_TraceStorage(true);
+    CFE_PSP_Trace_Init(CFE_PSP_RST_TYPE_POWERON);
+    Ring = UT_Get_TraceRingHeader(0);
+
+    /* Nominal case: the first event of a thread claims a ring, named after the OSAL task */
+    UT_SetDataBuffer(UT_KEY(OS_GetResourceName), TaskName, sizeof(TaskName), false);
+    UT_Trace_Record(CFE_PSP_TRACE_EVENT_MODULE_BASE, CFE_PSP_TRACE_PHASE_BEGIN, 11);
+    UtAssert_ADDRESS_EQ(UT_Get_TraceLocalRing(), UT_Get_TraceRing(0));
+    UtAssert_STUB_COUNT(PCS_pthread_setspecific, 1);
+    UtAssert_UINT32_EQ(UT_Get_TraceHeader()->RingsClaimed, 1);
+    UtAssert_STRINGBUF_EQ(Ring->Name, sizeof(Ring->Name), "ut-task", -1);
+    UtAssert_UINT32_EQ(Ring->WriteCount, 1);
+    Entry = UT_Get_TraceEntry(0, 0);
+    UtAssert_UINT32_EQ(Entry->EventId, CFE_PSP_TRACE_EVENT_MODULE_BASE);
+    UtAssert_UINT32_EQ(Entry->Phase, CFE_PSP_TRACE_PHASE_BEGIN);
+    UtAssert_UINT32_EQ(Entry->Arg, 11);
+
+    /* Nominal case: later events of the thread use the same ring */
+    UT_Trace_Record(CFE_PSP_TRACE_EVENT_MODULE_BASE, CFE_PSP_TRACE_PHASE_END, 12);
+    UtAssert_STUB_COUNT(PCS_pthread_setspecific, 1);
+    UtAssert_UINT32_EQ(Ring->WriteCount, 2);
+    UtAssert_UINT32_EQ(UT_Get_TraceEntry(0, 1)->Phase, CFE_PSP_TRACE_PHASE_END);
+
+    /* Nominal case: a thread which is not an OSAL task gets a ring of its own */
+    UT_SetDefaultReturnValue(UT_KEY(OS_GetResourceName), OS_ERROR);
+    UT_Clear_TraceLocalRing();
+    UT_Trace_Record(CFE_PSP_TRACE_EVENT_MODULE_BASE, CFE_PSP_TRACE_PHASE_INSTANT, 13);
+    UtAssert_ADDRESS_EQ(UT_Get_TraceLocalRing(), UT_Get_TraceRing(1));
+    UtAssert_STRINGBUF_EQ(UT_Get_TraceRingHeader(1)->Name, sizeof(Ring->Name), "thread-1", -1);
+
+    /* Nominal case: the ring of an exited thread is claimed again, keeping its events */
+    CFE_PSP_Trace_ReleaseRing(UT_Get_TraceRing(0));
+    UT_Clear_TraceLocalRing();
+    UT_Trace_Record(CFE_PSP_TRACE_EVENT_MODULE_BASE, CFE_PSP_TRACE_PHASE_INSTANT, 14);
+    UtAssert_ADDRESS_EQ(UT_Get_TraceLocalRing(), UT_Get_TraceRing(0));
+    UtAssert_UINT32_EQ(UT_Get_TraceHeader()->RingsClaimed, 3);
+    UtAssert_UINT32_EQ(Ring->RestartCount, 2);
+    UtAssert_UINT32_EQ(Ring->WriteCount, 3);
+    UtAssert_STRINGBUF_EQ(Ring->PrevName, sizeof(Ring->PrevName), "ut-task", -1);
+    UtAssert_STRINGBUF_EQ(Ring->Name, sizeof(Ring->Name), "thread-0", -1);
+
+    UT_Trace_Teardown();
+}
+
+void Test_CFE_PSP_Trace_Overflow(void)
+{
+    /*
+     * Test Case For:
+     * CFE_PSP_TraceRing_t *CFE_PSP_Trace_ClaimRing(void)
+     */
+    CFE_PSP_TraceStorageHeader_t *Header;
+    uint32                        MaxRings;
+    uint32                        i;
+
+    UT_Setup_TraceStorage(true);
+    CFE_PSP_Trace_Init(CFE_PSP_RST_TYPE_POWERON);
+    UT_SetDefaultReturnValue(UT_KEY(OS_GetResourceName), OS_ERROR);
+    Header   = UT_Get_TraceHeader();
+    MaxRings = UT_Get_TraceMaxRings();
+
+    /* Nominal case: every ring is claimed by a different thread */
+    for (i = 0; i < MaxRings; ++i)
+    {
+        UT_Clear_TraceLocalRing();
+        UT_Trace_Record(CFE_PSP_TRACE_EVENT_MODULE_BASE, CFE_PSP_TRACE_PHASE_INSTANT, i);
+        UtAssert_UINT32_EQ(UT_Get_TraceRingHeader(i)->WriteCount, 1);
+    }
+
+    /* Error case: with no ring free, events of other threads are dropped rather than recorded */
+    UT_Clear_TraceLocalRing();
+    UT_Trace_Record(CFE_PSP_TRACE_EVENT_MODULE_BASE, CFE_PSP_TRACE_PHASE_INSTANT, 100);
+    UT_Trace_Record(CFE_PSP_TRACE_EVENT_MODULE_BASE, CFE_PSP_TRACE_PHASE_INSTANT, 101);
+    UtAssert_NULL(UT_Get_TraceLocalRing());
+    UtAssert_UINT32_EQ(Header->EventsDropped, 2);
+    UtAssert_UINT32_EQ(Header->RingsClaimed, MaxRings);
+    for (i = 0; i < MaxRings; ++i)
+    {
+        UtAssert_UINT32_EQ(UT_Get_TraceRingHeader(i)->WriteCount, 1);
+    }
+
+    /* Error case: something which is not a ring of the storage frees nothing */
+    CFE_PSP_Trace_ReleaseRing(NULL);
+    CFE_PSP_Trace_ReleaseRing(Header);
+    UT_Trace_Record(CFE_PSP_TRACE_EVENT_MODULE_BASE, CFE_PSP_TRACE_PHASE_INSTANT, 102);
+    UtAssert_NULL(UT_Get_TraceLocalRing());
+    UtAssert_UINT32_EQ(Header->EventsDropped, 3);
+
+    /* Nominal case: the thread gets a ring once one is released, and releasing it again has no effect */
+    CFE_PSP_Trace_ReleaseRing(UT_Get_TraceRing(MaxRings - 1));
+    CFE_PSP_Trace_ReleaseRing(UT_Get_TraceRing(MaxRings - 1));
+    UT_Trace_Record(CFE_PSP_TRACE_EVENT_MODULE_BASE, CFE_PSP_TRACE_PHASE_INSTANT, 103);
+    UtAssert_ADDRESS_EQ(UT_Get_TraceLocalRing(), UT_Get_TraceRing(MaxRings - 1));
+    UtAssert_UINT32_EQ(UT_Get_TraceRingHeader(MaxRings - 1)->WriteCount, 2);
+    UtAssert_UINT32_EQ(Header->EventsDropped, 3);
+
+    /* Error case: still no ring free for another thread */
+    UT_Clear_TraceLocalRing();
+    UT_Trace_Record(CFE_PSP_TRACE_EVENT_MODULE_BASE, CFE_PSP_TRACE_PHASE_INSTANT, 104);
+    UtAssert_NULL(UT_Get_TraceLocalRing());
+    UtAssert_UINT32_EQ(Header->EventsDropped, 4);
+
+    /* Nominal case: a new boot gives every ring back */
+    CFE_PSP_Trace_Init(CFE_PSP_RST_TYPE_PROCESSOR);
+    UT_Trace_Record(CFE_PSP_TRACE_EVENT_MODULE_BASE, CFE_PSP_TRACE_PHASE_INSTANT, 105);
+    UtAssert_ADDRESS_EQ(UT_Get_TraceLocalRing(), UT_Get_TraceRing(0));
+
+    UT_Trace_Teardown();
+}
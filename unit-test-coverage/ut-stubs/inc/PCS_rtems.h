@@ -22,8 +22,20 @@
 
 #include "PCS_basetypes.h"
 
-typedef uint32_t PCS_rtems_task_priority;
-typedef uint32_t PCS_rtems_id;
+typedef uint32_t  PCS_rtems_task_priority;
+typedef uint32_t  PCS_rtems_id;
+typedef uint32_t  PCS_rtems_name;
+typedef uint32_t  PCS_rtems_mode;
+typedef uint32_t  PCS_rtems_attribute;
+typedef uintptr_t PCS_rtems_task_argument;
+typedef void      PCS_rtems_task;
+
+#define PCS_RTEMS_SELF               0
+#define PCS_RTEMS_DEFAULT_MODES      0
+#define PCS_RTEMS_DEFAULT_ATTRIBUTES 0
+
+#define PCS_rtems_build_name(c1, c2, c3, c4) \
+    ((PCS_rtems_name)(c1) << 24 | (PCS_rtems_name)(c2) << 16 | (PCS_rtems_name)(c3) << 8 | (PCS_rtems_name)(c4))
 
 struct PCS_rtems_bsdnet_ifconfig
 {
@@ -44,6 +56,7 @@ struct PCS_rtems_bsdnet_config
 typedef enum
 {
     PCS_RTEMS_SUCCESSFUL = 0,
+    PCS_RTEMS_TOO_MANY   = 5,
 } PCS_rtems_status_code;
 
 #endif
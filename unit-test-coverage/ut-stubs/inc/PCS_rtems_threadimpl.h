@@ -0,0 +1,72 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,719-1, and identified as “core Flight System: Bootes”
+ *
+ * Copyright (c) 2020 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ************************************************************************/
+
+/* PSP coverage stub replacement for rtems/score/threadimpl.h */
+#ifndef PCS_RTEMS_THREADIMPL_H
+#define PCS_RTEMS_THREADIMPL_H
+
+#include "PCS_basetypes.h"
+#include "PCS_rtems.h"
+
+/* ----------------------------------------- */
+/* constants normally defined in rtems/score */
+/* ----------------------------------------- */
+#define PCS_TOD_NANOSECONDS_PER_SECOND      1000000000
+#define PCS_TOD_NANOSECONDS_PER_MICROSECOND 1000
+
+/* ----------------------------------------- */
+/* types normally defined in rtems/score */
+/* ----------------------------------------- */
+
+/* A time in nanoseconds, rather than the binary fraction used by RTEMS */
+typedef int64_t PCS_Timestamp_Control;
+
+typedef struct
+{
+    PCS_rtems_id id;
+    union
+    {
+        const char *name_p;
+        uint32_t    name_u32;
+    } name;
+} PCS_Objects_Control;
+
+typedef struct
+{
+    PCS_Objects_Control   Object;
+    PCS_Timestamp_Control cpu_time_used;
+} PCS_Thread_Control;
+
+/* ----------------------------------------- */
+/* prototypes normally declared in rtems/score */
+/* ----------------------------------------- */
+extern size_t PCS__Thread_Get_name(const PCS_Thread_Control *the_thread, char *buffer, size_t buffer_size);
+extern void   PCS__Thread_Get_CPU_time_used(PCS_Thread_Control *the_thread, PCS_Timestamp_Control *cpu_time_used);
+extern PCS_Timestamp_Control PCS__Thread_Get_CPU_time_used_after_last_reset(PCS_Thread_Control *the_thread);
+extern void                  PCS__TOD_Get_uptime(PCS_Timestamp_Control *time);
+
+extern void     PCS__Timestamp_Subtract(const PCS_Timestamp_Control *start, const PCS_Timestamp_Control *end,
+                                        PCS_Timestamp_Control *result);
+extern void     PCS__Timestamp_Divide(const PCS_Timestamp_Control *lhs, const PCS_Timestamp_Control *rhs,
+                                      uint32_t *ival_percentage, uint32_t *fval_percentage);
+extern bool     PCS__Timestamp_Less_than(const PCS_Timestamp_Control *lhs, const PCS_Timestamp_Control *rhs);
+extern uint64_t PCS__Timestamp_Get_as_nanoseconds(const PCS_Timestamp_Control *time);
+extern uint32_t PCS__Timestamp_Get_seconds(const PCS_Timestamp_Control *time);
+extern uint32_t PCS__Timestamp_Get_nanoseconds(const PCS_Timestamp_Control *time);
+
+#endif
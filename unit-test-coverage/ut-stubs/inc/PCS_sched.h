@@ -0,0 +1,58 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,719-1, and identified as “core Flight System: Bootes”
+ *
+ * Copyright (c) 2020 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ************************************************************************/
+
+/* PSP coverage stub replacement for sched.h */
+#ifndef PCS_SCHED_H
+#define PCS_SCHED_H
+
+#include "PCS_basetypes.h"
+#include "PCS_sys_types.h"
+
+/* ----------------------------------------- */
+/* constants normally defined in sched.h */
+/* ----------------------------------------- */
+
+#define PCS_SCHED_IDLE  0x1E01
+#define PCS_CPU_SETSIZE 64
+
+/* ----------------------------------------- */
+/* types normally defined in sched.h */
+/* ----------------------------------------- */
+
+struct PCS_sched_param
+{
+    int sched_priority;
+};
+
+typedef struct
+{
+    uint64_t bits[PCS_CPU_SETSIZE / 64];
+} PCS_cpu_set_t;
+
+/* ----------------------------------------- */
+/* prototypes normally declared in sched.h */
+/* ----------------------------------------- */
+
+extern void PCS_CPU_ZERO(PCS_cpu_set_t *set);
+extern void PCS_CPU_SET(int cpu, PCS_cpu_set_t *set);
+extern int  PCS_sched_yield(void);
+extern int  PCS_sched_setscheduler(PCS_pid_t pid, int policy, const struct PCS_sched_param *param);
+extern int  PCS_sched_setaffinity(PCS_pid_t pid, size_t cpusetsize, const PCS_cpu_set_t *mask);
+extern int  PCS_sched_getcpu(void);
+
+#endif
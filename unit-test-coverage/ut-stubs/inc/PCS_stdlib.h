@@ -43,5 +43,6 @@ extern int               PCS_system(const char *command);
 extern void *            PCS_malloc(size_t sz);
 extern void              PCS_free(void *ptr);
 extern void              PCS_abort(void);
+extern char *            PCS_getenv(const char *name);
 
 #endif
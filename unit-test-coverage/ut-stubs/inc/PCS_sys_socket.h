@@ -0,0 +1,59 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,719-1, and identified as “core Flight System: Bootes”
+ *
+ * Copyright (c) 2020 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ************************************************************************/
+
+/* PSP coverage stub replacement for sys/socket.h */
+#ifndef PCS_SYS_SOCKET_H
+#define PCS_SYS_SOCKET_H
+
+#include "PCS_basetypes.h"
+#include "PCS_sys_types.h"
+
+/* ----------------------------------------- */
+/* constants normally defined in sys/socket.h */
+/* ----------------------------------------- */
+
+#define PCS_AF_UNIX      0x1F01
+#define PCS_SOCK_DGRAM   0x1F02
+#define PCS_SOCK_CLOEXEC 0x10000
+#define PCS_MSG_DONTWAIT 0x1F04
+
+/* ----------------------------------------- */
+/* types normally defined in sys/socket.h */
+/* ----------------------------------------- */
+
+typedef unsigned int   PCS_socklen_t;
+typedef unsigned short PCS_sa_family_t;
+
+struct PCS_sockaddr
+{
+    PCS_sa_family_t sa_family;
+    char            sa_data[14];
+};
+
+/* ----------------------------------------- */
+/* prototypes normally declared in sys/socket.h */
+/* ----------------------------------------- */
+
+extern int         PCS_socket(int domain, int type, int protocol);
+extern int         PCS_bind(int fd, const struct PCS_sockaddr *addr, PCS_socklen_t len);
+extern PCS_ssize_t PCS_sendto(int fd, const void *buf, size_t n, int flags, const struct PCS_sockaddr *addr,
+                              PCS_socklen_t addr_len);
+extern PCS_ssize_t PCS_recvfrom(int fd, void *buf, size_t n, int flags, struct PCS_sockaddr *addr,
+                                PCS_socklen_t *addr_len);
+
+#endif
@@ -21,17 +21,31 @@
 #define PCS_TIME_H
 
 #include "PCS_basetypes.h"
+#include "PCS_sys_types.h"
 
 /* ----------------------------------------- */
 /* constants normally defined in time.h */
 /* ----------------------------------------- */
 
+#define PCS_CLOCK_MONOTONIC 0x1D01
+
 /* ----------------------------------------- */
 /* types normally defined in time.h */
 /* ----------------------------------------- */
 
+typedef int PCS_clockid_t;
+
+struct PCS_timespec
+{
+    PCS_time_t tv_sec;
+    long       tv_nsec;
+};
+
 /* ----------------------------------------- */
 /* prototypes normally declared in time.h */
 /* ----------------------------------------- */
 
+extern int PCS_clock_gettime(PCS_clockid_t clock_id, struct PCS_timespec *tp);
+extern int PCS_nanosleep(const struct PCS_timespec *req, struct PCS_timespec *rem);
+
 #endif
@@ -0,0 +1,33 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,719-1, and identified as “core Flight System: Bootes”
+ *
+ * Copyright (c) 2020 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ************************************************************************/
+
+/* PSP coverage stub replacement for pthread.h */
+#ifndef OVERRIDE_PTHREAD_H
+#define OVERRIDE_PTHREAD_H
+
+#include "PCS_pthread.h"
+
+/* ----------------------------------------- */
+/* mappings for declarations in pthread.h */
+/* ----------------------------------------- */
+
+#define pthread_key_t       PCS_pthread_key_t
+#define pthread_key_create  PCS_pthread_key_create
+#define pthread_setspecific PCS_pthread_setspecific
+
+#endif
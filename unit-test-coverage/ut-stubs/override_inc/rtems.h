@@ -24,9 +24,20 @@
 
 #define rtems_task_priority PCS_rtems_task_priority
 #define rtems_id            PCS_rtems_id
+#define rtems_name          PCS_rtems_name
+#define rtems_mode          PCS_rtems_mode
+#define rtems_attribute     PCS_rtems_attribute
+#define rtems_task_argument PCS_rtems_task_argument
+#define rtems_task          PCS_rtems_task
+#define rtems_build_name    PCS_rtems_build_name
+
+#define RTEMS_SELF               PCS_RTEMS_SELF
+#define RTEMS_DEFAULT_MODES      PCS_RTEMS_DEFAULT_MODES
+#define RTEMS_DEFAULT_ATTRIBUTES PCS_RTEMS_DEFAULT_ATTRIBUTES
 
 #define rtems_status_code PCS_rtems_status_code
 #define RTEMS_SUCCESSFUL  PCS_RTEMS_SUCCESSFUL
+#define RTEMS_TOO_MANY    PCS_RTEMS_TOO_MANY
 
 #define rtems_bsdnet_ifconfig PCS_rtems_bsdnet_ifconfig
 #define rtems_bsdnet_config   PCS_rtems_bsdnet_config
@@ -0,0 +1,52 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,719-1, and identified as “core Flight System: Bootes”
+ *
+ * Copyright (c) 2020 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ************************************************************************/
+
+/* PSP coverage stub replacement for rtems/score/threadimpl.h */
+#ifndef OVERRIDE_RTEMS_SCORE_THREADIMPL_H
+#define OVERRIDE_RTEMS_SCORE_THREADIMPL_H
+
+#include "PCS_rtems_threadimpl.h"
+
+/* the stubs are of the RTEMS 6 API */
+#ifndef __RTEMS_MAJOR__
+#define __RTEMS_MAJOR__ 6
+#endif
+
+/* ----------------------------------------- */
+/* mappings for declarations in rtems/score */
+/* ----------------------------------------- */
+#define TOD_NANOSECONDS_PER_SECOND      PCS_TOD_NANOSECONDS_PER_SECOND
+#define TOD_NANOSECONDS_PER_MICROSECOND PCS_TOD_NANOSECONDS_PER_MICROSECOND
+
+#define Timestamp_Control PCS_Timestamp_Control
+#define Objects_Control   PCS_Objects_Control
+#define Thread_Control    PCS_Thread_Control
+
+#define _Thread_Get_name                           PCS__Thread_Get_name
+#define _Thread_Get_CPU_time_used                  PCS__Thread_Get_CPU_time_used
+#define _Thread_Get_CPU_time_used_after_last_reset PCS__Thread_Get_CPU_time_used_after_last_reset
+#define _TOD_Get_uptime                            PCS__TOD_Get_uptime
+
+#define _Timestamp_Subtract           PCS__Timestamp_Subtract
+#define _Timestamp_Divide             PCS__Timestamp_Divide
+#define _Timestamp_Less_than          PCS__Timestamp_Less_than
+#define _Timestamp_Get_as_nanoseconds PCS__Timestamp_Get_as_nanoseconds
+#define _Timestamp_Get_seconds        PCS__Timestamp_Get_seconds
+#define _Timestamp_Get_nanoseconds    PCS__Timestamp_Get_nanoseconds
+
+#endif
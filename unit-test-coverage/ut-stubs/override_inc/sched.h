@@ -0,0 +1,40 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,719-1, and identified as “core Flight System: Bootes”
+ *
+ * Copyright (c) 2020 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ************************************************************************/
+
+/* PSP coverage stub replacement for sched.h */
+#ifndef OVERRIDE_SCHED_H
+#define OVERRIDE_SCHED_H
+
+#include "PCS_sched.h"
+
+/* ----------------------------------------- */
+/* mappings for declarations in sched.h */
+/* ----------------------------------------- */
+
+#define SCHED_IDLE         PCS_SCHED_IDLE
+#define CPU_SETSIZE        PCS_CPU_SETSIZE
+#define sched_param        PCS_sched_param
+#define cpu_set_t          PCS_cpu_set_t
+#define CPU_ZERO           PCS_CPU_ZERO
+#define CPU_SET            PCS_CPU_SET
+#define sched_yield        PCS_sched_yield
+#define sched_setscheduler PCS_sched_setscheduler
+#define sched_setaffinity  PCS_sched_setaffinity
+#define sched_getcpu       PCS_sched_getcpu
+
+#endif
@@ -0,0 +1,44 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,719-1, and identified as “core Flight System: Bootes”
+ *
+ * Copyright (c) 2020 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ************************************************************************/
+
+/* PSP coverage stub replacement for sys/socket.h */
+#ifndef OVERRIDE_SYS_SOCKET_H
+#define OVERRIDE_SYS_SOCKET_H
+
+#include "PCS_sys_socket.h"
+
+/* as on POSIX systems, this also provides the sys/types.h definitions */
+#include <sys/types.h>
+
+/* ----------------------------------------- */
+/* mappings for declarations in sys/socket.h */
+/* ----------------------------------------- */
+
+#define AF_UNIX      PCS_AF_UNIX
+#define SOCK_DGRAM   PCS_SOCK_DGRAM
+#define SOCK_CLOEXEC PCS_SOCK_CLOEXEC
+#define MSG_DONTWAIT PCS_MSG_DONTWAIT
+#define socklen_t    PCS_socklen_t
+#define sa_family_t  PCS_sa_family_t
+#define sockaddr     PCS_sockaddr
+#define socket       PCS_socket
+#define bind         PCS_bind
+#define sendto       PCS_sendto
+#define recvfrom     PCS_recvfrom
+
+#endif
@@ -22,4 +22,14 @@
 
 #include "PCS_time.h"
 
+/* ----------------------------------------- */
+/* mappings for declarations in time.h */
+/* ----------------------------------------- */
+
+#define CLOCK_MONOTONIC PCS_CLOCK_MONOTONIC
+#define clockid_t       PCS_clockid_t
+#define timespec        PCS_timespec
+#define clock_gettime   PCS_clock_gettime
+#define nanosleep       PCS_nanosleep
+
 #endif
@@ -43,6 +43,7 @@
 #define read        PCS_read
 #define rmdir       PCS_rmdir
 #define sysconf     PCS_sysconf
+#define unlink      PCS_unlink
 #define write       PCS_write
 
 #endif
@@ -0,0 +1,87 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,719-1, and identified as “core Flight System: Bootes”
+ *
+ * Copyright (c) 2020 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ************************************************************************/
+
+/* PSP coverage stubs for the shared sysmon threshold alarms, cfe_psp_sysmonalarm.h */
+#include "utstubs.h"
+
+#include "cfe_psp_sysmonalarm.h"
+
+void CFE_PSP_SysmonAlarm_Init(CFE_PSP_SysmonAlarmSet_t *Set, const char *ModuleName,
+                              const char *const *SubsystemNames)
+{
+    UT_Stub_RegisterContext(UT_KEY(CFE_PSP_SysmonAlarm_Init), Set);
+    UT_Stub_RegisterContext(UT_KEY(CFE_PSP_SysmonAlarm_Init), ModuleName);
+    UT_Stub_RegisterContext(UT_KEY(CFE_PSP_SysmonAlarm_Init), SubsystemNames);
+    UT_DEFAULT_IMPL(CFE_PSP_SysmonAlarm_Init);
+}
+
+void CFE_PSP_SysmonAlarm_SetNotify(CFE_PSP_SysmonAlarmSet_t *Set, CFE_PSP_SysmonAlarm_NotifyFunc_t NotifyFunc,
+                                   void *NotifyArg)
+{
+    UT_Stub_RegisterContext(UT_KEY(CFE_PSP_SysmonAlarm_SetNotify), Set);
+    UT_Stub_RegisterContextGenericArg(UT_KEY(CFE_PSP_SysmonAlarm_SetNotify), NotifyFunc);
+    UT_Stub_RegisterContext(UT_KEY(CFE_PSP_SysmonAlarm_SetNotify), NotifyArg);
+    UT_DEFAULT_IMPL(CFE_PSP_SysmonAlarm_SetNotify);
+}
+
+int32 CFE_PSP_SysmonAlarm_Configure(CFE_PSP_SysmonAlarmSet_t *Set, const char *Spec)
+{
+    UT_Stub_RegisterContext(UT_KEY(CFE_PSP_SysmonAlarm_Configure), Set);
+    UT_Stub_RegisterContext(UT_KEY(CFE_PSP_SysmonAlarm_Configure), Spec);
+    return UT_DEFAULT_IMPL(CFE_PSP_SysmonAlarm_Configure);
+}
+
+void CFE_PSP_SysmonAlarm_Reset(CFE_PSP_SysmonAlarmSet_t *Set)
+{
+    UT_Stub_RegisterContext(UT_KEY(CFE_PSP_SysmonAlarm_Reset), Set);
+    UT_DEFAULT_IMPL(CFE_PSP_SysmonAlarm_Reset);
+}
+
+/*
+ * A hook may read channels of the module through the ValueFunc and Arg arguments
+ */
+uint32 CFE_PSP_SysmonAlarm_Check(CFE_PSP_SysmonAlarmSet_t *Set, CFE_PSP_SysmonAlarm_ValueFunc_t ValueFunc, void *Arg)
+{
+    UT_Stub_RegisterContext(UT_KEY(CFE_PSP_SysmonAlarm_Check), Set);
+    UT_Stub_RegisterContextGenericArg(UT_KEY(CFE_PSP_SysmonAlarm_Check), ValueFunc);
+    UT_Stub_RegisterContextGenericArg(UT_KEY(CFE_PSP_SysmonAlarm_Check), Arg);
+    return UT_DEFAULT_IMPL(CFE_PSP_SysmonAlarm_Check);
+}
+
+void CFE_PSP_SysmonAlarm_Notify(CFE_PSP_SysmonAlarmSet_t *Set)
+{
+    UT_Stub_RegisterContext(UT_KEY(CFE_PSP_SysmonAlarm_Notify), Set);
+    UT_DEFAULT_IMPL(CFE_PSP_SysmonAlarm_Notify);
+}
+
+/*
+ * The status is copied from the data buffer, if one is set, otherwise it is all zero
+ */
+void CFE_PSP_SysmonAlarm_GetStatus(const CFE_PSP_SysmonAlarmSet_t *Set, CFE_PSP_SysmonAlarmStatus_t *Status)
+{
+    UT_Stub_RegisterContext(UT_KEY(CFE_PSP_SysmonAlarm_GetStatus), Set);
+    UT_Stub_RegisterContext(UT_KEY(CFE_PSP_SysmonAlarm_GetStatus), Status);
+    UT_DEFAULT_IMPL(CFE_PSP_SysmonAlarm_GetStatus);
+
+    if (UT_Stub_CopyToLocal(UT_KEY(CFE_PSP_SysmonAlarm_GetStatus), Status, sizeof(*Status)) < sizeof(*Status))
+    {
+        Status->HighMask      = 0;
+        Status->LowMask       = 0;
+        Status->CrossingCount = 0;
+    }
+}
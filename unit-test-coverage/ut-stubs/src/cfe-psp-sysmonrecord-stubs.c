@@ -0,0 +1,54 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,719-1, and identified as “core Flight System: Bootes”
+ *
+ * Copyright (c) 2020 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ************************************************************************/
+
+/* PSP coverage stubs for the shared sysmon sample recorder, cfe_psp_sysmonrecord.h */
+#include "utstubs.h"
+
+#include "cfe_psp_sysmonrecord.h"
+
+int32 CFE_PSP_SysmonRecord_Attach(CFE_PSP_SysmonRecorder_t *Recorder, void *Memory, size_t Size,
+                                  const char *ModuleName, const char *const *SubsystemNames)
+{
+    UT_Stub_RegisterContext(UT_KEY(CFE_PSP_SysmonRecord_Attach), Recorder);
+    UT_Stub_RegisterContext(UT_KEY(CFE_PSP_SysmonRecord_Attach), Memory);
+    UT_Stub_RegisterContextGenericArg(UT_KEY(CFE_PSP_SysmonRecord_Attach), Size);
+    UT_Stub_RegisterContext(UT_KEY(CFE_PSP_SysmonRecord_Attach), ModuleName);
+    UT_Stub_RegisterContext(UT_KEY(CFE_PSP_SysmonRecord_Attach), SubsystemNames);
+    return UT_DEFAULT_IMPL(CFE_PSP_SysmonRecord_Attach);
+}
+
+int32 CFE_PSP_SysmonRecord_AttachReserved(CFE_PSP_SysmonRecorder_t *Recorder, const char *ModuleName,
+                                          const char *const *SubsystemNames)
+{
+    UT_Stub_RegisterContext(UT_KEY(CFE_PSP_SysmonRecord_AttachReserved), Recorder);
+    UT_Stub_RegisterContext(UT_KEY(CFE_PSP_SysmonRecord_AttachReserved), ModuleName);
+    UT_Stub_RegisterContext(UT_KEY(CFE_PSP_SysmonRecord_AttachReserved), SubsystemNames);
+    return UT_DEFAULT_IMPL(CFE_PSP_SysmonRecord_AttachReserved);
+}
+
+void CFE_PSP_SysmonRecord_Detach(CFE_PSP_SysmonRecorder_t *Recorder)
+{
+    UT_Stub_RegisterContext(UT_KEY(CFE_PSP_SysmonRecord_Detach), Recorder);
+    UT_DEFAULT_IMPL(CFE_PSP_SysmonRecord_Detach);
+}
+
+void CFE_PSP_SysmonRecord_BeginSample(CFE_PSP_SysmonRecorder_t *Recorder)
+{
+    UT_Stub_RegisterContext(UT_KEY(CFE_PSP_SysmonRecord_BeginSample), Recorder);
+    UT_DEFAULT_IMPL(CFE_PSP_SysmonRecord_BeginSample);
+}
@@ -0,0 +1,46 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,719-1, and identified as “core Flight System: Bootes”
+ *
+ * Copyright (c) 2020 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ************************************************************************/
+
+/*
+ * PSP coverage stubs for the timebase API of cfe_psp.h, which is provided by a
+ * timebase module rather than the PSP implementations under test.  The shared
+ * sysmon recorder uses it to timestamp samples.
+ */
+#include "utstubs.h"
+
+#include "cfe_psp.h"
+
+void CFE_PSP_Get_Timebase(uint32 *Tbu, uint32 *Tbl)
+{
+    *Tbu = 0;
+    *Tbl = 0;
+
+    UT_Stub_RegisterContext(UT_KEY(CFE_PSP_Get_Timebase), Tbu);
+    UT_Stub_RegisterContext(UT_KEY(CFE_PSP_Get_Timebase), Tbl);
+    UT_DEFAULT_IMPL(CFE_PSP_Get_Timebase);
+}
+
+uint32 CFE_PSP_GetTimerTicksPerSecond(void)
+{
+    return UT_DEFAULT_IMPL(CFE_PSP_GetTimerTicksPerSecond);
+}
+
+uint32 CFE_PSP_GetTimerLow32Rollover(void)
+{
+    return UT_DEFAULT_IMPL(CFE_PSP_GetTimerLow32Rollover);
+}
@@ -82,6 +82,25 @@ unsigned long int PCS_strtoul(const char *nptr, char **endptr, int base)
     return Result;
 }
 
+/*
+ * Gets the next value from the data buffer, which is an array of string
+ * pointers in the order of the calls, or NULL (variable not set) if there is none
+ */
+char *PCS_getenv(const char *name)
+{
+    char *retval;
+
+    UT_Stub_RegisterContext(UT_KEY(PCS_getenv), name);
+
+    retval = NULL;
+    if (UT_DEFAULT_IMPL(PCS_getenv) == 0)
+    {
+        UT_Stub_CopyToLocal(UT_KEY(PCS_getenv), &retval, sizeof(retval));
+    }
+
+    return retval;
+}
+
 int PCS_system(const char *command)
 {
     return UT_DEFAULT_IMPL(PCS_system);
@@ -18,11 +18,13 @@
 
 /* PSP coverage stub replacement for string.h */
 #include <string.h>
+#include <strings.h>
 #include <stdlib.h>
 #include <stdio.h>
 #include "utstubs.h"
 
 #include "PCS_string.h"
+#include "PCS_strings.h"
 
 void *PCS_memset(void *s, int c, size_t n)
 {
@@ -203,3 +205,8 @@ char *PCS_strerror(int errnum)
     snprintf(str, sizeof(str), "UT_ERR_%d", errnum);
     return str;
 }
+
+int PCS_strcasecmp(const char *s1, const char *s2)
+{
+    return UT_DEFAULT_IMPL_RC(PCS_strcasecmp, strcasecmp(s1, s2));
+}
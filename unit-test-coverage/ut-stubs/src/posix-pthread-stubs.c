@@ -0,0 +1,39 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,719-1, and identified as “core Flight System: Bootes”
+ *
+ * Copyright (c) 2020 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ************************************************************************/
+
+/* PSP coverage stub replacement for pthread.h */
+#include "utstubs.h"
+
+#include "PCS_pthread.h"
+
+int PCS_pthread_key_create(PCS_pthread_key_t *key, void (*destructor)(void *))
+{
+    *key = 0;
+
+    UT_Stub_RegisterContext(UT_KEY(PCS_pthread_key_create), key);
+    UT_Stub_RegisterContext(UT_KEY(PCS_pthread_key_create), destructor);
+
+    return UT_DEFAULT_IMPL(PCS_pthread_key_create);
+}
+
+int PCS_pthread_setspecific(PCS_pthread_key_t key, const void *value)
+{
+    UT_Stub_RegisterContext(UT_KEY(PCS_pthread_setspecific), value);
+
+    return UT_DEFAULT_IMPL(PCS_pthread_setspecific);
+}
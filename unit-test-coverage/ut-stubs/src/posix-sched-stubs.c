@@ -0,0 +1,63 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,719-1, and identified as “core Flight System: Bootes”
+ *
+ * Copyright (c) 2020 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ************************************************************************/
+
+/* PSP coverage stub replacement for sched.h */
+#include <string.h>
+#include "utstubs.h"
+
+#include "PCS_sched.h"
+
+/*
+ * The CPU set operations are not stubs, but work on the stub PCS_cpu_set_t
+ */
+void PCS_CPU_ZERO(PCS_cpu_set_t *set)
+{
+    memset(set, 0, sizeof(*set));
+}
+
+void PCS_CPU_SET(int cpu, PCS_cpu_set_t *set)
+{
+    if (cpu >= 0 && cpu < PCS_CPU_SETSIZE)
+    {
+        set->bits[cpu / 64] |= (uint64_t)1 << (cpu % 64);
+    }
+}
+
+int PCS_sched_yield(void)
+{
+    return UT_DEFAULT_IMPL(PCS_sched_yield);
+}
+
+int PCS_sched_setscheduler(PCS_pid_t pid, int policy, const struct PCS_sched_param *param)
+{
+    UT_Stub_RegisterContextGenericArg(UT_KEY(PCS_sched_setscheduler), policy);
+
+    return UT_DEFAULT_IMPL(PCS_sched_setscheduler);
+}
+
+int PCS_sched_setaffinity(PCS_pid_t pid, size_t cpusetsize, const PCS_cpu_set_t *mask)
+{
+    UT_Stub_RegisterContext(UT_KEY(PCS_sched_setaffinity), mask);
+
+    return UT_DEFAULT_IMPL(PCS_sched_setaffinity);
+}
+
+int PCS_sched_getcpu(void)
+{
+    return UT_DEFAULT_IMPL(PCS_sched_getcpu);
+}
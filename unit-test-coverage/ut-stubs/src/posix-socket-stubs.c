@@ -0,0 +1,69 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,719-1, and identified as “core Flight System: Bootes”
+ *
+ * Copyright (c) 2020 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ************************************************************************/
+
+/* PSP coverage stub replacement for sys/socket.h */
+#include <string.h>
+#include "utstubs.h"
+
+#include "PCS_sys_socket.h"
+
+int PCS_socket(int domain, int type, int protocol)
+{
+    return UT_DEFAULT_IMPL_RC(PCS_socket, 3);
+}
+
+int PCS_bind(int fd, const struct PCS_sockaddr *addr, PCS_socklen_t len)
+{
+    return UT_DEFAULT_IMPL(PCS_bind);
+}
+
+PCS_ssize_t PCS_sendto(int fd, const void *buf, size_t n, int flags, const struct PCS_sockaddr *addr,
+                       PCS_socklen_t addr_len)
+{
+    int32 Status;
+
+    UT_Stub_RegisterContext(UT_KEY(PCS_sendto), buf);
+    UT_Stub_RegisterContextGenericArg(UT_KEY(PCS_sendto), n);
+
+    Status = UT_DEFAULT_IMPL_RC(PCS_sendto, n);
+
+    return Status;
+}
+
+/*
+ * Receives the data in the data buffer, if any, unless a hook function
+ * (which may fill the buffer itself) returns a nonzero status
+ */
+PCS_ssize_t PCS_recvfrom(int fd, void *buf, size_t n, int flags, struct PCS_sockaddr *addr,
+                         PCS_socklen_t *addr_len)
+{
+    int32 Status;
+
+    UT_Stub_RegisterContext(UT_KEY(PCS_recvfrom), buf);
+    UT_Stub_RegisterContextGenericArg(UT_KEY(PCS_recvfrom), n);
+    UT_Stub_RegisterContext(UT_KEY(PCS_recvfrom), addr_len);
+
+    Status = UT_DEFAULT_IMPL(PCS_recvfrom);
+
+    if (Status == 0)
+    {
+        Status = UT_Stub_CopyToLocal(UT_KEY(PCS_recvfrom), buf, n);
+    }
+
+    return Status;
+}
@@ -0,0 +1,48 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,719-1, and identified as “core Flight System: Bootes”
+ *
+ * Copyright (c) 2020 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ************************************************************************/
+
+/* PSP coverage stub replacement for time.h */
+#include <string.h>
+#include "utstubs.h"
+
+#include "PCS_time.h"
+
+/*
+ * Gets the next time from the data buffer, which is an array of
+ * struct PCS_timespec, or zero if there is none
+ */
+int PCS_clock_gettime(PCS_clockid_t clock_id, struct PCS_timespec *tp)
+{
+    int32 Status;
+
+    Status = UT_DEFAULT_IMPL(PCS_clock_gettime);
+
+    if (Status == 0 && UT_Stub_CopyToLocal(UT_KEY(PCS_clock_gettime), tp, sizeof(*tp)) < sizeof(*tp))
+    {
+        memset(tp, 0, sizeof(*tp));
+    }
+
+    return Status;
+}
+
+int PCS_nanosleep(const struct PCS_timespec *req, struct PCS_timespec *rem)
+{
+    UT_Stub_RegisterContext(UT_KEY(PCS_nanosleep), req);
+
+    return UT_DEFAULT_IMPL(PCS_nanosleep);
+}
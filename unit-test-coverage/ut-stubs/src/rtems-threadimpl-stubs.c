@@ -0,0 +1,118 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,719-1, and identified as “core Flight System: Bootes”
+ *
+ * Copyright (c) 2020 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ************************************************************************/
+
+/* PSP coverage stub replacement for rtems/score/threadimpl.h */
+#include <string.h>
+#include <stdlib.h>
+#include "utstubs.h"
+
+#include "PCS_rtems_threadimpl.h"
+
+size_t PCS__Thread_Get_name(const PCS_Thread_Control *the_thread, char *buffer, size_t buffer_size)
+{
+    const char *Name;
+
+    UT_DEFAULT_IMPL(PCS__Thread_Get_name);
+
+    Name = the_thread->Object.name.name_p;
+    if (Name == NULL)
+    {
+        Name = "";
+    }
+
+    strncpy(buffer, Name, buffer_size - 1);
+    buffer[buffer_size - 1] = 0;
+
+    return strlen(buffer);
+}
+
+void PCS__Thread_Get_CPU_time_used(PCS_Thread_Control *the_thread, PCS_Timestamp_Control *cpu_time_used)
+{
+    UT_DEFAULT_IMPL(PCS__Thread_Get_CPU_time_used);
+
+    *cpu_time_used = the_thread->cpu_time_used;
+}
+
+PCS_Timestamp_Control PCS__Thread_Get_CPU_time_used_after_last_reset(PCS_Thread_Control *the_thread)
+{
+    UT_DEFAULT_IMPL(PCS__Thread_Get_CPU_time_used_after_last_reset);
+
+    return the_thread->cpu_time_used;
+}
+
+/*
+ * Gets the next uptime from the data buffer, which is an array of PCS_Timestamp_Control,
+ * or zero if there is none
+ */
+void PCS__TOD_Get_uptime(PCS_Timestamp_Control *time)
+{
+    UT_DEFAULT_IMPL(PCS__TOD_Get_uptime);
+
+    if (UT_Stub_CopyToLocal(UT_KEY(PCS__TOD_Get_uptime), time, sizeof(*time)) < sizeof(*time))
+    {
+        *time = 0;
+    }
+}
+
+/*
+ * The timestamp operations are not stubs, but do the same as RTEMS on the
+ * nanosecond PCS_Timestamp_Control
+ */
+void PCS__Timestamp_Subtract(const PCS_Timestamp_Control *start, const PCS_Timestamp_Control *end,
+                             PCS_Timestamp_Control *result)
+{
+    *result = *end - *start;
+}
+
+void PCS__Timestamp_Divide(const PCS_Timestamp_Control *lhs, const PCS_Timestamp_Control *rhs,
+                           uint32_t *ival_percentage, uint32_t *fval_percentage)
+{
+    int64_t answer;
+
+    if (*rhs == 0)
+    {
+        *ival_percentage = 0;
+        *fval_percentage = 0;
+        return;
+    }
+
+    answer = (*lhs * 100000) / *rhs;
+
+    *ival_percentage = answer / 1000;
+    *fval_percentage = answer % 1000;
+}
+
+bool PCS__Timestamp_Less_than(const PCS_Timestamp_Control *lhs, const PCS_Timestamp_Control *rhs)
+{
+    return *lhs < *rhs;
+}
+
+uint64_t PCS__Timestamp_Get_as_nanoseconds(const PCS_Timestamp_Control *time)
+{
+    return *time;
+}
+
+uint32_t PCS__Timestamp_Get_seconds(const PCS_Timestamp_Control *time)
+{
+    return *time / PCS_TOD_NANOSECONDS_PER_SECOND;
+}
+
+uint32_t PCS__Timestamp_Get_nanoseconds(const PCS_Timestamp_Control *time)
+{
+    return *time % PCS_TOD_NANOSECONDS_PER_SECOND;
+}
@@ -193,6 +193,38 @@ void CFE_PSP_GetTime(OS_time_t *LocalTime)
     }
 }
 
+/*****************************************************************************/
+/**
+** \brief CFE_PSP_GetTimeCoarse stub function
+**
+** \par Description
+**        This function is used as a placeholder for the PSP function
+**        CFE_PSP_GetTimeCoarse.  The LocalTime structure is set to the user-defined
+**        values in BSP_Time.
+**
+** \par Assumptions, External Events, and Notes:
+**        None
+**
+** \returns
+**        This function does not return a value.
+**
+******************************************************************************/
+void CFE_PSP_GetTimeCoarse(OS_time_t *LocalTime)
+{
+    int32 status;
+
+    status = UT_DEFAULT_IMPL(CFE_PSP_GetTimeCoarse);
+
+    if (status >= 0)
+    {
+        if (UT_Stub_CopyToLocal(UT_KEY(CFE_PSP_GetTimeCoarse), (uint8 *)LocalTime, sizeof(*LocalTime)) <
+            sizeof(*LocalTime))
+        {
+            *LocalTime = OS_TimeAssembleFromNanoseconds(100, 200000);
+        }
+    }
+}
+
 /*****************************************************************************/
 /**
 ** \brief CFE_PSP_WriteToCDS stub function
@@ -376,6 +408,108 @@ void CFE_PSP_Get_Timebase(uint32 *Tbu, uint32 *Tbl)
     UT_DEFAULT_IMPL(CFE_PSP_Get_Timebase);
 }
 
+/*****************************************************************************/
+/**
+** \brief CFE_PSP_SoftTimebase_GetStats stub function
+**
+** \par Description
+**        This function is used as a placeholder for the PSP function
+**        CFE_PSP_SoftTimebase_GetStats.  The Stats structure is set to the
+**        user-defined data buffer, if any.
+**
+** \par Assumptions, External Events, and Notes:
+**        None
+**
+** \returns
+**        Returns either CFE_PSP_SUCCESS or a user-defined value.
+**
+******************************************************************************/
+int32 CFE_PSP_SoftTimebase_GetStats(CFE_PSP_SoftTimebase_Stats_t *Stats)
+{
+    int32 status;
+
+    UT_Stub_RegisterContext(UT_KEY(CFE_PSP_SoftTimebase_GetStats), Stats);
+    status = UT_DEFAULT_IMPL(CFE_PSP_SoftTimebase_GetStats);
+
+    if (status >= 0)
+    {
+        if (UT_Stub_CopyToLocal(UT_KEY(CFE_PSP_SoftTimebase_GetStats), (uint8 *)Stats, sizeof(*Stats)) <
+            sizeof(*Stats))
+        {
+            memset(Stats, 0, sizeof(*Stats));
+        }
+    }
+
+    return status;
+}
+
+/*****************************************************************************/
+/**
+** \brief CFE_PSP_SoftTimebase_ResetStats stub function
+**
+** \par Description
+**        This function is used as a placeholder for the PSP function
+**        CFE_PSP_SoftTimebase_ResetStats.
+**
+** \par Assumptions, External Events, and Notes:
+**        None
+**
+** \returns
+**        This function does not return a value.
+**
+******************************************************************************/
+void CFE_PSP_SoftTimebase_ResetStats(void)
+{
+    UT_DEFAULT_IMPL(CFE_PSP_SoftTimebase_ResetStats);
+}
+
+/*****************************************************************************/
+/**
+** \brief CFE_PSP_SoftTimebase_SetCoarsePeriod stub function
+**
+** \par Description
+**        This function is used as a placeholder for the PSP function
+**        CFE_PSP_SoftTimebase_SetCoarsePeriod.
+**
+** \par Assumptions, External Events, and Notes:
+**        None
+**
+** \returns
+**        This function does not return a value.
+**
+******************************************************************************/
+void CFE_PSP_SoftTimebase_SetCoarsePeriod(uint32 PeriodUsec)
+{
+    UT_Stub_RegisterContextGenericArg(UT_KEY(CFE_PSP_SoftTimebase_SetCoarsePeriod), PeriodUsec);
+    UT_DEFAULT_IMPL(CFE_PSP_SoftTimebase_SetCoarsePeriod);
+}
+
+/*****************************************************************************/
+/**
+** \brief CFE_PSP_SoftTimebase_AddDerived stub function
+**
+** \par Description
+**        This function is used as a placeholder for the PSP function
+**        CFE_PSP_SoftTimebase_AddDerived.
+**
+** \par Assumptions, External Events, and Notes:
+**        None
+**
+** \returns
+**        Returns either CFE_PSP_SUCCESS or a user-defined value.
+**
+******************************************************************************/
+int32 CFE_PSP_SoftTimebase_AddDerived(const char *Name, uint32 Divider, CFE_PSP_SoftTimebase_Callback_t Callback,
+                                      void *Arg)
+{
+    UT_Stub_RegisterContext(UT_KEY(CFE_PSP_SoftTimebase_AddDerived), Name);
+    UT_Stub_RegisterContextGenericArg(UT_KEY(CFE_PSP_SoftTimebase_AddDerived), Divider);
+    UT_Stub_RegisterContextGenericArg(UT_KEY(CFE_PSP_SoftTimebase_AddDerived), Callback);
+    UT_Stub_RegisterContext(UT_KEY(CFE_PSP_SoftTimebase_AddDerived), Arg);
+
+    return UT_DEFAULT_IMPL(CFE_PSP_SoftTimebase_AddDerived);
+}
+
 /*****************************************************************************/
 /**
 ** \brief CFE_PSP_GetResetArea stub function